@@ -0,0 +1,154 @@
+#include "xna/common/dynamicaabbtree.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace xna;
+
+//DynamicAabbTree against the brute force loops it replaces, at 1k, 10k and 100k boxes.
+//The boxes have half extents in [0.2, 1.5] and fill a cube whose side grows with the cube root of the count, so the
+//density stays the same. Every other box moves up to 0.3 units per axis each frame.
+static constexpr int Frames = 5;
+
+struct Scene {
+	std::vector<BoundingBox> Boxes;
+	std::vector<Vector3> Velocities;
+	float Side{ 0 };
+};
+
+static Scene CreateScene(size_t count, uint32_t seed) {
+	Scene scene;
+	scene.Side = std::cbrt(static_cast<float>(count)) * 10.0F;
+	scene.Boxes.resize(count);
+	scene.Velocities.resize(count);
+
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> position(0.0F, scene.Side);
+	std::uniform_real_distribution<float> extent(0.2F, 1.5F);
+	std::uniform_real_distribution<float> velocity(-0.3F, 0.3F);
+
+	for (size_t i = 0; i < count; ++i) {
+		const Vector3 center(position(random), position(random), position(random));
+		const Vector3 halfExtent(extent(random), extent(random), extent(random));
+		scene.Boxes[i] = BoundingBox(center - halfExtent, center + halfExtent);
+		scene.Velocities[i] = i % 2 == 0 ? Vector3(velocity(random), velocity(random), velocity(random)) : Vector3::Zero();
+	}
+
+	return scene;
+}
+
+template <typename Function>
+static double Milliseconds(Function&& function) {
+	const auto start = std::chrono::steady_clock::now();
+	function();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static size_t BruteForcePairs(std::vector<BoundingBox> const& boxes) {
+	size_t pairs = 0;
+
+	for (size_t i = 0; i < boxes.size(); ++i) {
+		for (size_t j = i + 1; j < boxes.size(); ++j) {
+			if (boxes[i].Intersects(boxes[j]))
+				++pairs;
+		}
+	}
+
+	return pairs;
+}
+
+static size_t TreePairs(DynamicAabbTree const& tree, std::vector<BoundingBox> const& boxes) {
+	size_t pairs = 0;
+
+	//The tree reports pairs of fattened boxes, the exact boxes filter them like the narrow phase would.
+	tree.QueryPairs([&](size_t proxy1, size_t proxy2) {
+		if (boxes[tree.UserData(proxy1)].Intersects(boxes[tree.UserData(proxy2)]))
+			++pairs;
+
+		return true;
+		});
+
+	return pairs;
+}
+
+static bool Run(size_t count) {
+	auto scene = CreateScene(count, 44);
+	DynamicAabbTree tree;
+	std::vector<size_t> proxies(count);
+
+	const auto build = Milliseconds([&] {
+		for (size_t i = 0; i < count; ++i)
+			proxies[i] = tree.Add(scene.Boxes[i], i);
+		});
+
+	auto move = 0.0;
+	auto pairs = 0.0;
+	size_t reinserts = 0;
+	size_t treePairs = 0;
+
+	for (int frame = 0; frame < Frames; ++frame) {
+		move += Milliseconds([&] {
+			for (size_t i = 0; i < count; i += 2) {
+				auto& box = scene.Boxes[i];
+				box = BoundingBox(box.Min + scene.Velocities[i], box.Max + scene.Velocities[i]);
+
+				if (tree.Move(proxies[i], box, scene.Velocities[i]))
+					++reinserts;
+			}
+			});
+
+		pairs += Milliseconds([&] { treePairs = TreePairs(tree, scene.Boxes); });
+	}
+
+	//One frame of the quadratic loop, 100k boxes take most of a minute.
+	size_t brutePairs = 0;
+	const auto bruteForce = Milliseconds([&] { brutePairs = BruteForcePairs(scene.Boxes); });
+
+	//A camera over the middle of the cube, about a third of the boxes are visible.
+	const auto side = scene.Side;
+	const BoundingFrustum frustum(
+		Matrix::CreateLookAt(Vector3(side / 2, side / 2, side * 1.2F), Vector3(side / 2, side / 2, 0), Vector3::Up())
+		* Matrix::CreatePerspectiveFieldOfView(0.8F, 1.3F, 0.1F, side));
+
+	size_t treeVisible = 0;
+	const auto treeCulling = Milliseconds([&] {
+		tree.Query(frustum, [&](size_t) {
+			++treeVisible;
+			return true;
+			});
+		});
+
+	size_t loopVisible = 0;
+	const auto loopCulling = Milliseconds([&] {
+		for (size_t i = 0; i < count; ++i) {
+			uint8_t planeMask = BoundingFrustum::AllPlanes;
+			uint8_t lastPlane = 0;
+
+			if (frustum.Cull(tree.FatBox(proxies[i]), planeMask, lastPlane) != ContainmentType::Disjoint)
+				++loopVisible;
+		}
+		});
+
+	std::printf("%zu boxes: build %.2f ms, height %zu\n", count, build, tree.Height());
+	std::printf("  per frame: move %.2f ms (%zu reinserts), pairs %.2f ms, brute force pairs %.2f ms\n",
+		move / Frames, reinserts / Frames, pairs / Frames, bruteForce);
+	std::printf("  frustum: tree %.3f ms, Cull loop %.3f ms, %zu visible\n", treeCulling, loopCulling, treeVisible);
+
+	if (treePairs != brutePairs || treeVisible != loopVisible) {
+		std::printf("  the tree found %zu pairs and %zu visible boxes, the loops %zu and %zu\n", treePairs, treeVisible, brutePairs, loopVisible);
+		return false;
+	}
+
+	return true;
+}
+
+int main() {
+	auto passed = true;
+
+	for (const size_t count : { 1000, 10000, 100000 })
+		passed = Run(count) && passed;
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+#include "csharp/runtime/intrinsics.hpp"
+#include "xna/common/fastmath.hpp"
+#include "xna/common/numerics.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace xna;
+using csharp::X86Intrinsics;
+
+//Batch overloads of the numerics types against the loops over the single functions they replace.
+//Every figure is the best of Runs, in microseconds, so the noise of other processes only makes a run slower.
+static constexpr int Runs = 40;
+
+template <typename Function>
+static double Microseconds(Function&& function) {
+	auto best = 0.0;
+
+	for (int run = 0; run < Runs; ++run) {
+		const auto start = std::chrono::steady_clock::now();
+		function();
+		const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+		if (run == 0 || elapsed < best)
+			best = elapsed;
+	}
+
+	return best;
+}
+
+//Number of results of the batch that do not have the same bits as the loop.
+template <typename T>
+static size_t Differences(std::vector<T> const& batch, std::vector<T> const& loop) {
+	size_t differences = 0;
+
+	for (size_t i = 0; i < batch.size(); ++i) {
+		if (!(batch[i] == loop[i]))
+			++differences;
+	}
+
+	return differences;
+}
+
+template <typename Batch, typename Loop, typename T>
+static void Compare(char const* name, Batch&& batch, Loop&& loop, std::vector<T> const& batchResults, std::vector<T> const& loopResults) {
+	const auto batchTime = Microseconds(batch);
+	const auto loopTime = Microseconds(loop);
+	std::printf("  %-34s %8.1f %8.1f", name, loopTime, batchTime);
+
+	if (const auto differences = Differences(batchResults, loopResults))
+		std::printf("   %zu results differ", differences);
+
+	std::printf("\n");
+}
+
+//The Vector2, Vector3 and Vector4 Transform and TransformNormal overloads over arrays, 100k vectors.
+static void Transforms() {
+	constexpr size_t Count = 100000;
+
+	std::mt19937 random(31);
+	std::uniform_real_distribution<float> value(-10.0F, 10.0F);
+	std::vector<Vector2> vectors2(Count), batch2(Count), loop2(Count);
+	std::vector<Vector3> vectors3(Count), batch3(Count), loop3(Count);
+	std::vector<Vector4> vectors4(Count), batch4(Count), loop4(Count);
+
+	for (size_t i = 0; i < Count; ++i) {
+		vectors2[i] = Vector2(value(random), value(random));
+		vectors3[i] = Vector3(value(random), value(random), value(random));
+		vectors4[i] = Vector4(value(random), value(random), value(random), value(random));
+	}
+
+	const auto matrix = Matrix::CreateFromYawPitchRoll(0.3F, 0.5F, 0.7F) * Matrix::CreateTranslation(1, 2, 3);
+	const auto rotation = Quaternion::CreateFromYawPitchRoll(0.3F, 0.5F, 0.7F);
+
+	std::printf("%zu vectors, us                        loop    batch\n", Count);
+
+	Compare("Vector2 Transform",
+		[&] { Vector2::Transform(vectors2.data(), Count, matrix, batch2.data(), Count); },
+		[&] {
+			for (size_t i = 0; i < Count; ++i)
+				loop2[i] = Vector2::Transform(vectors2[i], matrix);
+		},
+		batch2, loop2);
+
+	Compare("Vector3 Transform",
+		[&] { Vector3::Transform(vectors3.data(), Count, matrix, batch3.data(), Count); },
+		[&] {
+			for (size_t i = 0; i < Count; ++i)
+				loop3[i] = Vector3::Transform(vectors3[i], matrix);
+		},
+		batch3, loop3);
+
+	Compare("Vector3 TransformNormal",
+		[&] { Vector3::TransformNormal(vectors3.data(), Count, matrix, batch3.data(), Count); },
+		[&] {
+			for (size_t i = 0; i < Count; ++i)
+				loop3[i] = Vector3::TransformNormal(vectors3[i], matrix);
+		},
+		batch3, loop3);
+
+	//The quaternion overload over arrays is named TransformNormal, like in XNA.
+	Compare("Vector3 TransformNormal(rotation)",
+		[&] { Vector3::TransformNormal(vectors3.data(), Count, rotation, batch3.data(), Count); },
+		[&] {
+			for (size_t i = 0; i < Count; ++i)
+				loop3[i] = Vector3::Transform(vectors3[i], rotation);
+		},
+		batch3, loop3);
+
+	Compare("Vector4 Transform",
+		[&] { Vector4::Transform(vectors4.data(), Count, matrix, batch4.data(), Count); },
+		[&] {
+			for (size_t i = 0; i < Count; ++i)
+				loop4[i] = Vector4::Transform(vectors4[i], matrix);
+		},
+		batch4, loop4);
+}
+
+//The Quaternion and FastMath batches and the skinning palette conversion, 4096 quaternions like a large skeleton set.
+static void Quaternions() {
+	constexpr size_t Count = 4096;
+	constexpr float Amount = 0.3F;
+
+	std::mt19937 random(35);
+	std::uniform_real_distribution<float> value(-1.0F, 1.0F);
+	std::vector<Quaternion> quaternions1(Count), quaternions2(Count), batch(Count), loop(Count);
+	std::vector<Matrix> batchPalette(Count), loopPalette(Count);
+
+	for (size_t i = 0; i < Count; ++i) {
+		quaternions1[i] = Quaternion::Normalize(Quaternion(value(random), value(random), value(random), value(random)));
+		quaternions2[i] = Quaternion::Normalize(Quaternion(value(random), value(random), value(random), value(random)));
+	}
+
+	const std::span<const Quaternion> sources1(quaternions1);
+	const std::span<const Quaternion> sources2(quaternions2);
+
+	std::printf("%zu quaternions, us                     loop    batch\n", Count);
+
+	Compare("Quaternion Normalize",
+		[&] { Quaternion::Normalize(sources1, batch); },
+		[&] {
+			for (size_t i = 0; i < Count; ++i)
+				loop[i] = Quaternion::Normalize(quaternions1[i]);
+		},
+		batch, loop);
+
+	Compare("Quaternion Lerp",
+		[&] { Quaternion::Lerp(sources1, sources2, Amount, batch); },
+		[&] {
+			for (size_t i = 0; i < Count; ++i)
+				loop[i] = Quaternion::Lerp(quaternions1[i], quaternions2[i], Amount);
+		},
+		batch, loop);
+
+	//The exact batch is a loop too, the vector replacement for it is FastMath::Slerp.
+	Compare("Quaternion Slerp",
+		[&] { Quaternion::Slerp(sources1, sources2, Amount, batch); },
+		[&] {
+			for (size_t i = 0; i < Count; ++i)
+				loop[i] = Quaternion::Slerp(quaternions1[i], quaternions2[i], Amount);
+		},
+		batch, loop);
+
+	Compare("FastMath Slerp",
+		[&] { FastMath::Slerp(sources1, sources2, Amount, batch); },
+		[&] {
+			for (size_t i = 0; i < Count; ++i)
+				loop[i] = FastMath::Slerp(quaternions1[i], quaternions2[i], Amount);
+		},
+		batch, loop);
+
+	Compare("Matrix CreateFromQuaternion",
+		[&] { Matrix::CreateFromQuaternion(sources1, batchPalette); },
+		[&] {
+			for (size_t i = 0; i < Count; ++i)
+				loopPalette[i] = Matrix::CreateFromQuaternion(quaternions1[i]);
+		},
+		batchPalette, loopPalette);
+}
+
+int main() {
+	std::printf("AVX2 %s, AVX-512 %s\n", X86Intrinsics::IsAvx2Supported() ? "on" : "off", X86Intrinsics::IsAvx512Supported() ? "on" : "off");
+	Transforms();
+	Quaternions();
+	return 0;
+}
@@ -0,0 +1,193 @@
+#include "xna/common/dynamicaabbtree.hpp"
+#include "xna/common/spatialhash.hpp"
+#include "xna/common/sweepandprune.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace xna;
+
+//SweepAndPrune against the SpatialHash grid and the DynamicAabbTree on moving objects, like the sprites of a side-scrolling level.
+//The objects are 24x40 and fill a strip 600 units high with 8 units of width per object. Every object moves every frame,
+//horizontally up to 2 units and, for the walkers, vertically only one frame in five.
+//Each broadphase moves all its proxies and then produces the overlapping pairs.
+static constexpr int Frames = 20;
+static constexpr float StripHeight = 600.0F;
+
+struct Scene {
+	std::vector<float> X;
+	std::vector<float> Y;
+	std::vector<float> VelocityX;
+	std::vector<float> VelocityY;
+
+	Rectangle RectangleOf(size_t i) const {
+		return Rectangle(static_cast<int32_t>(X[i]), static_cast<int32_t>(Y[i]), 24, 40);
+	}
+
+	BoundingBox BoxOf(size_t i) const {
+		const auto x = static_cast<float>(static_cast<int32_t>(X[i]));
+		const auto y = static_cast<float>(static_cast<int32_t>(Y[i]));
+		return BoundingBox(Vector3(x, y, 0), Vector3(x + 24, y + 40, 1));
+	}
+
+	void Step() {
+		for (size_t i = 0; i < X.size(); ++i) {
+			X[i] += VelocityX[i];
+			Y[i] += VelocityY[i];
+
+			if (Y[i] < 0 || Y[i] > StripHeight)
+				VelocityY[i] = -VelocityY[i];
+		}
+	}
+};
+
+static Scene CreateScene(size_t count, bool walkers) {
+	Scene scene;
+	scene.X.resize(count);
+	scene.Y.resize(count);
+	scene.VelocityX.resize(count);
+	scene.VelocityY.resize(count);
+
+	std::mt19937 random(46);
+	std::uniform_real_distribution<float> x(0.0F, static_cast<float>(count) * 8.0F);
+	std::uniform_real_distribution<float> y(0.0F, StripHeight);
+	std::uniform_real_distribution<float> velocity(-2.0F, 2.0F);
+
+	for (size_t i = 0; i < count; ++i) {
+		scene.X[i] = x(random);
+		scene.Y[i] = y(random);
+		scene.VelocityX[i] = velocity(random);
+		scene.VelocityY[i] = walkers && random() % 5 != 0 ? 0.0F : velocity(random) * 0.5F;
+	}
+
+	return scene;
+}
+
+template <typename Function>
+static double Milliseconds(Function&& function) {
+	const auto start = std::chrono::steady_clock::now();
+	function();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool Run(size_t count, bool walkers) {
+	auto scene = CreateScene(count, walkers);
+	std::vector<Rectangle> rectangles(count);
+	std::vector<BoundingBox> boxes(count);
+	std::vector<size_t> userData(count);
+
+	for (size_t i = 0; i < count; ++i) {
+		rectangles[i] = scene.RectangleOf(i);
+		boxes[i] = scene.BoxOf(i);
+		userData[i] = i;
+	}
+
+	SweepAndPrune<Rectangle> sweep2;
+	SweepAndPrune<BoundingBox> sweep3;
+	SpatialHash grid;
+	DynamicAabbTree tree;
+	std::vector<size_t> sweep2Proxies(count);
+	std::vector<size_t> sweep3Proxies(count);
+	std::vector<size_t> gridProxies(count);
+	std::vector<size_t> treeProxies(count);
+
+	sweep2.Add(std::span<const Rectangle>(rectangles), std::span<const size_t>(userData), std::span<size_t>(sweep2Proxies));
+	sweep3.Add(std::span<const BoundingBox>(boxes), std::span<const size_t>(userData), std::span<size_t>(sweep3Proxies));
+
+	for (size_t i = 0; i < count; ++i) {
+		gridProxies[i] = grid.Add(rectangles[i], i);
+		treeProxies[i] = tree.Add(boxes[i], i);
+	}
+
+	sweep2.ClearPairChanges();
+	sweep3.ClearPairChanges();
+
+	auto sweep2Time = 0.0;
+	auto sweep3Time = 0.0;
+	auto gridTime = 0.0;
+	auto treeTime = 0.0;
+	size_t pairChanges = 0;
+	size_t gridPairs = 0;
+	size_t treePairs = 0;
+
+	for (int frame = 0; frame < Frames; ++frame) {
+		scene.Step();
+
+		sweep2Time += Milliseconds([&] {
+			for (size_t i = 0; i < count; ++i)
+				sweep2.Move(sweep2Proxies[i], scene.RectangleOf(i));
+
+			sweep2.Update();
+			pairChanges += sweep2.AddedPairs().size() + sweep2.RemovedPairs().size();
+			sweep2.ClearPairChanges();
+			});
+
+		sweep3Time += Milliseconds([&] {
+			for (size_t i = 0; i < count; ++i)
+				sweep3.Move(sweep3Proxies[i], scene.BoxOf(i));
+
+			sweep3.Update();
+			sweep3.ClearPairChanges();
+			});
+
+		//The grid and the tree report candidates, the exact test filters them like the narrow phase would.
+		gridTime += Milliseconds([&] {
+			for (size_t i = 0; i < count; ++i)
+				grid.Move(gridProxies[i], scene.RectangleOf(i));
+
+			gridPairs = 0;
+			grid.QueryPairs([&](size_t proxy1, size_t proxy2) {
+				if (scene.RectangleOf(grid.UserData(proxy1)).Intersects(scene.RectangleOf(grid.UserData(proxy2))))
+					++gridPairs;
+
+				return true;
+				});
+			});
+
+		treeTime += Milliseconds([&] {
+			for (size_t i = 0; i < count; ++i)
+				tree.Move(treeProxies[i], scene.BoxOf(i), Vector3(scene.VelocityX[i], scene.VelocityY[i], 0));
+
+			treePairs = 0;
+			tree.QueryPairs([&](size_t proxy1, size_t proxy2) {
+				if (scene.BoxOf(tree.UserData(proxy1)).Intersects(scene.BoxOf(tree.UserData(proxy2))))
+					++treePairs;
+
+				return true;
+				});
+			});
+	}
+
+	std::printf("%7zu  %8.2f %8.2f %8.2f %8.2f   %zu pairs, %zu changes per frame\n",
+		count, sweep2Time / Frames, sweep3Time / Frames, gridTime / Frames, treeTime / Frames,
+		sweep2.PairCount(), pairChanges / Frames);
+
+	//Boxes that only touch intersect, rectangles that only touch do not, so only the 2D broadphases must agree.
+	if (sweep2.PairCount() != gridPairs) {
+		std::printf("  SweepAndPrune<Rectangle> kept %zu pairs, the grid found %zu\n", sweep2.PairCount(), gridPairs);
+		return false;
+	}
+
+	if (sweep3.PairCount() != treePairs) {
+		std::printf("  SweepAndPrune<BoundingBox> kept %zu pairs, the tree found %zu\n", sweep3.PairCount(), treePairs);
+		return false;
+	}
+
+	return true;
+}
+
+int main() {
+	auto passed = true;
+
+	for (const auto walkers : { true, false }) {
+		std::printf(walkers ? "80%% walkers, ms per frame\n" : "All drifting vertically, ms per frame\n");
+		std::printf("  count    SAP 2D   SAP 3D     grid     tree\n");
+
+		for (const size_t count : { 1000, 10000, 100000 })
+			passed = Run(count, walkers) && passed;
+	}
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+#ifndef CSHARP_BUFFERS_ALIGNEDALLOCATOR_HPP
+#define CSHARP_BUFFERS_ALIGNEDALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace csharp {
+	//Standard allocator that aligns every allocation to Alignment bytes, so containers can hold data
+	//loaded with aligned vector instructions or kept apart from other data on its own cache lines.
+	template <typename T, size_t Alignment>
+	struct AlignedAllocator {
+		static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two no smaller than alignof(T).");
+
+		using value_type = T;
+
+		template <typename U>
+		struct rebind {
+			using other = AlignedAllocator<U, Alignment>;
+		};
+
+		constexpr AlignedAllocator() noexcept = default;
+
+		template <typename U>
+		constexpr AlignedAllocator(AlignedAllocator<U, Alignment> const&) noexcept {}
+
+		T* allocate(size_t count) {
+			return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+		}
+
+		void deallocate(T* pointer, size_t) noexcept {
+			::operator delete(pointer, std::align_val_t(Alignment));
+		}
+
+		template <typename U>
+		constexpr bool operator==(AlignedAllocator<U, Alignment> const&) const noexcept {
+			return true;
+		}
+	};
+}
+
+#endif
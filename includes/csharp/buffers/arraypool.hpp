@@ -0,0 +1,279 @@
+#ifndef CSHARP_BUFFERS_ARRAYPOOL_HPP
+#define CSHARP_BUFFERS_ARRAYPOOL_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace csharp {
+	//Counters describing how an ArrayPool has been used since it was created.
+	struct ArrayPoolStatistics {
+		//Number of calls to Rent that requested a non-empty array.
+		uint64_t Rents{ 0 };
+		//Number of rents served by an array already owned by the pool.
+		uint64_t Hits{ 0 };
+		//Number of rents that had to allocate a new array.
+		uint64_t Misses{ 0 };
+		//Number of arrays given back to the pool.
+		uint64_t Returns{ 0 };
+		//Number of returned arrays released because they were not pool-sized or their bucket was full.
+		uint64_t Discards{ 0 };
+	};
+
+	//Provides a resource pool that enables reusing instances of arrays.
+	//
+	//Arrays are grouped in power-of-two size classes, starting at 16 elements.
+	//A rented array may be longer than requested. The Shared() pool also keeps one
+	//array per size class in a per-thread cache, so a Rent followed by a Return on
+	//the same thread does not take a lock.
+	template <typename T>
+	class ArrayPool {
+	public:
+		static constexpr size_t DefaultMaxArrayLength = 1024 * 1024;
+		static constexpr size_t DefaultMaxArraysPerBucket = 32;
+
+		//Creates a pool with its own buckets. Only the Shared() pool uses the per-thread cache.
+		ArrayPool(size_t maxArrayLength = DefaultMaxArrayLength, size_t maxArraysPerBucket = DefaultMaxArraysPerBucket)
+			: ArrayPool(maxArrayLength, maxArraysPerBucket, false) {}
+
+		ArrayPool(ArrayPool const&) = delete;
+		ArrayPool& operator=(ArrayPool const&) = delete;
+
+		//Retrieves a shared ArrayPool instance.
+		static ArrayPool& Shared() {
+			static ArrayPool shared(DefaultMaxArrayLength, DefaultMaxArraysPerBucket, true);
+			return shared;
+		}
+
+		//Retrieves an array that is at least the requested length.
+		std::vector<T> Rent(size_t minimumLength) {
+			if (minimumLength == 0)
+				return {};
+
+			rents.fetch_add(1, std::memory_order_relaxed);
+
+			const auto index = SelectBucketIndex(minimumLength);
+
+			if (index >= bucketCount) {
+				misses.fetch_add(1, std::memory_order_relaxed);
+				return std::vector<T>(minimumLength);
+			}
+
+			std::vector<T> array;
+
+			if (useThreadCache) {
+				array.swap(threadCache[index]);
+
+				if (!array.empty()) {
+					hits.fetch_add(1, std::memory_order_relaxed);
+					return array;
+				}
+			}
+
+			auto& bucket = buckets[index];
+			{
+				std::lock_guard<std::mutex> lock(bucket.mutex);
+
+				if (!bucket.arrays.empty()) {
+					array.swap(bucket.arrays.back());
+					bucket.arrays.pop_back();
+				}
+			}
+
+			if (!array.empty()) {
+				hits.fetch_add(1, std::memory_order_relaxed);
+				return array;
+			}
+
+			misses.fetch_add(1, std::memory_order_relaxed);
+			return std::vector<T>(GetMaxSizeForBucket(index));
+		}
+
+		//Returns an array that was previously obtained from Rent.
+		//Arrays whose length does not match a size class of this pool are released.
+		void Return(std::vector<T>&& array, bool clearArray = false) {
+			const auto length = array.size();
+
+			if (length == 0)
+				return;
+
+			returns.fetch_add(1, std::memory_order_relaxed);
+
+			const auto index = SelectBucketIndex(length);
+
+			if (index >= bucketCount || length != GetMaxSizeForBucket(index)) {
+				discards.fetch_add(1, std::memory_order_relaxed);
+				std::vector<T>().swap(array);
+				return;
+			}
+
+			if (clearArray)
+				std::fill(array.begin(), array.end(), T());
+
+			if (useThreadCache) {
+				//The newest array stays with the thread, the previous one moves to the shared bucket.
+				array.swap(threadCache[index]);
+
+				if (array.empty())
+					return;
+			}
+
+			auto& bucket = buckets[index];
+			{
+				std::lock_guard<std::mutex> lock(bucket.mutex);
+
+				if (bucket.arrays.size() < maxArraysPerBucket) {
+					bucket.arrays.emplace_back(std::move(array));
+					return;
+				}
+			}
+
+			discards.fetch_add(1, std::memory_order_relaxed);
+			std::vector<T>().swap(array);
+		}
+
+		//Gets a snapshot of the pool counters.
+		ArrayPoolStatistics Statistics() const {
+			ArrayPoolStatistics statistics;
+			statistics.Rents = rents.load(std::memory_order_relaxed);
+			statistics.Hits = hits.load(std::memory_order_relaxed);
+			statistics.Misses = misses.load(std::memory_order_relaxed);
+			statistics.Returns = returns.load(std::memory_order_relaxed);
+			statistics.Discards = discards.load(std::memory_order_relaxed);
+			return statistics;
+		}
+
+		//Resets the pool counters to zero.
+		void ResetStatistics() {
+			rents.store(0, std::memory_order_relaxed);
+			hits.store(0, std::memory_order_relaxed);
+			misses.store(0, std::memory_order_relaxed);
+			returns.store(0, std::memory_order_relaxed);
+			discards.store(0, std::memory_order_relaxed);
+		}
+
+		//Gets the size class index used for an array of the specified length.
+		static constexpr size_t SelectBucketIndex(size_t length) {
+			return static_cast<size_t>(std::bit_width((length - 1) | (MinimumArrayLength - 1))) - MinimumArrayLengthShift;
+		}
+
+		//Gets the length of the arrays stored in the specified size class.
+		static constexpr size_t GetMaxSizeForBucket(size_t index) {
+			return MinimumArrayLength << index;
+		}
+
+	private:
+		ArrayPool(size_t maxArrayLength, size_t maxArraysPerBucket, bool useThreadCache)
+			: maxArraysPerBucket(maxArraysPerBucket), useThreadCache(useThreadCache) {
+			maxArrayLength = (std::clamp)(maxArrayLength, MinimumArrayLength, MaximumArrayLength);
+			bucketCount = SelectBucketIndex(maxArrayLength) + 1;
+
+			if (useThreadCache)
+				bucketCount = (std::min)(bucketCount, ThreadCacheBucketCount);
+
+			buckets = std::make_unique<Bucket[]>(bucketCount);
+
+			for (size_t i = 0; i < bucketCount; ++i)
+				buckets[i].arrays.reserve(maxArraysPerBucket);
+		}
+
+		struct Bucket {
+			std::mutex mutex;
+			std::vector<std::vector<T>> arrays;
+		};
+
+		static constexpr size_t MinimumArrayLengthShift = 4;
+		static constexpr size_t MinimumArrayLength = size_t{ 1 } << MinimumArrayLengthShift;
+		static constexpr size_t MaximumArrayLength = size_t{ 1 } << 30;
+		static constexpr size_t ThreadCacheBucketCount = static_cast<size_t>(std::bit_width(DefaultMaxArrayLength - 1)) - MinimumArrayLengthShift + 1;
+
+		inline static thread_local std::array<std::vector<T>, ThreadCacheBucketCount> threadCache{};
+
+		std::unique_ptr<Bucket[]> buckets;
+		size_t bucketCount{ 0 };
+		size_t maxArraysPerBucket{ 0 };
+		bool useThreadCache{ false };
+
+		std::atomic<uint64_t> rents{ 0 };
+		std::atomic<uint64_t> hits{ 0 };
+		std::atomic<uint64_t> misses{ 0 };
+		std::atomic<uint64_t> returns{ 0 };
+		std::atomic<uint64_t> discards{ 0 };
+	};
+
+	//Holds an array rented from an ArrayPool and returns it when destroyed.
+	template <typename T>
+	class PooledArray {
+	public:
+		PooledArray() = default;
+
+		PooledArray(size_t minimumLength, ArrayPool<T>& pool = ArrayPool<T>::Shared())
+			: pool(&pool), array(pool.Rent(minimumLength)) {}
+
+		PooledArray(PooledArray const&) = delete;
+		PooledArray& operator=(PooledArray const&) = delete;
+
+		PooledArray(PooledArray&& other) noexcept
+			: pool(other.pool), array(std::move(other.array)) {
+			other.array.clear();
+		}
+
+		PooledArray& operator=(PooledArray&& other) noexcept {
+			if (this != &other) {
+				Release();
+				pool = other.pool;
+				array.swap(other.array);
+			}
+
+			return *this;
+		}
+
+		~PooledArray() {
+			Release();
+		}
+
+		//Gets a pointer to the first element of the rented array.
+		constexpr T* Data() { return array.data(); }
+		//Gets a pointer to the first element of the rented array.
+		constexpr T const* Data() const { return array.data(); }
+		//Gets the length of the rented array, which may be larger than requested.
+		constexpr size_t Length() const { return array.size(); }
+		//Gets the rented array.
+		constexpr std::vector<T>& Buffer() { return array; }
+		//Gets the rented array.
+		constexpr std::vector<T> const& Buffer() const { return array; }
+
+		//Ensures the rented array is at least the requested length, renting a larger one if needed.
+		//The contents are not preserved.
+		void EnsureLength(size_t minimumLength, ArrayPool<T>& arrayPool = ArrayPool<T>::Shared()) {
+			if (array.size() >= minimumLength)
+				return;
+
+			Release();
+			pool = &arrayPool;
+			array = pool->Rent(minimumLength);
+		}
+
+		constexpr T& operator[](size_t index) { return array[index]; }
+		constexpr T const& operator[](size_t index) const { return array[index]; }
+
+	private:
+		void Release() {
+			if (pool && !array.empty())
+				pool->Return(std::move(array));
+
+			array.clear();
+		}
+
+	private:
+		ArrayPool<T>* pool{ nullptr };
+		std::vector<T> array;
+	};
+}
+
+#endif
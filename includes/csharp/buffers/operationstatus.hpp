@@ -0,0 +1,18 @@
+#ifndef CSHARP_BUFFERS_OPERATIONSTATUS_HPP
+#define CSHARP_BUFFERS_OPERATIONSTATUS_HPP
+
+namespace csharp {
+	//Defines the values that can be returned from span-based operations that support processing of input contained in multiple discontiguous buffers.
+	enum class OperationStatus {
+		//The entire input buffer has been processed and the operation is complete.
+		Done,
+		//The input is partially processed, up to what could fit into the destination buffer.
+		DestinationTooSmall,
+		//The input is partially processed, up to the last valid chunk of the input that could be consumed.
+		NeedMoreData,
+		//The input contained invalid bytes which could not be processed.
+		InvalidData,
+	};
+}
+
+#endif
@@ -3,21 +3,23 @@
 
 #include "stream.hpp"
 #include "exception.hpp"
+#include "../buffers/arraypool.hpp"
 #include <optional>
 #include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
 
 namespace csharp {
 	/*
 	* The BinaryReader class uses byte encodings, by default UTF8.
-	* This was not implemented, but we tried to follow the same standard.
+	* Characters are decoded from UTF-8 and returned as UTF-16 code units (char16_t),
+	* like the 16-bit .NET char. Strings are returned as UTF-8 (ReadString) or UTF-16 (ReadString16).
 	* Also the reading of primitives was modified.
 	*
 	*/
 
-	//TODO: ReadString and ReadChar as it only reads ASCII characters
-	//https://learn.microsoft.com/pt-br/dotnet/csharp/language-reference/builtin-types/char
-	//char - 16 bits
-
 	//The BinaryReader class uses byte encodings, by default UTF8
 	class BinaryReader {
 	public:
@@ -42,8 +44,10 @@ namespace csharp {
 			_disposed = true;
 		}
 
+		//Returns the next available character as a Unicode scalar value and does not advance the position, or -1 if none is available.
 		virtual int32_t PeekChar();
-		virtual int32_t Read(bool twoBytesPerChar = false);
+		//Reads the next character as a Unicode scalar value and advances the position, or returns -1 at the end of the stream.
+		virtual int32_t Read();
 
 		virtual uint8_t ReadByte() {
 			return InternalReadByte();
@@ -57,7 +61,9 @@ namespace csharp {
 			return InternalReadByte() != 0;
 		}
 
-		virtual char ReadChar(bool twoBytesPerChar = false);
+		//Reads the next character from the current stream.
+		//Characters outside the Basic Multilingual Plane need a surrogate pair and must be read with ReadChars.
+		virtual char16_t ReadChar();
 
 		virtual int16_t ReadInt16() {
 			return ReadNumeric<int16_t>();
@@ -91,14 +97,22 @@ namespace csharp {
 			return ReadNumeric<double>();
 		}
 
+		//Reads a length-prefixed UTF-8 string. Invalid sequences are replaced with U+FFFD.
 		virtual std::string ReadString();
+		//Reads a length-prefixed UTF-8 string. Invalid sequences are replaced with U+FFFD.
 		virtual std::u8string ReadString8();
+		//Reads a length-prefixed UTF-8 string and converts it to UTF-16.
+		virtual std::u16string ReadString16();
+		//Reads a length-prefixed UTF-8 string into a buffer owned by this reader and returns a view of it.
+		//No allocation is made once the buffer has grown to the longest string read. Invalid sequences are replaced with U+FFFD.
+		//The view is only valid until the next call to ReadStringView or until the reader is destroyed.
+		std::string_view ReadStringView();
 
-		virtual int32_t Read(char* buffer, int32_t bufferLength, int32_t index, int32_t count);
+		virtual int32_t Read(char16_t* buffer, int32_t bufferLength, int32_t index, int32_t count);
 
-		virtual int32_t Read(char* buffer, int32_t bufferLength);
+		virtual int32_t Read(char16_t* buffer, int32_t bufferLength);
 
-		virtual std::vector<char> ReadChars(int32_t count);
+		virtual std::vector<char16_t> ReadChars(int32_t count);
 
 		virtual int32_t Read(uint8_t* buffer, int32_t bufferLength, int32_t index, int32_t count);
 
@@ -106,6 +120,10 @@ namespace csharp {
 
 		virtual std::vector<uint8_t> ReadBytes(int32_t count);
 
+		//Reads the specified number of bytes into an existing buffer, growing it only when it is too small.
+		//Returns the number of bytes read, which can be less than count at the end of the stream.
+		int32_t ReadBytes(int32_t count, std::vector<uint8_t>& buffer);
+
 		virtual void ReadExactly(uint8_t* buffer, int32_t bufferLength);
 
 		int32_t Read7BitEncodedInt();
@@ -127,30 +145,22 @@ namespace csharp {
 				return {};
 			}
 
-			auto charBytes = std::vector<uint8_t>(MaxCharBytesSize);
-			int32_t currPos = 0;
+			static_assert(sizeof(typename TSTRING::value_type) == 1, "GenericReadString only supports single byte code units.");
 
-			TSTRING sb{};
+			//The bytes are read straight into the result, so no intermediate buffer is needed.
+			TSTRING sb(static_cast<size_t>(stringLength), typename TSTRING::value_type{});
+			auto bytes = reinterpret_cast<uint8_t*>(sb.data());
+			int32_t currPos = 0;
 
 			do
 			{
-				const auto readLength = std::min(MaxCharBytesSize, stringLength - currPos);
-				const auto n = _stream->Read(charBytes.data(), readLength);
+				const auto n = _stream->Read(bytes, stringLength, currPos, stringLength - currPos);
 
-				if (n == 0)
+				if (n <= 0)
 				{
 					throw EndOfStreamException(SR::IO_EOF_ReadBeyondEOF);
 				}
 
-				const auto chars = reinterpret_cast<TSTRING::value_type*>(charBytes.data());
-
-				if (currPos == 0 && n == stringLength)
-				{
-					return TSTRING(chars);
-				}
-
-				sb.append(chars);
-
 				currPos += n;
 
 			} while (currPos < stringLength);
@@ -161,7 +171,7 @@ namespace csharp {
 	private:
 		uint8_t InternalReadByte();
 		void InternalRead(std::vector<uint8_t>& buffer);
-		int32_t InternalReadChars(char* buffer, int32_t bufferLength);
+		int32_t InternalReadChars(char16_t* buffer, int32_t bufferLength);
 
 		template<class TNUMERIC>
 		TNUMERIC ReadNumeric() {
@@ -185,25 +195,48 @@ namespace csharp {
 		bool _disposed{ false };
 
 		std::vector<uint8_t> _auxBuffer;
+		PooledArray<uint8_t> _stringWindow;
 	};
 
+	//Writes primitive types in binary to a stream.
+	//Writes are collected in an internal buffer that is sent to the stream when it fills up,
+	//when Flush is called or when the writer is closed or destroyed.
 	class BinaryWriter {
 	public:
 		BinaryWriter(std::shared_ptr<Stream> const& output)
 			: BinaryWriter(output, false) {
 		}
 
-		BinaryWriter(std::shared_ptr<Stream> const& output, bool leaveOpen) {
+		BinaryWriter(std::shared_ptr<Stream> const& output, bool leaveOpen)
+			: BinaryWriter(output, leaveOpen, DefaultBufferSize) {
+		}
+
+		BinaryWriter(std::shared_ptr<Stream> const& output, bool leaveOpen, int32_t bufferSize) {
 			ArgumentNullException::ThrowIfNull(output.get(), "output");
+			ArgumentOutOfRangeException::ThrowIfNegative(bufferSize, "bufferSize");
 
 			if (!output->CanWrite())
 				throw ArgumentException(SR::Argument_StreamNotWritable);
 
 			OutStream = output;
 			_leaveOpen = leaveOpen;
+			_buffer.EnsureLength(static_cast<size_t>((std::max)(bufferSize, MinBufferSize)));
+		}
+
+		BinaryWriter(BinaryWriter const&) = delete;
+		BinaryWriter& operator=(BinaryWriter const&) = delete;
+
+		virtual ~BinaryWriter() {
+			try {
+				FlushBuffer();
+			}
+			catch (...) {
+			}
 		}
 
-		inline void Close() const {
+		inline void Close() {
+			FlushBuffer();
+
 			if (_leaveOpen)
 				OutStream->Flush();
 			else
@@ -215,43 +248,52 @@ namespace csharp {
 			return OutStream;
 		}
 
+		//Clears the internal buffer and causes any buffered data to be written to the underlying stream.
 		inline virtual void Flush() {
+			FlushBuffer();
 			OutStream->Flush();
 		}
 
 		inline virtual int64_t Seek(int32_t offset, SeekOrigin origin) {
+			FlushBuffer();
 			return OutStream->Seek(offset, origin);
 		}
 
 		inline virtual void Write(bool value) {
-			OutStream->WriteByte(static_cast<uint8_t>(value ? 1 : 0));
+			WriteByteInternal(static_cast<uint8_t>(value ? 1 : 0));
 		}
 
 		inline virtual void Write(uint8_t value) {
-			OutStream->WriteByte(value);
+			WriteByteInternal(value);
 		}
 
 		inline virtual void Write(int8_t value) {
-			OutStream->WriteByte(static_cast<uint8_t>(value));
+			WriteByteInternal(static_cast<uint8_t>(value));
 		}
 
 		inline virtual void Write(uint8_t const* buffer, int32_t bufferLength) {
-			OutStream->Write(buffer, bufferLength, 0, bufferLength);
+			ArgumentNullException::ThrowIfNull(buffer, "buffer");
+			WriteBytes(buffer, bufferLength);
 		}
 
 		inline virtual void Write(uint8_t const* buffer, int32_t bufferLength, int32_t index, int32_t count) {
-			OutStream->Write(buffer, bufferLength, index, count);
+			ArgumentNullException::ThrowIfNull(buffer, "buffer");
+			ArgumentOutOfRangeException::ThrowIfNegative(index, "index");
+			ArgumentOutOfRangeException::ThrowIfNegative(count, "count");
+
+			if (index > bufferLength - count)
+				throw ArgumentException(SR::Argument_InvalidOffLen);
+
+			WriteBytes(buffer + index, count);
 		}
 
 		inline virtual void Write(char ch) {
-			const auto byte = static_cast<uint8_t>(ch);
-			OutStream->Write(&byte, 1);
+			WriteByteInternal(static_cast<uint8_t>(ch));
 		}
 
 		inline virtual void Write(char* chars, int32_t charsLength) {
 			ArgumentNullException::ThrowIfNull(chars, "chars");
-			auto bytes = reinterpret_cast<const uint8_t*>(chars);
-			OutStream->Write(bytes, charsLength);
+			WriteBytes(reinterpret_cast<const uint8_t*>(chars), charsLength);
 		}
 
 		inline virtual void Write(char* chars, int32_t charsLength, int32_t index, int32_t count) {
@@ -262,8 +304,7 @@ namespace csharp {
 			if (index > charsLength - count)
 				throw ArgumentOutOfRangeException("index");
 
-			auto bytes = reinterpret_cast<const uint8_t*>(chars);
-			OutStream->Write(bytes, charsLength, index, count);
+			WriteBytes(reinterpret_cast<const uint8_t*>(chars) + index, count);
 		}
 
 		inline virtual void Write(double value) {
@@ -298,35 +339,88 @@ namespace csharp {
 			WriteNumeric(value);
 		}
 
+		//Writes a length-prefixed string to this stream.
 		virtual void Write(std::string const& value) {
-			Write7BitEncodedInt(static_cast<int64_t>(value.size()));
-			auto bytes = reinterpret_cast<const uint8_t*>(value.data());
-			OutStream->Write(bytes, static_cast<int32_t>(value.size()));
-		}		
+			Write(std::string_view(value));
+		}
+
+		//Writes a length-prefixed string to this stream.
+		virtual void Write(std::string_view const& value);
+
+		//Writes a length-prefixed string to this stream.
+		inline void Write(const char* value) {
+			ArgumentNullException::ThrowIfNull(value, "value");
+			Write(std::string_view(value));
+		}
+
+		//Writes a contiguous sequence of trivially copyable values to this stream, without a length prefix.
+		template <typename T, size_t Extent>
+		void Write(std::span<T, Extent> values) {
+			static_assert(std::is_trivially_copyable_v<T>, "The span element type must be trivially copyable.");
+			WriteBytes(reinterpret_cast<const uint8_t*>(values.data()), values.size_bytes());
+		}
+
+		//Writes an array of trivially copyable values to this stream, without a length prefix.
+		template <typename T>
+		void WriteArray(T const* values, size_t count) {
+			static_assert(std::is_trivially_copyable_v<T>, "The array element type must be trivially copyable.");
+
+			if (count == 0)
+				return;
 
+			ArgumentNullException::ThrowIfNull(values, "values");
+			WriteBytes(reinterpret_cast<const uint8_t*>(values), count * sizeof(T));
+		}
+
+		//Writes a 32-bit integer in a compressed format.
 		void Write7BitEncodedInt(int32_t value);
-		void Write7BitEncodedInt(int64_t value);
+		//Writes a 64-bit integer in a compressed format.
+		void Write7BitEncodedInt64(int64_t value);
+
+		//Writes a 64-bit integer in a compressed format.
+		inline void Write7BitEncodedInt(int64_t value) {
+			Write7BitEncodedInt64(value);
+		}
 
 	protected:
 		BinaryWriter() {
 			OutStream = Stream::Null;
+			_buffer.EnsureLength(MinBufferSize);
 		}
 
 		template <typename TNUMERIC>
 		void WriteNumeric(TNUMERIC const& value) {
-			auto bytes = reinterpret_cast<const uint8_t*>(&value);
-			const auto size = sizeof(value);
-			OutStream->Write(bytes, static_cast<int32_t>(size));
+			constexpr auto size = sizeof(value);
+
+			if (_bufferPosition + size > _buffer.Length())
+				FlushBuffer();
+
+			std::memcpy(_buffer.Data() + _bufferPosition, &value, size);
+			_bufferPosition += size;
 		}
 
+		inline void WriteByteInternal(uint8_t value) {
+			if (_bufferPosition >= _buffer.Length())
+				FlushBuffer();
+
+			_buffer[_bufferPosition++] = value;
+		}
+
+		//Sends the buffered bytes to the underlying stream without flushing the stream itself.
+		void FlushBuffer();
+		void WriteBytes(uint8_t const* bytes, size_t count);
+
 	protected:
 		std::shared_ptr<Stream> OutStream;
 
 	private:
-		static constexpr int MaxArrayPoolRentalSize = 64 * 1024;
+		static constexpr int32_t DefaultBufferSize = 64 * 1024;
+		static constexpr int32_t MinBufferSize = 16;
 		static std::shared_ptr<BinaryWriter> Null;
 		bool _leaveOpen{ false };
 		bool _useFastUtf8{ true };
+		PooledArray<uint8_t> _buffer;
+		size_t _bufferPosition{ 0 };
 	};
 }
 
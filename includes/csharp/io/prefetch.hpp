@@ -0,0 +1,99 @@
+#ifndef CSHARP_IO_PREFETCH_HPP
+#define CSHARP_IO_PREFETCH_HPP
+
+#include "stream.hpp"
+#include "../buffers/arraypool.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace csharp {
+	//Wraps a readable stream and reads ahead of the consumer on a background thread.
+	//Up to bufferCount buffers are kept filled, so a read only blocks when the consumer outruns the source.
+	//Seeks that land in the current buffer or in the buffers already read ahead are served from memory, in both directions.
+	//Any other seek stops the background thread, drops every buffer, seeks the source and starts reading ahead again,
+	//so the next read waits for a whole buffer from the source. Interleaving reads far apart costs one such restart per seek.
+	//The source stream must not be used directly while it is wrapped.
+	class PrefetchStream : public Stream {
+	public:
+		static constexpr int32_t DefaultBufferSize = 256 * 1024;
+		static constexpr int32_t DefaultBufferCount = 4;
+
+		PrefetchStream(std::shared_ptr<Stream> const& source)
+			: PrefetchStream(source, DefaultBufferSize, DefaultBufferCount, false) {}
+
+		PrefetchStream(std::shared_ptr<Stream> const& source, int32_t bufferSize, int32_t bufferCount, bool leaveOpen = false);
+
+		PrefetchStream(PrefetchStream const&) = delete;
+		PrefetchStream& operator=(PrefetchStream const&) = delete;
+
+		~PrefetchStream();
+
+		bool CanRead() const override { return !_closed; }
+		bool CanWrite() const override { return false; }
+		bool CanSeek() const override { return !_closed && _canSeek; }
+
+		int64_t Length() const override;
+		int64_t Position() const override;
+		void Position(int64_t value) override;
+
+		void Close() override;
+		void Flush() override {}
+		int64_t Seek(int64_t offset, SeekOrigin origin) override;
+		void SetLength(int64_t value) override;
+		int32_t Read(uint8_t* buffer, int32_t bufferLength, int32_t offset, int32_t count) override;
+		int32_t Read(uint8_t* buffer, int32_t bufferLength) override;
+		int32_t ReadByte() override;
+		void Write(uint8_t const* buffer, int32_t bufferLength, int32_t offset, int32_t count) override;
+		void WriteByte(uint8_t value) override;
+
+		//Gets the underlying stream.
+		std::shared_ptr<Stream> BaseStream() const { return _source; }
+
+	private:
+		struct Chunk {
+			std::vector<uint8_t> Data;
+			int32_t Length{ 0 };
+		};
+
+		void EnsureNotClosed() const;
+		void StartWorker();
+		void StopWorker();
+		void Fill();
+		bool NextChunk();
+		bool SeekBuffered(int64_t target);
+
+	private:
+		std::shared_ptr<Stream> _source;
+		int32_t _bufferSize{ DefaultBufferSize };
+		int32_t _bufferCount{ DefaultBufferCount };
+		bool _leaveOpen{ false };
+		bool _canSeek{ false };
+		bool _closed{ false };
+		int64_t _length{ 0 };
+		int64_t _position{ 0 };
+
+		//Consumer side, only touched by the reading thread.
+		Chunk _current;
+		int32_t _currentOffset{ 0 };
+
+		//Shared with the worker, guarded by _mutex.
+		std::mutex _mutex;
+		std::condition_variable _filledCondition;
+		std::condition_variable _freeCondition;
+		std::deque<Chunk> _filled;
+		std::vector<std::vector<uint8_t>> _free;
+		bool _stopping{ false };
+		bool _endOfStream{ false };
+		std::exception_ptr _error;
+
+		std::thread _worker;
+	};
+}
+
+#endif
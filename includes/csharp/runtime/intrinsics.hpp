@@ -0,0 +1,44 @@
+#ifndef CSHARP_RUNTIME_INTRINSICS_HPP
+#define CSHARP_RUNTIME_INTRINSICS_HPP
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CSHARP_INTRINSICS_X86 1
+//GCC 12 initializes _mm512_undefined_ps with itself, which raises -Wuninitialized wherever an AVX-512 intrinsic that uses it is inlined.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#else
+#include <immintrin.h>
+#endif
+#endif
+
+//Marks a function that uses instruction sets above the compiler baseline, so it can be compiled
+//without raising the baseline of the whole translation unit. MSVC accepts any intrinsic in any
+//function, so the macro expands to nothing there.
+#if defined(CSHARP_INTRINSICS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CSHARP_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CSHARP_TARGET(isa)
+#endif
+
+namespace csharp {
+	//Reports which x86 instruction set extensions are supported by the current processor and operating system.
+	//SSE2 is the baseline on x86 and x64. Every query returns false on other architectures.
+	struct X86Intrinsics {
+		//Returns true if SSE4.1 instructions can be used.
+		static bool IsSse41Supported();
+		//Returns true if AVX2 instructions can be used.
+		static bool IsAvx2Supported();
+		//Returns true if FMA3 instructions can be used.
+		static bool IsFmaSupported();
+		//Returns true if F16C half precision conversion instructions can be used.
+		static bool IsF16cSupported();
+		//Returns true if AVX-512 Foundation instructions can be used.
+		static bool IsAvx512Supported();
+	};
+}
+
+#endif
@@ -35,6 +35,8 @@ namespace csharp {
 			= "Offset and length were out of bounds for the array or count is greater than the number of elements from index to the end of the source collection.";
 		inline static const std::string NotSupported_UnwritableStream
 			= "Stream does not support writing.";
+		inline static const std::string NotSupported_UnseekableStream
+			= "Stream does not support seeking.";
 		inline static const std::string Arg_UnauthorizedAccessException
 			= "Attempted to perform an unauthorized operation.";
 		inline static const std::string UnauthorizedAccess_MemStreamBuffer
@@ -57,6 +59,8 @@ namespace csharp {
 			= "Too many bytes in what should have been a 7-bit encoded integer.";
 		inline static const std::string IO_InvalidStringLen_Len
 			= "BinaryReader encountered an invalid string length.";
+		inline static const std::string Arg_SurrogatesNotAllowedAsSingleChar
+			= "Unicode surrogate characters must be read out as pairs together in the same call, not individually. Consider reading them with ReadChars.";
 		inline static const std::string Argument_StreamNotWritable
 			= "Stream was not writable.";	
 		inline static const std::string Overflow_TimeSpanTooLong
@@ -0,0 +1,35 @@
+#ifndef CSHARP_TEXT_INTERNER_HPP
+#define CSHARP_TEXT_INTERNER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace csharp {
+	//Process-wide pool of immutable strings, like the .NET String.Intern.
+	//Each distinct value is stored once and lives until the process ends, so the returned references
+	//never dangle and equal interned strings can be compared by address.
+	struct StringInterner {
+		//Retrieves the pooled string equal to value, adding a copy of value to the pool if it is not there yet.
+		static std::string const& Intern(std::string_view value);
+
+		//Retrieves the pooled string equal to value, or nullptr if it has not been interned.
+		static std::string const* IsInterned(std::string_view value);
+
+		//Gets the number of strings in the pool.
+		static size_t Count();
+
+		//Hash that accepts std::string, std::string_view and const char* keys,
+		//so unordered containers of std::string can be searched without building a temporary.
+		struct Hash {
+			using is_transparent = void;
+
+			size_t operator()(std::string_view value) const noexcept {
+				return std::hash<std::string_view>{}(value);
+			}
+		};
+	};
+}
+
+#endif
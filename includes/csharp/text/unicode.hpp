@@ -2,8 +2,11 @@
 #define CSHARP_TEXT_UNICODE_HPP
 
 #include <cstdint>
+#include <string>
+#include <string_view>
 #include <vector>
 #include "csharp/exception.hpp"
+#include "csharp/buffers/operationstatus.hpp"
 
 //
 // The char type keyword is an alias for the .NET System.Char structure type that represents a Unicode UTF-16 character.
@@ -86,6 +89,165 @@ namespace csharp {
 			return ((value - 0x110000u) ^ 0xD800u) >= 0xFFEF0800u;
 		}
 	};
+
+	//Provides static methods that convert chunked data between UTF-8 and UTF-16 encodings.
+	//Runs of ASCII are processed 16 or 32 bytes at a time with SSE2 or AVX2 (selected at run time);
+	//other sequences are decoded one scalar at a time.
+	struct Utf8 {
+		//Determines whether the provided bytes are well-formed UTF-8.
+		static bool IsValid(uint8_t const* utf8, size_t length) {
+			return GetIndexOfFirstInvalidByte(utf8, length) == length;
+		}
+
+		//Determines whether the provided string is well-formed UTF-8.
+		static bool IsValid(std::string_view utf8) {
+			return IsValid(reinterpret_cast<uint8_t const*>(utf8.data()), utf8.size());
+		}
+
+		//Returns the index of the first byte that does not belong to a well-formed UTF-8 sequence, or length if there is none.
+		static size_t GetIndexOfFirstInvalidByte(uint8_t const* utf8, size_t length);
+
+		//Returns the number of leading ASCII bytes.
+		static size_t GetIndexOfFirstNonAsciiByte(uint8_t const* utf8, size_t length);
+
+		//Converts a UTF-8 encoded byte span to a UTF-16 encoded character span.
+		//Invalid sequences are replaced with U+FFFD when replaceInvalidSequences is true, otherwise the conversion stops with InvalidData.
+		//When isFinalBlock is false, an incomplete sequence at the end of the source returns NeedMoreData.
+		static OperationStatus ToUtf16(uint8_t const* source, size_t sourceLength, char16_t* destination, size_t destinationLength,
+			size_t& bytesRead, size_t& charsWritten, bool replaceInvalidSequences = true, bool isFinalBlock = true);
+
+		//Converts a UTF-16 character span to a UTF-8 encoded byte span.
+		//Unpaired surrogates are replaced with U+FFFD when replaceInvalidSequences is true, otherwise the conversion stops with InvalidData.
+		//When isFinalBlock is false, a high surrogate at the end of the source returns NeedMoreData.
+		static OperationStatus FromUtf16(char16_t const* source, size_t sourceLength, uint8_t* destination, size_t destinationLength,
+			size_t& charsRead, size_t& bytesWritten, bool replaceInvalidSequences = true, bool isFinalBlock = true);
+
+		//Converts a UTF-8 string to UTF-16, replacing invalid sequences with U+FFFD.
+		static std::u16string ToUtf16String(std::string_view utf8);
+
+		//Converts a UTF-16 string to UTF-8, replacing unpaired surrogates with U+FFFD.
+		static std::string FromUtf16String(std::u16string_view utf16);
+
+		//Converts a UTF-8 string to a wide string: UTF-16 where wchar_t is 16 bits wide, UTF-32 otherwise.
+		static std::wstring ToWString(std::string_view utf8);
+
+		//Converts a UTF-8 string to a wide string, reusing the storage of the destination.
+		static void ToWString(std::string_view utf8, std::wstring& destination);
+
+		//Converts a wide string to UTF-8.
+		static std::string FromWString(std::wstring_view wide);
+
+		//Returns a copy of the string in which every invalid UTF-8 sequence is replaced with U+FFFD.
+		static std::string ReplaceInvalidSequences(std::string_view utf8);
+
+		//Gets the length of the sequence started by the specified lead byte, or 0 if it cannot start a sequence.
+		static constexpr int32_t GetSequenceLength(uint8_t leadByte) {
+			if (leadByte < 0x80u)
+				return 1;
+			if (leadByte < 0xC2u)
+				return 0;
+			if (leadByte < 0xE0u)
+				return 2;
+			if (leadByte < 0xF0u)
+				return 3;
+			if (leadByte < 0xF5u)
+				return 4;
+
+			return 0;
+		}
+
+		//Decodes the sequence at the start of the source.
+		//Returns the number of bytes of a well-formed sequence and sets scalar;
+		//0 if the available bytes are a valid but incomplete prefix;
+		//or the negated length of the maximal invalid subpart, which should be replaced by a single U+FFFD.
+		static constexpr int32_t DecodeScalar(uint8_t const* source, size_t available, uint32_t& scalar) {
+			const uint32_t b0 = source[0];
+
+			if (b0 < 0x80u) {
+				scalar = b0;
+				return 1;
+			}
+
+			if (b0 < 0xC2u || b0 > 0xF4u)
+				return -1;
+
+			if (available < 2)
+				return 0;
+
+			const uint32_t b1 = source[1];
+
+			if (b0 < 0xE0u) {
+				if ((b1 & 0xC0u) != 0x80u)
+					return -1;
+
+				scalar = ((b0 & 0x1Fu) << 6) | (b1 & 0x3Fu);
+				return 2;
+			}
+
+			//The second byte range excludes overlong forms, surrogates and values above U+10FFFF.
+			const uint32_t lower = b0 == 0xE0u ? 0xA0u : (b0 == 0xF0u ? 0x90u : 0x80u);
+			const uint32_t upper = b0 == 0xEDu ? 0x9Fu : (b0 == 0xF4u ? 0x8Fu : 0xBFu);
+
+			if (b1 < lower || b1 > upper)
+				return -1;
+
+			if (available < 3)
+				return 0;
+
+			const uint32_t b2 = source[2];
+
+			if ((b2 & 0xC0u) != 0x80u)
+				return -2;
+
+			if (b0 < 0xF0u) {
+				scalar = ((b0 & 0x0Fu) << 12) | ((b1 & 0x3Fu) << 6) | (b2 & 0x3Fu);
+				return 3;
+			}
+
+			if (available < 4)
+				return 0;
+
+			const uint32_t b3 = source[3];
+
+			if ((b3 & 0xC0u) != 0x80u)
+				return -3;
+
+			scalar = ((b0 & 0x07u) << 18) | ((b1 & 0x3Fu) << 12) | ((b2 & 0x3Fu) << 6) | (b3 & 0x3Fu);
+			return 4;
+		}
+
+		//Encodes a Unicode scalar value. The destination must have room for 4 bytes.
+		//Returns the number of bytes written.
+		static constexpr int32_t EncodeScalar(uint32_t scalar, uint8_t* destination) {
+			if (scalar < 0x80u) {
+				destination[0] = static_cast<uint8_t>(scalar);
+				return 1;
+			}
+
+			if (scalar < 0x800u) {
+				destination[0] = static_cast<uint8_t>(0xC0u | (scalar >> 6));
+				destination[1] = static_cast<uint8_t>(0x80u | (scalar & 0x3Fu));
+				return 2;
+			}
+
+			if (scalar < 0x10000u) {
+				destination[0] = static_cast<uint8_t>(0xE0u | (scalar >> 12));
+				destination[1] = static_cast<uint8_t>(0x80u | ((scalar >> 6) & 0x3Fu));
+				destination[2] = static_cast<uint8_t>(0x80u | (scalar & 0x3Fu));
+				return 3;
+			}
+
+			destination[0] = static_cast<uint8_t>(0xF0u | (scalar >> 18));
+			destination[1] = static_cast<uint8_t>(0x80u | ((scalar >> 12) & 0x3Fu));
+			destination[2] = static_cast<uint8_t>(0x80u | ((scalar >> 6) & 0x3Fu));
+			destination[3] = static_cast<uint8_t>(0x80u | (scalar & 0x3Fu));
+			return 4;
+		}
+
+	private:
+		static size_t WidenAscii(uint8_t const* source, char16_t* destination, size_t count);
+		static size_t NarrowAscii(char16_t const* source, uint8_t* destination, size_t count);
+	};
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef CSHARP_THREADING_PARALLEL_HPP
+#define CSHARP_THREADING_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace csharp {
+	//Fork-join loops for the batch operations that take a thread count. Every call starts threadCount - 1 threads,
+	//runs the first share of the work on the calling thread and returns once all threads have finished.
+	struct Parallel {
+		//Calls work(thread) once for every thread from 0 to threadCount, thread 0 on the calling thread.
+		//If a thread cannot be started, or work throws on the calling thread, the threads already started
+		//are joined before the exception is rethrown.
+		template <typename Work>
+		static void Run(size_t threadCount, Work&& work) {
+			std::vector<std::thread> workers;
+
+			if (threadCount > 1)
+				workers.reserve(threadCount - 1);
+
+			try {
+				for (size_t thread = 1; thread < threadCount; ++thread)
+					workers.emplace_back([&work, thread] { work(thread); });
+
+				work(size_t{ 0 });
+			}
+			catch (...) {
+				Join(workers);
+				throw;
+			}
+
+			Join(workers);
+		}
+
+		//Splits count items into threadCount ranges and calls work(range, first, count) for every range that is not empty.
+		//The ranges start at multiples of alignment items, like 64 for loops that write one bit per item to 64-bit words,
+		//so no two threads write the same word.
+		template <typename Work>
+		static void For(size_t count, size_t threadCount, size_t alignment, Work&& work) {
+			const auto blocks = (count + alignment - 1) / alignment;
+			const auto rangeSize = (blocks + threadCount - 1) / threadCount * alignment;
+
+			Run(threadCount, [&](size_t range) {
+				const auto first = range * rangeSize;
+
+				if (first < count)
+					work(range, first, std::min(rangeSize, count - first));
+				});
+		}
+
+		//Splits count items into threadCount ranges of nearly equal size and calls work(range, first, count) for every range that is not empty.
+		template <typename Work>
+		static void For(size_t count, size_t threadCount, Work&& work) {
+			For(count, threadCount, 1, work);
+		}
+
+	private:
+		static void Join(std::vector<std::thread>& workers) {
+			for (auto& worker : workers)
+				worker.join();
+		}
+	};
+}
+
+#endif
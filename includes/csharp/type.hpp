@@ -8,6 +8,8 @@
 #include "misc.hpp"
 #include <vector>
 #include <map>
+#include <functional>
+#include <string_view>
 #include <optional>
 
 namespace csharp {
@@ -126,17 +128,17 @@ namespace csharp {
 			runtimeMap.insert({ typeName, type });
 		}
 
-		static inline std::unique_ptr<Type> GetType(std::string const& typeName) {
+		static inline std::unique_ptr<Type> GetType(std::string_view typeName) {
 			const auto iterator = runtimeMap.find(typeName);
 
 			if (iterator != runtimeMap.end())
-				return std::make_unique<Type>(runtimeMap[typeName]);
+				return std::make_unique<Type>(iterator->second);
 
 			return nullptr;
 		}
 
 	private:
-		static inline auto runtimeMap = std::map<std::string, Type>
+		static inline auto runtimeMap = std::map<std::string, Type, std::less<>>
 		{
 			{ typeid(char).name(), typeof<char>() },
 			{ typeid(unsigned char).name(), typeof<unsigned char>() },
@@ -8,6 +8,7 @@
 #include <string>
 #include <stdexcept>
 #include <source_location>
+#include "csharp/text/unicode.hpp"
 
 namespace misc {
 	template <typename TENUM>
@@ -64,24 +65,16 @@ namespace misc {
 		return is_shared_ptr<T>::value || is_unique_ptr<T>::value || is_weak_ptr<T>::value;
 	}
 
-	//Convert a string to wstring
+	//Convert a UTF-8 string to wstring
 	static inline std::wstring ToWString(const std::string& str)
 	{
-		std::wstring wstr;
-		size_t size;
-		wstr.resize(str.length());
-		mbstowcs_s(&size, &wstr[0], wstr.size() + 1, str.c_str(), str.size());
-		return wstr;
+		return csharp::Utf8::ToWString(str);
 	}
 
-	//Convert a wstring to string
+	//Convert a wstring to a UTF-8 string
 	static inline std::string ToString(const std::wstring& wstr)
 	{
-		std::string str;
-		size_t size;
-		str.resize(wstr.length());
-		wcstombs_s(&size, &str[0], str.size() + 1, wstr.c_str(), wstr.size());
-		return str;
+		return csharp::Utf8::FromWString(wstr);
 	}
 
 	//Returns a hash reporting input values
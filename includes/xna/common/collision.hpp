@@ -3,20 +3,63 @@
 
 #include "math.hpp"
 #include "numerics.hpp"
+#include "soa.hpp"
 #include <optional>
 #include <cstdint>
+#include <span>
 #include <vector>
 #include <limits>
+#include <type_traits>
 
 namespace xna {
 	struct Plane;
 	struct BoundingFrustum;
 	struct BoundingBox;
 	struct BoundingSphere;
+	struct BoundingOrientedBox;
 	struct Ray;
 
+	//Point of the Minkowski difference PointA - PointB of two convex shapes, with the points of both shapes it comes from
+	//and the direction it was found along.
+	struct SupportVertex {
+		Vector3 Point{};
+		Vector3 PointA{};
+		Vector3 PointB{};
+		Vector3 Direction{};
+	};
+
+	//Simplex kept between GJK queries of the same pair of shapes. The next query finds the support points again along the same directions
+	//and starts from them, so shapes that moved little since the last query need few iterations.
+	struct GjkCache {
+		Vector3 Directions[4]{};
+		int32_t Count{ 0 };
+	};
+
+	//Result of a GJK query between two convex shapes A and B.
+	struct GjkResult {
+		//Whether the shapes intersect or touch.
+		bool Intersects{ false };
+		//Distance between the shapes when they do not intersect.
+		float Distance{ 0 };
+		//Penetration depth when the shapes intersect, computed by Gjk::Penetration only.
+		float Depth{ 0 };
+		//Unit direction from A to B. Moving B by Normal * Depth separates intersecting shapes.
+		Vector3 Normal{};
+		//Closest points of A and B when the shapes do not intersect, deepest points of each shape inside the other when they do.
+		Vector3 PointA{};
+		Vector3 PointB{};
+		//Number of GJK and EPA iterations.
+		int32_t Iterations{ 0 };
+	};
+
+	class Epa;
+
+	//Simplex of the GJK distance algorithm. Fixed-size storage, so every query can keep its own on the stack.
 	class Gjk {
 	public:
+		//Iterations after which a query stops with the closest simplex found.
+		static constexpr int32_t MaxIterations = 64;
+
 		constexpr Gjk() {}
 
 		constexpr bool FullSimplex() const { return simplexBits == 15; }
@@ -29,12 +72,74 @@ namespace xna {
 		}
 
 		bool AddSupportPoint(Vector3 const& newPoint);
+		//Adds the support point vertex.PointA - vertex.PointB, keeping the vertex for ClosestPoints, Save and the EPA stage.
+		bool AddSupportPoint(SupportVertex const& vertex);
+		//Gets the points of both shapes that make ClosestPoint, for a simplex built from support vertices.
+		void ClosestPoints(Vector3& pointA, Vector3& pointB) const;
+		//Copies the vertices of the simplex and returns how many there are.
+		int32_t Vertices(SupportVertex* vertices) const;
+		//Keeps the directions of the simplex vertices for the next query of the same shapes.
+		void Save(GjkCache& cache) const;
+
+		//Gets whether two convex shapes intersect. Stops as soon as a separating direction is found.
+		//The shapes are BoundingBox, BoundingSphere, BoundingFrustum, BoundingOrientedBox or any function
+		//void(Vector3 const& direction, Vector3& result) that gives the point of the shape farthest along direction.
+		//cache, when not null, warm starts the query and is updated.
+		template <typename ShapeA, typename ShapeB>
+		static bool Intersects(ShapeA const& shapeA, ShapeB const& shapeB, GjkCache* cache = nullptr) {
+			Gjk gjk;
+			GjkResult result;
+			gjk.Solve(shapeA, shapeB, cache, true, result);
+			return result.Intersects;
+		}
+
+		//Gets the distance and the closest points of two convex shapes, or only that they intersect. The shapes are like for Intersects.
+		template <typename ShapeA, typename ShapeB>
+		static GjkResult Distance(ShapeA const& shapeA, ShapeB const& shapeB, GjkCache* cache = nullptr) {
+			Gjk gjk;
+			GjkResult result;
+			gjk.Solve(shapeA, shapeB, cache, false, result);
+			return result;
+		}
+
+		//Like Distance, and when the shapes intersect, expands the final simplex into a polytope (EPA) to find the penetration depth,
+		//normal and deepest points. If the polytope fills up first, the result is the shallowest support direction found, which still
+		//separates the shapes but may be deeper than needed.
+		template <typename ShapeA, typename ShapeB>
+		static GjkResult Penetration(ShapeA const& shapeA, ShapeB const& shapeB, GjkCache* cache = nullptr);
 
 	private:
-		using listv3 = std::vector<Vector3>;
-		using listv3v3 = std::vector<std::vector<Vector3>>;
-		using listf = std::vector<float>;
-		using listff = std::vector<std::vector<float>>;
+		static constexpr float IntersectionTolerance = 1E-10F;
+		static constexpr float DistanceTolerance = 1E-06F;
+		static constexpr float DuplicateTolerance = 1E-12F;
+
+		template <typename Shape>
+		static void SupportPoint(Shape const& shape, Vector3 const& direction, Vector3& result) {
+			if constexpr (requires { shape.SupportMapping(direction, result); })
+				shape.SupportMapping(direction, result);
+			else
+				shape(direction, result);
+		}
+
+		template <typename ShapeA, typename ShapeB>
+		static SupportVertex Support(ShapeA const& shapeA, ShapeB const& shapeB, Vector3 const& direction) {
+			SupportVertex vertex;
+			vertex.Direction = direction;
+			SupportPoint(shapeA, direction, vertex.PointA);
+			SupportPoint(shapeB, -direction, vertex.PointB);
+			vertex.Point = vertex.PointA - vertex.PointB;
+			return vertex;
+		}
+
+		//Gets whether point is one of the simplex vertices, which means the search cannot get closer to the origin.
+		bool ContainsVertex(Vector3 const& point) const;
+
+		template <typename ShapeA, typename ShapeB>
+		void Solve(ShapeA const& shapeA, ShapeB const& shapeB, GjkCache* cache, bool stopWhenSeparated, GjkResult& result);
+
+		//Adds vertices found around a simplex of less than four vertices that contains the origin, for the EPA stage.
+		template <typename ShapeA, typename ShapeB>
+		static int32_t CompleteTetrahedron(ShapeA const& shapeA, ShapeB const& shapeB, SupportVertex* vertices, int32_t count);
 
 		void UpdateDeterminant(int32_t xmIdx);
 		bool UpdateSimplex(int32_t newIndex);
@@ -62,20 +167,245 @@ namespace xna {
 		}
 
 	private:
-		inline static auto BitsToIndices = std::vector<int32_t>{
+		static constexpr int32_t BitsToIndices[16] = {
 			0, 1, 2, 17, 3, 25, 26, 209, 4, 33, 34, 273, 35, 281, 282, 2257
 		};
 
 		Vector3 closestPoint{};
 		int32_t simplexBits{ 0 };
 		float maxLengthSq{ 0 };
-		listv3 y = listv3(4);
-		listf yLengthSq = listf(4);
-		listv3v3 edges = listv3v3(4, listv3(4));
-		listff edgeLengthSq = listff(4, listf(4));
-		listff det = listff(16, listf(4));
+		Vector3 y[4]{};
+		float yLengthSq[4]{};
+		Vector3 edges[4][4]{};
+		float edgeLengthSq[4][4]{};
+		float det[16][4]{};
+		SupportVertex vertices[4]{};
 	};
 
+	//Expanding polytope of the EPA stage of Gjk::Penetration. Starts from a tetrahedron of the Minkowski difference that contains the origin
+	//and grows towards the face closest to the origin until that face is on the boundary, which gives the penetration depth and normal.
+	//Fixed-size storage like Gjk, about 10 KB.
+	class Epa {
+	public:
+		static constexpr int32_t MaxVertices = 64;
+		//A convex polytope of n vertices has at most 2n - 4 faces.
+		static constexpr int32_t MaxFaces = 2 * MaxVertices;
+		//Iterations after which the closest face found is used.
+		static constexpr int32_t MaxIterations = MaxVertices - 4;
+		//Distance, relative to Size, between the closest face and the boundary of the difference at which the search stops.
+		static constexpr float Tolerance = 1E-04F;
+
+		//Starts from four vertices around the origin. Returns false if they are on one plane.
+		bool Initialize(SupportVertex const* tetrahedron);
+
+		//Gets the outward unit normal of the face closest to the origin.
+		constexpr Vector3 const& ClosestNormal() const { return faces[closest].Normal; }
+		//Gets the distance from the origin to the face closest to the origin.
+		constexpr float ClosestDistance() const { return faces[closest].Distance; }
+		//Gets the distance from the origin to the farthest vertex, the scale of the tolerances.
+		constexpr float Size() const { return size; }
+
+		//Adds a vertex found along the normal of the closest face and replaces the faces it can see, and the faces it lies on
+		//when it is on the line of one of their edges. Returns false, leaving the polytope unchanged, if it is full.
+		bool Expand(SupportVertex const& vertex);
+		//Writes the depth, normal and deepest points of the closest face.
+		void GetResult(GjkResult& result) const;
+
+	private:
+		struct Face {
+			int32_t Vertices[3]{};
+			Vector3 Normal{};
+			float Distance{ 0 };
+		};
+
+		bool MakeFace(int32_t a, int32_t b, int32_t c, Face& face) const;
+		void FindClosest();
+		//Gets whether point is in front of the plane of face.
+		bool IsVisible(Face const& face, Vector3 const& point) const;
+		//Writes the edges around the visible faces to horizon and returns their number.
+		int32_t FindHorizon(bool const* visible);
+		//Gets the face with the edge from -> to, or -1.
+		int32_t FindFace(int32_t from, int32_t to) const;
+
+		SupportVertex vertices[MaxVertices]{};
+		Face faces[MaxFaces]{};
+		int32_t horizon[MaxFaces * 3][2]{};
+		//A point inside the polytope, which tells the outward side of the faces.
+		Vector3 center{};
+		int32_t vertexCount{ 0 };
+		int32_t faceCount{ 0 };
+		int32_t closest{ 0 };
+		float size{ 0 };
+	};
+
+	template <typename ShapeA, typename ShapeB>
+	void Gjk::Solve(ShapeA const& shapeA, ShapeB const& shapeB, GjkCache* cache, bool stopWhenSeparated, GjkResult& result) {
+		Reset();
+
+		//The warm start skips support points found twice, which would collapse the simplex to a single point.
+		if (cache != nullptr) {
+			for (int32_t i = 0; i < cache->Count && i < 4; ++i) {
+				const auto vertex = Support(shapeA, shapeB, cache->Directions[i]);
+
+				if (!ContainsVertex(vertex.Point))
+					AddSupportPoint(vertex);
+			}
+		}
+
+		if (simplexBits == 0)
+			AddSupportPoint(Support(shapeA, shapeB, Vector3::UnitX()));
+
+		auto v = closestPoint;
+		auto lengthSq = v.LengthSquared();
+		result.Intersects = false;
+		result.Iterations = 0;
+
+		while (result.Iterations < MaxIterations) {
+			if (FullSimplex() || lengthSq <= IntersectionTolerance * maxLengthSq) {
+				result.Intersects = true;
+				break;
+			}
+
+			++result.Iterations;
+			const auto vertex = Support(shapeA, shapeB, -v);
+			const auto progress = Vector3::Dot(v, vertex.Point);
+
+			//The support point is on the far side of a plane through the origin, so the shapes are apart.
+			if (stopWhenSeparated && progress > 0.0F)
+				break;
+
+			//Nothing of the difference is closer than v along v. The rounding of the dot product grows with the longer of v and the support point.
+			if (progress > 0.0F && lengthSq - progress <= DistanceTolerance * MathHelper::Max(lengthSq, vertex.Point.LengthSquared()))
+				break;
+
+			if (ContainsVertex(vertex.Point) || !AddSupportPoint(vertex))
+				break;
+
+			const auto previous = lengthSq;
+			v = closestPoint;
+			lengthSq = v.LengthSquared();
+
+			if (!FullSimplex() && previous - lengthSq <= DistanceTolerance * previous)
+				break;
+		}
+
+		if (cache != nullptr)
+			Save(*cache);
+
+		ClosestPoints(result.PointA, result.PointB);
+		result.Depth = 0.0F;
+
+		if (result.Intersects) {
+			result.Distance = 0.0F;
+			result.Normal = Vector3::Zero();
+			return;
+		}
+
+		result.Distance = std::sqrt(lengthSq);
+		result.Normal = result.Distance > 0.0F ? -v / result.Distance : Vector3::Zero();
+	}
+
+	template <typename ShapeA, typename ShapeB>
+	int32_t Gjk::CompleteTetrahedron(ShapeA const& shapeA, ShapeB const& shapeB, SupportVertex* vertices, int32_t count) {
+		while (count < 4) {
+			//Directions across the simplex, both ways: the axes around a point, two perpendiculars of a segment, the normal of a triangle.
+			Vector3 directions[3];
+			int32_t directionCount = 1;
+			const auto edge = vertices[1].Point - vertices[0].Point;
+
+			if (count == 1) {
+				directions[0] = Vector3::UnitX();
+				directions[1] = Vector3::UnitY();
+				directions[2] = Vector3::UnitZ();
+				directionCount = 3;
+			}
+			else if (count == 2) {
+				const auto axis = std::abs(edge.X) < std::abs(edge.Y)
+					? (std::abs(edge.X) < std::abs(edge.Z) ? Vector3::UnitX() : Vector3::UnitZ())
+					: (std::abs(edge.Y) < std::abs(edge.Z) ? Vector3::UnitY() : Vector3::UnitZ());
+				directions[0] = Vector3::Cross(edge, axis);
+				directions[1] = Vector3::Cross(edge, directions[0]);
+				directionCount = 2;
+			}
+			else {
+				directions[0] = Vector3::Cross(edge, vertices[2].Point - vertices[0].Point);
+			}
+
+			auto added = false;
+
+			for (int32_t i = 0; i < directionCount * 2 && !added; ++i) {
+				const auto vertex = Support(shapeA, shapeB, (i & 1) == 0 ? directions[i >> 1] : -directions[i >> 1]);
+
+				//The new vertex must be off the point, line or plane of the vertices found so far.
+				auto offset = vertex.Point - vertices[0].Point;
+
+				if (count == 2)
+					offset = Vector3::Cross(offset, edge) / edge.Length();
+				else if (count == 3)
+					offset = directions[0] * (Vector3::Dot(offset, directions[0]) / directions[0].LengthSquared());
+
+				if (offset.LengthSquared() > IntersectionTolerance * (vertex.Point.LengthSquared() + vertices[0].Point.LengthSquared())) {
+					vertices[count++] = vertex;
+					added = true;
+				}
+			}
+
+			if (!added)
+				break;
+		}
+
+		return count;
+	}
+
+	template <typename ShapeA, typename ShapeB>
+	GjkResult Gjk::Penetration(ShapeA const& shapeA, ShapeB const& shapeB, GjkCache* cache) {
+		Gjk gjk;
+		GjkResult result;
+		gjk.Solve(shapeA, shapeB, cache, false, result);
+
+		if (!result.Intersects)
+			return result;
+
+		SupportVertex tetrahedron[4];
+		const auto count = CompleteTetrahedron(shapeA, shapeB, tetrahedron, gjk.Vertices(tetrahedron));
+
+		//Flat shapes that only touch: no depth.
+		Epa epa;
+		if (count < 4 || !epa.Initialize(tetrahedron))
+			return result;
+
+		//The support distance along any direction is a depth that separates the shapes. The smallest one found is the result
+		//if the polytope fills up before its closest face reaches the boundary.
+		SupportVertex shallowest;
+		auto shallowestDistance = std::numeric_limits<float>::max();
+
+		for (int32_t i = 0; i < Epa::MaxIterations; ++i) {
+			++result.Iterations;
+			const auto vertex = Support(shapeA, shapeB, epa.ClosestNormal());
+			const auto distance = Vector3::Dot(vertex.Direction, vertex.Point);
+
+			//The closest face is on the boundary when nothing of the difference lies beyond it.
+			if (distance - epa.ClosestDistance() <= Epa::Tolerance * epa.Size()) {
+				epa.GetResult(result);
+				return result;
+			}
+
+			if (distance < shallowestDistance) {
+				shallowestDistance = distance;
+				shallowest = vertex;
+			}
+
+			if (!epa.Expand(vertex))
+				break;
+		}
+
+		result.Depth = MathHelper::Max(shallowestDistance, 0.0F);
+		result.Normal = shallowest.Direction;
+		result.PointA = shallowest.PointA;
+		result.PointB = shallowest.PointB;
+		return result;
+	}
+
 	//Describes the intersection between a plane and a bounding volume.
 	enum class PlaneIntersectionType {
 		//There is no intersection, and the bounding volume is in the positive half-space of the Plane.
@@ -96,6 +426,18 @@ namespace xna {
 		Intersects,
 	};
 
+	//Speed and tightness of BoundingSphere::CreateFromPoints. Every level finds the points with the lowest and highest projections
+	//on a set of directions, takes the smallest sphere around them and grows it over the other points (extremal points optimal sphere).
+	//More directions cost more per point and give a sphere closer to the smallest one.
+	enum class BoundingSphereQuality {
+		//3 directions, the axes.
+		Fast,
+		//7 directions, the axes and the diagonals of a cube.
+		Balanced,
+		//49 directions.
+		Tight,
+	};
+
 	//Defines a plane. 
 	struct Plane {
 		//The normal vector of the Plane.
@@ -111,16 +453,48 @@ namespace xna {
 		constexpr Plane(Vector4 const& value) :
 			Normal({ value.X, value.Y, value.Z }), D(value.W) {}
 
-		Plane(Vector3 const& point1, Vector3 const& point2, Vector3 const& point3);
+		constexpr Plane(Vector3 const& point1, Vector3 const& point2, Vector3 const& point3) {
+			const auto num1 = point2.X - point1.X;
+			const auto num2 = point2.Y - point1.Y;
+			const auto num3 = point2.Z - point1.Z;
+			const auto num4 = point3.X - point1.X;
+			const auto num5 = point3.Y - point1.Y;
+			const auto num6 = point3.Z - point1.Z;
+			const auto num7 = (num2 * num6 - num3 * num5);
+			const auto num8 = (num3 * num4 - num1 * num6);
+			const auto num9 = (num1 * num5 - num2 * num4);
+			const auto num10 = 1.0f / MathHelper::Sqrt(num7 * num7 + num8 * num8 + num9 * num9);
+			Normal.X = num7 * num10;
+			Normal.Y = num8 * num10;
+			Normal.Z = num9 * num10;
+			D = -(Normal.X * point1.X + Normal.Y * point1.Y + Normal.Z * point1.Z);
+		}
 
 		constexpr bool operator==(Plane const& other) const {
 			return Normal == other.Normal && D == other.D;
 		}
 
 		//Changes the coefficients of the Normal vector of a Plane to make it of unit length. 
-		void Normalize();
+		constexpr void Normalize() {
+			const auto d = (Normal.X * Normal.X + Normal.Y * Normal.Y + Normal.Z * Normal.Z);
+
+			if (MathHelper::Abs(d - 1.0f) < 1.1920928955078125E-07)
+				return;
+
+			const auto num = 1.0f / MathHelper::Sqrt(d);
+
+			Normal.X *= num;
+			Normal.Y *= num;
+			Normal.Z *= num;
+			D *= num;
+		}
+
 		//Changes the coefficients of the Normal vector of a Plane to make it of unit length. 
-		static Plane Normalize(Plane const& value);
+		static constexpr Plane Normalize(Plane const& value) {
+			auto p = value;
+			p.Normalize();
+			return p;
+		}
 
 		//Transforms a normalized Plane by a Matrix or Quaternion.
 		static constexpr Plane Transform(Plane const& plane, Matrix const& matrix);
@@ -142,12 +516,18 @@ namespace xna {
 		constexpr PlaneIntersectionType Intersects(BoundingSphere const& sphere) const;
 		//Checks whether a Plane intersects a bounding volume.
 		std::optional<float> Intersects(Ray const& ray) const;
+		//Checks whether a Plane intersects a bounding volume.
+		PlaneIntersectionType Intersects(BoundingOrientedBox const& box) const;
 	};
 
 	//Defines a frustum and helps determine whether forms intersect with it. 
 	struct BoundingFrustum {
 		static constexpr int CornerCount = 8;
 		static constexpr int PlaneCount = 6;
+		//Plane mask with every plane set, bit i standing for planes[i].
+		static constexpr uint8_t AllPlanes = 0x3F;
+		//CullBatch calls with fewer boxes than this run on the calling thread only.
+		static constexpr size_t MinimumParallelCount = 65536;
 
 		constexpr BoundingFrustum() = default;
 		constexpr BoundingFrustum(Matrix const& matrix) {
@@ -184,24 +564,63 @@ namespace xna {
 		constexpr Matrix GetMatrix() const { return matrix; }
 		//Gets or sets the Matrix that describes this bounding frustum.
 		constexpr void SetMatrix(Matrix const& value);
-		//Gets or sets the Matrix that describes this bounding frustum.
-		bool Intersects(BoundingBox const& box);
-		//Gets or sets the Matrix that describes this bounding frustum.
-		bool Intersects(BoundingSphere const& box);
-		//Gets or sets the Matrix that describes this bounding frustum.
+		//Checks whether the current BoundingFrustum intersects a specified bounding volume.
+		bool Intersects(BoundingBox const& box) const;
+		//Checks whether the current BoundingFrustum intersects a specified bounding volume.
+		bool Intersects(BoundingSphere const& box) const;
+		//Checks whether the current BoundingFrustum intersects a specified Plane.
 		constexpr PlaneIntersectionType Intersects(Plane const& plane) const;
-		//Gets or sets the Matrix that describes this bounding frustum.
-		bool Intersects(BoundingFrustum const& frustum);
-		//Gets or sets the Matrix that describes this bounding frustum.
+		//Checks whether the current BoundingFrustum intersects a specified bounding volume.
+		bool Intersects(BoundingFrustum const& frustum) const;
+		//Checks whether the current BoundingFrustum intersects a specified Ray.
 		std::optional<float> Intersects(Ray const& ray) const;
+		//Checks whether the current BoundingFrustum intersects a specified bounding volume.
+		bool Intersects(BoundingOrientedBox const& box) const;
 		//Checks whether the current BoundingFrustum contains a specified bounding volume. 
 		constexpr ContainmentType Contains(BoundingBox const& box) const;
 		//Checks whether the current BoundingFrustum contains a specified bounding volume. 
-		ContainmentType Contains(BoundingFrustum const& box);
+		ContainmentType Contains(BoundingFrustum const& box) const;
 		//Checks whether the current BoundingFrustum contains a specified bounding volume. 
 		constexpr ContainmentType Contains(Vector3 const& point) const;
 		//Checks whether the current BoundingFrustum contains a specified bounding volume. 
 		constexpr ContainmentType Contains(BoundingSphere const& box) const;
+		//Checks whether the current BoundingFrustum contains a specified bounding volume, with the plane tests of Contains for a BoundingBox.
+		ContainmentType Contains(BoundingOrientedBox const& box) const;
+
+		//Culls a box against the planes set in planeMask with its n-vertex and p-vertex, instead of the GJK iterations of Intersects.
+		//Returns Disjoint, Contains, or Intersects when the box crosses a plane, which includes some boxes just outside a corner of the frustum.
+		//Unless the box is Disjoint, planeMask keeps only the planes the box crosses, the planes the children of the box in a hierarchy still need.
+		//lastPlane is tested first and receives the plane that rejects the box. Kept per object between frames, it usually rejects on the first test.
+		constexpr ContainmentType Cull(BoundingBox const& box, uint8_t& planeMask, uint8_t& lastPlane) const {
+			return CullVolume(box, planeMask, lastPlane);
+		}
+		//Culls a sphere against the planes set in planeMask, like Cull for a box.
+		constexpr ContainmentType Cull(BoundingSphere const& sphere, uint8_t& planeMask, uint8_t& lastPlane) const {
+			return CullVolume(sphere, planeMask, lastPlane);
+		}
+		//Culls boxes against all planes, four or eight at a time. Writes the same results as Cull with AllPlanes,
+		//and returns false if destination is smaller than boxes.
+		bool Cull(std::span<const BoundingBox> boxes, std::span<ContainmentType> destination) const;
+		//Sets bit i % 64 of visible[i / 64] when box i is not Disjoint, clearing the other bits. Same as IntersectsBatch for boxes.
+		bool CullBatch(std::span<const BoundingBox> boxes, std::span<uint64_t> visible, size_t threadCount = 1) const;
+
+		//Batch plane tests of Cull with all planes, four or eight volumes at a time. Bit i % 64 of result[i / 64] is set when volume i
+		//is not Disjoint, and the other bits of the words written are cleared. The bits are a superset of the volumes Intersects accepts.
+		//Spheres can be kept as a Vector4SoA with the radius in W, and boxes as two Vector3SoA with the minimum and maximum points.
+		//With threadCount greater than 1 and at least MinimumParallelCount volumes, ranges of whole words run on threadCount threads.
+		//Return false if result has fewer than (count + 63) / 64 words or the box streams have different counts.
+		bool IntersectsBatch(std::span<const BoundingBox> boxes, std::span<uint64_t> result, size_t threadCount = 1) const;
+		bool IntersectsBatch(std::span<const BoundingSphere> spheres, std::span<uint64_t> result, size_t threadCount = 1) const;
+		bool IntersectsBatch(Vector3SoA const& minimums, Vector3SoA const& maximums, std::span<uint64_t> result, size_t threadCount = 1) const;
+		bool IntersectsBatch(Vector4SoA const& spheres, std::span<uint64_t> result, size_t threadCount = 1) const;
+		//Same as IntersectsBatch, setting the bits of the volumes the frustum Contains.
+		bool ContainsBatch(std::span<const BoundingBox> boxes, std::span<uint64_t> result, size_t threadCount = 1) const;
+		bool ContainsBatch(std::span<const BoundingSphere> spheres, std::span<uint64_t> result, size_t threadCount = 1) const;
+		bool ContainsBatch(Vector3SoA const& minimums, Vector3SoA const& maximums, std::span<uint64_t> result, size_t threadCount = 1) const;
+		bool ContainsBatch(Vector4SoA const& spheres, std::span<uint64_t> result, size_t threadCount = 1) const;
+		//Writes the indices of the bits set among the first count bits, in increasing order, and returns how many were written.
+		//Stops when indices is full.
+		static size_t GetIndices(std::span<const uint64_t> bits, size_t count, std::span<uint32_t> indices);
 
 		constexpr void SupportMapping(Vector3 const& v, Vector3& result) const;
 	public:
@@ -210,9 +629,11 @@ namespace xna {
 
 	private:		
 		Matrix matrix{ Matrix::Identity() };
-		Gjk gjk{};
 
 	private:
+		template <typename T>
+		constexpr ContainmentType CullVolume(T const& volume, uint8_t& planeMask, uint8_t& lastPlane) const;
+
 		static constexpr Ray ComputeIntersectionLine(Plane const& p1, Plane const& p2);
 		static constexpr Vector3 ComputeIntersection(Plane const& plane, Ray const& ray);
 
@@ -225,6 +646,8 @@ namespace xna {
 	struct BoundingBox {
 		//Specifies the total number of corners (8) in the BoundingBox.
 		inline static constexpr int CornerCount = 8;
+		//CreateFromPoints calls with fewer points than this run on the calling thread only.
+		static constexpr size_t MinimumParallelCount = 262144;
 
 		//The maximum point the BoundingBox contains.
 		Vector3 Min{};
@@ -252,22 +675,27 @@ namespace xna {
 		}
 		//Creates the smallest BoundingBox that will contain a group of points.
 		static constexpr BoundingBox CreateFromPoints(Vector3 const* points, size_t size);
+		//Creates the smallest BoundingBox that will contain a group of points, four or eight points at a time.
+		//With threadCount greater than 1 and at least MinimumParallelCount points, ranges of points run on threadCount threads.
+		static BoundingBox CreateFromPoints(std::span<const Vector3> points, size_t threadCount);
 
 		//Checks whether the current BoundingBox intersects with another bounding volume.
 		constexpr bool Intersects(BoundingBox const& box) const;
 		//Checks whether the current BoundingBox intersects with another bounding volume.
-		bool Intersects(BoundingFrustum& frustum) const;
+		bool Intersects(BoundingFrustum const& frustum) const;
 		//Checks whether the current BoundingBox intersects with another bounding volume.
 		constexpr PlaneIntersectionType Intersects(Plane const& plane) const;
 		//Checks whether the current BoundingBox intersects with another bounding volume.
 		std::optional<float> Intersects(Ray const& ray) const;
 		//Checks whether the current BoundingBox intersects with another bounding volume.
 		constexpr bool Intersects(BoundingSphere const& sphere) const;
+		//Checks whether the current BoundingBox intersects with another bounding volume.
+		bool Intersects(BoundingOrientedBox const& box) const;
 
 		//Tests whether the BoundingBox overlaps another bounding volume.
 		constexpr ContainmentType Contains(BoundingBox const& box) const;
 		//Tests whether the BoundingBox overlaps another bounding volume.
-		ContainmentType Contains(BoundingFrustum& frustum) const;
+		ContainmentType Contains(BoundingFrustum const& frustum) const;
 		//Tests whether the BoundingBox overlaps another bounding volume.
 		constexpr ContainmentType Contains(Vector3 const& point) const;
 		//Tests whether the BoundingBox overlaps another bounding volume.
@@ -282,6 +710,9 @@ namespace xna {
 
 	//Defines a sphere. 
 	struct BoundingSphere {
+		//CreateFromPoints calls with fewer points than this run on the calling thread only.
+		static constexpr size_t MinimumParallelCount = 65536;
+
 		//The center point of the sphere.
 		Vector3 Center{};
 		//The radius of the sphere.
@@ -305,6 +736,10 @@ namespace xna {
 		}
 		//Creates a BoundingSphere that can contain a specified list of points.
 		static BoundingSphere CreateFromPoints(Vector3 const* points, size_t size);
+		//Creates a BoundingSphere that contains a list of points, usually tighter than the one of CreateFromPoints(points, size).
+		//With threadCount greater than 1 and at least MinimumParallelCount points, ranges of points run on threadCount threads;
+		//each range grows its own sphere and the spheres are merged, so the result depends on threadCount.
+		static BoundingSphere CreateFromPoints(std::span<const Vector3> points, BoundingSphereQuality quality, size_t threadCount = 1);
 
 		//Creates the smallest BoundingSphere that can contain a specified BoundingFrustum. 
 		static BoundingSphere CreateFromFrustum(BoundingFrustum const& points);
@@ -312,18 +747,20 @@ namespace xna {
 		//Checks whether the current BoundingSphere intersects another bounding volume.
 		constexpr bool Intersects(BoundingBox const& box) const;
 		//Checks whether the current BoundingSphere intersects another bounding volume.
-		bool Intersects(BoundingFrustum& frustum) const;
+		bool Intersects(BoundingFrustum const& frustum) const;
 		//Checks whether the current BoundingSphere intersects another bounding volume.
 		constexpr PlaneIntersectionType Intersects(Plane const& plane) const;
 		//Checks whether the current BoundingSphere intersects another bounding volume.
 		std::optional<float> Intersects(Ray const& ray) const;
 		//Checks whether the current BoundingSphere intersects another bounding volume.
 		constexpr bool Intersects(BoundingSphere const& sphere) const;
+		//Checks whether the current BoundingSphere intersects another bounding volume.
+		bool Intersects(BoundingOrientedBox const& box) const;
 
 		//Checks whether the current BoundingSphere contains a specified bounding volume.
 		ContainmentType Contains(BoundingBox const& box) const;
 		//Checks whether the current BoundingSphere contains a specified bounding volume.
-		ContainmentType Contains(BoundingFrustum& frustum) const;
+		ContainmentType Contains(BoundingFrustum const& frustum) const;
 		//Checks whether the current BoundingSphere contains a specified bounding volume.
 		ContainmentType Contains(Vector3 const& point) const;
 		//Checks whether the current BoundingSphere contains a specified bounding volume.
@@ -335,6 +772,76 @@ namespace xna {
 		void SupportMapping(Vector3 const& v, Vector3& result) const;
 	};
 
+	//Defines a box-shaped 3D volume with any orientation, tighter than a BoundingBox around rotated objects.
+	//The box spans Extents on each side of Center along its own axes, the X, Y and Z axes rotated by Orientation.
+	struct BoundingOrientedBox {
+		//Specifies the total number of corners (8) in the BoundingOrientedBox.
+		inline static constexpr int CornerCount = 8;
+		//CreateFromPoints calls with fewer points than this run on the calling thread only.
+		static constexpr size_t MinimumParallelCount = 262144;
+
+		//The center point of the box.
+		Vector3 Center{};
+		//Half the size of the box along each of its axes.
+		Vector3 Extents{};
+		//The unit rotation from the X, Y and Z axes to the axes of the box.
+		Quaternion Orientation{ Quaternion::Identity() };
+
+		constexpr BoundingOrientedBox() = default;
+		constexpr BoundingOrientedBox(Vector3 const& center, Vector3 const& extents, Quaternion const& orientation) :
+			Center(center), Extents(extents), Orientation(orientation) {}
+
+		constexpr bool operator==(BoundingOrientedBox const& other) const {
+			return Center == other.Center && Extents == other.Extents && Orientation == other.Orientation;
+		}
+
+		//Gets the unit axes of the box.
+		constexpr void GetAxes(Vector3& axisX, Vector3& axisY, Vector3& axisZ) const;
+		//Gets an array of points that make up the corners of the box, in the order of BoundingBox::GetCorners.
+		void GetCorners(std::vector<Vector3>& corners) const;
+
+		//Creates a BoundingOrientedBox with the same volume as a BoundingBox.
+		static constexpr BoundingOrientedBox CreateFromBoundingBox(BoundingBox const& box);
+		//Creates a BoundingOrientedBox that contains a group of points, aligned with their principal axes, the eigenvectors of their covariance.
+		//Falls back to the BoundingBox of the points when it is smaller, as for points spread unevenly over the surface of a box.
+		//The extents are widened by a few ulps of the distance of the box from the origin plus its size, so Contains finds every point.
+		//With threadCount greater than 1 and at least MinimumParallelCount points, ranges of points run on threadCount threads.
+		static BoundingOrientedBox CreateFromPoints(std::span<const Vector3> points, size_t threadCount = 1);
+
+		//Transforms the box by a Matrix. A matrix that scales unevenly along axes other than those of the box
+		//would make a parallelepiped, and the box returned is the one around it along the transformed axes.
+		BoundingOrientedBox Transform(Matrix const& matrix) const;
+		//Rotates the box around the origin.
+		BoundingOrientedBox Transform(Quaternion const& rotation) const;
+
+		//Checks whether the current BoundingOrientedBox intersects another bounding volume, with the 15 separating axes of two boxes.
+		bool Intersects(BoundingOrientedBox const& box) const;
+		//Checks whether the current BoundingOrientedBox intersects another bounding volume, with the 15 separating axes of two boxes.
+		bool Intersects(BoundingBox const& box) const;
+		//Checks whether the current BoundingOrientedBox intersects another bounding volume.
+		bool Intersects(BoundingSphere const& sphere) const;
+		//Checks whether the current BoundingOrientedBox intersects another bounding volume, with the separating axes of
+		//the frustum planes, the box axes and the crossings of their edges.
+		bool Intersects(BoundingFrustum const& frustum) const;
+		//Checks whether the current BoundingOrientedBox intersects another bounding volume.
+		PlaneIntersectionType Intersects(Plane const& plane) const;
+		//Checks whether the current BoundingOrientedBox intersects another bounding volume.
+		std::optional<float> Intersects(Ray const& ray) const;
+
+		//Checks whether the current BoundingOrientedBox contains a specified bounding volume.
+		ContainmentType Contains(Vector3 const& point) const;
+		//Checks whether the current BoundingOrientedBox contains a specified bounding volume.
+		ContainmentType Contains(BoundingSphere const& sphere) const;
+		//Checks whether the current BoundingOrientedBox contains a specified bounding volume.
+		ContainmentType Contains(BoundingBox const& box) const;
+		//Checks whether the current BoundingOrientedBox contains a specified bounding volume.
+		ContainmentType Contains(BoundingOrientedBox const& box) const;
+		//Checks whether the current BoundingOrientedBox contains a specified bounding volume.
+		ContainmentType Contains(BoundingFrustum const& frustum) const;
+
+		void SupportMapping(Vector3 const& v, Vector3& result) const;
+	};
+
 	//Defines a ray.
 	struct Ray {
 		//Specifies the starting point of the Ray.
@@ -369,6 +876,11 @@ namespace xna {
 		inline std::optional<float> Intersects(BoundingSphere const& sphere) const {
 			return sphere.Intersects(*this);
 		}
+
+		//Checks whether the Ray intersects a specified plane or bounding volume. 
+		inline std::optional<float> Intersects(BoundingOrientedBox const& box) const {
+			return box.Intersects(*this);
+		}
 	};
 
 	//---------------------------------------------------------------------------------//
@@ -478,6 +990,34 @@ namespace xna {
 		return num1 != 6 ? ContainmentType::Intersects : ContainmentType::Contains;
 	}
 
+	template <typename T>
+	constexpr ContainmentType BoundingFrustum::CullVolume(T const& volume, uint8_t& planeMask, uint8_t& lastPlane) const {
+		auto mask = planeMask;
+		auto index = lastPlane < PlaneCount ? lastPlane : 0;
+
+		for (size_t i = 0; i < PlaneCount; ++i, index = index + 1 < PlaneCount ? index + 1 : 0) {
+			const auto bit = static_cast<uint8_t>(1 << index);
+
+			if ((mask & bit) == 0)
+				continue;
+
+			switch (planes[index].Intersects(volume))
+			{
+			case PlaneIntersectionType::Front:
+				lastPlane = static_cast<uint8_t>(index);
+				return ContainmentType::Disjoint;
+			case PlaneIntersectionType::Back:
+				mask &= static_cast<uint8_t>(~bit);
+				break;
+			default:
+				break;
+			}
+		}
+
+		planeMask = mask;
+		return mask == 0 ? ContainmentType::Contains : ContainmentType::Intersects;
+	}
+
 	constexpr void BoundingFrustum::SetMatrix(Matrix const& value) {
 		matrix = value;
 		planes[2].Normal.X = -value.M14 - value.M11;
@@ -576,8 +1116,12 @@ namespace xna {
 	}	
 
 	constexpr BoundingBox BoundingBox::CreateFromPoints(Vector3 const* points, size_t size) {
+		if (!std::is_constant_evaluated())
+			return CreateFromPoints(std::span<const Vector3>(points, size), 1);
+
+		//The lowest float, numeric_limits::min being the smallest positive one.
 		Vector3 result1 = Vector3(FLOAT_MAX_VALUE);
-		Vector3 result2 = Vector3(FLOAT_MIN_VALUE);
+		Vector3 result2 = Vector3(std::numeric_limits<float>::lowest());
 
 		for (size_t i = 0; i < size; ++i) {
 			const auto& point = points[i];
@@ -597,7 +1141,7 @@ namespace xna {
 			&& Min.Z <= box.Max.Z;
 	}
 
-	inline bool BoundingBox::Intersects(BoundingFrustum& frustum) const {
+	inline bool BoundingBox::Intersects(BoundingFrustum const& frustum) const {
 		return frustum.Intersects(*this);
 	}
 
@@ -664,7 +1208,7 @@ namespace xna {
 		return result2 <= Radius * Radius;
 	}
 
-	inline bool BoundingSphere::Intersects(BoundingFrustum& frustum) const {
+	inline bool BoundingSphere::Intersects(BoundingFrustum const& frustum) const {
 		return frustum.Intersects(*this);
 	}
 
@@ -684,6 +1228,38 @@ namespace xna {
 		return radius1 * radius1 + 2.0F * radius1 * radius2 + radius2 * radius2 > result;
 	}
 
+	inline bool BoundingSphere::Intersects(BoundingOrientedBox const& box) const {
+		return box.Intersects(*this);
+	}
+
+	inline bool BoundingBox::Intersects(BoundingOrientedBox const& box) const {
+		return box.Intersects(*this);
+	}
+
+	inline bool BoundingFrustum::Intersects(BoundingOrientedBox const& box) const {
+		return box.Intersects(*this);
+	}
+
+	inline PlaneIntersectionType Plane::Intersects(BoundingOrientedBox const& box) const {
+		return box.Intersects(*this);
+	}
+
+
+	constexpr void BoundingOrientedBox::GetAxes(Vector3& axisX, Vector3& axisY, Vector3& axisZ) const {
+		//The rows of Matrix::CreateFromQuaternion(Orientation).
+		const auto x = Orientation.X;
+		const auto y = Orientation.Y;
+		const auto z = Orientation.Z;
+		const auto w = Orientation.W;
+		axisX = Vector3(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + z * w), 2.0f * (z * x - y * w));
+		axisY = Vector3(2.0f * (x * y - z * w), 1.0f - 2.0f * (z * z + x * x), 2.0f * (y * z + x * w));
+		axisZ = Vector3(2.0f * (z * x + y * w), 2.0f * (y * z - x * w), 1.0f - 2.0f * (y * y + x * x));
+	}
+
+	constexpr BoundingOrientedBox BoundingOrientedBox::CreateFromBoundingBox(BoundingBox const& box) {
+		return BoundingOrientedBox((box.Min + box.Max) * 0.5f, (box.Max - box.Min) * 0.5f, Quaternion::Identity());
+	}
+
 
 	constexpr Plane Plane::Transform(Plane const& plane, Matrix const& matrix) {
 		Matrix result = Matrix::Invert(matrix);
@@ -774,6 +1350,63 @@ namespace xna {
 		return num < -sphere.Radius
 			? PlaneIntersectionType::Back : PlaneIntersectionType::Intersecting;
 	}
+
+	constexpr Matrix Matrix::CreateShadow(Vector3 lightDirection, Plane plane) {
+		const auto result = Plane::Normalize(plane);
+		const auto num1 = result.Normal.X * lightDirection.X + result.Normal.Y * lightDirection.Y + result.Normal.Z * lightDirection.Z;
+		const auto num2 = -result.Normal.X;
+		const auto num3 = -result.Normal.Y;
+		const auto num4 = -result.Normal.Z;
+		const auto num5 = -result.D;
+
+		Matrix shadow;
+		shadow.M11 = num2 * lightDirection.X + num1;
+		shadow.M21 = num3 * lightDirection.X;
+		shadow.M31 = num4 * lightDirection.X;
+		shadow.M41 = num5 * lightDirection.X;
+		shadow.M12 = num2 * lightDirection.Y;
+		shadow.M22 = num3 * lightDirection.Y + num1;
+		shadow.M32 = num4 * lightDirection.Y;
+		shadow.M42 = num5 * lightDirection.Y;
+		shadow.M13 = num2 * lightDirection.Z;
+		shadow.M23 = num3 * lightDirection.Z;
+		shadow.M33 = num4 * lightDirection.Z + num1;
+		shadow.M43 = num5 * lightDirection.Z;
+		shadow.M14 = 0.0f;
+		shadow.M24 = 0.0f;
+		shadow.M34 = 0.0f;
+		shadow.M44 = num1;
+		return shadow;
+	}
+
+	constexpr Matrix Matrix::CreateReflection(Plane value) {
+		const auto plane = Plane::Normalize(value);
+		const auto x = plane.Normal.X;
+		const auto y = plane.Normal.Y;
+		const auto z = plane.Normal.Z;
+		const auto num1 = -2.0f * x;
+		const auto num2 = -2.0f * y;
+		const auto num3 = -2.0f * z;
+
+		Matrix reflection;
+		reflection.M11 = num1 * x + 1.0f;
+		reflection.M12 = num2 * x;
+		reflection.M13 = num3 * x;
+		reflection.M14 = 0.0f;
+		reflection.M21 = num1 * y;
+		reflection.M22 = num2 * y + 1.0f;
+		reflection.M23 = num3 * y;
+		reflection.M24 = 0.0f;
+		reflection.M31 = num1 * z;
+		reflection.M32 = num2 * z;
+		reflection.M33 = num3 * z + 1.0f;
+		reflection.M34 = 0.0f;
+		reflection.M41 = num1 * plane.D;
+		reflection.M42 = num2 * plane.D;
+		reflection.M43 = num3 * plane.D;
+		reflection.M44 = 1.0f;
+		return reflection;
+	}
 }
 
 #endif
\ No newline at end of file
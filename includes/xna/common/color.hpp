@@ -3,6 +3,7 @@
 
 #include "packedvalue.hpp"
 #include <limits>
+#include <span>
 
 namespace xna {
 	//Represents a four-component color using red, green, blue, and alpha data. 
@@ -152,6 +153,26 @@ namespace xna {
 			return color;
 		}
 
+		//Batch operations over packed colors, as stored in textures. Every function returns the same values as its single
+		//color counterpart and false if the sources have different sizes or destination is smaller.
+		//Destination can be one of the sources.
+
+		//Linearly interpolates every pair of colors, as Lerp.
+		static bool Lerp(std::span<const uint32_t> values1, std::span<const uint32_t> values2, float amount, std::span<uint32_t> destination);
+		//Multiplies every component of every color by the scale factor, as Multiply.
+		static bool Multiply(std::span<const uint32_t> values, float scale, std::span<uint32_t> destination);
+		//Multiplies the red, green and blue components by alpha, as FromNonPremultiplied(r, g, b, a).
+		static bool FromNonPremultiplied(std::span<const uint32_t> values, std::span<uint32_t> destination);
+		//Divides the red, green and blue components by alpha, rounding to nearest and saturating at 255.
+		//Colors with zero alpha become transparent black.
+		static bool ToNonPremultiplied(std::span<const uint32_t> values, std::span<uint32_t> destination);
+		//Converts every color to a Vector4, as ToVector4.
+		static bool ToVector4(std::span<const uint32_t> values, std::span<Vector4> destination);
+		//Packs every Vector4, as Color(Vector4).
+		static bool FromVector4(std::span<const Vector4> vectors, std::span<uint32_t> destination);
+		//Swaps the red and blue components, converting between RGBA and BGRA byte order.
+		static bool SwapRedBlue(std::span<const uint32_t> values, std::span<uint32_t> destination);
+
 		constexpr bool operator==(Color const& other) const {
 			return _packedValue == other._packedValue;
 		}
@@ -0,0 +1,309 @@
+#ifndef XNA_COMMON_DYNAMICAABBTREE_HPP
+#define XNA_COMMON_DYNAMICAABBTREE_HPP
+
+#include "collision.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace xna {
+	//Bounding volume hierarchy of BoundingBox proxies for broadphase queries. Every proxy is stored with a fattened box,
+	//so small moves do not change the tree. Insertion picks the sibling with the lowest surface area cost, and the nodes
+	//above it are rotated when that lowers their surface area, which keeps the tree balanced without rebuilds.
+	//Queries test the fattened boxes and hand the proxies to a callback, which runs the exact test of the objects.
+	class DynamicAabbTree {
+	public:
+		//Proxy returned for no proxy.
+		static constexpr size_t NullProxy = static_cast<size_t>(-1);
+		//Distance the boxes are fattened by on every side when no margin is specified.
+		static constexpr float DefaultMargin = 0.1f;
+		//Multiple of the displacement passed to Move by which the fattened box is stretched in the direction of motion.
+		static constexpr float DisplacementMultiplier = 2.0f;
+
+		explicit DynamicAabbTree(float margin = DefaultMargin) : margin(margin) {}
+
+		//Gets the number of proxies.
+		size_t Count() const { return proxyCount; }
+		//Gets the height of the tree, 0 for an empty tree or a single proxy.
+		size_t Height() const { return root == NullProxy ? 0 : static_cast<size_t>(nodes[root].Height); }
+		//Removes all proxies.
+		void Clear();
+
+		//Adds a proxy for a box and returns it. userData is kept with the proxy.
+		size_t Add(BoundingBox const& box, size_t userData = 0);
+		//Removes a proxy.
+		void Remove(size_t proxy);
+		//Moves a proxy to a new box. displacement, the expected motion until the next Move, stretches the fattened box.
+		//Returns true if the proxy was reinserted, false if the fattened box still holds the new box.
+		bool Move(size_t proxy, BoundingBox const& box, Vector3 const& displacement = Vector3::Zero());
+
+		//Gets the fattened box of a proxy.
+		BoundingBox const& FatBox(size_t proxy) const { return nodes[proxy].Box; }
+		//Gets the value passed to Add for a proxy.
+		size_t UserData(size_t proxy) const { return nodes[proxy].UserData; }
+
+		//Calls callback(proxy) for every proxy whose fattened box intersects box. Stops when callback returns false.
+		template <typename Callback>
+		void Query(BoundingBox const& box, Callback&& callback) const {
+			NodeStack<size_t> stack;
+
+			if (root != NullProxy)
+				stack.Push(root);
+
+			while (!stack.Empty()) {
+				const auto index = stack.Pop();
+				const auto& node = nodes[index];
+
+				if (!node.Box.Intersects(box))
+					continue;
+
+				if (node.IsLeaf()) {
+					if (!callback(index))
+						return;
+				}
+				else {
+					stack.Push(node.Child1);
+					stack.Push(node.Child2);
+				}
+			}
+		}
+
+		//Calls callback(proxy) for every proxy whose fattened box is not Disjoint from the frustum by BoundingFrustum::Cull.
+		//The plane mask is carried down the tree, and the proxies below a node the frustum contains are reported without tests.
+		//Stops when callback returns false.
+		template <typename Callback>
+		void Query(BoundingFrustum const& frustum, Callback&& callback) const {
+			NodeStack<MaskedNode> stack;
+
+			if (root != NullProxy)
+				stack.Push({ root, BoundingFrustum::AllPlanes });
+
+			while (!stack.Empty()) {
+				auto [index, planeMask] = stack.Pop();
+				const auto& node = nodes[index];
+				uint8_t lastPlane = 0;
+
+				switch (frustum.Cull(node.Box, planeMask, lastPlane)) {
+				case ContainmentType::Disjoint:
+					continue;
+				case ContainmentType::Contains:
+					if (!ForEachLeaf(index, callback))
+						return;
+					continue;
+				default:
+					break;
+				}
+
+				if (node.IsLeaf()) {
+					if (!callback(index))
+						return;
+				}
+				else {
+					stack.Push({ node.Child1, planeMask });
+					stack.Push({ node.Child2, planeMask });
+				}
+			}
+		}
+
+		//Casts a ray through the fattened boxes with BoundingBox::Intersects(Ray). hit(proxy) tests the object of a proxy
+		//and returns the distance along the ray of the hit, or nothing. distance is the longest distance searched and receives the distance
+		//of the nearest hit. Returns the proxy of the nearest hit, or NullProxy. Nodes farther than the nearest hit so far are skipped.
+		template <typename Hit>
+		size_t RayCast(Ray const& ray, float& distance, Hit&& hit) const {
+			NodeStack<size_t> stack;
+			auto nearest = NullProxy;
+
+			if (root != NullProxy && EntersWithin(nodes[root].Box, ray, distance))
+				stack.Push(root);
+
+			while (!stack.Empty()) {
+				const auto index = stack.Pop();
+				const auto& node = nodes[index];
+
+				if (node.IsLeaf()) {
+					const std::optional<float> result = hit(index);
+
+					if (result.has_value() && *result <= distance) {
+						distance = *result;
+						nearest = index;
+					}
+
+					continue;
+				}
+
+				//The node can be stale after a closer hit, so the children are tested again against the current distance.
+				const auto entry1 = nodes[node.Child1].Box.Intersects(ray);
+				const auto entry2 = nodes[node.Child2].Box.Intersects(ray);
+				const auto within1 = entry1.has_value() && *entry1 <= distance;
+				const auto within2 = entry2.has_value() && *entry2 <= distance;
+
+				//The nearer child goes on top of the stack.
+				if (within1 && within2) {
+					const auto firstIsNearer = *entry1 <= *entry2;
+					stack.Push(firstIsNearer ? node.Child2 : node.Child1);
+					stack.Push(firstIsNearer ? node.Child1 : node.Child2);
+				}
+				else if (within1) {
+					stack.Push(node.Child1);
+				}
+				else if (within2) {
+					stack.Push(node.Child2);
+				}
+			}
+
+			return nearest;
+		}
+
+		//Calls callback(proxy1, proxy2) once for every pair of proxies whose fattened boxes intersect. Stops when callback returns false.
+		template <typename Callback>
+		void QueryPairs(Callback&& callback) const {
+			NodeStack<NodePair> stack;
+
+			if (root != NullProxy)
+				stack.Push({ root, root });
+
+			while (!stack.Empty()) {
+				const auto [index1, index2] = stack.Pop();
+				const auto& node1 = nodes[index1];
+
+				if (index1 == index2) {
+					if (node1.IsLeaf())
+						continue;
+
+					//Pairs inside each child, then pairs across the children.
+					stack.Push({ node1.Child1, node1.Child1 });
+					stack.Push({ node1.Child2, node1.Child2 });
+					stack.Push({ node1.Child1, node1.Child2 });
+					continue;
+				}
+
+				const auto& node2 = nodes[index2];
+
+				if (!node1.Box.Intersects(node2.Box))
+					continue;
+
+				if (node1.IsLeaf() && node2.IsLeaf()) {
+					if (!callback(index1, index2))
+						return;
+				}
+				else if (node2.IsLeaf() || (!node1.IsLeaf() && Area(node1.Box) >= Area(node2.Box))) {
+					stack.Push({ node1.Child1, index2 });
+					stack.Push({ node1.Child2, index2 });
+				}
+				else {
+					stack.Push({ index1, node2.Child1 });
+					stack.Push({ index1, node2.Child2 });
+				}
+			}
+		}
+
+		//Half the surface area of a box, the cost the tree minimizes.
+		static constexpr float Area(BoundingBox const& box) {
+			const auto x = box.Max.X - box.Min.X;
+			const auto y = box.Max.Y - box.Min.Y;
+			const auto z = box.Max.Z - box.Min.Z;
+			return x * y + y * z + z * x;
+		}
+
+	private:
+		struct Node {
+			BoundingBox Box;
+			size_t UserData{ 0 };
+			//Parent of a node in the tree, next free node of a free node.
+			size_t Parent{ NullProxy };
+			size_t Child1{ NullProxy };
+			size_t Child2{ NullProxy };
+			//0 for leaves, -1 for free nodes.
+			int32_t Height{ 0 };
+
+			constexpr bool IsLeaf() const { return Child1 == NullProxy; }
+		};
+
+		struct MaskedNode {
+			size_t Index;
+			uint8_t PlaneMask;
+		};
+
+		struct NodePair {
+			size_t Index1;
+			size_t Index2;
+		};
+
+		//Traversal stack that spills to the heap only for very deep trees.
+		template <typename T>
+		class NodeStack {
+		public:
+			bool Empty() const { return count == 0; }
+
+			void Push(T const& value) {
+				if (count < Capacity)
+					local[count] = value;
+				else
+					spill.push_back(value);
+
+				++count;
+			}
+
+			T Pop() {
+				--count;
+
+				if (count < Capacity)
+					return local[count];
+
+				const auto value = spill.back();
+				spill.pop_back();
+				return value;
+			}
+
+		private:
+			static constexpr size_t Capacity = 64;
+			T local[Capacity];
+			std::vector<T> spill;
+			size_t count{ 0 };
+		};
+
+		template <typename Callback>
+		bool ForEachLeaf(size_t index, Callback& callback) const {
+			NodeStack<size_t> stack;
+			stack.Push(index);
+
+			while (!stack.Empty()) {
+				const auto current = stack.Pop();
+				const auto& node = nodes[current];
+
+				if (node.IsLeaf()) {
+					if (!callback(current))
+						return false;
+				}
+				else {
+					stack.Push(node.Child1);
+					stack.Push(node.Child2);
+				}
+			}
+
+			return true;
+		}
+
+		static bool EntersWithin(BoundingBox const& box, Ray const& ray, float distance) {
+			const auto entry = box.Intersects(ray);
+			return entry.has_value() && *entry <= distance;
+		}
+
+		size_t AllocateNode();
+		void FreeNode(size_t index);
+		void InsertLeaf(size_t leaf);
+		void RemoveLeaf(size_t leaf);
+		size_t FindBestSibling(BoundingBox const& box) const;
+		void Refit(size_t index);
+		void Rotate(size_t index);
+
+		std::vector<Node> nodes;
+		size_t root{ NullProxy };
+		size_t freeList{ NullProxy };
+		size_t proxyCount{ 0 };
+		float margin{ DefaultMargin };
+	};
+}
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef XNA_COMMON_FASTMATH_HPP
+#define XNA_COMMON_FASTMATH_HPP
+
+#include "numerics.hpp"
+#include "csharp/runtime/intrinsics.hpp"
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+namespace xna {
+	//Approximate versions of the square root, trigonometric and normalization functions for hot loops that prefer speed over precision.
+	//The members of Vector2, Vector3, Quaternion, Matrix and MathHelper keep full precision; code opts in by calling FastMath explicitly.
+	//Error bounds are measured against the double precision results.
+	struct FastMath {
+		//Approximates 1 / sqrt(value) with the processor estimate refined by one Newton-Raphson step.
+		//Relative error at most 3e-7 for positive normal values. The estimate treats subnormal values as zero, so values below FLT_MIN,
+		//zero, infinity and NaN are left to 1 / std::sqrt instead: infinity for zero, zero for infinity and NaN for negative values.
+		static float ReciprocalSqrt(float value) {
+#if defined(CSHARP_INTRINSICS_X86)
+			if (!IsPositiveNormal(value))
+				return 1.0f / std::sqrt(value);
+
+			const auto x = _mm_set_ss(value);
+			const auto estimate = _mm_rsqrt_ss(x);
+			const auto xyy = _mm_mul_ss(_mm_mul_ss(x, estimate), estimate);
+			return _mm_cvtss_f32(_mm_mul_ss(_mm_mul_ss(_mm_set_ss(0.5f), estimate), _mm_sub_ss(_mm_set_ss(3.0f), xyy)));
+#else
+			return 1.0f / std::sqrt(value);
+#endif
+		}
+
+		//Approximates the square root as value * ReciprocalSqrt(value). Same relative error for positive normal values.
+		//Subnormal values and infinity use std::sqrt, and zero, negative values and NaN return 0.
+		static float Sqrt(float value) {
+			if (IsPositiveNormal(value))
+				return value * ReciprocalSqrt(value);
+
+			return value > 0.0f ? std::sqrt(value) : 0.0f;
+		}
+
+		//Calculates the sine and cosine of an angle with 11th and 10th degree minimax polynomials and no branches.
+		//Absolute error at most 4e-7 for angles in [-8192, 8192] radians and 1.5e-6 in [-100000, 100000], the valid domain.
+		//Larger angles lose the reduction to one turn and give values in [-1, 1] that are not the sine and cosine. Infinity and NaN give NaN.
+		static void SinCos(float radians, float& sin, float& cos) {
+			//Reduces to y in [-pi, pi]. 2pi is split in two so quotient * TwoPiHigh is exact in the valid domain.
+			//Adding and subtracting 1.5 * 2^23 rounds the turns to the nearest whole number below 2^22 turns, without an int
+			//conversion that would be undefined for large angles. This relies on strict float evaluation, not /fp:fast or -ffast-math.
+			const auto quotient = (radians * InverseTwoPi + RoundingBias) - RoundingBias;
+			auto y = (radians - quotient * TwoPiHigh) - quotient * TwoPiLow;
+
+			//Reflects to [-pi/2, pi/2], where sin is unchanged and cos changes sign. Past the valid domain y can be far outside one turn,
+			//so the reflected angle is clamped to -pi/2 to keep the polynomials in range. The selects compile to minss and maxss, which
+			//turn NaN into -pi/2, and radians - radians, zero for finite angles, brings the NaN of infinity and NaN back.
+			const auto absY = std::abs(y);
+			const auto sign = std::copysign(1.0f, HalfPi - absY);
+			auto reflected = absY < Pi - absY ? absY : Pi - absY;
+			reflected = reflected > -HalfPi ? reflected : -HalfPi;
+			y = std::copysign(1.0f, y) * reflected * (1.0f + (radians - radians));
+
+			const auto y2 = y * y;
+			sin = (((((-2.3889859e-08f * y2 + 2.7525562e-06f) * y2 - 0.00019840874f) * y2 + 0.0083333310f) * y2 - 0.16666667f) * y2 + 1.0f) * y;
+			cos = sign * (((((-2.6051615e-07f * y2 + 2.4760495e-05f) * y2 - 0.0013888378f) * y2 + 0.041666638f) * y2 - 0.5f) * y2 + 1.0f);
+		}
+
+		//Calculates the sine of an angle. Same error as SinCos.
+		static float Sin(float radians) {
+			float sin, cos;
+			SinCos(radians, sin, cos);
+			return sin;
+		}
+
+		//Calculates the cosine of an angle. Same error as SinCos.
+		static float Cos(float radians) {
+			float sin, cos;
+			SinCos(radians, sin, cos);
+			return cos;
+		}
+
+		//Calculates the angle whose tangent is y / x, in [-pi, pi], with a 9th degree polynomial for atan on [0, 1].
+		//Absolute error at most 1.2e-5 radians. Returns 0 when both values are 0.
+		static float Atan2(float y, float x) {
+			const auto absX = std::abs(x);
+			const auto absY = std::abs(y);
+			const auto maximum = absX > absY ? absX : absY;
+			const auto minimum = absX > absY ? absY : absX;
+
+			if (maximum == 0.0f)
+				return 0.0f;
+
+			const auto a = minimum / maximum;
+			const auto s = a * a;
+			auto r = ((((0.0208351f * s - 0.0851330f) * s + 0.1801410f) * s - 0.3302995f) * s + 0.9998660f) * a;
+
+			r = absY > absX ? HalfPi - r : r;
+			r = x < 0.0f ? Pi - r : r;
+			return std::copysign(r, y);
+		}
+
+		//Normalizes a vector with ReciprocalSqrt. A zero vector gives NaN, like Vector2::Normalize.
+		static Vector2 Normalize(Vector2 const& value) {
+			return value * ReciprocalSqrt(value.LengthSquared());
+		}
+
+		//Normalizes a vector with ReciprocalSqrt. A zero vector gives NaN, like Vector3::Normalize.
+		static Vector3 Normalize(Vector3 const& value) {
+			return value * ReciprocalSqrt(value.LengthSquared());
+		}
+
+		//Normalizes a quaternion with ReciprocalSqrt. A zero quaternion gives NaN, like Quaternion::Normalize.
+		static Quaternion Normalize(Quaternion const& value) {
+			const auto num = ReciprocalSqrt(value.LengthSquared());
+			return Quaternion(value.X * num, value.Y * num, value.Z * num, value.W * num);
+		}
+
+		//Interpolates along the shortest path and normalizes with ReciprocalSqrt, like Quaternion::Lerp.
+		static Quaternion Lerp(Quaternion const& quaternion1, Quaternion const& quaternion2, float amount) {
+			const auto num1 = Quaternion::Dot(quaternion1, quaternion2) >= 0.0f ? amount : -amount;
+			const auto num2 = 1.0f - amount;
+			Quaternion quaternion;
+			quaternion.X = num2 * quaternion1.X + num1 * quaternion2.X;
+			quaternion.Y = num2 * quaternion1.Y + num1 * quaternion2.Y;
+			quaternion.Z = num2 * quaternion1.Z + num1 * quaternion2.Z;
+			quaternion.W = num2 * quaternion1.W + num1 * quaternion2.W;
+			return Normalize(quaternion);
+		}
+
+		//Approximates Quaternion::Slerp with Lerp after correcting the amount for the angle between the quaternions,
+		//so the rotation advances at a nearly constant rate. The result is at most 0.002 radians from Slerp.
+		static Quaternion Slerp(Quaternion const& quaternion1, Quaternion const& quaternion2, float amount) {
+			return Lerp(quaternion1, quaternion2, SlerpAmount(std::abs(Quaternion::Dot(quaternion1, quaternion2)), amount));
+		}
+
+		//Batch versions of Lerp and Slerp. They return the same values as the single quaternion functions,
+		//and false if the sources have different sizes or destination is smaller. Destination can be one of the sources.
+		static bool Lerp(std::span<const Quaternion> quaternions1, std::span<const Quaternion> quaternions2, float amount, std::span<Quaternion> destination);
+		static bool Slerp(std::span<const Quaternion> quaternions1, std::span<const Quaternion> quaternions2, float amount, std::span<Quaternion> destination);
+
+		//Calculates the distance between two vectors with Sqrt.
+		static float Distance(Vector2 const& value1, Vector2 const& value2) {
+			return Sqrt(Vector2::DistanceSquared(value1, value2));
+		}
+
+		//Calculates the distance between two vectors with Sqrt.
+		static float Distance(Vector3 const& value1, Vector3 const& value2) {
+			return Sqrt(Vector3::DistanceSquared(value1, value2));
+		}
+
+		//Creates a matrix that rotates around the x-axis, with SinCos.
+		static Matrix CreateRotationX(float radians) {
+			float sin, cos;
+			SinCos(radians, sin, cos);
+
+			auto rotation = Matrix::Identity();
+			rotation.M22 = cos;
+			rotation.M23 = sin;
+			rotation.M32 = -sin;
+			rotation.M33 = cos;
+			return rotation;
+		}
+
+		//Creates a matrix that rotates around the y-axis, with SinCos.
+		static Matrix CreateRotationY(float radians) {
+			float sin, cos;
+			SinCos(radians, sin, cos);
+
+			auto rotation = Matrix::Identity();
+			rotation.M11 = cos;
+			rotation.M13 = -sin;
+			rotation.M31 = sin;
+			rotation.M33 = cos;
+			return rotation;
+		}
+
+		//Creates a matrix that rotates around the z-axis, with SinCos.
+		static Matrix CreateRotationZ(float radians) {
+			float sin, cos;
+			SinCos(radians, sin, cos);
+
+			auto rotation = Matrix::Identity();
+			rotation.M11 = cos;
+			rotation.M12 = sin;
+			rotation.M21 = -sin;
+			rotation.M22 = cos;
+			return rotation;
+		}
+
+		//Creates a quaternion with the specified yaw, pitch and roll, with SinCos.
+		static Quaternion CreateQuaternionFromYawPitchRoll(float yaw, float pitch, float roll) {
+			float num2, num3, num5, num6, num8, num9;
+			SinCos(roll * 0.5f, num2, num3);
+			SinCos(pitch * 0.5f, num5, num6);
+			SinCos(yaw * 0.5f, num8, num9);
+
+			Quaternion fromYawPitchRoll;
+			fromYawPitchRoll.X = (num9 * num5 * num3 + num8 * num6 * num2);
+			fromYawPitchRoll.Y = (num8 * num6 * num3 - num9 * num5 * num2);
+			fromYawPitchRoll.Z = (num9 * num6 * num2 - num8 * num5 * num3);
+			fromYawPitchRoll.W = (num9 * num6 * num3 + num8 * num5 * num2);
+			return fromYawPitchRoll;
+		}
+
+		//Creates a rotation matrix with the specified yaw, pitch and roll, with SinCos.
+		static Matrix CreateFromYawPitchRoll(float yaw, float pitch, float roll) {
+			return Matrix::CreateFromQuaternion(CreateQuaternionFromYawPitchRoll(yaw, pitch, roll));
+		}
+
+		//The amount Slerp passes to Lerp, for the absolute cosine of the angle between the quaternions.
+		static constexpr float SlerpAmount(float cosine, float amount) {
+			const auto a = 1.0904f + cosine * (-3.2452f + cosine * (3.55645f - cosine * 1.43519f));
+			const auto b = 0.848013f + cosine * (-1.06021f + cosine * 0.215638f);
+			const auto k = a * (amount - 0.5f) * (amount - 0.5f) + b;
+			return amount + amount * (amount - 0.5f) * (amount - 1.0f) * k;
+		}
+
+	private:
+		//Whether value is in [FLT_MIN, FLT_MAX], with one unsigned comparison of the bits.
+		static constexpr bool IsPositiveNormal(float value) {
+			return std::bit_cast<uint32_t>(value) - 0x00800000u < 0x7F000000u;
+		}
+
+		static constexpr float Pi = 3.14159265f;
+		static constexpr float HalfPi = 1.57079633f;
+		static constexpr float TwoPiHigh = 6.28125f;
+		static constexpr float TwoPiLow = 0.00193530717958647692f;
+		static constexpr float InverseTwoPi = 0.159154943f;
+		static constexpr float RoundingBias = 12582912.0f;
+	};
+}
+
+#endif
@@ -4,6 +4,8 @@
 #include <limits>
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
+#include <type_traits>
 
 namespace xna {
 	//Contains commonly used precalculated values. 
@@ -18,7 +20,7 @@ namespace xna {
 		//Converts radians to degrees.
 		static constexpr float ToDegrees(float radians) { return radians * 57.2957764F; }
 		//Calculates the absolute value of the difference of two values
-		static float Distance(float value1, float value2) { return std::abs(value1 - value2); }
+		static constexpr float Distance(float value1, float value2) { return Abs(value1 - value2); }
 		//Returns the lesser of two values.
 		static constexpr float Min(float value1, float value2) { return (std::min)(value1, value2); }
 		//Returns the greater of two values.
@@ -66,6 +68,176 @@ namespace xna {
 			const auto num7 = num3 - num2;
 			return value1 * num4 + value2 * num5 + tangent1 * num6 + tangent2 * num7;
 		}
+
+		//The functions below call the <cmath> functions at run time. In constant expressions they are evaluated
+		//in double precision and rounded to float, which gives the same value as <cmath> or one ulp away.
+
+		//Returns the absolute value of a number.
+		static constexpr float Abs(float value) {
+			if (!std::is_constant_evaluated())
+				return std::abs(value);
+
+			return value < 0.0f ? -value : value + 0.0f;
+		}
+
+		//Returns the square root of a number, or NaN for negative numbers.
+		static constexpr float Sqrt(float value) {
+			if (!std::is_constant_evaluated())
+				return std::sqrt(value);
+
+			return static_cast<float>(SqrtConstant(value));
+		}
+
+		//Calculates the sine and cosine of an angle in radians.
+		//In constant expressions the angle is reduced exactly for magnitudes up to about 1e6 and must be below 1e18.
+		static constexpr void SinCos(float radians, float& sin, float& cos) {
+			if (!std::is_constant_evaluated()) {
+				sin = std::sin(radians);
+				cos = std::cos(radians);
+				return;
+			}
+
+			double s = 0, c = 0;
+			SinCosConstant(radians, s, c);
+			sin = static_cast<float>(s);
+			cos = static_cast<float>(c);
+		}
+
+		//Returns the sine of an angle in radians.
+		static constexpr float Sin(float radians) {
+			if (!std::is_constant_evaluated())
+				return std::sin(radians);
+
+			double s = 0, c = 0;
+			SinCosConstant(radians, s, c);
+			return static_cast<float>(s);
+		}
+
+		//Returns the cosine of an angle in radians.
+		static constexpr float Cos(float radians) {
+			if (!std::is_constant_evaluated())
+				return std::cos(radians);
+
+			double s = 0, c = 0;
+			SinCosConstant(radians, s, c);
+			return static_cast<float>(c);
+		}
+
+		//Returns the tangent of an angle in radians.
+		static constexpr float Tan(float radians) {
+			if (!std::is_constant_evaluated())
+				return std::tan(radians);
+
+			double s = 0, c = 0;
+			SinCosConstant(radians, s, c);
+			return static_cast<float>(s / c);
+		}
+
+		//Returns the angle in [0, pi] whose cosine is the specified number, or NaN outside [-1, 1].
+		static constexpr float Acos(float value) {
+			if (!std::is_constant_evaluated())
+				return std::acos(value);
+
+			if (!(value >= -1.0f && value <= 1.0f))
+				return std::numeric_limits<float>::quiet_NaN();
+
+			if (value == -1.0f)
+				return static_cast<float>(PI);
+
+			//acos(x) = 2 atan(sqrt((1 - x) / (1 + x))), where 1 - x and 1 + x are exact in double.
+			const double x = value;
+			return static_cast<float>(2.0 * AtanConstant(SqrtConstant((1.0 - x) / (1.0 + x))));
+		}
+
+	private:
+		//Newton-Raphson square root, started above the root after scaling the value to [1, 4).
+		static constexpr double SqrtConstant(double value) {
+			if (!(value > 0.0) || value == std::numeric_limits<double>::infinity())
+				return value == 0.0 || value != value || value > 0.0 ? value : std::numeric_limits<double>::quiet_NaN();
+
+			double scale = 1.0;
+
+			while (value >= 4.0) {
+				value *= 0.25;
+				scale *= 2.0;
+			}
+
+			while (value < 1.0) {
+				value *= 4.0;
+				scale *= 0.5;
+			}
+
+			auto root = value;
+
+			while (true) {
+				const auto next = 0.5 * (root + value / root);
+
+				if (next >= root)
+					break;
+
+				root = next;
+			}
+
+			return root * scale;
+		}
+
+		//Reduces the angle to [-pi/4, pi/4] around a multiple of pi/2, with pi/2 split in three parts so the
+		//products with the quadrant are exact, then sums the Taylor series.
+		static constexpr void SinCosConstant(double radians, double& sin, double& cos) {
+			if (radians != radians || radians - radians != 0.0) {
+				sin = cos = std::numeric_limits<double>::quiet_NaN();
+				return;
+			}
+
+			constexpr double PiOver2High = 1.57079632673412561417e+00;
+			constexpr double PiOver2Middle = 6.07710050630396597660e-11;
+			constexpr double PiOver2Low = 2.02226624879595063154e-21;
+
+			const auto scaled = radians * (2.0 / PI);
+			const auto quadrant = static_cast<double>(static_cast<int64_t>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5));
+			const auto r = ((radians - quadrant * PiOver2High) - quadrant * PiOver2Middle) - quadrant * PiOver2Low;
+			const auto r2 = r * r;
+
+			double s = r, c = 1.0;
+			double sinTerm = r, cosTerm = 1.0;
+
+			for (int n = 1; n <= 11; ++n) {
+				sinTerm *= -r2 / ((2.0 * n) * (2.0 * n + 1.0));
+				cosTerm *= -r2 / ((2.0 * n - 1.0) * (2.0 * n));
+				s += sinTerm;
+				c += cosTerm;
+			}
+
+			switch (static_cast<int64_t>(quadrant) & 3) {
+			case 0: sin = s; cos = c; break;
+			case 1: sin = c; cos = -s; break;
+			case 2: sin = -s; cos = -c; break;
+			default: sin = -c; cos = s; break;
+			}
+		}
+
+		//Arctangent of a non-negative value. Values above 1 use atan(x) = pi/2 - atan(1/x) and values above
+		//tan(pi/12) are shifted by pi/6, so the series runs on at most 0.268.
+		static constexpr double AtanConstant(double value) {
+			if (value > 1.0)
+				return PI / 2.0 - AtanConstant(1.0 / value);
+
+			constexpr double Sqrt3 = 1.7320508075688772;
+			constexpr double TanPiOver12 = 0.2679491924311227;
+
+			if (value > TanPiOver12)
+				return PI / 6.0 + AtanConstant((value * Sqrt3 - 1.0) / (Sqrt3 + value));
+
+			const auto v2 = value * value;
+			double sum = value, term = value;
+
+			for (int n = 1; n <= 14; ++n) {
+				term *= -v2;
+				sum += term / (2.0 * n + 1.0);
+			}
+
+			return sum;
+		}
 	};
 }
 
@@ -1,9 +1,13 @@
 ﻿#ifndef XNA_COMMON_VECTORS_HPP
 #define XNA_COMMON_VECTORS_HPP
 
+#include "csharp/runtime/intrinsics.hpp"
+#include "math.hpp"
 #include <cmath>
 #include <optional>
 #include <cstdint>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 namespace xna {
@@ -209,16 +213,16 @@ namespace xna {
 		//Returns the unit vector for the y-axis.
 		static constexpr Vector2 UnitY() { return { 0, 1 }; }
 
-		inline float Length() const {
-			return sqrt(LengthSquared());
+		constexpr float Length() const {
+			return MathHelper::Sqrt(LengthSquared());
 		}
 
 		constexpr float LengthSquared() const {
 			return (X * X + Y * Y);
 		}
 
-		static inline float Distance(Vector2 const& value1, Vector2 const& value2) {
-			return sqrt(DistanceSquared(value1, value2));
+		static constexpr float Distance(Vector2 const& value1, Vector2 const& value2) {
+			return MathHelper::Sqrt(DistanceSquared(value1, value2));
 		}
 
 		static constexpr float DistanceSquared(Vector2 const& value1, Vector2 const& value2) {
@@ -231,13 +235,13 @@ namespace xna {
 			return value1.X * value2.X + value1.Y * value2.Y;
 		}
 
-		inline void Normalize() {
+		constexpr void Normalize() {
 			const auto normal = 1.0f / Length();
 			X *= normal;
 			Y *= normal;
 		}
 
-		static inline Vector2 Normalize(Vector2 const& value) {
+		static constexpr Vector2 Normalize(Vector2 const& value) {
 			auto v = value;
 			v.Normalize();
 			return v;
@@ -428,33 +432,33 @@ namespace xna {
 		}
 
 		//Returns a Vector3 with all of its components set to zero.
-		static Vector3 Zero() { return {}; }
+		static constexpr Vector3 Zero() { return {}; }
 		//Returns a Vector2 with both of its components set to one.
-		static Vector3 One() { return { 1 }; }
+		static constexpr Vector3 One() { return { 1 }; }
 		//Returns the x unit Vector3(1, 0, 0).
-		static Vector3 UnitX() { return { 1,0,0 }; }
+		static constexpr Vector3 UnitX() { return { 1,0,0 }; }
 		//Returns the y unit Vector3 (0, 1, 0). 
-		static Vector3 UnitY() { return { 0,1,0 }; }
+		static constexpr Vector3 UnitY() { return { 0,1,0 }; }
 		//Returns the z unit Vector3 (0, 0, 1). 
-		static Vector3 UnitZ() { return { 0,0,1 }; }
+		static constexpr Vector3 UnitZ() { return { 0,0,1 }; }
 		//Returns a unit vector designating up (0, 1, 0).
-		static Vector3 Up() { return UnitY(); }
+		static constexpr Vector3 Up() { return UnitY(); }
 		//Returns a unit Vector3 designating down (0, −1, 0).
-		static Vector3 Down() { return -UnitY(); }
+		static constexpr Vector3 Down() { return -UnitY(); }
 		//Returns a unit Vector3 pointing to the right (1, 0, 0).
-		static Vector3 Right() { return UnitX(); }
+		static constexpr Vector3 Right() { return UnitX(); }
 		//Returns a unit Vector3 designating left (−1, 0, 0).
-		static Vector3 Left() { return -UnitX(); }
+		static constexpr Vector3 Left() { return -UnitX(); }
 		//Returns a unit Vector3 designating forward in a right-handed coordinate system(0, 0, −1).
-		static Vector3 Forward() { return -UnitZ(); }
+		static constexpr Vector3 Forward() { return -UnitZ(); }
 		//Returns a unit Vector3 designating backward in a right-handed coordinate system (0, 0, 1).
-		static Vector3 Backward() { return UnitZ(); }
+		static constexpr Vector3 Backward() { return UnitZ(); }
 
-		inline float Length() const { return sqrt(LengthSquared());	}
+		constexpr float Length() const { return MathHelper::Sqrt(LengthSquared()); }
 		constexpr float LengthSquared() const {	return (X * X + Y * Y + Z * Z);	}
 
-		inline static float Distance(Vector3 const& value1, Vector3 const& value2) {
-			return std::sqrt(DistanceSquared(value1, value2));
+		static constexpr float Distance(Vector3 const& value1, Vector3 const& value2) {
+			return MathHelper::Sqrt(DistanceSquared(value1, value2));
 		}
 
 		static constexpr float DistanceSquared(Vector3 const& value1, Vector3 const& value2) {
@@ -468,14 +472,14 @@ namespace xna {
 			return vector1.X * vector2.X + vector1.Y * vector2.Y + vector1.Z * vector2.Z;
 		}
 
-		inline void Normalize() {
+		constexpr void Normalize() {
 			const auto num = 1.0f / Length();
 			X *= num;
 			Y *= num;
 			Z *= num;
 		}
 		
-		static Vector3 Normalize(Vector3 const& value) {
+		static constexpr Vector3 Normalize(Vector3 const& value) {
 			auto v = value;
 			v.Normalize();
 			return v;
@@ -565,7 +569,7 @@ namespace xna {
 			return vector3;
 		}
 
-		static Vector3 Hermite(Vector3 const& value1, Vector3 const& tangent1, Vector3 const& value2, Vector3 const& tangent2, float amount) {
+		static constexpr Vector3 Hermite(Vector3 const& value1, Vector3 const& tangent1, Vector3 const& value2, Vector3 const& tangent2, float amount) {
 			const auto num1 = amount * amount;
 			const auto num2 = amount * num1;
 			const auto num3 = 2.0F * num2 - 3.0F * num1 + 1.0F;
@@ -689,18 +693,18 @@ namespace xna {
 			return Vector3::Divide(value, divider);
 		}
 
-		friend constexpr Vector3 operator+=(Vector3 const& value1, Vector3 const& value2) {
-			auto vec = value1;
-			vec.X += value2.X;
-			vec.Y += value2.Y;
-			return vec;
+		friend constexpr Vector3& operator+=(Vector3& value1, Vector3 const& value2) {
+			value1.X += value2.X;
+			value1.Y += value2.Y;
+			value1.Z += value2.Z;
+			return value1;
 		}
 
-		friend constexpr Vector3 operator-=(Vector3 const& value1, Vector3 const& value2) {
-			auto vec = value1;
-			vec.X -= value2.X;
-			vec.Y -= value2.Y;
-			return vec;
+		friend constexpr Vector3& operator-=(Vector3& value1, Vector3 const& value2) {
+			value1.X -= value2.X;
+			value1.Y -= value2.Y;
+			value1.Z -= value2.Z;
+			return value1;
 		}
 	};
 
@@ -732,23 +736,23 @@ namespace xna {
 			return std::make_optional<Vector4>(X, Y, Z,W);
 		}
 
-		static Vector4 Zero() { return {}; }
-		static Vector4 One() { return { 1 }; }
-		static Vector4 UnitX() { return { 1,0,0,0 }; }
-		static Vector4 UnitY() { return { 0,1,0,0 }; }
-		static Vector4 UnitZ() { return { 0,0,1,0 }; }
-		static Vector4 UnitW() { return { 0,0,0,1 }; }
+		static constexpr Vector4 Zero() { return {}; }
+		static constexpr Vector4 One() { return { 1 }; }
+		static constexpr Vector4 UnitX() { return { 1,0,0,0 }; }
+		static constexpr Vector4 UnitY() { return { 0,1,0,0 }; }
+		static constexpr Vector4 UnitZ() { return { 0,0,1,0 }; }
+		static constexpr Vector4 UnitW() { return { 0,0,0,1 }; }
 
-		float Length() const {
-			return sqrt(LengthSquared());
+		constexpr float Length() const {
+			return MathHelper::Sqrt(LengthSquared());
 		}
 
 		constexpr float LengthSquared() const {
 			return (X * X + Y * Y + Z * Z + W * W);
 		}
 
-		inline static float Distance(Vector4 const& value1, Vector4 const& value2) {
-			return sqrt(DistanceSquared(value1, value2));
+		static constexpr float Distance(Vector4 const& value1, Vector4 const& value2) {
+			return MathHelper::Sqrt(DistanceSquared(value1, value2));
 		}
 
 		static constexpr float DistanceSquared(Vector4 const& value1, Vector4 const& value2) {
@@ -763,7 +767,7 @@ namespace xna {
 			return vector1.X * vector2.X + vector1.Y * vector2.Y + vector1.Z * vector2.Z + vector1.W * vector2.W;
 		}
 
-		void Normalize() {
+		constexpr void Normalize() {
 			const auto num = 1.0f / Length();
 			X *= num;
 			Y *= num;
@@ -771,7 +775,7 @@ namespace xna {
 			W *= num;
 		}
 
-		inline static Vector4 Normalize(Vector4 const& vector) {
+		static constexpr Vector4 Normalize(Vector4 const& vector) {
 			auto v = vector;
 			v.Normalize();
 			return v;
@@ -795,7 +799,7 @@ namespace xna {
 			return vector4;
 		}
 
-		static Vector4 Clamp(Vector4 const& value1, Vector4 const& min, Vector4 const& max) {
+		static constexpr Vector4 Clamp(Vector4 const& value1, Vector4 const& min, Vector4 const& max) {
 			const auto x = value1.X;
 			const auto num1 = x > max.X ? max.X : x;
 			const auto num2 = num1 < min.X ? min.X : num1;
@@ -816,7 +820,7 @@ namespace xna {
 			return vector4;
 		}
 
-		static Vector4 Lerp(Vector4 const& value1, Vector4 const& value2, float amount) {
+		static constexpr Vector4 Lerp(Vector4 const& value1, Vector4 const& value2, float amount) {
 			Vector4 vector4;
 			vector4.X = value1.X + (value2.X - value1.X) * amount;
 			vector4.Y = value1.Y + (value2.Y - value1.Y) * amount;
@@ -825,7 +829,7 @@ namespace xna {
 			return vector4;
 		}
 
-		static Vector4 Barycentric(Vector4 const& value1, Vector4 const& value2, Vector4 const& value3,	float amount1,	float amount2) {
+		static constexpr Vector4 Barycentric(Vector4 const& value1, Vector4 const& value2, Vector4 const& value3,	float amount1,	float amount2) {
 			Vector4 vector4;
 			vector4.X = value1.X + amount1 * (value2.X - value1.X) + amount2 * (value3.X - value1.X);
 			vector4.Y = value1.Y + amount1 * (value2.Y - value1.Y) + amount2 * (value3.Y - value1.Y);
@@ -834,7 +838,7 @@ namespace xna {
 			return vector4;
 		}
 
-		static Vector4 SmoothStep(Vector4 const& value1, Vector4 const& value2, float amount) {
+		static constexpr Vector4 SmoothStep(Vector4 const& value1, Vector4 const& value2, float amount) {
 			amount = amount > 1.0F ? 1.0f : (amount < 0.0F ? 0.0f : amount);
 			amount = (amount * amount * (3.0F - 2.0F * amount));
 			Vector4 vector4;
@@ -845,7 +849,7 @@ namespace xna {
 			return vector4;
 		}
 
-		static Vector4 CatmullRom(Vector4 const& value1, Vector4 const& value2, Vector4 const& value3, Vector4 const& value4, float amount) {
+		static constexpr Vector4 CatmullRom(Vector4 const& value1, Vector4 const& value2, Vector4 const& value3, Vector4 const& value4, float amount) {
 			const auto num1 = amount * amount;
 			const auto num2 = amount * num1;
 			Vector4 vector4;
@@ -856,7 +860,7 @@ namespace xna {
 			return vector4;
 		}
 
-		static Vector4 Hermite(Vector4 const& value1, Vector4 const& tangent1, Vector4 const& value2, Vector4 const& tangent2, float amount) {
+		static constexpr Vector4 Hermite(Vector4 const& value1, Vector4 const& tangent1, Vector4 const& value2, Vector4 const& tangent2, float amount) {
 			const auto num1 = amount * amount;
 			const auto num2 = amount * num1;
 			const auto num3 = (2.0F * num2 - 3.0F * num1 + 1.0F);
@@ -991,7 +995,8 @@ namespace xna {
 		}
 	};
 
-	struct Matrix {
+	//Rows are 16-byte aligned so the vectorized operations can load them directly.
+	struct alignas(16) Matrix {
 		float M11{ 0 };
 		float M12{ 0 };
 		float M13{ 0 };
@@ -1094,14 +1099,77 @@ namespace xna {
 			M43 = value.Z;
 		}
 
-		static Matrix CreateBillboard(Vector3 const& objectPosition, Vector3 const& cameraPosition, Vector3 const& cameraUpVector, Vector3* cameraForwardVector);
+		//Creates a spherical billboard that rotates around a specified object position.
+		//cameraForwardVector is used when the camera is at the object position and can be null.
+		static constexpr Matrix CreateBillboard(Vector3 const& objectPosition, Vector3 const& cameraPosition, Vector3 const& cameraUpVector, Vector3 const* cameraForwardVector) {
+			auto vector1 = objectPosition - cameraPosition;
+			const auto num = vector1.LengthSquared();
 
-		static Matrix CreateConstrainedBillboard(
+			if (num < 9.99999974737875E-05)
+				vector1 = cameraForwardVector != nullptr ? -*cameraForwardVector : Vector3::Forward();
+			else
+				vector1 = vector1 * (1.0f / MathHelper::Sqrt(num));
+
+			const auto vector3 = Vector3::Normalize(Vector3::Cross(cameraUpVector, vector1));
+			const auto vector2 = Vector3::Cross(vector1, vector3);
+
+			return Matrix(
+				vector3.X, vector3.Y, vector3.Z, 0.0f,
+				vector2.X, vector2.Y, vector2.Z, 0.0f,
+				vector1.X, vector1.Y, vector1.Z, 0.0f,
+				objectPosition.X, objectPosition.Y, objectPosition.Z, 1.0f);
+		}
+
+		//Creates a cylindrical billboard that rotates around a specified axis.
+		//cameraForwardVector and objectForwardVector can be null.
+		static constexpr Matrix CreateConstrainedBillboard(
 			Vector3 const& objectPosition,
 			Vector3 const& cameraPosition,
 			Vector3 const& rotateAxis,
-			Vector3* cameraForwardVector,
-			Vector3* objectForwardVector);
+			Vector3 const* cameraForwardVector,
+			Vector3 const* objectForwardVector) {
+			auto vector2 = objectPosition - cameraPosition;
+			const auto num2 = vector2.LengthSquared();
+
+			if (num2 < 9.99999974737875E-05)
+				vector2 = cameraForwardVector != nullptr ? -*cameraForwardVector : Vector3::Forward();
+			else
+				vector2 = vector2 * (1.0f / MathHelper::Sqrt(num2));
+
+			const auto vector4 = rotateAxis;
+			auto num = Vector3::Dot(rotateAxis, vector2);
+			Vector3 vector;
+			Vector3 vector3;
+
+			if (MathHelper::Abs(num) > 0.998254656791687) {
+				if (objectForwardVector != nullptr) {
+					vector = *objectForwardVector;
+					num = Vector3::Dot(rotateAxis, vector);
+
+					if (MathHelper::Abs(num) > 0.998254656791687) {
+						num = Vector3::Dot(rotateAxis, Vector3::Forward());
+						vector = MathHelper::Abs(num) > 0.998254656791687 ? Vector3::Right() : Vector3::Forward();
+					}
+				}
+				else {
+					num = Vector3::Dot(rotateAxis, Vector3::Forward());
+					vector = MathHelper::Abs(num) > 0.998254656791687 ? Vector3::Right() : Vector3::Forward();
+				}
+
+				vector3 = Vector3::Normalize(Vector3::Cross(rotateAxis, vector));
+				vector = Vector3::Normalize(Vector3::Cross(vector3, rotateAxis));
+			}
+			else {
+				vector3 = Vector3::Normalize(Vector3::Cross(rotateAxis, vector2));
+				vector = Vector3::Normalize(Vector3::Cross(vector3, vector4));
+			}
+
+			return Matrix(
+				vector3.X, vector3.Y, vector3.Z, 0.0f,
+				vector4.X, vector4.Y, vector4.Z, 0.0f,
+				vector.X, vector.Y, vector.Z, 0.0f,
+				objectPosition.X, objectPosition.Y, objectPosition.Z, 1.0f);
+		}
 
 		static constexpr Matrix CreateTranslation(Vector3 const& position) {
 			Matrix translation;
@@ -1208,12 +1276,97 @@ namespace xna {
 			return scale1;
 		}
 
-		static Matrix CreateRotationX(float radians);
-		static Matrix CreateRotationY(float radians);
-		static Matrix CreateRotationZ(float radians);
-		static Matrix CreateFromAxisAngle(Vector3 const& axis, float angle);
-		static Matrix CreatePerspectiveFieldOfView(
-			float fieldOfView, float aspectRatio, float nearPlaneDistance, float farPlaneDistance);
+		static constexpr Matrix CreateRotationX(float radians) {
+			float sin = 0, cos = 0;
+			MathHelper::SinCos(radians, sin, cos);
+
+			auto rotation = Matrix::Identity();
+			rotation.M22 = cos;
+			rotation.M23 = sin;
+			rotation.M32 = -sin;
+			rotation.M33 = cos;
+			return rotation;
+		}
+
+		static constexpr Matrix CreateRotationY(float radians) {
+			float sin = 0, cos = 0;
+			MathHelper::SinCos(radians, sin, cos);
+
+			auto rotation = Matrix::Identity();
+			rotation.M11 = cos;
+			rotation.M13 = -sin;
+			rotation.M31 = sin;
+			rotation.M33 = cos;
+			return rotation;
+		}
+
+		static constexpr Matrix CreateRotationZ(float radians) {
+			float sin = 0, cos = 0;
+			MathHelper::SinCos(radians, sin, cos);
+
+			auto rotation = Matrix::Identity();
+			rotation.M11 = cos;
+			rotation.M12 = sin;
+			rotation.M21 = -sin;
+			rotation.M22 = cos;
+			return rotation;
+		}
+
+		static constexpr Matrix CreateFromAxisAngle(Vector3 const& axis, float angle) {
+			const auto x = axis.X;
+			const auto y = axis.Y;
+			const auto z = axis.Z;
+			float num1 = 0, num2 = 0;
+			MathHelper::SinCos(angle, num1, num2);
+			const auto num3 = x * x;
+			const auto num4 = y * y;
+			const auto num5 = z * z;
+			const auto num6 = x * y;
+			const auto num7 = x * z;
+			const auto num8 = y * z;
+
+			Matrix fromAxisAngle;
+			fromAxisAngle.M11 = num3 + num2 * (1.0f - num3);
+			fromAxisAngle.M12 = num6 - num2 * num6 + num1 * z;
+			fromAxisAngle.M13 = num7 - num2 * num7 - num1 * y;
+			fromAxisAngle.M14 = 0.0f;
+			fromAxisAngle.M21 = num6 - num2 * num6 - num1 * z;
+			fromAxisAngle.M22 = num4 + num2 * (1.0f - num4);
+			fromAxisAngle.M23 = num8 - num2 * num8 + num1 * x;
+			fromAxisAngle.M24 = 0.0f;
+			fromAxisAngle.M31 = num7 - num2 * num7 + num1 * y;
+			fromAxisAngle.M32 = num8 - num2 * num8 - num1 * x;
+			fromAxisAngle.M33 = num5 + num2 * (1.0f - num5);
+			fromAxisAngle.M34 = 0.0f;
+			fromAxisAngle.M41 = 0.0f;
+			fromAxisAngle.M42 = 0.0f;
+			fromAxisAngle.M43 = 0.0f;
+			fromAxisAngle.M44 = 1.0f;
+			return fromAxisAngle;
+		}
+
+		static constexpr Matrix CreatePerspectiveFieldOfView(
+			float fieldOfView, float aspectRatio, float nearPlaneDistance, float farPlaneDistance) {
+			if (fieldOfView <= 0.0f || fieldOfView >= MathHelper::PI
+				|| nearPlaneDistance <= 0.0 || farPlaneDistance <= 0.0 || nearPlaneDistance >= farPlaneDistance) {
+				return Matrix();
+			}
+
+			const auto num1 = 1.0f / MathHelper::Tan(fieldOfView * 0.5f);
+			const auto num2 = num1 / aspectRatio;
+
+			Matrix perspectiveFieldOfView;
+			perspectiveFieldOfView.M11 = num2;
+			perspectiveFieldOfView.M12 = perspectiveFieldOfView.M13 = perspectiveFieldOfView.M14 = 0.0f;
+			perspectiveFieldOfView.M22 = num1;
+			perspectiveFieldOfView.M21 = perspectiveFieldOfView.M23 = perspectiveFieldOfView.M24 = 0.0f;
+			perspectiveFieldOfView.M31 = perspectiveFieldOfView.M32 = 0.0f;
+			perspectiveFieldOfView.M33 = farPlaneDistance / (nearPlaneDistance - farPlaneDistance);
+			perspectiveFieldOfView.M34 = -1.0f;
+			perspectiveFieldOfView.M41 = perspectiveFieldOfView.M42 = perspectiveFieldOfView.M44 = 0.0f;
+			perspectiveFieldOfView.M43 = nearPlaneDistance * farPlaneDistance / (nearPlaneDistance - farPlaneDistance);
+			return perspectiveFieldOfView;
+		}
 
 		static constexpr Matrix CreatePerspective(
 			float width, float height, float nearPlaneDistance, float farPlaneDistance) {
@@ -1285,17 +1438,80 @@ namespace xna {
 			return orthographicOffCenter;
 		}
 
-		static Matrix CreateLookAt(
-			Vector3 const& cameraPosition, Vector3 const& cameraTarget, Vector3 const& cameraUpVector);
-		static Matrix CreateWorld(
-			Vector3 const& position, Vector3 const& forward, Vector3 const& up);
+		static constexpr Matrix CreateLookAt(
+			Vector3 const& cameraPosition, Vector3 const& cameraTarget, Vector3 const& cameraUpVector) {
+			const auto vector3_1 = Vector3::Normalize(cameraPosition - cameraTarget);
+			const auto vector3_2 = Vector3::Normalize(Vector3::Cross(cameraUpVector, vector3_1));
+			const auto vector1 = Vector3::Cross(vector3_1, vector3_2);
+
+			Matrix lookAt;
+			lookAt.M11 = vector3_2.X;
+			lookAt.M12 = vector1.X;
+			lookAt.M13 = vector3_1.X;
+			lookAt.M14 = 0.0f;
+			lookAt.M21 = vector3_2.Y;
+			lookAt.M22 = vector1.Y;
+			lookAt.M23 = vector3_1.Y;
+			lookAt.M24 = 0.0f;
+			lookAt.M31 = vector3_2.Z;
+			lookAt.M32 = vector1.Z;
+			lookAt.M33 = vector3_1.Z;
+			lookAt.M34 = 0.0f;
+			lookAt.M41 = -Vector3::Dot(vector3_2, cameraPosition);
+			lookAt.M42 = -Vector3::Dot(vector1, cameraPosition);
+			lookAt.M43 = -Vector3::Dot(vector3_1, cameraPosition);
+			lookAt.M44 = 1.0f;
+			return lookAt;
+		}
+
+		static constexpr Matrix CreateWorld(
+			Vector3 const& position, Vector3 const& forward, Vector3 const& up) {
+			const auto vector3_1 = Vector3::Normalize(-forward);
+			const auto vector2 = Vector3::Normalize(Vector3::Cross(up, vector3_1));
+			const auto vector3_2 = Vector3::Cross(vector3_1, vector2);
 
-		static Matrix CreateFromQuaternion(Quaternion const& quaternion);
-		static Matrix CreateFromYawPitchRoll(float yaw, float pitch, float roll);
-		static Matrix CreateShadow(Vector3 lightDirection, Plane plane);
-		static Matrix CreateReflection(Plane value);
-		static Matrix Transform(Matrix value, Quaternion rotation);
-		static Matrix Transpose(Matrix matrix);
+			return Matrix(
+				vector2.X, vector2.Y, vector2.Z, 0.0f,
+				vector3_2.X, vector3_2.Y, vector3_2.Z, 0.0f,
+				vector3_1.X, vector3_1.Y, vector3_1.Z, 0.0f,
+				position.X, position.Y, position.Z, 1.0f);
+		}
+
+		static constexpr Matrix CreateFromQuaternion(Quaternion const& quaternion);
+		//Creates a rotation matrix from every quaternion, for example to fill a skinning palette.
+		//Returns false if destination is smaller than quaternions.
+		static bool CreateFromQuaternion(std::span<const Quaternion> quaternions, std::span<Matrix> destination);
+		static constexpr Matrix CreateFromYawPitchRoll(float yaw, float pitch, float roll);
+		//Defined in collision.hpp with Plane.
+		static constexpr Matrix CreateShadow(Vector3 lightDirection, Plane plane);
+		//Defined in collision.hpp with Plane.
+		static constexpr Matrix CreateReflection(Plane value);
+		static constexpr Matrix Transform(Matrix value, Quaternion rotation);
+
+		static constexpr Matrix Transpose(Matrix matrix) {
+			Matrix result;
+
+			if (!std::is_constant_evaluated() && TransposeVectorized(matrix, result))
+				return result;
+
+			result.M11 = matrix.M11;
+			result.M12 = matrix.M21;
+			result.M13 = matrix.M31;
+			result.M14 = matrix.M41;
+			result.M21 = matrix.M12;
+			result.M22 = matrix.M22;
+			result.M23 = matrix.M32;
+			result.M24 = matrix.M42;
+			result.M31 = matrix.M13;
+			result.M32 = matrix.M23;
+			result.M33 = matrix.M33;
+			result.M34 = matrix.M43;
+			result.M41 = matrix.M14;
+			result.M42 = matrix.M24;
+			result.M43 = matrix.M34;
+			result.M44 = matrix.M44;
+			return result;
+		}
 
 		constexpr float Determinant() const {
 			const auto num1 = (M33 * M44 - M34 * M43);
@@ -1312,6 +1528,13 @@ namespace xna {
 		}
 
 		static constexpr Matrix Invert(Matrix const& matrix) {
+			if (!std::is_constant_evaluated()) {
+				Matrix inverse;
+
+				if (InvertVectorized(matrix, inverse))
+					return inverse;
+			}
+
 			const auto m11 = matrix.M11;
 			const auto m12 = matrix.M12;
 			const auto m13 = matrix.M13;
@@ -1378,6 +1601,74 @@ namespace xna {
 			return matrix1;
 		}
 
+		//Inverts a matrix whose last column is (0, 0, 0, 1), such as any combination of scale, rotation and translation.
+		//Only the upper 3x3 part needs cofactors, which makes it much cheaper than Invert.
+		static constexpr Matrix InvertAffine(Matrix const& matrix) {
+			const auto num1 = matrix.M22 * matrix.M33 - matrix.M23 * matrix.M32;
+			const auto num2 = matrix.M23 * matrix.M31 - matrix.M21 * matrix.M33;
+			const auto num3 = matrix.M21 * matrix.M32 - matrix.M22 * matrix.M31;
+			const auto num4 = 1.0f / (matrix.M11 * num1 + matrix.M12 * num2 + matrix.M13 * num3);
+
+			Matrix matrix1;
+			matrix1.M11 = num1 * num4;
+			matrix1.M21 = num2 * num4;
+			matrix1.M31 = num3 * num4;
+			matrix1.M12 = (matrix.M13 * matrix.M32 - matrix.M12 * matrix.M33) * num4;
+			matrix1.M22 = (matrix.M11 * matrix.M33 - matrix.M13 * matrix.M31) * num4;
+			matrix1.M32 = (matrix.M12 * matrix.M31 - matrix.M11 * matrix.M32) * num4;
+			matrix1.M13 = (matrix.M12 * matrix.M23 - matrix.M13 * matrix.M22) * num4;
+			matrix1.M23 = (matrix.M13 * matrix.M21 - matrix.M11 * matrix.M23) * num4;
+			matrix1.M33 = (matrix.M11 * matrix.M22 - matrix.M12 * matrix.M21) * num4;
+			matrix1.M41 = -(matrix.M41 * matrix1.M11 + matrix.M42 * matrix1.M21 + matrix.M43 * matrix1.M31);
+			matrix1.M42 = -(matrix.M41 * matrix1.M12 + matrix.M42 * matrix1.M22 + matrix.M43 * matrix1.M32);
+			matrix1.M43 = -(matrix.M41 * matrix1.M13 + matrix.M42 * matrix1.M23 + matrix.M43 * matrix1.M33);
+			matrix1.M44 = 1.0f;
+			return matrix1;
+		}
+
+		//Inverts a matrix made only of a rotation and a translation, such as a camera or a rigid body transform.
+		//The rotation is inverted by transposing it, so the result is wrong if the matrix contains scale.
+		static constexpr Matrix InvertOrthonormal(Matrix const& matrix) {
+			Matrix matrix1;
+			matrix1.M11 = matrix.M11;
+			matrix1.M12 = matrix.M21;
+			matrix1.M13 = matrix.M31;
+			matrix1.M21 = matrix.M12;
+			matrix1.M22 = matrix.M22;
+			matrix1.M23 = matrix.M32;
+			matrix1.M31 = matrix.M13;
+			matrix1.M32 = matrix.M23;
+			matrix1.M33 = matrix.M33;
+			matrix1.M41 = -(matrix.M41 * matrix.M11 + matrix.M42 * matrix.M12 + matrix.M43 * matrix.M13);
+			matrix1.M42 = -(matrix.M41 * matrix.M21 + matrix.M42 * matrix.M22 + matrix.M43 * matrix.M23);
+			matrix1.M43 = -(matrix.M41 * matrix.M31 + matrix.M42 * matrix.M32 + matrix.M43 * matrix.M33);
+			matrix1.M44 = 1.0f;
+			return matrix1;
+		}
+
+		//Decompose treats the matrix as singular when the determinant of the upper 3x3 part is at most
+		//this fraction of the product of the row lengths.
+		static constexpr float DecomposeEpsilon = 1e-6f;
+		//Decompose reads the rotation directly from the rows when the cosine of the angle between every two rows
+		//is at most this, and uses the polar decomposition otherwise.
+		static constexpr float OrthogonalTolerance = 1e-5f;
+
+		//Creates the matrix that scales, then rotates, then translates. Same as
+		//CreateScale(scale) * CreateFromQuaternion(rotation) * CreateTranslation(translation), with no products.
+		static constexpr Matrix Compose(Vector3 const& scale, Quaternion const& rotation, Vector3 const& translation);
+
+		//Extracts the scale, rotation and translation of an affine matrix, so that Compose rebuilds it.
+		//A reflection is returned as a negative X scale. When the rows are not orthogonal, because of shear or
+		//non-uniform scale under a rotation, the rotation is the closest one by polar decomposition.
+		//Returns false with the identity rotation if the matrix is singular.
+		constexpr bool Decompose(Vector3& scale, Quaternion& rotation, Vector3& translation) const;
+
+		//Batch versions of Compose and Decompose, vectorized for the orthonormal case. They return the same values as
+		//the single matrix functions, and false if the sources have different sizes or a destination is smaller.
+		//Singular matrices are not reported; they get the identity rotation.
+		static bool Compose(std::span<const Vector3> scales, std::span<const Quaternion> rotations, std::span<const Vector3> translations, std::span<Matrix> destination);
+		static bool Decompose(std::span<const Matrix> matrices, std::span<Vector3> scales, std::span<Quaternion> rotations, std::span<Vector3> translations);
+
 		static constexpr Matrix Lerp(Matrix const& matrix1, Matrix const& matrix2, float amount) {
 			Matrix matrix;
 			matrix.M11 = matrix1.M11 + (matrix2.M11 - matrix1.M11) * amount;
@@ -1464,6 +1755,13 @@ namespace xna {
 
 		static constexpr Matrix Multiply(Matrix const& matrix1, Matrix const& matrix2) {
 			Matrix matrix;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			if (!std::is_constant_evaluated()) {
+				MultiplySse2(matrix1, matrix2, matrix);
+				return matrix;
+			}
+#endif
 			matrix.M11 = (matrix1.M11 * matrix2.M11 + matrix1.M12 * matrix2.M21 + matrix1.M13 * matrix2.M31 + matrix1.M14 * matrix2.M41);
 			matrix.M12 = (matrix1.M11 * matrix2.M12 + matrix1.M12 * matrix2.M22 + matrix1.M13 * matrix2.M32 + matrix1.M14 * matrix2.M42);
 			matrix.M13 = (matrix1.M11 * matrix2.M13 + matrix1.M12 * matrix2.M23 + matrix1.M13 * matrix2.M33 + matrix1.M14 * matrix2.M43);
@@ -1483,6 +1781,10 @@ namespace xna {
 			return matrix;
 		}
 
+		//Multiplies every matrix in matrices by matrix, for example to combine many world matrices with one view projection.
+		//Returns false if destination is smaller than matrices. Destination can be matrices.
+		static bool Multiply(std::span<const Matrix> matrices, Matrix const& matrix, std::span<Matrix> destination);
+
 		static constexpr Matrix Multiply(Matrix const& matrix1, float scaleFactor) {
 			float num = scaleFactor;
 			Matrix matrix;
@@ -1579,6 +1881,37 @@ namespace xna {
 		friend constexpr Matrix operator/(Matrix const& matrix, float divider) {
 			return Matrix::Divide(matrix, divider);
 		}
+
+	private:
+#if defined(CSHARP_INTRINSICS_X86)
+		//Each row of the product is the sum of the rows of matrix2 scaled by the elements of the same row of matrix1,
+		//added in the same order as the scalar code so the results are identical. Kept inline because a call costs
+		//more than the 16 multiplies.
+		CSHARP_TARGET("sse2")
+		static void MultiplySse2(Matrix const& matrix1, Matrix const& matrix2, Matrix& result) {
+			__m128 right[4];
+
+			for (size_t k = 0; k < 4; ++k)
+				right[k] = _mm_load_ps(&matrix2.M11 + k * 4);
+
+			for (size_t k = 0; k < 4; ++k) {
+				const auto row = _mm_load_ps(&matrix1.M11 + k * 4);
+				auto value = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), right[0]);
+				value = _mm_add_ps(value, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), right[1]));
+				value = _mm_add_ps(value, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), right[2]));
+				value = _mm_add_ps(value, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), right[3]));
+				_mm_store_ps(&result.M11 + k * 4, value);
+			}
+		}
+#endif
+		//SIMD cofactor inverse used outside constant evaluation. Returns the same bits as the scalar code,
+		//or false if the processor has no vector path.
+		static bool InvertVectorized(Matrix const& matrix, Matrix& result);
+		//SIMD transpose used outside constant evaluation, or false if the processor has no vector path.
+		static bool TransposeVectorized(Matrix const& matrix, Matrix& result);
+		//Replaces the upper 3x3 part of a matrix with positive determinant by its orthogonal polar factor, with the
+		//scaled Newton iteration X = (gX + X^-T / g) / 2.
+		static constexpr void PolarRotation(Matrix& matrix);
 	};
 
 	struct Quaternion {
@@ -1611,9 +1944,9 @@ namespace xna {
 			return X * X + Y * Y + Z * Z + W * W;
 		}
 
-		inline float Length() const { return std::sqrt(LengthSquared()); }
+		constexpr float Length() const { return MathHelper::Sqrt(LengthSquared()); }
 
-		void Normalize() {
+		constexpr void Normalize() {
 			const auto num = 1.0F / Length();
 			X *= num;
 			Y *= num;
@@ -1621,7 +1954,7 @@ namespace xna {
 			W *= num;
 		}
 
-		static Quaternion Normalize(Quaternion const& quaternion) {
+		static constexpr Quaternion Normalize(Quaternion const& quaternion) {
 			auto q = quaternion;
 			q.Normalize();
 			return q;
@@ -1652,16 +1985,139 @@ namespace xna {
 			return quaternion1;
 		}
 
-		static Quaternion CreateFromAxisAngle(Vector3 const& axis, float angle);
-		static Quaternion CreateFromYawPitchRoll(float yaw, float pitch, float roll);
-		static Quaternion CreateFromRotationMatrix(Matrix const& matrix);
+		static constexpr Quaternion CreateFromAxisAngle(Vector3 const& axis, float angle) {
+			float num2 = 0, num3 = 0;
+			MathHelper::SinCos(angle * 0.5f, num2, num3);
+			Quaternion fromAxisAngle;
+			fromAxisAngle.X = axis.X * num2;
+			fromAxisAngle.Y = axis.Y * num2;
+			fromAxisAngle.Z = axis.Z * num2;
+			fromAxisAngle.W = num3;
+			return fromAxisAngle;
+		}
+
+		static constexpr Quaternion CreateFromYawPitchRoll(float yaw, float pitch, float roll) {
+			float num2 = 0, num3 = 0, num5 = 0, num6 = 0, num8 = 0, num9 = 0;
+			MathHelper::SinCos(roll * 0.5f, num2, num3);
+			MathHelper::SinCos(pitch * 0.5f, num5, num6);
+			MathHelper::SinCos(yaw * 0.5f, num8, num9);
+			Quaternion fromYawPitchRoll;
+			fromYawPitchRoll.X = (num9 * num5 * num3 + num8 * num6 * num2);
+			fromYawPitchRoll.Y = (num8 * num6 * num3 - num9 * num5 * num2);
+			fromYawPitchRoll.Z = (num9 * num6 * num2 - num8 * num5 * num3);
+			fromYawPitchRoll.W = (num9 * num6 * num3 + num8 * num5 * num2);
+			return fromYawPitchRoll;
+		}
+
+		static constexpr Quaternion CreateFromRotationMatrix(Matrix const& matrix) {
+			const auto num1 = matrix.M11 + matrix.M22 + matrix.M33;
+
+			Quaternion fromRotationMatrix;
+			if (num1 > 0.0)
+			{
+				const auto num2 = MathHelper::Sqrt(num1 + 1.0F);
+				fromRotationMatrix.W = num2 * 0.5f;
+				const auto num3 = 0.5f / num2;
+				fromRotationMatrix.X = (matrix.M23 - matrix.M32) * num3;
+				fromRotationMatrix.Y = (matrix.M31 - matrix.M13) * num3;
+				fromRotationMatrix.Z = (matrix.M12 - matrix.M21) * num3;
+			}
+			else if (matrix.M11 >= matrix.M22 && matrix.M11 >= matrix.M33)
+			{
+				const auto num4 = MathHelper::Sqrt(1.0F + matrix.M11 - matrix.M22 - matrix.M33);
+				const auto num5 = 0.5f / num4;
+				fromRotationMatrix.X = 0.5f * num4;
+				fromRotationMatrix.Y = (matrix.M12 + matrix.M21) * num5;
+				fromRotationMatrix.Z = (matrix.M13 + matrix.M31) * num5;
+				fromRotationMatrix.W = (matrix.M23 - matrix.M32) * num5;
+			}
+			else if (matrix.M22 > matrix.M33)
+			{
+				const auto num6 = MathHelper::Sqrt(1.0F + matrix.M22 - matrix.M11 - matrix.M33);
+				const auto num7 = 0.5f / num6;
+				fromRotationMatrix.X = (matrix.M21 + matrix.M12) * num7;
+				fromRotationMatrix.Y = 0.5f * num6;
+				fromRotationMatrix.Z = (matrix.M32 + matrix.M23) * num7;
+				fromRotationMatrix.W = (matrix.M31 - matrix.M13) * num7;
+			}
+			else
+			{
+				const auto num8 = MathHelper::Sqrt(1.0F + matrix.M33 - matrix.M11 - matrix.M22);
+				const auto num9 = 0.5f / num8;
+				fromRotationMatrix.X = (matrix.M31 + matrix.M13) * num9;
+				fromRotationMatrix.Y = (matrix.M32 + matrix.M23) * num9;
+				fromRotationMatrix.Z = 0.5f * num8;
+				fromRotationMatrix.W = (matrix.M12 - matrix.M21) * num9;
+			}
+			return fromRotationMatrix;
+		}
 
 		static constexpr float Dot(Quaternion const& quaternion1, Quaternion const& quaternion2) {
 			return quaternion1.X * quaternion2.X + quaternion1.Y * quaternion2.Y + quaternion1.Z * quaternion2.Z + quaternion1.W * quaternion2.W;
 		}
 
-		static Quaternion Slerp(Quaternion const& quaternion1, Quaternion const& quaternion2, float amount);
-		static Quaternion Lerp(Quaternion const& quaternion1, Quaternion const& quaternion2, float amount);
+		static constexpr Quaternion Slerp(Quaternion const& quaternion1, Quaternion const& quaternion2, float amount) {
+			const auto num1 = amount;
+			auto d = quaternion1.X * quaternion2.X + quaternion1.Y * quaternion2.Y + quaternion1.Z * quaternion2.Z + quaternion1.W * quaternion2.W;
+			bool flag = false;
+
+			if (d < 0.0) {
+				flag = true;
+				d = -d;
+			}
+
+			float num2 = 0;
+			float num3 = 0;
+
+			if (d > 0.99999898672103882) {
+				num2 = 1.0f - num1;
+				num3 = flag ? -num1 : num1;
+			}
+			else {
+				const auto a = MathHelper::Acos(d);
+				const auto num4 = 1.0F / MathHelper::Sin(a);
+				num2 = MathHelper::Sin((1.0F - num1) * a) * num4;
+				num3 = flag ? -MathHelper::Sin(num1 * a) * num4 : MathHelper::Sin(num1 * a) * num4;
+			}
+			Quaternion quaternion;
+			quaternion.X = num2 * quaternion1.X + num3 * quaternion2.X;
+			quaternion.Y = num2 * quaternion1.Y + num3 * quaternion2.Y;
+			quaternion.Z = num2 * quaternion1.Z + num3 * quaternion2.Z;
+			quaternion.W = num2 * quaternion1.W + num3 * quaternion2.W;
+			return quaternion;
+		}
+
+		static constexpr Quaternion Lerp(Quaternion const& quaternion1, Quaternion const& quaternion2, float amount) {
+			const auto num1 = amount;
+			const auto num2 = 1.0f - num1;
+			Quaternion quaternion;
+
+			if (quaternion1.X * quaternion2.X + quaternion1.Y * quaternion2.Y + quaternion1.Z * quaternion2.Z + quaternion1.W * quaternion2.W >= 0.0) {
+				quaternion.X = num2 * quaternion1.X + num1 * quaternion2.X;
+				quaternion.Y = num2 * quaternion1.Y + num1 * quaternion2.Y;
+				quaternion.Z = num2 * quaternion1.Z + num1 * quaternion2.Z;
+				quaternion.W = num2 * quaternion1.W + num1 * quaternion2.W;
+			}
+			else {
+				quaternion.X = num2 * quaternion1.X - num1 * quaternion2.X;
+				quaternion.Y = num2 * quaternion1.Y - num1 * quaternion2.Y;
+				quaternion.Z = num2 * quaternion1.Z - num1 * quaternion2.Z;
+				quaternion.W = num2 * quaternion1.W - num1 * quaternion2.W;
+			}
+			const auto num3 = 1.0f / MathHelper::Sqrt(quaternion.X * quaternion.X + quaternion.Y * quaternion.Y + quaternion.Z * quaternion.Z + quaternion.W * quaternion.W);
+			quaternion.X *= num3;
+			quaternion.Y *= num3;
+			quaternion.Z *= num3;
+			quaternion.W *= num3;
+			return quaternion;
+		}
+
+		//Batch versions over arrays of quaternions, for example to blend two animation poses. They return the same values
+		//as the single quaternion functions, and false if the sources have different sizes or destination is smaller.
+		//Destination can be one of the sources.
+		static bool Normalize(std::span<const Quaternion> source, std::span<Quaternion> destination);
+		static bool Slerp(std::span<const Quaternion> quaternions1, std::span<const Quaternion> quaternions2, float amount, std::span<Quaternion> destination);
+		static bool Lerp(std::span<const Quaternion> quaternions1, std::span<const Quaternion> quaternions2, float amount, std::span<Quaternion> destination);
 
 		static constexpr Quaternion Concatenate(Quaternion const& value1, Quaternion const& value2) {
 			const auto x1 = value2.X;
@@ -1792,6 +2248,229 @@ namespace xna {
 		}
 	};
 
+	constexpr Matrix Matrix::CreateFromQuaternion(Quaternion const& quaternion) {
+		const auto num1 = quaternion.X * quaternion.X;
+		const auto num2 = quaternion.Y * quaternion.Y;
+		const auto num3 = quaternion.Z * quaternion.Z;
+		const auto num4 = quaternion.X * quaternion.Y;
+		const auto num5 = quaternion.Z * quaternion.W;
+		const auto num6 = quaternion.Z * quaternion.X;
+		const auto num7 = quaternion.Y * quaternion.W;
+		const auto num8 = quaternion.Y * quaternion.Z;
+		const auto num9 = quaternion.X * quaternion.W;
+
+		Matrix fromQuaternion;
+		fromQuaternion.M11 = 1.0f - 2.0f * (num2 + num3);
+		fromQuaternion.M12 = 2.0f * (num4 + num5);
+		fromQuaternion.M13 = 2.0f * (num6 - num7);
+		fromQuaternion.M14 = 0.0f;
+		fromQuaternion.M21 = 2.0f * (num4 - num5);
+		fromQuaternion.M22 = 1.0f - 2.0f * (num3 + num1);
+		fromQuaternion.M23 = 2.0f * (num8 + num9);
+		fromQuaternion.M24 = 0.0f;
+		fromQuaternion.M31 = 2.0f * (num6 + num7);
+		fromQuaternion.M32 = 2.0f * (num8 - num9);
+		fromQuaternion.M33 = 1.0f - 2.0f * (num2 + num1);
+		fromQuaternion.M34 = 0.0f;
+		fromQuaternion.M41 = 0.0f;
+		fromQuaternion.M42 = 0.0f;
+		fromQuaternion.M43 = 0.0f;
+		fromQuaternion.M44 = 1.0f;
+		return fromQuaternion;
+	}
+
+	constexpr Matrix Matrix::Compose(Vector3 const& scale, Quaternion const& rotation, Vector3 const& translation) {
+		const auto num1 = rotation.X * rotation.X;
+		const auto num2 = rotation.Y * rotation.Y;
+		const auto num3 = rotation.Z * rotation.Z;
+		const auto num4 = rotation.X * rotation.Y;
+		const auto num5 = rotation.Z * rotation.W;
+		const auto num6 = rotation.Z * rotation.X;
+		const auto num7 = rotation.Y * rotation.W;
+		const auto num8 = rotation.Y * rotation.Z;
+		const auto num9 = rotation.X * rotation.W;
+
+		Matrix composed;
+		composed.M11 = (1.0f - 2.0f * (num2 + num3)) * scale.X;
+		composed.M12 = (2.0f * (num4 + num5)) * scale.X;
+		composed.M13 = (2.0f * (num6 - num7)) * scale.X;
+		composed.M14 = 0.0f;
+		composed.M21 = (2.0f * (num4 - num5)) * scale.Y;
+		composed.M22 = (1.0f - 2.0f * (num3 + num1)) * scale.Y;
+		composed.M23 = (2.0f * (num8 + num9)) * scale.Y;
+		composed.M24 = 0.0f;
+		composed.M31 = (2.0f * (num6 + num7)) * scale.Z;
+		composed.M32 = (2.0f * (num8 - num9)) * scale.Z;
+		composed.M33 = (1.0f - 2.0f * (num2 + num1)) * scale.Z;
+		composed.M34 = 0.0f;
+		composed.M41 = translation.X;
+		composed.M42 = translation.Y;
+		composed.M43 = translation.Z;
+		composed.M44 = 1.0f;
+		return composed;
+	}
+
+	constexpr bool Matrix::Decompose(Vector3& scale, Quaternion& rotation, Vector3& translation) const {
+		translation = Vector3(M41, M42, M43);
+
+		auto scaleX = MathHelper::Sqrt(M11 * M11 + M12 * M12 + M13 * M13);
+		const auto scaleY = MathHelper::Sqrt(M21 * M21 + M22 * M22 + M23 * M23);
+		const auto scaleZ = MathHelper::Sqrt(M31 * M31 + M32 * M32 + M33 * M33);
+		const auto determinant = M11 * (M22 * M33 - M23 * M32) - M12 * (M21 * M33 - M23 * M31) + M13 * (M21 * M32 - M22 * M31);
+
+		if (determinant < 0.0f)
+			scaleX = -scaleX;
+
+		scale = Vector3(scaleX, scaleY, scaleZ);
+
+		if (!(MathHelper::Abs(determinant) > DecomposeEpsilon * MathHelper::Abs(scaleX * scaleY * scaleZ))) {
+			rotation = Quaternion::Identity();
+			return false;
+		}
+
+		const auto dot12 = M11 * M21 + M12 * M22 + M13 * M23;
+		const auto dot13 = M11 * M31 + M12 * M32 + M13 * M33;
+		const auto dot23 = M21 * M31 + M22 * M32 + M23 * M33;
+
+		if (MathHelper::Abs(dot12) <= OrthogonalTolerance * MathHelper::Abs(scaleX * scaleY)
+			&& MathHelper::Abs(dot13) <= OrthogonalTolerance * MathHelper::Abs(scaleX * scaleZ)
+			&& MathHelper::Abs(dot23) <= OrthogonalTolerance * MathHelper::Abs(scaleY * scaleZ)) {
+			const auto inverseX = 1.0f / scaleX;
+			const auto inverseY = 1.0f / scaleY;
+			const auto inverseZ = 1.0f / scaleZ;
+
+			Matrix orthonormal;
+			orthonormal.M11 = M11 * inverseX;
+			orthonormal.M12 = M12 * inverseX;
+			orthonormal.M13 = M13 * inverseX;
+			orthonormal.M21 = M21 * inverseY;
+			orthonormal.M22 = M22 * inverseY;
+			orthonormal.M23 = M23 * inverseY;
+			orthonormal.M31 = M31 * inverseZ;
+			orthonormal.M32 = M32 * inverseZ;
+			orthonormal.M33 = M33 * inverseZ;
+			rotation = Quaternion::CreateFromRotationMatrix(orthonormal);
+			return true;
+		}
+
+		//M = P * U with P symmetric: U is the rotation and the diagonal of P = M * U^T is the scale.
+		//A reflection is moved out of the first row first so that U is a rotation.
+		const auto sign = determinant < 0.0f ? -1.0f : 1.0f;
+		auto polar = *this;
+		polar.M11 *= sign;
+		polar.M12 *= sign;
+		polar.M13 *= sign;
+		PolarRotation(polar);
+
+		scale.X = M11 * polar.M11 + M12 * polar.M12 + M13 * polar.M13;
+		scale.Y = M21 * polar.M21 + M22 * polar.M22 + M23 * polar.M23;
+		scale.Z = M31 * polar.M31 + M32 * polar.M32 + M33 * polar.M33;
+		rotation = Quaternion::CreateFromRotationMatrix(polar);
+		return true;
+	}
+
+	constexpr void Matrix::PolarRotation(Matrix& matrix) {
+		auto x = matrix;
+
+		for (size_t iteration = 0; iteration < 20; ++iteration) {
+			//Cofactors, so X^-T = cofactors / determinant.
+			const auto c11 = x.M22 * x.M33 - x.M23 * x.M32;
+			const auto c12 = x.M23 * x.M31 - x.M21 * x.M33;
+			const auto c13 = x.M21 * x.M32 - x.M22 * x.M31;
+			const auto c21 = x.M13 * x.M32 - x.M12 * x.M33;
+			const auto c22 = x.M11 * x.M33 - x.M13 * x.M31;
+			const auto c23 = x.M12 * x.M31 - x.M11 * x.M32;
+			const auto c31 = x.M12 * x.M23 - x.M13 * x.M22;
+			const auto c32 = x.M13 * x.M21 - x.M11 * x.M23;
+			const auto c33 = x.M11 * x.M22 - x.M12 * x.M21;
+			const auto determinant = x.M11 * c11 + x.M12 * c12 + x.M13 * c13;
+
+			//g = sqrt(|X^-1| / |X|) with Frobenius norms balances the two terms and speeds up convergence.
+			const auto normX = x.M11 * x.M11 + x.M12 * x.M12 + x.M13 * x.M13 + x.M21 * x.M21 + x.M22 * x.M22
+				+ x.M23 * x.M23 + x.M31 * x.M31 + x.M32 * x.M32 + x.M33 * x.M33;
+			const auto normC = c11 * c11 + c12 * c12 + c13 * c13 + c21 * c21 + c22 * c22 + c23 * c23 + c31 * c31 + c32 * c32 + c33 * c33;
+			const auto gamma = MathHelper::Sqrt(MathHelper::Sqrt(normC / normX) / MathHelper::Abs(determinant));
+			const auto a = 0.5f * gamma;
+			const auto b = 0.5f / (gamma * determinant);
+
+			Matrix next;
+			next.M11 = a * x.M11 + b * c11;
+			next.M12 = a * x.M12 + b * c12;
+			next.M13 = a * x.M13 + b * c13;
+			next.M21 = a * x.M21 + b * c21;
+			next.M22 = a * x.M22 + b * c22;
+			next.M23 = a * x.M23 + b * c23;
+			next.M31 = a * x.M31 + b * c31;
+			next.M32 = a * x.M32 + b * c32;
+			next.M33 = a * x.M33 + b * c33;
+
+			const auto change = MathHelper::Abs(next.M11 - x.M11) + MathHelper::Abs(next.M12 - x.M12) + MathHelper::Abs(next.M13 - x.M13)
+				+ MathHelper::Abs(next.M21 - x.M21) + MathHelper::Abs(next.M22 - x.M22) + MathHelper::Abs(next.M23 - x.M23)
+				+ MathHelper::Abs(next.M31 - x.M31) + MathHelper::Abs(next.M32 - x.M32) + MathHelper::Abs(next.M33 - x.M33);
+			x = next;
+
+			if (change <= 1e-6f)
+				break;
+		}
+
+		matrix.M11 = x.M11;
+		matrix.M12 = x.M12;
+		matrix.M13 = x.M13;
+		matrix.M21 = x.M21;
+		matrix.M22 = x.M22;
+		matrix.M23 = x.M23;
+		matrix.M31 = x.M31;
+		matrix.M32 = x.M32;
+		matrix.M33 = x.M33;
+	}
+
+	constexpr Matrix Matrix::CreateFromYawPitchRoll(float yaw, float pitch, float roll) {
+		return Matrix::CreateFromQuaternion(Quaternion::CreateFromYawPitchRoll(yaw, pitch, roll));
+	}
+
+	constexpr Matrix Matrix::Transform(Matrix value, Quaternion rotation) {
+		const auto num1 = rotation.X + rotation.X;
+		const auto num2 = rotation.Y + rotation.Y;
+		const auto num3 = rotation.Z + rotation.Z;
+		const auto num4 = rotation.W * num1;
+		const auto num5 = rotation.W * num2;
+		const auto num6 = rotation.W * num3;
+		const auto num7 = rotation.X * num1;
+		const auto num8 = rotation.X * num2;
+		const auto num9 = rotation.X * num3;
+		const auto num10 = rotation.Y * num2;
+		const auto num11 = rotation.Y * num3;
+		const auto num12 = rotation.Z * num3;
+		const auto num13 = 1.0f - num10 - num12;
+		const auto num14 = num8 - num6;
+		const auto num15 = num9 + num5;
+		const auto num16 = num8 + num6;
+		const auto num17 = 1.0f - num7 - num12;
+		const auto num18 = num11 - num4;
+		const auto num19 = num9 - num5;
+		const auto num20 = num11 + num4;
+		const auto num21 = 1.0f - num7 - num10;
+
+		Matrix matrix;
+		matrix.M11 = value.M11 * num13 + value.M12 * num14 + value.M13 * num15;
+		matrix.M12 = value.M11 * num16 + value.M12 * num17 + value.M13 * num18;
+		matrix.M13 = value.M11 * num19 + value.M12 * num20 + value.M13 * num21;
+		matrix.M14 = value.M14;
+		matrix.M21 = value.M21 * num13 + value.M22 * num14 + value.M23 * num15;
+		matrix.M22 = value.M21 * num16 + value.M22 * num17 + value.M23 * num18;
+		matrix.M23 = value.M21 * num19 + value.M22 * num20 + value.M23 * num21;
+		matrix.M24 = value.M24;
+		matrix.M31 = value.M31 * num13 + value.M32 * num14 + value.M33 * num15;
+		matrix.M32 = value.M31 * num16 + value.M32 * num17 + value.M33 * num18;
+		matrix.M33 = value.M31 * num19 + value.M32 * num20 + value.M33 * num21;
+		matrix.M34 = value.M34;
+		matrix.M41 = value.M41 * num13 + value.M42 * num14 + value.M43 * num15;
+		matrix.M42 = value.M41 * num16 + value.M42 * num17 + value.M43 * num18;
+		matrix.M43 = value.M41 * num19 + value.M42 * num20 + value.M43 * num21;
+		matrix.M44 = value.M44;
+		return matrix;
+	}
+
 	constexpr Vector2 Vector2::Transform(Vector2 const& position, Matrix const& matrix) {
 		const auto posx = (position.X * matrix.M11 + position.Y * matrix.M21) + matrix.M41;
 		const auto posy = (position.X * matrix.M12 + position.Y * matrix.M22) + matrix.M42;
@@ -2,7 +2,10 @@
 #define CXNA_COMMON_PACKEDVECTOR_HPP
 
 #include "numerics.hpp"
+#include <bit>
 #include <cmath>
+#include <cstdint>
+#include <span>
 
 namespace xna {
 	class IPackedVector {
@@ -50,6 +53,297 @@ namespace xna {
 		static uint32_t PackSNorm(uint32_t bitmask, float value);
 		static double ClampAndRound(float value, float min, float max);
 	};
+
+	//Converts between 32-bit floats and IEEE 754 half precision floats.
+	struct HalfUtils {
+		//Rounds to the nearest half, ties to even. Magnitudes above 65504, including infinity, pack to 65504
+		//and NaN packs to 0x7FFF, both keeping the sign.
+		static uint16_t Pack(float value);
+
+		static constexpr float Unpack(uint16_t value) {
+			const auto sign = static_cast<uint32_t>(value & 0x8000) << 16;
+			const auto exponent = (value >> 10) & 0x1F;
+			const auto mantissa = static_cast<uint32_t>(value & 0x3FF);
+
+			if (exponent == 0) {
+				const auto magnitude = static_cast<float>(mantissa) * 5.96046448e-8f;
+				return std::bit_cast<float>(std::bit_cast<uint32_t>(magnitude) | sign);
+			}
+
+			if (exponent == 0x1F)
+				return std::bit_cast<float>(sign | 0x7F800000U | (mantissa != 0 ? 0x00400000U : 0U) | mantissa << 13);
+
+			return std::bit_cast<float>(sign | static_cast<uint32_t>(exponent + 112) << 23 | mantissa << 13);
+		}
+	};
+
+	//Packed vector types for compact vertex and texture data. The bulk Pack and Unpack functions convert whole arrays
+	//of packed values with SIMD and return the same values as the single vector functions. They return false if
+	//destination is smaller than the source.
+
+	//Packed vector type containing two 16-bit floating-point values.
+	struct HalfVector2 : public IPackedVector, public IPackedVectorT<uint32_t> {
+		constexpr HalfVector2() = default;
+		HalfVector2(float x, float y);
+		HalfVector2(Vector2 const& vector);
+
+		//Expands the packed representation into a Vector2.
+		constexpr Vector2 ToVector2() const {
+			return { HalfUtils::Unpack(static_cast<uint16_t>(_packedValue)), HalfUtils::Unpack(static_cast<uint16_t>(_packedValue >> 16)) };
+		}
+
+		constexpr virtual Vector4 ToVector4() const override {
+			const auto vector2 = ToVector2();
+			return { vector2.X, vector2.Y, 0.0f, 1.0f };
+		}
+
+		virtual void PackFromVector4(Vector4 const& vector) override;
+
+		virtual constexpr uint32_t PackedValue() const override { return _packedValue; }
+		virtual constexpr void PackedValue(uint32_t const& value) override { _packedValue = value; }
+
+		constexpr bool operator==(HalfVector2 const& other) const { return _packedValue == other._packedValue; }
+
+		static bool Pack(std::span<const Vector2> vectors, std::span<uint32_t> destination);
+		static bool Unpack(std::span<const uint32_t> values, std::span<Vector2> destination);
+
+	private:
+		uint32_t _packedValue{ 0 };
+	};
+
+	//Packed vector type containing four 16-bit floating-point values.
+	struct HalfVector4 : public IPackedVector, public IPackedVectorT<uint64_t> {
+		constexpr HalfVector4() = default;
+		HalfVector4(float x, float y, float z, float w);
+		HalfVector4(Vector4 const& vector);
+
+		constexpr virtual Vector4 ToVector4() const override {
+			return {
+				HalfUtils::Unpack(static_cast<uint16_t>(_packedValue)),
+				HalfUtils::Unpack(static_cast<uint16_t>(_packedValue >> 16)),
+				HalfUtils::Unpack(static_cast<uint16_t>(_packedValue >> 32)),
+				HalfUtils::Unpack(static_cast<uint16_t>(_packedValue >> 48)) };
+		}
+
+		virtual void PackFromVector4(Vector4 const& vector) override;
+
+		virtual constexpr uint64_t PackedValue() const override { return _packedValue; }
+		virtual constexpr void PackedValue(uint64_t const& value) override { _packedValue = value; }
+
+		constexpr bool operator==(HalfVector4 const& other) const { return _packedValue == other._packedValue; }
+
+		static bool Pack(std::span<const Vector4> vectors, std::span<uint64_t> destination);
+		static bool Unpack(std::span<const uint64_t> values, std::span<Vector4> destination);
+
+	private:
+		uint64_t _packedValue{ 0 };
+	};
+
+	//Packed vector type containing four 8-bit signed normalized values, ranging from -1 to 1.
+	struct NormalizedByte4 : public IPackedVector, public IPackedVectorT<uint32_t> {
+		constexpr NormalizedByte4() = default;
+		NormalizedByte4(float x, float y, float z, float w);
+		NormalizedByte4(Vector4 const& vector);
+
+		constexpr virtual Vector4 ToVector4() const override {
+			return {
+				PackUtils::UnpackSNorm(0xFF, _packedValue),
+				PackUtils::UnpackSNorm(0xFF, _packedValue >> 8),
+				PackUtils::UnpackSNorm(0xFF, _packedValue >> 16),
+				PackUtils::UnpackSNorm(0xFF, _packedValue >> 24) };
+		}
+
+		virtual void PackFromVector4(Vector4 const& vector) override;
+
+		virtual constexpr uint32_t PackedValue() const override { return _packedValue; }
+		virtual constexpr void PackedValue(uint32_t const& value) override { _packedValue = value; }
+
+		constexpr bool operator==(NormalizedByte4 const& other) const { return _packedValue == other._packedValue; }
+
+		static bool Pack(std::span<const Vector4> vectors, std::span<uint32_t> destination);
+		static bool Unpack(std::span<const uint32_t> values, std::span<Vector4> destination);
+
+	private:
+		uint32_t _packedValue{ 0 };
+	};
+
+	//Packed vector type containing two 16-bit signed normalized values, ranging from -1 to 1.
+	struct NormalizedShort2 : public IPackedVector, public IPackedVectorT<uint32_t> {
+		constexpr NormalizedShort2() = default;
+		NormalizedShort2(float x, float y);
+		NormalizedShort2(Vector2 const& vector);
+
+		//Expands the packed representation into a Vector2.
+		constexpr Vector2 ToVector2() const {
+			return { PackUtils::UnpackSNorm(0xFFFF, _packedValue), PackUtils::UnpackSNorm(0xFFFF, _packedValue >> 16) };
+		}
+
+		constexpr virtual Vector4 ToVector4() const override {
+			const auto vector2 = ToVector2();
+			return { vector2.X, vector2.Y, 0.0f, 1.0f };
+		}
+
+		virtual void PackFromVector4(Vector4 const& vector) override;
+
+		virtual constexpr uint32_t PackedValue() const override { return _packedValue; }
+		virtual constexpr void PackedValue(uint32_t const& value) override { _packedValue = value; }
+
+		constexpr bool operator==(NormalizedShort2 const& other) const { return _packedValue == other._packedValue; }
+
+		static bool Pack(std::span<const Vector2> vectors, std::span<uint32_t> destination);
+		static bool Unpack(std::span<const uint32_t> values, std::span<Vector2> destination);
+
+	private:
+		uint32_t _packedValue{ 0 };
+	};
+
+	//Packed vector type containing four 16-bit signed normalized values, ranging from -1 to 1.
+	struct NormalizedShort4 : public IPackedVector, public IPackedVectorT<uint64_t> {
+		constexpr NormalizedShort4() = default;
+		NormalizedShort4(float x, float y, float z, float w);
+		NormalizedShort4(Vector4 const& vector);
+
+		constexpr virtual Vector4 ToVector4() const override {
+			return {
+				PackUtils::UnpackSNorm(0xFFFF, static_cast<uint32_t>(_packedValue)),
+				PackUtils::UnpackSNorm(0xFFFF, static_cast<uint32_t>(_packedValue >> 16)),
+				PackUtils::UnpackSNorm(0xFFFF, static_cast<uint32_t>(_packedValue >> 32)),
+				PackUtils::UnpackSNorm(0xFFFF, static_cast<uint32_t>(_packedValue >> 48)) };
+		}
+
+		virtual void PackFromVector4(Vector4 const& vector) override;
+
+		virtual constexpr uint64_t PackedValue() const override { return _packedValue; }
+		virtual constexpr void PackedValue(uint64_t const& value) override { _packedValue = value; }
+
+		constexpr bool operator==(NormalizedShort4 const& other) const { return _packedValue == other._packedValue; }
+
+		static bool Pack(std::span<const Vector4> vectors, std::span<uint64_t> destination);
+		static bool Unpack(std::span<const uint64_t> values, std::span<Vector4> destination);
+
+	private:
+		uint64_t _packedValue{ 0 };
+	};
+
+	//Packed vector type containing four 16-bit signed integer values.
+	struct Short4 : public IPackedVector, public IPackedVectorT<uint64_t> {
+		constexpr Short4() = default;
+		Short4(float x, float y, float z, float w);
+		Short4(Vector4 const& vector);
+
+		constexpr virtual Vector4 ToVector4() const override {
+			return {
+				static_cast<float>(static_cast<int16_t>(_packedValue)),
+				static_cast<float>(static_cast<int16_t>(_packedValue >> 16)),
+				static_cast<float>(static_cast<int16_t>(_packedValue >> 32)),
+				static_cast<float>(static_cast<int16_t>(_packedValue >> 48)) };
+		}
+
+		virtual void PackFromVector4(Vector4 const& vector) override;
+
+		virtual constexpr uint64_t PackedValue() const override { return _packedValue; }
+		virtual constexpr void PackedValue(uint64_t const& value) override { _packedValue = value; }
+
+		constexpr bool operator==(Short4 const& other) const { return _packedValue == other._packedValue; }
+
+		static bool Pack(std::span<const Vector4> vectors, std::span<uint64_t> destination);
+		static bool Unpack(std::span<const uint64_t> values, std::span<Vector4> destination);
+
+	private:
+		uint64_t _packedValue{ 0 };
+	};
+
+	//Packed vector type containing unsigned normalized values ranging from 0 to 1.
+	//The x, y and z components use 5 bits, and the w component uses 1 bit.
+	struct Bgra5551 : public IPackedVector, public IPackedVectorT<uint16_t> {
+		constexpr Bgra5551() = default;
+		Bgra5551(float x, float y, float z, float w);
+		Bgra5551(Vector4 const& vector);
+
+		constexpr virtual Vector4 ToVector4() const override {
+			return {
+				PackUtils::UnpackUNorm(0x1F, static_cast<uint32_t>(_packedValue >> 10)),
+				PackUtils::UnpackUNorm(0x1F, static_cast<uint32_t>(_packedValue >> 5)),
+				PackUtils::UnpackUNorm(0x1F, static_cast<uint32_t>(_packedValue)),
+				PackUtils::UnpackUNorm(0x01, static_cast<uint32_t>(_packedValue >> 15)) };
+		}
+
+		virtual void PackFromVector4(Vector4 const& vector) override;
+
+		virtual constexpr uint16_t PackedValue() const override { return _packedValue; }
+		virtual constexpr void PackedValue(uint16_t const& value) override { _packedValue = value; }
+
+		constexpr bool operator==(Bgra5551 const& other) const { return _packedValue == other._packedValue; }
+
+		static bool Pack(std::span<const Vector4> vectors, std::span<uint16_t> destination);
+		static bool Unpack(std::span<const uint16_t> values, std::span<Vector4> destination);
+
+	private:
+		uint16_t _packedValue{ 0 };
+	};
+
+	//Packed vector type containing unsigned normalized values ranging from 0 to 1.
+	//The x and z components use 5 bits, and the y component uses 6 bits.
+	struct Bgr565 : public IPackedVector, public IPackedVectorT<uint16_t> {
+		constexpr Bgr565() = default;
+		Bgr565(float x, float y, float z);
+		Bgr565(Vector3 const& vector);
+
+		//Expands the packed representation into a Vector3.
+		constexpr Vector3 ToVector3() const {
+			return {
+				PackUtils::UnpackUNorm(0x1F, static_cast<uint32_t>(_packedValue >> 11)),
+				PackUtils::UnpackUNorm(0x3F, static_cast<uint32_t>(_packedValue >> 5)),
+				PackUtils::UnpackUNorm(0x1F, static_cast<uint32_t>(_packedValue)) };
+		}
+
+		constexpr virtual Vector4 ToVector4() const override {
+			const auto vector3 = ToVector3();
+			return { vector3.X, vector3.Y, vector3.Z, 1.0f };
+		}
+
+		virtual void PackFromVector4(Vector4 const& vector) override;
+
+		virtual constexpr uint16_t PackedValue() const override { return _packedValue; }
+		virtual constexpr void PackedValue(uint16_t const& value) override { _packedValue = value; }
+
+		constexpr bool operator==(Bgr565 const& other) const { return _packedValue == other._packedValue; }
+
+		static bool Pack(std::span<const Vector3> vectors, std::span<uint16_t> destination);
+		static bool Unpack(std::span<const uint16_t> values, std::span<Vector3> destination);
+
+	private:
+		uint16_t _packedValue{ 0 };
+	};
+
+	//Packed vector type containing unsigned normalized values ranging from 0 to 1.
+	//The x, y and z components use 10 bits, and the w component uses 2 bits.
+	struct Rgba1010102 : public IPackedVector, public IPackedVectorT<uint32_t> {
+		constexpr Rgba1010102() = default;
+		Rgba1010102(float x, float y, float z, float w);
+		Rgba1010102(Vector4 const& vector);
+
+		constexpr virtual Vector4 ToVector4() const override {
+			return {
+				PackUtils::UnpackUNorm(0x3FF, _packedValue),
+				PackUtils::UnpackUNorm(0x3FF, _packedValue >> 10),
+				PackUtils::UnpackUNorm(0x3FF, _packedValue >> 20),
+				PackUtils::UnpackUNorm(0x03, _packedValue >> 30) };
+		}
+
+		virtual void PackFromVector4(Vector4 const& vector) override;
+
+		virtual constexpr uint32_t PackedValue() const override { return _packedValue; }
+		virtual constexpr void PackedValue(uint32_t const& value) override { _packedValue = value; }
+
+		constexpr bool operator==(Rgba1010102 const& other) const { return _packedValue == other._packedValue; }
+
+		static bool Pack(std::span<const Vector4> vectors, std::span<uint32_t> destination);
+		static bool Unpack(std::span<const uint32_t> values, std::span<Vector4> destination);
+
+	private:
+		uint32_t _packedValue{ 0 };
+	};
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+#ifndef XNA_COMMON_SOA_HPP
+#define XNA_COMMON_SOA_HPP
+
+#include "numerics.hpp"
+#include "csharp/buffers/alignedallocator.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace xna {
+	//Stores vectors as a structure of arrays: one contiguous, 64-byte aligned stream per component.
+	//Batch operations then work on 8 (AVX2) or 16 (AVX-512) vectors per instruction with no shuffling,
+	//so data that is processed every frame, such as particle positions, can be kept resident in this form.
+	//Every stream is padded to a multiple of LaneCount floats.
+	template <typename T>
+	class VectorSoA {
+	public:
+		static constexpr size_t Components = sizeof(T) / sizeof(float);
+		static constexpr size_t LaneCount = 16;
+		static constexpr size_t Alignment = 64;
+
+		static_assert(Components == 3 || Components == 4, "VectorSoA supports Vector3 and Vector4.");
+
+		constexpr VectorSoA() = default;
+
+		explicit VectorSoA(size_t count) {
+			Resize(count);
+		}
+
+		VectorSoA(T const* values, size_t count) {
+			CopyFrom(values, count);
+		}
+
+		VectorSoA(std::vector<T> const& values) {
+			CopyFrom(values.data(), values.size());
+		}
+
+		//Gets the number of vectors.
+		constexpr size_t Count() const { return count; }
+		//Gets the number of floats allocated per component, a multiple of LaneCount.
+		constexpr size_t Capacity() const { return capacity; }
+		constexpr bool Empty() const { return count == 0; }
+
+		//Changes the number of vectors. Existing vectors are kept and new ones are zero.
+		void Resize(size_t newCount);
+		//Makes room for at least minimumCount vectors without changing the count.
+		void Reserve(size_t minimumCount);
+		//Removes all vectors and keeps the storage.
+		void Clear() { count = 0; }
+		//Appends a vector.
+		void Add(T const& value);
+
+		//Gets the vector at the specified index.
+		T Get(size_t index) const;
+		//Sets the vector at the specified index.
+		void Set(size_t index, T const& value);
+
+		//Gets the X stream.
+		float* X() { return Stream(0); }
+		float const* X() const { return Stream(0); }
+		//Gets the Y stream.
+		float* Y() { return Stream(1); }
+		float const* Y() const { return Stream(1); }
+		//Gets the Z stream.
+		float* Z() { return Stream(2); }
+		float const* Z() const { return Stream(2); }
+		//Gets the W stream.
+		float* W() requires (Components == 4) { return Stream(3); }
+		float const* W() const requires (Components == 4) { return Stream(3); }
+
+		//Gets the stream of the specified component, 0 for X up to Components - 1.
+		float* Stream(size_t component) { return data.data() + component * capacity; }
+		float const* Stream(size_t component) const { return data.data() + component * capacity; }
+
+		//Replaces the contents with count vectors from an array.
+		void CopyFrom(T const* values, size_t count);
+		//Copies the vectors to an array. Returns false if the destination is too small.
+		bool CopyTo(T* destinationArray, size_t destinationLength) const;
+		//Copies the vectors to a new array.
+		std::vector<T> ToArray() const;
+
+		//Returns a vector that contains the lowest value of every component.
+		T Min() const;
+		//Returns a vector that contains the highest value of every component.
+		T Max() const;
+
+		//Transforms the vectors by a matrix. The destination is resized to the source count and can be the source.
+		static void Transform(VectorSoA const& source, Matrix const& matrix, VectorSoA& destination);
+		//Transforms the normals by a matrix, ignoring the translation. The destination is resized to the source count and can be the source.
+		static void TransformNormal(VectorSoA const& source, Matrix const& matrix, VectorSoA& destination) requires (Components == 3);
+		//Calculates the dot product of every pair of vectors into result, which must hold value1.Count() floats.
+		//Returns false if the counts differ.
+		static bool Dot(VectorSoA const& value1, VectorSoA const& value2, float* result);
+		//Calculates the dot product of every vector and value2 into result, which must hold value1.Count() floats.
+		static void Dot(VectorSoA const& value1, T const& value2, float* result);
+		//Normalizes the vectors. The destination is resized to the source count and can be the source.
+		static void Normalize(VectorSoA const& source, VectorSoA& destination);
+		//Performs a linear interpolation between every pair of vectors. Returns false if the counts differ.
+		//The destination is resized to the source count and can be either source.
+		static bool Lerp(VectorSoA const& value1, VectorSoA const& value2, float amount, VectorSoA& destination);
+		//Calculates the distance between every pair of vectors into result. Returns false if the counts differ.
+		static bool Distance(VectorSoA const& value1, VectorSoA const& value2, float* result);
+		//Calculates the distance between every vector and value2 into result.
+		static void Distance(VectorSoA const& value1, T const& value2, float* result);
+		//Calculates the squared distance between every pair of vectors into result. Returns false if the counts differ.
+		static bool DistanceSquared(VectorSoA const& value1, VectorSoA const& value2, float* result);
+		//Calculates the squared distance between every vector and value2 into result.
+		static void DistanceSquared(VectorSoA const& value1, T const& value2, float* result);
+
+	private:
+		size_t count{ 0 };
+		size_t capacity{ 0 };
+		std::vector<float, csharp::AlignedAllocator<float, Alignment>> data;
+	};
+
+	using Vector3SoA = VectorSoA<Vector3>;
+	using Vector4SoA = VectorSoA<Vector4>;
+
+	extern template class VectorSoA<Vector3>;
+	extern template class VectorSoA<Vector4>;
+}
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef XNA_COMMON_SPATIALHASH_HPP
+#define XNA_COMMON_SPATIALHASH_HPP
+
+#include "numerics.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace xna {
+	//Uniform grid of square cells over the plane for broadphase queries of Rectangle proxies. Only the cells that hold proxies
+	//are stored, in an open addressing table. A cell keeps its first proxies in place and the others in fixed size chunks taken from one array.
+	//A proxy is listed in every cell its rectangle overlaps, so the cell size should be about the size of the common rectangles.
+	//Queries test the rectangles and hand the proxies to a callback. The hash must not be changed from inside a callback.
+	class SpatialHash {
+	public:
+		//Proxy returned for no proxy.
+		static constexpr size_t NullProxy = static_cast<size_t>(-1);
+		//Width and height of the cells when no size is specified.
+		static constexpr int32_t DefaultCellSize = 64;
+
+		//Creates an empty hash. cellSize must be greater than 0.
+		explicit SpatialHash(int32_t cellSize = DefaultCellSize);
+
+		//Gets the width and height of the cells.
+		int32_t CellSize() const { return cellSize; }
+		//Gets the number of proxies.
+		size_t Count() const { return proxyCount; }
+		//Gets the number of cells that hold proxies.
+		size_t CellCount() const { return cellCount; }
+		//Removes all proxies.
+		void Clear();
+
+		//Adds a proxy for a rectangle and returns it. userData is kept with the proxy.
+		size_t Add(Rectangle const& bounds, size_t userData = 0);
+		//Removes a proxy.
+		void Remove(size_t proxy);
+		//Moves a proxy to a new rectangle. Returns true if the proxy changed cells, false if only the rectangle was replaced.
+		bool Move(size_t proxy, Rectangle const& bounds);
+
+		//Gets the rectangle of a proxy.
+		Rectangle const& Bounds(size_t proxy) const { return proxies[proxy].Bounds; }
+		//Gets the value passed to Add for a proxy.
+		size_t UserData(size_t proxy) const { return proxies[proxy].UserData; }
+
+		//Calls callback(proxy) once for every proxy whose rectangle intersects region. Stops when callback returns false.
+		template <typename Callback>
+		void Query(Rectangle const& region, Callback&& callback) const {
+			if (proxyCount == 0)
+				return;
+
+			const auto range = CellsOf(region);
+			const auto width = static_cast<int64_t>(range.MaxX) - range.MinX + 1;
+			const auto height = static_cast<int64_t>(range.MaxY) - range.MinY + 1;
+
+			auto visit = [&](Cell const& cell) {
+				return ForEachInCell(cell, [&](uint32_t index) {
+					const auto& proxy = proxies[index];
+
+					//A proxy in several cells of the region is reported from the first of them only.
+					if (!range.IsFirstShared(proxy.Cells, cell.X, cell.Y) || !proxy.Bounds.Intersects(region))
+						return true;
+
+					return static_cast<bool>(callback(static_cast<size_t>(index)));
+					});
+				};
+
+			//Regions larger than the table walk the stored cells instead of the grid.
+			if (width * height > static_cast<int64_t>(cells.size())) {
+				for (const auto& cell : cells) {
+					if (cell.Count != UnusedSlot && range.Contains(cell.X, cell.Y) && !visit(cell))
+						return;
+				}
+
+				return;
+			}
+
+			for (auto y = range.MinY; ; ++y) {
+				for (auto x = range.MinX; ; ++x) {
+					const auto slot = FindCell(x, y);
+
+					if (slot != NullIndex && !visit(cells[slot]))
+						return;
+
+					if (x == range.MaxX)
+						break;
+				}
+
+				if (y == range.MaxY)
+					break;
+			}
+		}
+
+		//Calls callback(proxy) for every proxy whose rectangle contains point. Stops when callback returns false.
+		template <typename Callback>
+		void Query(Point const& point, Callback&& callback) const {
+			if (proxyCount == 0)
+				return;
+
+			const auto slot = FindCell(CellOf(point.X), CellOf(point.Y));
+
+			if (slot == NullIndex)
+				return;
+
+			ForEachInCell(cells[slot], [&](uint32_t index) {
+				if (!proxies[index].Bounds.Contains(point))
+					return true;
+
+				return static_cast<bool>(callback(static_cast<size_t>(index)));
+				});
+		}
+
+		//Calls callback(proxy1, proxy2) once for every pair of proxies whose rectangles intersect. Stops when callback returns false.
+		template <typename Callback>
+		void QueryPairs(Callback&& callback) const {
+			std::vector<uint32_t> members;
+
+			for (const auto& cell : cells) {
+				if (cell.Count == UnusedSlot || cell.Count < 2)
+					continue;
+
+				//Copied out of the chunks so the inner loop runs over one array.
+				members.clear();
+				ForEachInCell(cell, [&](uint32_t index) { members.push_back(index); return true; });
+
+				for (size_t i = 0; i + 1 < members.size(); ++i) {
+					const auto& proxy1 = proxies[members[i]];
+
+					for (size_t j = i + 1; j < members.size(); ++j) {
+						const auto& proxy2 = proxies[members[j]];
+
+						//A pair sharing several cells is reported from the first of them only.
+						if (!proxy1.Cells.IsFirstShared(proxy2.Cells, cell.X, cell.Y) || !proxy1.Bounds.Intersects(proxy2.Bounds))
+							continue;
+
+						if (!callback(static_cast<size_t>(members[i]), static_cast<size_t>(members[j])))
+							return;
+					}
+				}
+			}
+		}
+
+	private:
+		static constexpr uint32_t NullIndex = static_cast<uint32_t>(-1);
+		//Count of the table slots that hold no cell.
+		static constexpr uint32_t UnusedSlot = static_cast<uint32_t>(-1);
+		static constexpr uint32_t ChunkCapacity = 7;
+		static constexpr uint32_t LocalCapacity = 4;
+
+		//Inclusive range of cell coordinates.
+		struct CellRange {
+			int32_t MinX{ 0 };
+			int32_t MinY{ 0 };
+			int32_t MaxX{ 0 };
+			int32_t MaxY{ 0 };
+
+			constexpr bool operator==(CellRange const& other) const {
+				return MinX == other.MinX && MinY == other.MinY && MaxX == other.MaxX && MaxY == other.MaxY;
+			}
+
+			constexpr bool Contains(int32_t x, int32_t y) const {
+				return MinX <= x && x <= MaxX && MinY <= y && y <= MaxY;
+			}
+
+			//Gets whether (x, y) is the cell with the lowest coordinates shared by both ranges.
+			constexpr bool IsFirstShared(CellRange const& other, int32_t x, int32_t y) const {
+				return x == (MinX > other.MinX ? MinX : other.MinX) && y == (MinY > other.MinY ? MinY : other.MinY);
+			}
+		};
+
+		struct Proxy {
+			Rectangle Bounds;
+			CellRange Cells;
+			//Value passed to Add, next free proxy of a free proxy.
+			size_t UserData{ 0 };
+		};
+
+		//32 bytes, like Cell.
+		struct Chunk {
+			uint32_t Proxies[ChunkCapacity];
+			uint32_t Next{ NullIndex };
+		};
+
+		//32 bytes. The first LocalCapacity proxies of a cell are kept in the cell and the others in its list of chunks,
+		//where only the head chunk can be partly filled.
+		struct Cell {
+			int32_t X{ 0 };
+			int32_t Y{ 0 };
+			uint32_t Count{ UnusedSlot };
+			uint32_t Head{ NullIndex };
+			uint32_t Local[LocalCapacity];
+		};
+
+		template <typename Function>
+		bool ForEachInCell(Cell const& cell, Function&& function) const {
+			const auto local = cell.Count < LocalCapacity ? cell.Count : LocalCapacity;
+
+			for (uint32_t i = 0; i < local; ++i) {
+				if (!function(cell.Local[i]))
+					return false;
+			}
+
+			auto chunk = cell.Head;
+			auto filled = HeadCount(cell);
+
+			while (chunk != NullIndex) {
+				const auto& current = chunks[chunk];
+
+				for (uint32_t i = 0; i < filled; ++i) {
+					if (!function(current.Proxies[i]))
+						return false;
+				}
+
+				chunk = current.Next;
+				filled = ChunkCapacity;
+			}
+
+			return true;
+		}
+
+		//Number of proxies in the head chunk of a cell, 0 when it has no chunks.
+		static constexpr uint32_t HeadCount(Cell const& cell) {
+			if (cell.Count <= LocalCapacity)
+				return 0;
+
+			const auto filled = (cell.Count - LocalCapacity) % ChunkCapacity;
+			return filled == 0 ? ChunkCapacity : filled;
+		}
+
+		constexpr int32_t CellOf(int32_t coordinate) const {
+			const auto value = static_cast<int64_t>(coordinate);
+			return static_cast<int32_t>(value >= 0 ? value / cellSize : (value - cellSize + 1) / cellSize);
+		}
+
+		CellRange CellsOf(Rectangle const& bounds) const;
+		uint32_t FindCell(int32_t x, int32_t y) const;
+		uint32_t FindOrAddCell(int32_t x, int32_t y);
+		void RemoveCell(uint32_t slot);
+		void Grow();
+		void Insert(uint32_t proxy, CellRange const& range);
+		void Erase(uint32_t proxy, CellRange const& range);
+		void InsertInCell(uint32_t proxy, int32_t x, int32_t y);
+		void EraseFromCell(uint32_t proxy, int32_t x, int32_t y);
+		size_t SlotOf(int32_t x, int32_t y) const;
+
+		int32_t cellSize{ DefaultCellSize };
+		std::vector<Proxy> proxies;
+		std::vector<Chunk> chunks;
+		std::vector<Cell> cells;
+		size_t proxyCount{ 0 };
+		size_t cellCount{ 0 };
+		size_t freeProxy{ NullProxy };
+		uint32_t freeChunk{ NullIndex };
+	};
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef XNA_COMMON_STATICMESHBVH_HPP
+#define XNA_COMMON_STATICMESHBVH_HPP
+
+#include "collision.hpp"
+#include "numerics.hpp"
+#include "../graphics/vertexposition.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace xna {
+	//Hit of a ray on a triangle of a StaticMeshBvh.
+	struct MeshRayHit {
+		//Distance along the ray, in lengths of its Direction.
+		float Distance{ 0 };
+		//Index of the triangle hit, the position of its first index divided by 3, or StaticMeshBvh::NoTriangle.
+		size_t Triangle{ static_cast<size_t>(-1) };
+		//Barycentric coordinates of the hit: the weights of the second and the third vertex of the triangle.
+		float U{ 0 };
+		float V{ 0 };
+	};
+
+	//Bounding volume hierarchy over the triangles of a mesh that does not change, for ray picking against level geometry.
+	//The tree is built once with the surface area heuristic over binned centroids and kept in 32-byte nodes, the children of a node next to each other.
+	//The triangles are copied in the order of the leaves, so the mesh arrays are not needed after Build.
+	//Rays hit both sides of the triangles.
+	class StaticMeshBvh {
+	public:
+		//Triangle of a ray that hits nothing.
+		static constexpr size_t NoTriangle = static_cast<size_t>(-1);
+		//Most triangles a leaf holds. Nodes with fewer triangles become leaves when splitting them costs more.
+		static constexpr uint32_t MaxLeafTriangles = 8;
+		//Number of bins along each axis for the split candidates.
+		static constexpr size_t BinCount = 16;
+		//Nodes with at least this many triangles are binned on threadCount threads, and the subtrees below this size are built one per thread.
+		static constexpr size_t MinimumParallelCount = 65536;
+		//Batch ray casts with fewer rays than this run on the calling thread only.
+		static constexpr size_t MinimumParallelRayCount = 4096;
+
+		StaticMeshBvh() = default;
+
+		//Builds the tree over the triangles of a triangle list, three indices per triangle. With threadCount greater than 1,
+		//large nodes and subtrees are built on threadCount threads, and the tree is the same for any threadCount.
+		//Returns false, leaving the tree empty, if the number of indices is not a multiple of 3 or an index is out of range.
+		bool Build(std::span<const VertexPositionNormalTexture> vertices, std::span<const uint16_t> indices, size_t threadCount = 1);
+		bool Build(std::span<const VertexPositionNormalTexture> vertices, std::span<const uint32_t> indices, size_t threadCount = 1);
+		bool Build(std::span<const Vector3> positions, std::span<const uint32_t> indices, size_t threadCount = 1);
+		//Removes all triangles.
+		void Clear();
+
+		//Gets the number of triangles.
+		size_t TriangleCount() const { return triangles.size(); }
+		//Gets the number of nodes.
+		size_t NodeCount() const { return nodes.size(); }
+		//Gets the box of all triangles.
+		BoundingBox Bounds() const;
+
+		//Gets the nearest hit of a ray closer than maxDistance.
+		std::optional<MeshRayHit> RayCast(Ray const& ray, float maxDistance = (std::numeric_limits<float>::max)()) const;
+		//Gets whether a ray hits any triangle closer than maxDistance, stopping at the first hit found, like for shadow or line of sight tests.
+		bool RayCastAny(Ray const& ray, float maxDistance = (std::numeric_limits<float>::max)()) const;
+
+		//Writes the nearest hit of every ray, or a hit with Triangle set to NoTriangle. Rays are traced in packets of four or eight
+		//that share the traversal, which pays most for coherent rays like those through nearby pixels.
+		//With threadCount greater than 1 and at least MinimumParallelRayCount rays, ranges of rays run on threadCount threads.
+		//Returns false if hits is smaller than rays.
+		bool RayCast(std::span<const Ray> rays, std::span<MeshRayHit> hits, float maxDistance = (std::numeric_limits<float>::max)(), size_t threadCount = 1) const;
+		//Sets bit i % 64 of result[i / 64] when ray i hits any triangle closer than maxDistance, clearing the other bits of the words written.
+		//Packets stop when all of their rays hit. Returns false if result has fewer than (count + 63) / 64 words.
+		bool RayCastAny(std::span<const Ray> rays, std::span<uint64_t> result, float maxDistance = (std::numeric_limits<float>::max)(), size_t threadCount = 1) const;
+
+	private:
+		friend struct MeshBvhKernels;
+
+		//32 bytes. An inner node has Count 0 and its children at First and First + 1, a leaf holds the triangles from First on.
+		struct Node {
+			Vector3 Min{};
+			Vector3 Max{};
+			uint32_t First{ 0 };
+			uint32_t Count{ 0 };
+
+			constexpr bool IsLeaf() const { return Count != 0; }
+		};
+
+		//A vertex and the two edges from it, for the intersection test.
+		struct Triangle {
+			Vector3 Vertex0{};
+			Vector3 Edge1{};
+			Vector3 Edge2{};
+		};
+
+		std::vector<Node> nodes;
+		std::vector<Triangle> triangles;
+		//Index in the mesh of every triangle, in the order of the leaves.
+		std::vector<uint32_t> triangleIndices;
+	};
+}
+
+#endif
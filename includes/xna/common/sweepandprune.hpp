@@ -0,0 +1,157 @@
+#ifndef XNA_COMMON_SWEEPANDPRUNE_HPP
+#define XNA_COMMON_SWEEPANDPRUNE_HPP
+
+#include "collision.hpp"
+#include "numerics.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace xna {
+	//Pair of overlapping proxies reported by SweepAndPrune, Proxy1 lower than Proxy2.
+	struct ProxyPair {
+		size_t Proxy1{ 0 };
+		size_t Proxy2{ 0 };
+	};
+
+	//Sweep and prune broadphase over BoundingBox (3 axes) or Rectangle (2 axes) proxies. The minimum and maximum of every proxy
+	//are kept in one sorted array of endpoints per axis. Moves only change the values, and Update restores the order with insertion sort,
+	//which is close to linear when the proxies move little between frames. Two proxies overlap when their intervals overlap on every axis,
+	//so the set of overlapping pairs changes only when two endpoints swap, and the changes are collected as added and removed pairs.
+	//Every swap costs, so an axis where many proxies share a small range, like the vertical axis of a long side-scrolling level,
+	//makes the sorts slower.
+	//Boxes overlap like BoundingBox::Intersects and rectangles like Rectangle::Intersects; rectangles with no width or height
+	//are treated as one unit wide or high.
+	template <typename T>
+	class SweepAndPrune {
+	public:
+		static_assert(std::is_same_v<T, BoundingBox> || std::is_same_v<T, Rectangle>, "SweepAndPrune supports BoundingBox and Rectangle.");
+
+		//Proxy returned for no proxy.
+		static constexpr size_t NullProxy = static_cast<size_t>(-1);
+		static constexpr size_t Axes = std::is_same_v<T, BoundingBox> ? 3 : 2;
+		using Coordinate = std::conditional_t<std::is_same_v<T, BoundingBox>, float, int32_t>;
+
+		SweepAndPrune() = default;
+
+		//Gets the number of proxies.
+		size_t Count() const { return proxyCount; }
+		//Gets the number of overlapping pairs.
+		size_t PairCount() const { return pairs.size(); }
+		//Removes all proxies and pairs.
+		void Clear();
+
+		//Adds a proxy for a box and returns it. userData is kept with the proxy. The pairs of the new proxy are added pairs.
+		//Costs a pass over the endpoints, so large sets are better added at once with the span version.
+		size_t Add(T const& box, size_t userData = 0);
+		//Adds a proxy for every box, with the user data at the same index, and writes the proxies to proxies.
+		//The endpoints are sorted again and the pairs of the new proxies are found with one sweep.
+		//Returns false if the spans have different sizes.
+		bool Add(std::span<const T> boxes, std::span<const size_t> userData, std::span<size_t> proxies);
+		//Removes a proxy. Its pairs become removed pairs.
+		void Remove(size_t proxy);
+		//Sets the box of a proxy. The pairs change on the next Update.
+		void Move(size_t proxy, T const& box);
+		//Sorts the endpoints of the moved proxies and updates the pairs, usually once per frame after the moves.
+		//Add and Remove call it first.
+		void Update();
+
+		//Gets the box of a proxy.
+		T const& Bounds(size_t proxy) const { return proxies[proxy].Box; }
+		//Gets the value passed to Add for a proxy.
+		size_t UserData(size_t proxy) const { return proxies[proxy].UserData; }
+
+		//Gets the pairs that started overlapping since the last ClearPairChanges.
+		std::span<const ProxyPair> AddedPairs() const { return added; }
+		//Gets the pairs that stopped overlapping since the last ClearPairChanges, including the pairs of removed proxies.
+		//A pair that is added and removed again between two calls is in neither list.
+		std::span<const ProxyPair> RemovedPairs() const { return removed; }
+		//Empties the lists of added and removed pairs, usually once per frame after they are handled.
+		void ClearPairChanges();
+
+		//Calls callback(proxy1, proxy2) for every overlapping pair. Stops when callback returns false.
+		template <typename Callback>
+		void ForEachPair(Callback&& callback) const {
+			for (const auto& [key, index] : pairs) {
+				if (!callback(static_cast<size_t>(key >> 32), static_cast<size_t>(key & 0xFFFFFFFF)))
+					return;
+			}
+		}
+
+	private:
+		static constexpr uint32_t NullIndex = static_cast<uint32_t>(-1);
+
+		//Data holds the proxy shifted left by one, and 1 in the low bit for a maximum.
+		struct Endpoint {
+			Coordinate Value{};
+			uint32_t Data{ 0 };
+
+			constexpr uint32_t Proxy() const { return Data >> 1; }
+			constexpr bool IsMax() const { return (Data & 1) != 0; }
+
+			//Minimums come before maximums of the same value, so touching intervals overlap.
+			constexpr bool operator<(Endpoint const& other) const {
+				return Value < other.Value || (Value == other.Value && (Data & 1) < (other.Data & 1));
+			}
+		};
+
+		struct Proxy {
+			T Box{};
+			size_t UserData{ 0 };
+		};
+
+		//Indices of the endpoints of a proxy in every axis, kept apart from the proxies because the sorts touch little else.
+		//Min[0] is the next free proxy of a free proxy, and Max[0] is NullIndex.
+		struct EndpointIndices {
+			uint32_t Min[Axes]{};
+			uint32_t Max[Axes]{};
+		};
+
+		static Coordinate MinOf(T const& box, size_t axis);
+		static Coordinate MaxOf(T const& box, size_t axis);
+
+		static constexpr uint64_t KeyOf(uint32_t proxy1, uint32_t proxy2) {
+			return proxy1 < proxy2
+				? (static_cast<uint64_t>(proxy1) << 32) | proxy2
+				: (static_cast<uint64_t>(proxy2) << 32) | proxy1;
+		}
+
+		//Compares the endpoint indices, which are ordered like the values, on every axis but skippedAxis.
+		static bool Overlaps(EndpointIndices const& proxy1, EndpointIndices const& proxy2, size_t skippedAxis = Axes) {
+			for (size_t axis = 0; axis < Axes; ++axis) {
+				if (axis != skippedAxis && (proxy1.Max[axis] < proxy2.Min[axis] || proxy2.Max[axis] < proxy1.Min[axis]))
+					return false;
+			}
+
+			return true;
+		}
+
+		uint32_t AllocateProxy(T const& box, size_t userData);
+		void SortAxis(size_t axis);
+		void SetIndex(Endpoint const& endpoint, size_t axis, uint32_t index);
+		void AddPair(uint32_t proxy1, uint32_t proxy2);
+		void RemovePair(uint32_t proxy1, uint32_t proxy2);
+
+		std::vector<Endpoint> endpoints[Axes];
+		std::vector<Proxy> proxies;
+		std::vector<EndpointIndices> indices;
+		size_t proxyCount{ 0 };
+		uint32_t freeProxy{ NullIndex };
+		bool sorted{ true };
+
+		//Overlapping pairs, with the index in added of the pairs added since the last ClearPairChanges, NullIndex for the others.
+		std::unordered_map<uint64_t, uint32_t> pairs;
+		//Index in removed of the pairs removed since the last ClearPairChanges.
+		std::unordered_map<uint64_t, uint32_t> removedIndices;
+		std::vector<ProxyPair> added;
+		std::vector<ProxyPair> removed;
+	};
+
+	extern template class SweepAndPrune<BoundingBox>;
+	extern template class SweepAndPrune<Rectangle>;
+}
+
+#endif
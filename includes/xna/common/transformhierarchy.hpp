@@ -0,0 +1,96 @@
+#ifndef XNA_COMMON_TRANSFORMHIERARCHY_HPP
+#define XNA_COMMON_TRANSFORMHIERARCHY_HPP
+
+#include "numerics.hpp"
+#include "soa.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace xna {
+	//Scene hierarchy kept as flat arrays. Local translation, rotation and scale are stored as structures of arrays,
+	//and every node comes after its parent, so world matrices can be computed in one forward pass.
+	//Changing a node marks it dirty; Update recomputes the world matrices of the dirty nodes and their descendants only.
+	class TransformHierarchy {
+	public:
+		//Parent of the root nodes.
+		static constexpr size_t NoParent = static_cast<size_t>(-1);
+		//Updates with fewer dirty nodes than this run on the calling thread only.
+		static constexpr size_t MinimumParallelCount = 8192;
+
+		TransformHierarchy() = default;
+
+		//Gets the number of nodes.
+		size_t Count() const { return parents.size(); }
+		//Makes room for at least capacity nodes.
+		void Reserve(size_t capacity);
+		//Removes all nodes.
+		void Clear();
+
+		//Adds a node with the identity transform and returns its index.
+		//parent must be NoParent or an existing node.
+		size_t Add(size_t parent = NoParent);
+		//Adds a node with the specified local transform and returns its index.
+		//parent must be NoParent or an existing node.
+		size_t Add(size_t parent, Vector3 const& translation, Quaternion const& rotation, Vector3 const& scale);
+
+		//Gets the parent of a node, or NoParent.
+		size_t Parent(size_t node) const { return parents[node]; }
+
+		//Gets the local translation of a node.
+		Vector3 Translation(size_t node) const { return translations.Get(node); }
+		//Sets the local translation of a node.
+		void Translation(size_t node, Vector3 const& value);
+		//Gets the local rotation of a node.
+		Quaternion Rotation(size_t node) const;
+		//Sets the local rotation of a node.
+		void Rotation(size_t node, Quaternion const& value);
+		//Gets the local scale of a node.
+		Vector3 Scale(size_t node) const { return scales.Get(node); }
+		//Sets the local scale of a node.
+		void Scale(size_t node, Vector3 const& value);
+		//Sets the local translation, rotation and scale of a node.
+		void Local(size_t node, Vector3 const& translation, Quaternion const& rotation, Vector3 const& scale);
+
+		//Creates the local matrix of a node, scale then rotation then translation.
+		Matrix LocalMatrix(size_t node) const;
+
+		//Gets whether the world matrix of a node waits for Update. Descendants of a dirty node
+		//report false until Update runs, but are recomputed too.
+		bool IsDirty(size_t node) const { return dirty[node] != 0; }
+		//Forces the world matrix of a node and its descendants to be recomputed by the next Update.
+		void MarkDirty(size_t node);
+
+		//Gets the world matrix of a node as of the last Update.
+		Matrix const& World(size_t node) const { return worlds[node]; }
+		//Gets the world matrices of all nodes as of the last Update, in node order.
+		std::span<const Matrix> WorldMatrices() const { return worlds; }
+
+		//Recomputes the world matrices of the dirty nodes and their descendants.
+		//With threadCount greater than 1 and at least MinimumParallelCount dirty nodes, disjoint subtrees are
+		//split among threadCount threads after the nodes above them are updated.
+		void Update(size_t threadCount = 1);
+
+	private:
+		void UpdateNode(size_t node);
+		void UpdateParallel(size_t threadCount);
+		void BuildPartitions(size_t threadCount);
+
+		std::vector<size_t> parents;
+		Vector3SoA translations;
+		Vector4SoA rotations;
+		Vector3SoA scales;
+		std::vector<uint8_t> dirty;
+		std::vector<Matrix> worlds;
+		bool anyDirty{ false };
+
+		//Nodes grouped by the thread that updates them, partition 0 being the nodes above the subtrees.
+		//Rebuilt on the first parallel update after nodes are added or the thread count changes.
+		std::vector<size_t> partitionNodes;
+		std::vector<size_t> partitionOffsets;
+		size_t partitionThreads{ 0 };
+	};
+}
+
+#endif
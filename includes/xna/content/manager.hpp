@@ -3,6 +3,7 @@
 
 #include "csharp/service.hpp"
 #include "csharp/io/stream.hpp"
+#include "csharp/text/interner.hpp"
 #include "../default.hpp"
 #include "reader.hpp"
 
@@ -26,7 +27,7 @@ namespace xna {
 		}
 
 		//Gets or sets the root directory associated with this ContentManager.
-		constexpr std::string RootDirectory() const {
+		constexpr std::string const& RootDirectory() const {
 			return rootDirectory;
 		}
 
@@ -35,29 +36,43 @@ namespace xna {
 			rootDirectory = value;
 		}
 
+		//Gets or sets the file size, in bytes, from which assets are read through a PrefetchStream.
+		//Large assets such as sound banks and texture atlases are then read ahead on a background thread. Zero disables it.
+		constexpr int64_t PrefetchThreshold() const {
+			return prefetchThreshold;
+		}
+
+		//Gets or sets the file size, in bytes, from which assets are read through a PrefetchStream.
+		//Large assets such as sound banks and texture atlases are then read ahead on a background thread. Zero disables it.
+		void PrefetchThreshold(int64_t value) {
+			prefetchThreshold = value < 0 ? 0 : value;
+		}
+
 		//Loads an asset that has been processed by the Content Pipeline.
+		//Loading an asset that is already cached does not allocate.
 		template <typename T>
-		auto Load(std::string const& assetName) {
+		auto Load(std::string_view assetName) {
 			if (assetName.empty()) {
 				return misc::ReturnDefaultOrNull<T>();
 			}
 			
 			if constexpr (misc::is_shared_ptr<T>::value) {
+				const auto it = loadedAssets.find(assetName);
 
-				if (loadedAssets.contains(assetName)) {
-					auto& voidAsset = loadedAssets[assetName];
+				if (it != loadedAssets.end()) {
 					using TYPE = T::element_type;
-					auto asset = reinterpret_pointer_cast<TYPE>(voidAsset);
+					auto asset = reinterpret_pointer_cast<TYPE>(it->second);
 					return asset;
 				}
 			}
 
-			const auto obj2 = ReadAsset<T>(assetName); 
+			auto const& internedName = csharp::StringInterner::Intern(assetName);
+			const auto obj2 = ReadAsset<T>(internedName); 
 
 			if constexpr (misc::is_shared_ptr<T>::value) {
 
 				if(obj2)
-					loadedAssets.emplace( assetName, obj2 );
+					loadedAssets.emplace( internedName, obj2 );
 			}
 
 			return obj2;
@@ -96,7 +111,9 @@ namespace xna {
 
 		std::string rootDirectory;				
 		std::shared_ptr<csharp::IServiceProvider> serviceProvider = nullptr;
-		std::map<std::string, std::shared_ptr<void>> loadedAssets;
+		//Keyed by asset names interned with csharp::StringInterner.
+		std::map<std::string_view, std::shared_ptr<void>> loadedAssets;
+		int64_t prefetchThreshold{ 0 };
 		
 		inline static std::shared_ptr<csharp::IServiceProvider> mainGameService = nullptr;		
 		inline const static std::string contentExtension = ".xnb";
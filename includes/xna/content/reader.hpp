@@ -5,10 +5,12 @@
 #include "../common/numerics.hpp"
 #include "../default.hpp"
 #include "csharp/io/binary.hpp"
+#include "csharp/text/interner.hpp"
 #include "typereadermanager.hpp"
 #include <any>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 
 namespace xna {
@@ -51,8 +53,8 @@ namespace xna {
 		double ReadDouble() override;
 
 		//Gets the name of the asset currently being read by this ContentReader.
-		constexpr std::string AssetName() const {
-			return _assetName;
+		constexpr std::string const& AssetName() const {
+			return *_assetName;
 		}
 
 		//Gets the ContentManager associated with the ContentReader.
@@ -65,11 +67,13 @@ namespace xna {
 		template <typename T>
 		auto ReadAsset();
 
-		std::vector<uint8_t> ReadByteBuffer(size_t size);		
+		//Reads size bytes into a buffer rented by this reader and returns exactly those bytes.
+		//The span is only valid until the next read, which reuses the buffer.
+		std::span<const uint8_t> ReadByteBuffer(size_t size);
 
 	private:
 		ContentReader(std::shared_ptr<xna::ContentManager> const& contentManager, std::shared_ptr<csharp::Stream>& input, std::string const& assetName, int32_t graphicsProfile)
-			: csharp::BinaryReader(input), _contentManager(contentManager), _assetName(assetName) {}
+			: csharp::BinaryReader(input), _contentManager(contentManager), _assetName(&csharp::StringInterner::Intern(assetName)) {}
 
 		static std::shared_ptr<csharp::Stream> PrepareStream(std::shared_ptr<csharp::Stream>& input, std::string const& assetName, int32_t& graphicsProfile);
 
@@ -86,10 +90,11 @@ namespace xna {
 
 	private:
 		std::shared_ptr<xna::ContentManager> _contentManager = nullptr;
-		std::string _assetName;
+		//Interned, so every reader of the same asset shares one copy of the name.
+		std::string const* _assetName = nullptr;
 		std::vector<std::shared_ptr<ContentTypeReader>> typeReaders;
 		int32_t graphicsProfile{ 0 };
-		std::vector<uint8_t> byteBuffer;
+		csharp::PooledArray<uint8_t> byteBuffer;
 
 		static constexpr uint16_t XnbVersionProfileMask = 32512;
 		static constexpr uint16_t XnbCompressedVersion = 32773;
@@ -35,7 +35,7 @@ namespace xna {
 
 			for (size_t level = 0; level < mipMaps; ++level) {
 				auto elementCount = input.ReadInt32();
-				std::vector<Byte> data = input.ReadByteBuffer(elementCount);
+				const auto data = input.ReadByteBuffer(elementCount);
 
 				texture2D->SetData(static_cast<Int>(level), nullptr, data, 0, elementCount);
 			}
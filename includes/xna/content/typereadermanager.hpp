@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <map>
 #include <any>
+#include <string_view>
 
 namespace xna {
 	//-------------------------------------------------------//
@@ -104,18 +105,19 @@ namespace xna {
 
 	private:
 		ContentTypeReaderManager(sptr<ContentReader>& contentReader);
-		static sptr<ContentTypeReader> GetTypeReader(String const& readerTypeName, sptr<ContentReader>& contentReader, std::vector<PContentTypeReader>& newTypeReaders);
-		static bool InstantiateTypeReader(String const& readerTypeName, sptr<ContentReader>& contentReader, sptr<ContentTypeReader>& reader);
-		static void AddTypeReader(String const& readerTypeName, sptr<ContentReader>& contentReader, sptr<ContentTypeReader>& reader);
+		static sptr<ContentTypeReader> GetTypeReader(std::string_view readerTypeName, sptr<ContentReader>& contentReader, std::vector<PContentTypeReader>& newTypeReaders);
+		static bool InstantiateTypeReader(std::string_view readerTypeName, sptr<ContentReader>& contentReader, sptr<ContentTypeReader>& reader);
+		static void AddTypeReader(std::string_view readerTypeName, sptr<ContentReader>& contentReader, sptr<ContentTypeReader>& reader);
 		static void RollbackAddReaders(std::vector<sptr<ContentTypeReader>>& newTypeReaders);
 
-		static void RollbackAddReader(std::map<String, PContentTypeReader>& dictionary, sptr<ContentTypeReader>& reader);
+		static void RollbackAddReader(std::map<std::string_view, PContentTypeReader>& dictionary, sptr<ContentTypeReader>& reader);
 		static void RollbackAddReader(std::map<PType, PContentTypeReader>& dictionary, sptr<ContentTypeReader>& reader);
 
 	private:
 		sptr<ContentReader> contentReader = nullptr;
 
-		inline static auto nameToReader = std::map<String, PContentTypeReader>();
+		//Keyed by reader type names interned with csharp::StringInterner, so lookups with a view read from the manifest do not allocate.
+		inline static auto nameToReader = std::map<std::string_view, PContentTypeReader>();
 		inline static auto targetTypeToReader = std::map<PType, PContentTypeReader>();
 		inline static auto readerTypeToReader = std::map<PType, PContentTypeReader>();
 
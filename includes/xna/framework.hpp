@@ -7,9 +7,16 @@
 #include "common/collision.hpp"
 #include "common/color.hpp"
 #include "common/curve.hpp"
+#include "common/dynamicaabbtree.hpp"
+#include "common/fastmath.hpp"
 #include "common/math.hpp"
 #include "common/numerics.hpp"
 #include "common/packedvalue.hpp"
+#include "common/soa.hpp"
+#include "common/spatialhash.hpp"
+#include "common/staticmeshbvh.hpp"
+#include "common/sweepandprune.hpp"
+#include "common/transformhierarchy.hpp"
 #include "content/lzx/decoder.hpp"
 #include "content/manager.hpp"
 #include "content/reader.hpp"
@@ -5,6 +5,7 @@
 #include "gresource.hpp"
 #include "shared.hpp"
 #include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -48,7 +49,7 @@ namespace xna {
 		//Sets data to the texture.
 		void SetData(std::vector<uint8_t> const& data, size_t startIndex = 0, size_t elementCount = 0);
 		//Sets data to the texture.
-		void SetData(int32_t level, Rectangle* rect, std::vector<uint8_t> const& data, size_t startIndex, size_t elementCount);
+		void SetData(int32_t level, Rectangle* rect, std::span<const uint8_t> data, size_t startIndex, size_t elementCount);
 		
 		//Loads texture data from a stream. 
 		static std::shared_ptr<Texture2D> FromStream(GraphicsDevice& device, csharp::Stream& stream);
@@ -23,6 +23,16 @@ namespace PlatformerStarterKit {
 
 			return ((distanceSquared > 0) && (distanceSquared < Radius * Radius));
 		}
+
+		//Gets the smallest rectangle that intersects every rectangle the circle intersects.
+		xna::Rectangle BoundingRectangle() const {
+			const auto left = static_cast<int>(std::floor(Center.X - Radius));
+			const auto top = static_cast<int>(std::floor(Center.Y - Radius));
+			const auto right = static_cast<int>(std::floor(Center.X + Radius)) + 1;
+			const auto bottom = static_cast<int>(std::floor(Center.Y + Radius)) + 1;
+
+			return xna::Rectangle(left, top, right - left, bottom - top);
+		}
 	};
 }
 
@@ -61,6 +61,13 @@ namespace PlatformerStarterKit {
 			}
 		}
 	}
+
+	void Enemy::Bump(xna::Vector2 const& other)
+	{
+		if (waitTime <= 0.0f && (other.X - position.X) * static_cast<int>(direction) > 0.0f)
+			waitTime = MaxWaitTime;
+	}
+
 	void Enemy::Draw(xna::GameTime const& gameTime, xna::SpriteBatch& spriteBatch)
 	{
 		if (!level->Player()->IsAlive() ||
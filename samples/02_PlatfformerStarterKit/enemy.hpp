@@ -29,6 +29,8 @@ namespace PlatformerStarterKit {
 
         void LoadContent(xna::String const& spriteSet);
         void Update(xna::GameTime const& gameTime);
+        // Stops and turns around if another enemy at the specified position is ahead.
+        void Bump(xna::Vector2 const& other);
         void Draw(xna::GameTime const& gameTime, xna::SpriteBatch& spriteBatch);
 
     private:
@@ -6,6 +6,7 @@
 #include "enemy.hpp"
 #include "level.hpp"
 #include "gem.hpp"
+#include <chrono>
 #include <format>
 
 using namespace std;
@@ -49,7 +50,9 @@ namespace PlatformerStarterKit {
 		void Update(GameTime const& gameTime) override {
 			HandleInput();
 
+			const auto start = std::chrono::steady_clock::now();
 			level->Update(gameTime);
+			levelUpdateTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 
 			Game::Update(gameTime);
 		}
@@ -142,6 +145,11 @@ namespace PlatformerStarterKit {
 			
 			float timeHeight = hudFont->MeasureString(timeString).Y;
 			DrawShadowedString(*hudFont, "SCORE: " + to_string(level->Score()), hudLocation + Vector2(0.0f, timeHeight * 1.2f), Colors::Yellow);
+
+#if defined(PLATFORMERSTARTERKIT_STRESS_COPIES)
+			const auto stressString = std::format("GEMS: {0} ENEMIES: {1} UPDATE: {2:.3f} ms", level->GemCount(), level->EnemyCount(), levelUpdateTime);
+			DrawShadowedString(*hudFont, stressString, hudLocation + Vector2(0.0f, timeHeight * 2.4f), Colors::Yellow);
+#endif
 			
 			PTexture2D status = nullptr;
 			if (level->TimeRemaining() == csharp::TimeSpan::Zero())
@@ -179,6 +187,7 @@ namespace PlatformerStarterKit {
 		int levelIndex = -1;
 		sptr<Level> level = nullptr;
 		bool wasContinuePressed = false;
+		double levelUpdateTime = 0.0;
 		csharp::TimeSpan WarningTime = csharp::TimeSpan::FromSeconds(30.0);
 		static constexpr int TargetFrameRate = 60;
 		static constexpr Buttons ContinueButton = Buttons::A;
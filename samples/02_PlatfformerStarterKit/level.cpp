@@ -3,6 +3,7 @@
 #include "level.hpp"
 #include "player.hpp"
 #include "gem.hpp"
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 #include <string>
@@ -47,6 +48,19 @@ namespace PlatformerStarterKit {
 			std::getline(reader, line);
 		}
 
+		if (StressCopies > 1) {
+			for (auto& current : lines) {
+				auto copy = current;
+				std::replace(copy.begin(), copy.end(), '1', '.');
+				std::replace(copy.begin(), copy.end(), 'X', '.');
+
+				for (int i = 1; i < StressCopies; ++i)
+					current += copy;
+			}
+
+			width = lines.empty() ? 0 : lines[0].size();
+		}
+
 		tiles = std::vector<std::vector<Tile>>(width, std::vector<Tile>(lines.size()));
 
 		for (size_t y = 0; y < lines.size(); ++y) {
@@ -149,10 +163,25 @@ namespace PlatformerStarterKit {
 				continue;
 
 			gem->Update(gameTime);
+			gemHash.Move(gemProxies[i], gem->BoundingCircle().BoundingRectangle());
+		}
 
-			if (gem->BoundingCircle().Intersects(player->BoundingRectangle())) {
-				OnGemCollected(gem, player);
-			}
+		//Only the gems near the player are tested, and they are collected after the query because it can't change the hash.
+		const auto bounds = player->BoundingRectangle();
+		touching.clear();
+
+		gemHash.Query(bounds, [&](size_t proxy) {
+			const auto index = gemHash.UserData(proxy);
+
+			if (gems[index]->BoundingCircle().Intersects(bounds))
+				touching.push_back(index);
+
+			return true;
+			});
+
+		for (const auto index : touching) {
+			OnGemCollected(gems[index], player);
+			gemHash.Remove(gemProxies[index]);
 		}
 	}
 
@@ -167,11 +196,29 @@ namespace PlatformerStarterKit {
 			auto& enemy = enemies[i];
 
 			enemy->Update(gameTime);
+			enemyHash.Move(enemyProxies[i], enemy->BoundingRectangle());
+		}
 
-			if (enemy->BoundingRectangle().Intersects(player->BoundingRectangle())) {
-				OnPlayerKilled(enemy);
-			}
+		if (StressCopies > 1) {
+			//The stress build also turns back the enemies that walk into each other, which tests every pair of enemies.
+			enemyHash.QueryPairs([&](size_t proxy1, size_t proxy2) {
+				auto& enemy1 = enemies[enemyHash.UserData(proxy1)];
+				auto& enemy2 = enemies[enemyHash.UserData(proxy2)];
+				enemy1->Bump(enemy2->Position());
+				enemy2->Bump(enemy1->Position());
+				return true;
+				});
 		}
+
+		touching.clear();
+
+		enemyHash.Query(player->BoundingRectangle(), [&](size_t proxy) {
+			touching.push_back(enemyHash.UserData(proxy));
+			return true;
+			});
+
+		for (const auto index : touching)
+			OnPlayerKilled(enemies[index]);
 	}
 
 	void Level::OnExitReached()
@@ -204,6 +251,12 @@ namespace PlatformerStarterKit {
 	void Level::Initialize()
 	{
 		LoadTiles(path);
+
+		for (size_t i = 0; i < gems.size(); ++i)
+			gemProxies.push_back(gemHash.Add(gems[i]->BoundingCircle().BoundingRectangle(), i));
+
+		for (size_t i = 0; i < enemies.size(); ++i)
+			enemyProxies.push_back(enemyHash.Add(enemies[i]->BoundingRectangle(), i));
 	}
 
 	void Level::Update(xna::GameTime const& gameTime) {
@@ -60,6 +60,14 @@ namespace PlatformerStarterKit {
 			return tiles[0].size();
 		}
 
+		size_t GemCount() const {
+			return gems.size();
+		}
+
+		size_t EnemyCount() const {
+			return enemies.size();
+		}
+
 		void Initialize();
 		void Update(xna::GameTime const& gameTime);
 		void Draw(xna::GameTime const& gameTime, xna::SpriteBatch& spriteBatch);
@@ -68,6 +76,14 @@ namespace PlatformerStarterKit {
 	private:
 		static constexpr xna::Point InvalidPosition = xna::Point(-1, -1);
 		static constexpr int PointsPerSecond = 5;
+		//The gems and enemies are found through spatial hashes with cells of two by two tiles.
+		static constexpr int HashCellSize = Tile::Width * 2;
+#if defined(PLATFORMERSTARTERKIT_STRESS_COPIES)
+		//The stress build repeats every level to the right this many times.
+		static constexpr int StressCopies = PLATFORMERSTARTERKIT_STRESS_COPIES;
+#else
+		static constexpr int StressCopies = 1;
+#endif
 
 		std::vector<std::vector<Tile>> tiles;
 		std::vector<xna::PTexture2D> layers;
@@ -75,6 +91,11 @@ namespace PlatformerStarterKit {
 		xna::sptr<PlatformerStarterKit::Player> player = nullptr;
 		std::vector<xna::sptr<Gem>> gems;
 		std::vector<xna::sptr<Enemy>> enemies;
+		xna::SpatialHash gemHash{ HashCellSize };
+		xna::SpatialHash enemyHash{ HashCellSize };
+		std::vector<size_t> gemProxies;
+		std::vector<size_t> enemyProxies;
+		std::vector<size_t> touching;
 		
 		xna::Vector2 start{};
 		xna::Point exit = InvalidPosition;		
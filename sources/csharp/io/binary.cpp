@@ -1,6 +1,7 @@
 #include "csharp/io/binary.hpp"
 #include <vector>
 #include <cstdint>
+#include <cstring>
 #include "csharp/text/unicode.hpp"
 
 namespace csharp {
@@ -21,53 +22,50 @@ namespace csharp {
         return ch;
 	}
 
-    int32_t BinaryReader::Read(bool twoBytesPerChar) {
+    int32_t BinaryReader::Read() {
         if (_disposed)
             throw InvalidOperationException();
 
-        int32_t charsRead = 0;
-        int32_t numBytes;
-        int64_t posSav = 0;
+        const auto lead = _stream->ReadByte();
 
-        if (_stream->CanSeek())
-        {
-            posSav = _stream->Position();
-        }
-        
-        char singleChar = '\0';
+        if (lead < 0)
+            return -1;
 
-        while (charsRead == 0) {
-            numBytes = twoBytesPerChar ? 2 : 1;
+        uint8_t bytes[4]{ static_cast<uint8_t>(lead) };
+        const auto sequenceLength = Utf8::GetSequenceLength(bytes[0]);
 
-            auto r = _stream->ReadByte();            
+        if (sequenceLength == 1)
+            return lead;
 
-            if (r == -1)
-            {
-                numBytes = 0;
-            }
-            if (numBytes == 2)
-            {
-                auto r2 = _stream->ReadByte();
-                r |= r2;
+        if (sequenceLength == 0)
+            return static_cast<int32_t>(UnicodeUtility::ReplacementChar);
 
-                if (r == -1)
-                {
-                    numBytes = 1;
-                }                
-            }
+        size_t available = 1;
+
+        while (true)
+        {
+            uint32_t scalar = 0;
+            const auto n = Utf8::DecodeScalar(bytes, available, scalar);
+
+            if (n > 0)
+                return static_cast<int32_t>(scalar);
 
-            if (numBytes == 0)
+            if (n < 0)
             {
-                return -1;
+                //The byte that broke the sequence can be the start of the next character.
+                if (_stream->CanSeek())
+                    _stream->Seek(-1, SeekOrigin::Current);
+
+                return static_cast<int32_t>(UnicodeUtility::ReplacementChar);
             }
 
-            const char chars = r;
-            const auto decoder = std::string(&chars);
-            charsRead = decoder.size();
-            singleChar = decoder[0];
-        }
+            const auto next = _stream->ReadByte();
+
+            if (next < 0)
+                return static_cast<int32_t>(UnicodeUtility::ReplacementChar);
 
-        return singleChar;
+            bytes[available++] = static_cast<uint8_t>(next);
+        }
     }
 
     uint8_t BinaryReader::InternalReadByte() {
@@ -83,15 +81,20 @@ namespace csharp {
         return static_cast<uint8_t>(b);
     }
 
-    char BinaryReader::ReadChar(bool twoBytes) {
-        const auto value = Read(twoBytes);
+    char16_t BinaryReader::ReadChar() {
+        const auto value = Read();
 
         if (value == -1)
         {
             throw EndOfStreamException(SR::IO_EOF_ReadBeyondEOF);
         }
 
-        return static_cast<char>(value);
+        if (value > 0xFFFF)
+        {
+            throw InvalidOperationException(SR::Arg_SurrogatesNotAllowedAsSingleChar);
+        }
+
+        return static_cast<char16_t>(value);
     }       
 
     void BinaryReader::InternalRead(std::vector<uint8_t>& buffer) {
@@ -102,14 +105,85 @@ namespace csharp {
     }
 
     std::string BinaryReader::ReadString() {
-        return GenericReadString<std::string>();
+        auto value = GenericReadString<std::string>();
+
+        if (!Utf8::IsValid(value))
+            value = Utf8::ReplaceInvalidSequences(value);
+
+        return value;
     }   
 
     std::u8string BinaryReader::ReadString8() {
-        return GenericReadString<std::u8string>();
+        auto value = GenericReadString<std::u8string>();
+        const auto view = std::string_view(reinterpret_cast<const char*>(value.data()), value.size());
+
+        if (!Utf8::IsValid(view))
+        {
+            const auto replaced = Utf8::ReplaceInvalidSequences(view);
+            value.assign(reinterpret_cast<const char8_t*>(replaced.data()), replaced.size());
+        }
+
+        return value;
     }
 
-    int32_t BinaryReader::Read(char* buffer, int32_t bufferLength, int32_t index, int32_t count) {
+    std::string_view BinaryReader::ReadStringView() {
+        if (_disposed)
+            throw InvalidOperationException();
+
+        const auto stringLength = Read7BitEncodedInt();
+
+        if (stringLength < 0)
+            throw IOException(SR::IO_InvalidStringLen_Len);
+
+        if (stringLength == 0)
+            return {};
+
+        _stringWindow.EnsureLength(static_cast<size_t>(stringLength));
+        _stream->ReadExactly(_stringWindow.Data(), stringLength);
+
+        const auto view = std::string_view(reinterpret_cast<const char*>(_stringWindow.Data()), static_cast<size_t>(stringLength));
+
+        if (Utf8::IsValid(view))
+            return view;
+
+        const auto replaced = Utf8::ReplaceInvalidSequences(view);
+        _stringWindow.EnsureLength(replaced.size());
+        std::memcpy(_stringWindow.Data(), replaced.data(), replaced.size());
+
+        return std::string_view(reinterpret_cast<const char*>(_stringWindow.Data()), replaced.size());
+    }
+
+    std::u16string BinaryReader::ReadString16() {
+        if (_disposed)
+            throw InvalidOperationException();
+
+        const auto stringLength = Read7BitEncodedInt();
+
+        if (stringLength < 0)
+        {
+            throw IOException(SR::IO_InvalidStringLen_Len);
+        }
+
+        if (stringLength == 0)
+        {
+            return {};
+        }
+
+        auto bytes = PooledArray<uint8_t>(static_cast<size_t>(stringLength));
+        _stream->ReadExactly(bytes.Data(), stringLength);
+
+        //A UTF-8 byte never decodes to more than one UTF-16 code unit.
+        std::u16string value(static_cast<size_t>(stringLength), u'\0');
+        size_t bytesRead = 0;
+        size_t charsWritten = 0;
+
+        Utf8::ToUtf16(bytes.Data(), static_cast<size_t>(stringLength), value.data(), value.size(), bytesRead, charsWritten);
+
+        value.resize(charsWritten);
+        return value;
+    }
+
+    int32_t BinaryReader::Read(char16_t* buffer, int32_t bufferLength, int32_t index, int32_t count) {
         ArgumentNullException::ThrowIfNull(buffer, "buffer");
 
         if (index < 0)
@@ -128,49 +202,64 @@ namespace csharp {
         return InternalReadChars(buffer + index, count);
     }
 
-    int32_t BinaryReader::Read(char* buffer, int32_t bufferLength) {
+    int32_t BinaryReader::Read(char16_t* buffer, int32_t bufferLength) {
         if (_disposed)
             throw InvalidOperationException();
 
         return InternalReadChars(buffer, bufferLength);
     }
 
-    int32_t BinaryReader::InternalReadChars(char* buffer, int32_t bufferLength) {
-        int totalCharsRead = 0;
-        auto charBytes = std::vector<uint8_t>(MaxCharBytesSize);
-        
-        auto numBytes = bufferLength;
+    int32_t BinaryReader::InternalReadChars(char16_t* buffer, int32_t bufferLength) {
+        int32_t totalCharsRead = 0;
+        size_t pending = 0;
 
-        while (bufferLength > 0)
-        {
-            auto numBytes = bufferLength;
+        //Room for a sequence left incomplete by the previous chunk.
+        auto charBytes = PooledArray<uint8_t>(MaxCharBytesSize + 4);
 
-            std::vector<uint8_t> byteBuffer;
-            
-            if (numBytes > MaxCharBytesSize)
+        while (totalCharsRead < bufferLength)
+        {
+            //A UTF-8 byte never decodes to more than one UTF-16 code unit, so requesting one byte
+            //per missing char does not read past the requested characters.
+            const auto numBytes = std::min(bufferLength - totalCharsRead, MaxCharBytesSize);
+            const auto read = _stream->Read(charBytes.Data() + pending, numBytes);
+            const auto endOfStream = read <= 0;
+            const auto available = pending + (endOfStream ? 0 : static_cast<size_t>(read));
+
+            if (available == 0)
             {
-                numBytes = MaxCharBytesSize;
+                break;
             }
 
-            numBytes = _stream->Read(charBytes.data(), numBytes);
-            byteBuffer = std::vector<uint8_t>(charBytes.begin(), charBytes.begin() + numBytes);
+            size_t bytesRead = 0;
+            size_t charsWritten = 0;
+
+            const auto status = Utf8::ToUtf16(charBytes.Data(), available, buffer + totalCharsRead,
+                static_cast<size_t>(bufferLength - totalCharsRead), bytesRead, charsWritten, true, endOfStream);
 
-            if (byteBuffer.empty())
+            totalCharsRead += static_cast<int32_t>(charsWritten);
+            pending = available - bytesRead;
+
+            if (endOfStream || status == OperationStatus::DestinationTooSmall)
             {
                 break;
-            }            
+            }
 
-            auto chars = reinterpret_cast<char*>(byteBuffer.data());
-            auto charsRead = std::string(chars);
+            if (pending > 0)
+            {
+                std::memmove(charBytes.Data(), charBytes.Data() + bytesRead, pending);
+            }
+        }
 
-            bufferLength = charsRead.length();            
-            totalCharsRead += charsRead.length();
+        //Bytes that were read but not decoded belong to the next character.
+        if (pending > 0 && _stream->CanSeek())
+        {
+            _stream->Seek(-static_cast<int64_t>(pending), SeekOrigin::Current);
         }
         
         return totalCharsRead;
     }
 
-    std::vector<char> BinaryReader::ReadChars(int32_t count) {
+    std::vector<char16_t> BinaryReader::ReadChars(int32_t count) {
         if (count < 0)
             throw ArgumentOutOfRangeException();
         
@@ -178,13 +267,13 @@ namespace csharp {
             throw InvalidOperationException();
 
         if (count == 0)
-            return std::vector<char>();
+            return std::vector<char16_t>();
 
-        auto chars = std::vector<char>(count);
+        auto chars = std::vector<char16_t>(count);
         const auto n = InternalReadChars(chars.data(), chars.size());
 
         if (n != count) {
-            chars = std::vector<char>(chars.begin(), chars.begin() + count);
+            chars.resize(n);
         }
 
         return chars;
@@ -226,12 +315,27 @@ namespace csharp {
 
         if (numRead != result.size())
         {
-            result = std::vector<uint8_t>(result.begin(), result.begin() + numRead);
+            result.resize(numRead);
         }
 
         return result;
     }
 
+    int32_t BinaryReader::ReadBytes(int32_t count, std::vector<uint8_t>& buffer) {
+        ArgumentOutOfRangeException::ThrowIfNegative(count, "count");
+
+        if (_disposed)
+            throw InvalidOperationException();
+
+        if (count == 0)
+            return 0;
+
+        if (buffer.size() < static_cast<size_t>(count))
+            buffer.resize(count);
+
+        return _stream->ReadAtLeast(buffer.data(), count, count, false);
+    }
+
     void BinaryReader::ReadExactly(uint8_t* buffer, int32_t bufferLength) {
         if (_disposed)
             throw InvalidOperationException();
@@ -298,26 +402,84 @@ namespace csharp {
     }
 
     void BinaryWriter::Write7BitEncodedInt(int32_t value) {
+        constexpr size_t MaxBytes = 5;
+
+        if (_bufferPosition + MaxBytes > _buffer.Length())
+            FlushBuffer();
+
         auto uValue = static_cast<uint32_t>(value);
+        auto output = _buffer.Data() + _bufferPosition;
 
         while (uValue > 0x7Fu)
         {
-            Write(static_cast<uint8_t>(uValue | ~0x7Fu));
+            *output++ = static_cast<uint8_t>(uValue | ~0x7Fu);
             uValue >>= 7;
         }
 
-        Write(static_cast<uint8_t>(uValue));
+        *output++ = static_cast<uint8_t>(uValue);
+        _bufferPosition = static_cast<size_t>(output - _buffer.Data());
     }
 
-    void BinaryWriter::Write7BitEncodedInt(int64_t value) {
-        auto uValue = static_cast<uint32_t>(value);
+    void BinaryWriter::Write7BitEncodedInt64(int64_t value) {
+        constexpr size_t MaxBytes = 10;
+
+        if (_bufferPosition + MaxBytes > _buffer.Length())
+            FlushBuffer();
+
+        auto uValue = static_cast<uint64_t>(value);
+        auto output = _buffer.Data() + _bufferPosition;
 
         while (uValue > 0x7Fu)
         {
-            Write(static_cast<uint8_t>(uValue | ~0x7Fu));
+            *output++ = static_cast<uint8_t>(uValue | ~0x7Fu);
             uValue >>= 7;
         }
 
-        Write(static_cast<uint8_t>(uValue));
+        *output++ = static_cast<uint8_t>(uValue);
+        _bufferPosition = static_cast<size_t>(output - _buffer.Data());
+    }
+
+    void BinaryWriter::Write(std::string_view const& value) {
+        if (value.size() > static_cast<size_t>(INT32_MAX))
+            throw ArgumentOutOfRangeException("value");
+
+        Write7BitEncodedInt(static_cast<int32_t>(value.size()));
+        WriteBytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+    }
+
+    void BinaryWriter::FlushBuffer() {
+        if (_bufferPosition == 0)
+            return;
+
+        const auto count = static_cast<int32_t>(_bufferPosition);
+        _bufferPosition = 0;
+        OutStream->Write(_buffer.Data(), count, 0, count);
+    }
+
+    void BinaryWriter::WriteBytes(uint8_t const* bytes, size_t count) {
+        const auto bufferLength = _buffer.Length();
+
+        if (count <= bufferLength - _bufferPosition) {
+            std::memcpy(_buffer.Data() + _bufferPosition, bytes, count);
+            _bufferPosition += count;
+            return;
+        }
+
+        FlushBuffer();
+
+        //Large blocks skip the buffer to avoid a second copy.
+        if (count >= bufferLength) {
+            while (count > 0) {
+                const auto chunk = static_cast<int32_t>((std::min)(count, static_cast<size_t>(INT32_MAX)));
+                OutStream->Write(bytes, chunk, 0, chunk);
+                bytes += chunk;
+                count -= chunk;
+            }
+
+            return;
+        }
+
+        std::memcpy(_buffer.Data(), bytes, count);
+        _bufferPosition = count;
     }
-}
\ No newline at end of file
+}
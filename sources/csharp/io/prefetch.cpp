@@ -0,0 +1,342 @@
+#include "csharp/io/prefetch.hpp"
+#include "csharp/io/exception.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace csharp {
+	PrefetchStream::PrefetchStream(std::shared_ptr<Stream> const& source, int32_t bufferSize, int32_t bufferCount, bool leaveOpen)
+		: _source(source), _leaveOpen(leaveOpen)
+	{
+		ArgumentNullException::ThrowIfNull(source.get(), "source");
+		ArgumentOutOfRangeException::ThrowIfNegative(bufferSize, "bufferSize");
+		ArgumentOutOfRangeException::ThrowIfNegative(bufferCount, "bufferCount");
+
+		if (!source->CanRead())
+			throw ArgumentException(SR::Argument_StreamNotReadable);
+
+		_bufferSize = (std::max)(bufferSize, 4096);
+		_bufferCount = (std::max)(bufferCount, 2);
+		_canSeek = source->CanSeek();
+
+		if (_canSeek) {
+			_length = source->Length();
+			_position = source->Position();
+		}
+
+		auto& pool = ArrayPool<uint8_t>::Shared();
+		_free.reserve(static_cast<size_t>(_bufferCount));
+
+		for (int32_t i = 0; i < _bufferCount; ++i)
+			_free.emplace_back(pool.Rent(static_cast<size_t>(_bufferSize)));
+
+		StartWorker();
+	}
+
+	PrefetchStream::~PrefetchStream() {
+		try {
+			Close();
+		}
+		catch (...) {
+		}
+	}
+
+	void PrefetchStream::EnsureNotClosed() const {
+		if (_closed)
+			throw InvalidOperationException(SR::ObjectDisposed_StreamClosed);
+	}
+
+	int64_t PrefetchStream::Length() const {
+		EnsureNotClosed();
+
+		if (!_canSeek)
+			throw NotSupportedException(SR::NotSupported_UnseekableStream);
+
+		return _length;
+	}
+
+	int64_t PrefetchStream::Position() const {
+		EnsureNotClosed();
+
+		if (!_canSeek)
+			throw NotSupportedException(SR::NotSupported_UnseekableStream);
+
+		return _position;
+	}
+
+	void PrefetchStream::Position(int64_t value) {
+		ArgumentOutOfRangeException::ThrowIfNegative(value, "value");
+		Seek(value, SeekOrigin::Begin);
+	}
+
+	void PrefetchStream::Close() {
+		if (_closed)
+			return;
+
+		StopWorker();
+
+		auto& pool = ArrayPool<uint8_t>::Shared();
+
+		if (!_current.Data.empty())
+			pool.Return(std::move(_current.Data));
+
+		for (auto& chunk : _filled)
+			pool.Return(std::move(chunk.Data));
+
+		for (auto& buffer : _free)
+			pool.Return(std::move(buffer));
+
+		_filled.clear();
+		_free.clear();
+		_closed = true;
+
+		if (!_leaveOpen)
+			_source->Close();
+	}
+
+	int64_t PrefetchStream::Seek(int64_t offset, SeekOrigin origin) {
+		EnsureNotClosed();
+
+		if (!_canSeek)
+			throw NotSupportedException(SR::NotSupported_UnseekableStream);
+
+		int64_t target = 0;
+
+		switch (origin)
+		{
+		case SeekOrigin::Begin:
+			target = offset;
+			break;
+		case SeekOrigin::Current:
+			target = _position + offset;
+			break;
+		case SeekOrigin::End:
+			target = _length + offset;
+			break;
+		default:
+			throw ArgumentException(SR::Argument_InvalidSeekOrigin);
+		}
+
+		if (target < 0)
+			throw IOException(SR::IO_SeekBeforeBegin);
+
+		if (SeekBuffered(target))
+			return _position;
+
+		StopWorker();
+
+		if (!_current.Data.empty())
+			_free.emplace_back(std::move(_current.Data));
+
+		for (auto& chunk : _filled)
+			_free.emplace_back(std::move(chunk.Data));
+
+		_filled.clear();
+		_current = Chunk();
+		_currentOffset = 0;
+		_endOfStream = false;
+		_error = nullptr;
+
+		_source->Seek(target, SeekOrigin::Begin);
+		_position = target;
+
+		StartWorker();
+
+		return _position;
+	}
+
+	void PrefetchStream::SetLength(int64_t value) {
+		throw NotSupportedException(SR::NotSupported_UnwritableStream);
+	}
+
+	int32_t PrefetchStream::Read(uint8_t* buffer, int32_t bufferLength, int32_t offset, int32_t count) {
+		ValidateBuffer(buffer, bufferLength);
+		ArgumentOutOfRangeException::ThrowIfNegative(offset, "offset");
+		ArgumentOutOfRangeException::ThrowIfNegative(count, "count");
+
+		if (bufferLength - offset < count)
+			throw ArgumentException(SR::Argument_InvalidOffLen);
+
+		EnsureNotClosed();
+
+		int32_t totalRead = 0;
+
+		while (totalRead < count) {
+			if (_currentOffset >= _current.Length && !NextChunk())
+				break;
+
+			const auto n = (std::min)(count - totalRead, _current.Length - _currentOffset);
+			std::memcpy(buffer + offset + totalRead, _current.Data.data() + _currentOffset, static_cast<size_t>(n));
+
+			_currentOffset += n;
+			totalRead += n;
+		}
+
+		_position += totalRead;
+		return totalRead;
+	}
+
+	int32_t PrefetchStream::Read(uint8_t* buffer, int32_t bufferLength) {
+		return Read(buffer, bufferLength, 0, bufferLength);
+	}
+
+	int32_t PrefetchStream::ReadByte() {
+		EnsureNotClosed();
+
+		if (_currentOffset >= _current.Length && !NextChunk())
+			return -1;
+
+		++_position;
+		return _current.Data[_currentOffset++];
+	}
+
+	void PrefetchStream::Write(uint8_t const* buffer, int32_t bufferLength, int32_t offset, int32_t count) {
+		throw NotSupportedException(SR::NotSupported_UnwritableStream);
+	}
+
+	void PrefetchStream::WriteByte(uint8_t value) {
+		throw NotSupportedException(SR::NotSupported_UnwritableStream);
+	}
+
+	bool PrefetchStream::NextChunk() {
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		if (!_current.Data.empty()) {
+			_free.emplace_back(std::move(_current.Data));
+			_current = Chunk();
+			_currentOffset = 0;
+			_freeCondition.notify_one();
+		}
+
+		_filledCondition.wait(lock, [this] { return !_filled.empty() || _endOfStream; });
+
+		if (_filled.empty()) {
+			if (_error)
+				std::rethrow_exception(_error);
+
+			return false;
+		}
+
+		_current = std::move(_filled.front());
+		_filled.pop_front();
+		_currentOffset = 0;
+
+		return _current.Length > 0;
+	}
+
+	bool PrefetchStream::SeekBuffered(int64_t target) {
+		//The current chunk starts where the consumer position was before reading from it.
+		auto chunkStart = _position - _currentOffset;
+
+		if (target >= chunkStart && target <= chunkStart + _current.Length) {
+			_currentOffset = static_cast<int32_t>(target - chunkStart);
+			_position = target;
+			return true;
+		}
+
+		if (target < chunkStart)
+			return false;
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		chunkStart += _current.Length;
+		size_t index = 0;
+
+		while (index < _filled.size() && target > chunkStart + _filled[index].Length) {
+			chunkStart += _filled[index].Length;
+			++index;
+		}
+
+		if (index == _filled.size())
+			return false;
+
+		//Hands the skipped buffers back to the worker, so it keeps reading ahead of the new position.
+		if (!_current.Data.empty())
+			_free.emplace_back(std::move(_current.Data));
+
+		for (size_t i = 0; i < index; ++i)
+			_free.emplace_back(std::move(_filled[i].Data));
+
+		_current = std::move(_filled[index]);
+		_filled.erase(_filled.begin(), _filled.begin() + static_cast<std::ptrdiff_t>(index) + 1);
+		_currentOffset = static_cast<int32_t>(target - chunkStart);
+		_position = target;
+
+		lock.unlock();
+		_freeCondition.notify_one();
+
+		return true;
+	}
+
+	void PrefetchStream::StartWorker() {
+		_stopping = false;
+		_worker = std::thread(&PrefetchStream::Fill, this);
+	}
+
+	void PrefetchStream::StopWorker() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stopping = true;
+		}
+
+		_freeCondition.notify_all();
+
+		if (_worker.joinable())
+			_worker.join();
+	}
+
+	void PrefetchStream::Fill() {
+		while (true) {
+			std::vector<uint8_t> buffer;
+
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_freeCondition.wait(lock, [this] { return !_free.empty() || _stopping; });
+
+				if (_stopping)
+					return;
+
+				buffer = std::move(_free.back());
+				_free.pop_back();
+			}
+
+			int32_t length = 0;
+			auto endOfStream = false;
+
+			try {
+				while (length < _bufferSize) {
+					const auto n = _source->Read(buffer.data(), _bufferSize, length, _bufferSize - length);
+
+					if (n <= 0) {
+						endOfStream = true;
+						break;
+					}
+
+					length += n;
+				}
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				_free.emplace_back(std::move(buffer));
+				_error = std::current_exception();
+				_endOfStream = true;
+				_filledCondition.notify_one();
+				return;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+
+				if (length > 0)
+					_filled.push_back(Chunk{ std::move(buffer), length });
+				else
+					_free.emplace_back(std::move(buffer));
+
+				_endOfStream = endOfStream;
+			}
+
+			_filledCondition.notify_one();
+
+			if (endOfStream)
+				return;
+		}
+	}
+}
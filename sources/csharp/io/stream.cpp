@@ -1,7 +1,9 @@
 #include "csharp/io/stream.hpp"
 #include "csharp/io/exception.hpp"
+#include "csharp/buffers/arraypool.hpp"
 #include <vector>
 #include <cstdint>
+#include <cstring>
 #include <cmath>
 #include <filesystem>
 #include <string>
@@ -24,13 +26,14 @@ namespace csharp {
 			throw InvalidOperationException(SR::ObjectDisposed_StreamClosed);
 		}
 
-		auto buffer = std::vector<byte>(bufferLength);
+		auto buffer = PooledArray<byte>(bufferLength);
+		const auto length = static_cast<int32_t>(buffer.Length());
 
 		int32_t bytesRead = 0;
 
-		while ((bytesRead = Read(buffer.data(), static_cast<int32_t>(buffer.size()), 0, static_cast<int32_t>(buffer.size()))) != 0)
+		while ((bytesRead = Read(buffer.Data(), length, 0, length)) > 0)
 		{
-			destination.Write(buffer.data(), static_cast<int32_t>(buffer.size()), 0, bytesRead);
+			destination.Write(buffer.Data(), length, 0, bytesRead);
 		}
 	}
 
@@ -64,17 +67,13 @@ namespace csharp {
 	int32_t Stream::Read(uint8_t* buffer, int32_t bufferLength) {
 		ValidateBuffer(buffer, bufferLength);
 
-		auto sharedBuffer = std::vector<byte>(bufferLength);
-		auto numRead = Read(sharedBuffer.data(), bufferLength, 0, bufferLength);
+		auto numRead = Read(buffer, bufferLength, 0, bufferLength);
 
 		if (numRead > bufferLength)
 		{
 			throw IOException(SR::IO_StreamTooLong);
 		}
 
-		for (size_t i = 0; i < numRead; ++i)
-			buffer[i] = sharedBuffer[i];
-
 		return numRead;
 	}
 
@@ -91,8 +90,8 @@ namespace csharp {
 		int32_t totalRead = 0;
 		while (totalRead < minimumBytes)
 		{
-			auto read = Read(buffer, bufferLength);
-			if (read == 0)
+			auto read = Read(buffer + totalRead, bufferLength - totalRead);
+			if (read <= 0)
 			{
 				if (throwOnEndOfStream)
 				{
@@ -111,12 +110,7 @@ namespace csharp {
 	void Stream::Write(uint8_t const* buffer, int32_t bufferLength) {
 		ValidateBuffer(buffer, bufferLength);
 
-		auto sharedBuffer = std::vector<byte>(bufferLength);
-
-		for (size_t i = 0; i < bufferLength; ++i)
-			sharedBuffer[i] = buffer[i];
-
-		Write(sharedBuffer.data(), bufferLength, 0, bufferLength);
+		Write(buffer, bufferLength, 0, bufferLength);
 	}
 
 	void Stream::ValidateBuffer(uint8_t const* buffer, int32_t bufferLength) {
@@ -280,8 +274,7 @@ namespace csharp {
 		if (n <= 0)
 			return 0;
 
-		for (size_t i = 0; i < n; ++i)
-			buffer[i] = _buffer[i];
+		std::memmove(buffer, _buffer.data() + _position, n);
 
 		_position += n;
 
@@ -470,11 +463,8 @@ namespace csharp {
 			_length = i;
 		}
 
-		//TODO: Verificar se est correto e verificar os std::memmove
 		//buffer.CopyTo(new Span<byte>(_buffer, _position, buffer.Length));
-		for (size_t x = _position; x < bufferLength; ++i) {
-			_buffer[x] = buffer[x];
-		}
+		std::memmove(_buffer.data() + _position, buffer, bufferLength);
 
 		_position = i;
 	}
@@ -606,8 +596,8 @@ namespace csharp {
 
 	void FileStream::Position(int64_t value) {
 		EnsureNotClosed();
-		const auto _position = static_cast<std::streampos>(value);
-		stream.seekg(_position);
+		stream.seekg(static_cast<std::streampos>(value));
+		_position = stream.tellg();
 	}
 
 	void FileStream::CopyTo(Stream& destination, int32_t bufferLength) {
@@ -621,12 +611,13 @@ namespace csharp {
 			throw InvalidOperationException(SR::ObjectDisposed_StreamClosed);
 		}
 
-		auto buffer = std::vector<byte>(bufferLength);
+		auto buffer = PooledArray<byte>(bufferLength);
+		const auto length = static_cast<int32_t>(buffer.Length());
 		int32_t bytesRead = 0;
 
-		while ((bytesRead = Read(buffer.data(), bufferLength, 0, bufferLength)) != 0)
+		while ((bytesRead = Read(buffer.Data(), length, 0, length)) > 0)
 		{
-			destination.Write(buffer.data(), bufferLength, 0, bytesRead);
+			destination.Write(buffer.Data(), length, 0, bytesRead);
 		}
 	}
 
@@ -665,11 +656,19 @@ namespace csharp {
 		auto buff = reinterpret_cast<char*>(buffer);
 		stream.read(buff + offset, count);
 
-		if (stream.rdstate() != std::fstream::goodbit) {
+		if (stream.bad()) {
 			return -1;
 		}
 
-		return static_cast<int32_t>(stream.gcount());
+		const auto read = stream.gcount();
+
+		//A short read at the end of the file still returns the bytes that were read.
+		if (stream.eof())
+			stream.clear();
+
+		_position += read;
+
+		return static_cast<int32_t>(read);
 	}
 
 	int32_t FileStream::Read(uint8_t* buffer, int32_t bufferLength) {
@@ -684,9 +683,14 @@ namespace csharp {
 		stream.read(&c, 1);
 
 		if (stream.rdstate() != std::fstream::goodbit) {
+			if (stream.eof())
+				stream.clear();
+
 			return -1;
 		}
 
+		_position += 1;
+
 		const auto uchar = static_cast<unsigned char>(c);
 		const auto result = static_cast<int32_t>(uchar);
 
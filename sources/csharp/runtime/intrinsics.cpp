@@ -0,0 +1,115 @@
+#include "csharp/runtime/intrinsics.hpp"
+#include <cstdint>
+
+#if defined(CSHARP_INTRINSICS_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace csharp {
+	struct X86Features {
+		bool Sse41{ false };
+		bool Avx2{ false };
+		bool Fma{ false };
+		bool F16c{ false };
+		bool Avx512{ false };
+
+		static X86Features const& Current() {
+			static const X86Features features = Detect();
+			return features;
+		}
+
+	private:
+		static X86Features Detect() {
+			X86Features features;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			int info[4]{};
+			CpuId(info, 0, 0);
+			const auto maxLeaf = info[0];
+
+			if (maxLeaf < 1)
+				return features;
+
+			CpuId(info, 1, 0);
+			const auto ecx1 = static_cast<uint32_t>(info[2]);
+
+			features.Sse41 = (ecx1 & (1u << 19)) != 0;
+
+			//AVX state must be enabled by the operating system before any 256-bit instruction is used.
+			const auto osxsave = (ecx1 & (1u << 27)) != 0;
+			const auto avx = (ecx1 & (1u << 28)) != 0;
+
+			if (!osxsave || !avx)
+				return features;
+
+			const auto xcr0 = XGetBv();
+			const auto ymmEnabled = (xcr0 & 0x6) == 0x6;
+			const auto zmmEnabled = (xcr0 & 0xE6) == 0xE6;
+
+			if (!ymmEnabled)
+				return features;
+
+			features.Fma = (ecx1 & (1u << 12)) != 0;
+			features.F16c = (ecx1 & (1u << 29)) != 0;
+
+			if (maxLeaf >= 7) {
+				CpuId(info, 7, 0);
+				const auto ebx7 = static_cast<uint32_t>(info[1]);
+
+				features.Avx2 = (ebx7 & (1u << 5)) != 0;
+				features.Avx512 = zmmEnabled && (ebx7 & (1u << 16)) != 0;
+			}
+#endif
+			return features;
+		}
+
+#if defined(CSHARP_INTRINSICS_X86)
+		static void CpuId(int info[4], int leaf, int subleaf) {
+#if defined(_MSC_VER)
+			__cpuidex(info, leaf, subleaf);
+#else
+			unsigned int a = 0, b = 0, c = 0, d = 0;
+			__cpuid_count(leaf, subleaf, a, b, c, d);
+			info[0] = static_cast<int>(a);
+			info[1] = static_cast<int>(b);
+			info[2] = static_cast<int>(c);
+			info[3] = static_cast<int>(d);
+#endif
+		}
+
+		static uint64_t XGetBv() {
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			uint32_t eax = 0, edx = 0;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+		}
+#endif
+	};
+
+	bool X86Intrinsics::IsSse41Supported() {
+		return X86Features::Current().Sse41;
+	}
+
+	bool X86Intrinsics::IsAvx2Supported() {
+		return X86Features::Current().Avx2;
+	}
+
+	bool X86Intrinsics::IsFmaSupported() {
+		return X86Features::Current().Fma;
+	}
+
+	bool X86Intrinsics::IsF16cSupported() {
+		return X86Features::Current().F16c;
+	}
+
+	bool X86Intrinsics::IsAvx512Supported() {
+		return X86Features::Current().Avx512;
+	}
+}
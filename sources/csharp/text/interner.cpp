@@ -0,0 +1,48 @@
+#include "csharp/text/interner.hpp"
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
+namespace csharp {
+	namespace {
+		//Nodes of an unordered_set are never moved by a rehash, so references to the strings stay valid.
+		struct InternPool {
+			std::shared_mutex mutex;
+			std::unordered_set<std::string, StringInterner::Hash, std::equal_to<>> strings;
+		};
+
+		InternPool& Pool() {
+			static InternPool pool;
+			return pool;
+		}
+	}
+
+	std::string const& StringInterner::Intern(std::string_view value) {
+		auto& pool = Pool();
+
+		{
+			std::shared_lock<std::shared_mutex> lock(pool.mutex);
+			const auto it = pool.strings.find(value);
+
+			if (it != pool.strings.end())
+				return *it;
+		}
+
+		std::unique_lock<std::shared_mutex> lock(pool.mutex);
+		return *pool.strings.emplace(value).first;
+	}
+
+	std::string const* StringInterner::IsInterned(std::string_view value) {
+		auto& pool = Pool();
+		std::shared_lock<std::shared_mutex> lock(pool.mutex);
+		const auto it = pool.strings.find(value);
+
+		return it != pool.strings.end() ? &*it : nullptr;
+	}
+
+	size_t StringInterner::Count() {
+		auto& pool = Pool();
+		std::shared_lock<std::shared_mutex> lock(pool.mutex);
+		return pool.strings.size();
+	}
+}
@@ -0,0 +1,452 @@
+#include "csharp/text/unicode.hpp"
+#include "csharp/runtime/intrinsics.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace csharp {
+#if defined(CSHARP_INTRINSICS_X86)
+	//Vector kernels for runs of ASCII. Each one stops at the first non-ASCII code unit of a block
+	//and leaves the remaining tail, shorter than one block, to the caller.
+	struct AsciiKernels {
+		inline static const bool UseAvx2 = X86Intrinsics::IsAvx2Supported();
+
+		CSHARP_TARGET("sse2")
+		static size_t SkipSse2(uint8_t const* source, size_t count) {
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				const auto block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i));
+				const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(block));
+
+				if (mask != 0)
+					return i + static_cast<size_t>(std::countr_zero(mask));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t SkipAvx2(uint8_t const* source, size_t count) {
+			size_t i = 0;
+
+			for (; i + 64 <= count; i += 64) {
+				const auto block0 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(source + i));
+				const auto block1 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(source + i + 32));
+
+				if (_mm256_movemask_epi8(_mm256_or_si256(block0, block1)) != 0)
+					break;
+			}
+
+			for (; i + 32 <= count; i += 32) {
+				const auto block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(source + i));
+				const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(block));
+
+				if (mask != 0)
+					return i + static_cast<size_t>(std::countr_zero(mask));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("sse2")
+		static size_t WidenSse2(uint8_t const* source, char16_t* destination, size_t count) {
+			const auto zero = _mm_setzero_si128();
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				const auto block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i));
+				const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(block));
+
+				//The whole block is stored, the caller guarantees room for count code units.
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_unpacklo_epi8(block, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 8), _mm_unpackhi_epi8(block, zero));
+
+				if (mask != 0)
+					return i + static_cast<size_t>(std::countr_zero(mask));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t WidenAvx2(uint8_t const* source, char16_t* destination, size_t count) {
+			size_t i = 0;
+
+			for (; i + 32 <= count; i += 32) {
+				const auto block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(source + i));
+				const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(block));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(block)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(block, 1)));
+
+				if (mask != 0)
+					return i + static_cast<size_t>(std::countr_zero(mask));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("sse2")
+		static size_t NarrowSse2(char16_t const* source, uint8_t* destination, size_t count) {
+			const auto nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+			const auto zero = _mm_setzero_si128();
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				const auto low = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i));
+				const auto high = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i + 8));
+				const auto combined = _mm_and_si128(_mm_or_si128(low, high), nonAsciiMask);
+
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(combined, zero)) != 0xFFFF)
+					break;
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(low, high));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t NarrowAvx2(char16_t const* source, uint8_t* destination, size_t count) {
+			const auto nonAsciiMask = _mm256_set1_epi16(static_cast<short>(0xFF80));
+			size_t i = 0;
+
+			for (; i + 32 <= count; i += 32) {
+				const auto low = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(source + i));
+				const auto high = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(source + i + 16));
+
+				if (!_mm256_testz_si256(_mm256_or_si256(low, high), nonAsciiMask))
+					break;
+
+				//packus works per 128-bit lane, so the 64-bit quarters are put back in order afterwards.
+				const auto packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), packed);
+			}
+
+			return i;
+		}
+	};
+#endif
+
+	size_t Utf8::GetIndexOfFirstNonAsciiByte(uint8_t const* utf8, size_t length) {
+		size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+		i = AsciiKernels::UseAvx2
+			? AsciiKernels::SkipAvx2(utf8, length)
+			: AsciiKernels::SkipSse2(utf8, length);
+#endif
+
+		while (i < length && utf8[i] < 0x80u)
+			++i;
+
+		return i;
+	}
+
+	size_t Utf8::GetIndexOfFirstInvalidByte(uint8_t const* utf8, size_t length) {
+		size_t i = 0;
+
+		while (i < length) {
+			i += GetIndexOfFirstNonAsciiByte(utf8 + i, length - i);
+
+			if (i >= length)
+				break;
+
+			//Non-ASCII text tends to stay non-ASCII, so the scalar loop runs until the next ASCII byte.
+			do {
+				uint32_t scalar = 0;
+				const auto n = DecodeScalar(utf8 + i, length - i, scalar);
+
+				if (n <= 0)
+					return i;
+
+				i += static_cast<size_t>(n);
+			} while (i < length && utf8[i] >= 0x80u);
+		}
+
+		return length;
+	}
+
+	size_t Utf8::WidenAscii(uint8_t const* source, char16_t* destination, size_t count) {
+		size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+		i = AsciiKernels::UseAvx2
+			? AsciiKernels::WidenAvx2(source, destination, count)
+			: AsciiKernels::WidenSse2(source, destination, count);
+#endif
+
+		for (; i < count && source[i] < 0x80u; ++i)
+			destination[i] = static_cast<char16_t>(source[i]);
+
+		return i;
+	}
+
+	size_t Utf8::NarrowAscii(char16_t const* source, uint8_t* destination, size_t count) {
+		size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+		i = AsciiKernels::UseAvx2
+			? AsciiKernels::NarrowAvx2(source, destination, count)
+			: AsciiKernels::NarrowSse2(source, destination, count);
+#endif
+
+		for (; i < count && source[i] < 0x80u; ++i)
+			destination[i] = static_cast<uint8_t>(source[i]);
+
+		return i;
+	}
+
+	OperationStatus Utf8::ToUtf16(uint8_t const* source, size_t sourceLength, char16_t* destination, size_t destinationLength,
+		size_t& bytesRead, size_t& charsWritten, bool replaceInvalidSequences, bool isFinalBlock) {
+		auto src = source;
+		auto dst = destination;
+		const auto srcEnd = source + sourceLength;
+		const auto dstEnd = destination + destinationLength;
+		auto status = OperationStatus::Done;
+
+		while (src < srcEnd) {
+			if (*src < 0x80u) {
+				const auto count = (std::min)(static_cast<size_t>(srcEnd - src), static_cast<size_t>(dstEnd - dst));
+
+				if (count == 0) {
+					status = OperationStatus::DestinationTooSmall;
+					break;
+				}
+
+				const auto n = WidenAscii(src, dst, count);
+				src += n;
+				dst += n;
+				continue;
+			}
+
+			uint32_t scalar = 0;
+			auto n = DecodeScalar(src, static_cast<size_t>(srcEnd - src), scalar);
+
+			if (n == 0) {
+				if (!isFinalBlock) {
+					status = OperationStatus::NeedMoreData;
+					break;
+				}
+
+				//A truncated sequence at the end of the input is a single maximal subpart.
+				n = -static_cast<int32_t>(srcEnd - src);
+			}
+
+			if (n < 0) {
+				if (!replaceInvalidSequences) {
+					status = OperationStatus::InvalidData;
+					break;
+				}
+
+				if (dst == dstEnd) {
+					status = OperationStatus::DestinationTooSmall;
+					break;
+				}
+
+				*dst++ = static_cast<char16_t>(UnicodeUtility::ReplacementChar);
+				src += -n;
+				continue;
+			}
+
+			if (scalar < 0x10000u) {
+				if (dst == dstEnd) {
+					status = OperationStatus::DestinationTooSmall;
+					break;
+				}
+
+				*dst++ = static_cast<char16_t>(scalar);
+			}
+			else {
+				if (dstEnd - dst < 2) {
+					status = OperationStatus::DestinationTooSmall;
+					break;
+				}
+
+				UnicodeUtility::GetUtf16SurrogatesFromSupplementaryPlaneScalar(scalar, dst[0], dst[1]);
+				dst += 2;
+			}
+
+			src += n;
+		}
+
+		bytesRead = static_cast<size_t>(src - source);
+		charsWritten = static_cast<size_t>(dst - destination);
+		return status;
+	}
+
+	OperationStatus Utf8::FromUtf16(char16_t const* source, size_t sourceLength, uint8_t* destination, size_t destinationLength,
+		size_t& charsRead, size_t& bytesWritten, bool replaceInvalidSequences, bool isFinalBlock) {
+		auto src = source;
+		auto dst = destination;
+		const auto srcEnd = source + sourceLength;
+		const auto dstEnd = destination + destinationLength;
+		auto status = OperationStatus::Done;
+
+		while (src < srcEnd) {
+			if (*src < 0x80u) {
+				const auto count = (std::min)(static_cast<size_t>(srcEnd - src), static_cast<size_t>(dstEnd - dst));
+
+				if (count == 0) {
+					status = OperationStatus::DestinationTooSmall;
+					break;
+				}
+
+				const auto n = NarrowAscii(src, dst, count);
+				src += n;
+				dst += n;
+				continue;
+			}
+
+			uint32_t scalar = *src;
+			size_t consumed = 1;
+
+			if (UnicodeUtility::IsSurrogateCodePoint(scalar)) {
+				const auto hasNext = src + 1 < srcEnd;
+
+				if (UnicodeUtility::IsHighSurrogateCodePoint(scalar) && hasNext && UnicodeUtility::IsLowSurrogateCodePoint(src[1])) {
+					scalar = UnicodeUtility::GetScalarFromUtf16SurrogatePair(scalar, src[1]);
+					consumed = 2;
+				}
+				else if (UnicodeUtility::IsHighSurrogateCodePoint(scalar) && !hasNext && !isFinalBlock) {
+					status = OperationStatus::NeedMoreData;
+					break;
+				}
+				else if (!replaceInvalidSequences) {
+					status = OperationStatus::InvalidData;
+					break;
+				}
+				else {
+					scalar = UnicodeUtility::ReplacementChar;
+				}
+			}
+
+			if (dstEnd - dst < UnicodeUtility::GetUtf8SequenceLength(scalar)) {
+				status = OperationStatus::DestinationTooSmall;
+				break;
+			}
+
+			dst += EncodeScalar(scalar, dst);
+			src += consumed;
+		}
+
+		charsRead = static_cast<size_t>(src - source);
+		bytesWritten = static_cast<size_t>(dst - destination);
+		return status;
+	}
+
+	std::u16string Utf8::ToUtf16String(std::string_view utf8) {
+		//A UTF-8 byte never decodes to more than one UTF-16 code unit.
+		std::u16string result(utf8.size(), u'\0');
+		size_t bytesRead = 0;
+		size_t charsWritten = 0;
+
+		ToUtf16(reinterpret_cast<uint8_t const*>(utf8.data()), utf8.size(), result.data(), result.size(), bytesRead, charsWritten);
+
+		result.resize(charsWritten);
+		return result;
+	}
+
+	std::string Utf8::FromUtf16String(std::u16string_view utf16) {
+		//A UTF-16 code unit never encodes to more than three UTF-8 bytes.
+		std::string result(utf16.size() * 3, '\0');
+		size_t charsRead = 0;
+		size_t bytesWritten = 0;
+
+		FromUtf16(utf16.data(), utf16.size(), reinterpret_cast<uint8_t*>(result.data()), result.size(), charsRead, bytesWritten);
+
+		result.resize(bytesWritten);
+		return result;
+	}
+
+	std::wstring Utf8::ToWString(std::string_view utf8) {
+		std::wstring result;
+		ToWString(utf8, result);
+		return result;
+	}
+
+	void Utf8::ToWString(std::string_view utf8, std::wstring& destination) {
+		destination.resize(utf8.size());
+
+		auto src = reinterpret_cast<uint8_t const*>(utf8.data());
+		size_t written = 0;
+
+		if constexpr (sizeof(wchar_t) == sizeof(char16_t)) {
+			size_t bytesRead = 0;
+			ToUtf16(src, utf8.size(), reinterpret_cast<char16_t*>(destination.data()), destination.size(), bytesRead, written);
+		}
+		else {
+			size_t i = 0;
+
+			while (i < utf8.size()) {
+				uint32_t scalar = 0;
+				auto n = DecodeScalar(src + i, utf8.size() - i, scalar);
+
+				if (n == 0)
+					n = -static_cast<int32_t>(utf8.size() - i);
+
+				if (n < 0) {
+					scalar = UnicodeUtility::ReplacementChar;
+					n = -n;
+				}
+
+				destination[written++] = static_cast<wchar_t>(scalar);
+				i += static_cast<size_t>(n);
+			}
+		}
+
+		destination.resize(written);
+	}
+
+	std::string Utf8::FromWString(std::wstring_view wide) {
+		if constexpr (sizeof(wchar_t) == sizeof(char16_t)) {
+			return FromUtf16String(std::u16string_view(reinterpret_cast<char16_t const*>(wide.data()), wide.size()));
+		}
+		else {
+			std::string result(wide.size() * 4, '\0');
+			auto dst = reinterpret_cast<uint8_t*>(result.data());
+			size_t written = 0;
+
+			for (const auto ch : wide) {
+				auto scalar = static_cast<uint32_t>(ch);
+
+				if (!UnicodeUtility::IsValidUnicodeScalar(scalar))
+					scalar = UnicodeUtility::ReplacementChar;
+
+				written += static_cast<size_t>(EncodeScalar(scalar, dst + written));
+			}
+
+			result.resize(written);
+			return result;
+		}
+	}
+
+	std::string Utf8::ReplaceInvalidSequences(std::string_view utf8) {
+		constexpr char ReplacementCharUtf8[] = "\xEF\xBF\xBD";
+
+		std::string result;
+		result.reserve(utf8.size() + 8);
+
+		auto src = reinterpret_cast<uint8_t const*>(utf8.data());
+		const auto length = utf8.size();
+		size_t i = 0;
+
+		while (i < length) {
+			const auto valid = GetIndexOfFirstInvalidByte(src + i, length - i);
+			result.append(utf8.data() + i, valid);
+			i += valid;
+
+			if (i >= length)
+				break;
+
+			uint32_t scalar = 0;
+			const auto n = DecodeScalar(src + i, length - i, scalar);
+
+			result.append(ReplacementCharUtf8, 3);
+			i += n == 0 ? length - i : static_cast<size_t>(-n);
+		}
+
+		return result;
+	}
+}
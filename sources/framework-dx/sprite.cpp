@@ -1,4 +1,5 @@
 #include "xna-dx/framework.hpp"
+#include "csharp/text/unicode.hpp"
 
 using DxSpriteBatch = DirectX::SpriteBatch;
 using DxSpriteSortMode = DirectX::SpriteSortMode;
@@ -71,7 +72,11 @@ namespace xna {
 	}	
 
 	Vector2 SpriteFont::MeasureString(String const& text, bool ignoreWhiteSpace) {
-		const auto size = Implementation->SpriteFont->MeasureString(text.c_str(), ignoreWhiteSpace);
+		//DirectXTK converts UTF-8 input into a new wide string on every call; this reuses one per thread.
+		thread_local std::wstring wtext;
+		csharp::Utf8::ToWString(text, wtext);
+
+		const auto size = Implementation->SpriteFont->MeasureString(wtext.c_str(), ignoreWhiteSpace);
 		Vector2 vec2{};
 		vec2.X = size.m128_f32[0];
 		vec2.Y = size.m128_f32[1];
@@ -312,9 +317,12 @@ namespace xna {
 		const auto v4 = color.ToVector4();
 		const XMVECTORF32 _color = { v4.X, v4.Y, v4.Z, v4.W };
 
+		thread_local std::wstring wtext;
+		csharp::Utf8::ToWString(text, wtext);
+
 		spriteFont.Implementation->SpriteFont->DrawString(
 			Implementation->SpriteBatch.get(),
-			text.c_str(),
+			wtext.c_str(),
 			_position,
 			_color
 		);
@@ -328,9 +336,12 @@ namespace xna {
 		const XMVECTORF32 _color = { v4.X, v4.Y, v4.Z, v4.W };
 		const auto _effects = static_cast<DxSpriteEffects>(effects);
 
+		thread_local std::wstring wtext;
+		csharp::Utf8::ToWString(text, wtext);
+
 		spriteFont.Implementation->SpriteFont->DrawString(
 			Implementation->SpriteBatch.get(),
-			text.c_str(),
+			wtext.c_str(),
 			_position,
 			_color,
 			rotation,
@@ -139,7 +139,7 @@ namespace xna {
 			throw csharp::InvalidOperationException();
 	}	
 
-	void Texture2D::SetData(Int level, Rectangle* rect, std::vector<Byte> const& data, size_t startIndex, size_t elementCount)
+	void Texture2D::SetData(Int level, Rectangle* rect, std::span<const Byte> data, size_t startIndex, size_t elementCount)
 	{
 		if (!BaseGraphicsDevice || !BaseGraphicsDevice->Implementation->Device || !BaseGraphicsDevice->Implementation->Context) {
 			throw csharp::InvalidOperationException();
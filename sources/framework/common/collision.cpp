@@ -1,43 +1,10 @@
 #include "xna/common/collision.hpp"
+#include "csharp/runtime/intrinsics.hpp"
+#include "csharp/threading/parallel.hpp"
+#include <algorithm>
+#include <bit>
 
 namespace xna {
-	Plane::Plane(Vector3 const& point1, Vector3 const& point2, Vector3 const& point3) {
-		const auto num1 = point2.X - point1.X;
-		const auto num2 = point2.Y - point1.Y;
-		const auto num3 = point2.Z - point1.Z;
-		const auto num4 = point3.X - point1.X;
-		const auto num5 = point3.Y - point1.Y;
-		const auto num6 = point3.Z - point1.Z;
-		const auto num7 = (num2 * num6 - num3 * num5);
-		const auto num8 = (num3 * num4 - num1 * num6);
-		const auto num9 = (num1 * num5 - num2 * num4);
-		const auto num10 = 1.0f / std::sqrt(num7 * num7 + num8 * num8 + num9 * num9);
-		Normal.X = num7 * num10;
-		Normal.Y = num8 * num10;
-		Normal.Z = num9 * num10;
-		D = -(Normal.X * point1.X + Normal.Y * point1.Y + Normal.Z * point1.Z);
-	}
-
-	void Plane::Normalize() {
-		const auto d = (Normal.X * Normal.X + Normal.Y * Normal.Y + Normal.Z * Normal.Z);
-		
-		if (std::abs(d - 1.0f) < 1.1920928955078125E-07)
-			return;
-
-		const auto num = 1.0f / std::sqrt(d);
-
-		Normal.X *= num;
-		Normal.Y *= num;
-		Normal.Z *= num;
-		D *= num;
-	}
-
-	Plane Plane::Normalize(Plane const& value) {
-		auto p = value;
-		p.Normalize();
-		return p;
-	}
-
 	std::optional<float> Plane::Intersects(Ray const& ray) const {
 		const auto num1 = (Normal.X * ray.Direction.X + Normal.Y * ray.Direction.Y + Normal.Z * ray.Direction.Z);
 
@@ -57,8 +24,8 @@ namespace xna {
 		return num3;
 	}
 
-	bool BoundingFrustum::Intersects(BoundingBox const& box) {
-		gjk.Reset();
+	bool BoundingFrustum::Intersects(BoundingBox const& box) const {
+		Gjk gjk;
 		Vector3 result1 = Vector3::Subtract(corners[0], box.Min);
 
 		if (result1.LengthSquared() < 9.9999997473787516E-06)
@@ -146,8 +113,8 @@ namespace xna {
 		return num4;
 	}
 
-	bool BoundingFrustum::Intersects(BoundingSphere const& sphere) {
-		gjk.Reset();
+	bool BoundingFrustum::Intersects(BoundingSphere const& sphere) const {
+		Gjk gjk;
 		auto result1 = Vector3::Subtract(corners[0], sphere.Center);
 
 		if (result1.LengthSquared() < 9.9999997473787516E-06)
@@ -192,8 +159,8 @@ namespace xna {
 		return true;
 	}
 
-	bool BoundingFrustum::Intersects(BoundingFrustum const& frustum) {
-		gjk.Reset();
+	bool BoundingFrustum::Intersects(BoundingFrustum const& frustum) const {
+		Gjk gjk;
 		Vector3 result1 = Vector3::Subtract(corners[0], frustum.corners[0]);
 
 		if (result1.LengthSquared() < 9.9999997473787516E-06)
@@ -236,7 +203,7 @@ namespace xna {
 		return true;
 	}
 
-	ContainmentType BoundingFrustum::Contains(BoundingFrustum const& frustum) {
+	ContainmentType BoundingFrustum::Contains(BoundingFrustum const& frustum) const {
 		ContainmentType containmentType = ContainmentType::Disjoint;
 
 		if (Intersects(frustum)) {
@@ -253,6 +220,513 @@ namespace xna {
 		return containmentType;
 	}
 
+	struct FrustumKernels {
+		//The volumes of a batch, read by index.
+		struct Boxes {
+			BoundingBox const* Values;
+		};
+
+		struct Spheres {
+			BoundingSphere const* Values;
+		};
+
+		struct BoxStreams {
+			float const* MinX;
+			float const* MinY;
+			float const* MinZ;
+			float const* MaxX;
+			float const* MaxY;
+			float const* MaxZ;
+		};
+
+		struct SphereStreams {
+			float const* X;
+			float const* Y;
+			float const* Z;
+			float const* Radius;
+		};
+
+		static ContainmentType Cull(BoundingFrustum const& frustum, BoundingBox const& box) {
+			auto planeMask = BoundingFrustum::AllPlanes;
+			uint8_t lastPlane = 0;
+			return frustum.Cull(box, planeMask, lastPlane);
+		}
+
+		static ContainmentType Cull(BoundingFrustum const& frustum, BoundingSphere const& sphere) {
+			auto planeMask = BoundingFrustum::AllPlanes;
+			uint8_t lastPlane = 0;
+			return frustum.Cull(sphere, planeMask, lastPlane);
+		}
+
+		static ContainmentType Cull(BoundingFrustum const& frustum, Boxes const& source, size_t index) {
+			return Cull(frustum, source.Values[index]);
+		}
+
+		static ContainmentType Cull(BoundingFrustum const& frustum, Spheres const& source, size_t index) {
+			return Cull(frustum, source.Values[index]);
+		}
+
+		static ContainmentType Cull(BoundingFrustum const& frustum, BoxStreams const& source, size_t index) {
+			return Cull(frustum, BoundingBox(
+				Vector3(source.MinX[index], source.MinY[index], source.MinZ[index]),
+				Vector3(source.MaxX[index], source.MaxY[index], source.MaxZ[index])));
+		}
+
+		static ContainmentType Cull(BoundingFrustum const& frustum, SphereStreams const& source, size_t index) {
+			//Not through the constructor, which clamps negative radii and the SIMD tests do not.
+			BoundingSphere sphere;
+			sphere.Center = Vector3(source.X[index], source.Y[index], source.Z[index]);
+			sphere.Radius = source.Radius[index];
+			return Cull(frustum, sphere);
+		}
+
+#if defined(CSHARP_INTRINSICS_X86)
+		inline static const bool UseAvx2 = csharp::X86Intrinsics::IsAvx2Supported();
+
+		//The batch kernels store ContainmentType values as 32-bit integers.
+		static_assert(sizeof(ContainmentType) == 4 && static_cast<int>(ContainmentType::Disjoint) == 0
+			&& static_cast<int>(ContainmentType::Contains) == 1 && static_cast<int>(ContainmentType::Intersects) == 2);
+		static_assert(sizeof(BoundingBox) == 6 * sizeof(float) && sizeof(BoundingSphere) == 4 * sizeof(float));
+
+		CSHARP_TARGET("sse2")
+		static void Transpose4(__m128& row0, __m128& row1, __m128& row2, __m128& row3) {
+			const auto low01 = _mm_unpacklo_ps(row0, row1);
+			const auto low23 = _mm_unpacklo_ps(row2, row3);
+			const auto high01 = _mm_unpackhi_ps(row0, row1);
+			const auto high23 = _mm_unpackhi_ps(row2, row3);
+			row0 = _mm_shuffle_ps(low01, low23, _MM_SHUFFLE(1, 0, 1, 0));
+			row1 = _mm_shuffle_ps(low01, low23, _MM_SHUFFLE(3, 2, 3, 2));
+			row2 = _mm_shuffle_ps(high01, high23, _MM_SHUFFLE(1, 0, 1, 0));
+			row3 = _mm_shuffle_ps(high01, high23, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+
+		CSHARP_TARGET("avx2")
+		static void Transpose4(__m256& row0, __m256& row1, __m256& row2, __m256& row3) {
+			const auto low01 = _mm256_unpacklo_ps(row0, row1);
+			const auto low23 = _mm256_unpacklo_ps(row2, row3);
+			const auto high01 = _mm256_unpackhi_ps(row0, row1);
+			const auto high23 = _mm256_unpackhi_ps(row2, row3);
+			row0 = _mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(1, 0, 1, 0));
+			row1 = _mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(3, 2, 3, 2));
+			row2 = _mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(1, 0, 1, 0));
+			row3 = _mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+
+		//Sets outside in the lanes of the boxes in front of a plane, and crossing in the lanes of the boxes that cross a plane.
+		//Same corners and order of operations as Plane::Intersects.
+		CSHARP_TARGET("sse2")
+		static void TestBoxes(Plane const* planes, __m128 minX, __m128 minY, __m128 minZ, __m128 maxX, __m128 maxY, __m128 maxZ, __m128& outside, __m128& crossing) {
+			const auto zero = _mm_setzero_ps();
+			outside = zero;
+			crossing = zero;
+
+			for (size_t p = 0; p < BoundingFrustum::PlaneCount; ++p) {
+				const auto& plane = planes[p];
+				const auto normalX = _mm_set1_ps(plane.Normal.X);
+				const auto normalY = _mm_set1_ps(plane.Normal.Y);
+				const auto normalZ = _mm_set1_ps(plane.Normal.Z);
+				const auto d = _mm_set1_ps(plane.D);
+
+				const auto negative = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(normalX, plane.Normal.X >= 0.0f ? minX : maxX),
+					_mm_mul_ps(normalY, plane.Normal.Y >= 0.0f ? minY : maxY)),
+					_mm_mul_ps(normalZ, plane.Normal.Z >= 0.0f ? minZ : maxZ)), d);
+				const auto positive = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(normalX, plane.Normal.X >= 0.0f ? maxX : minX),
+					_mm_mul_ps(normalY, plane.Normal.Y >= 0.0f ? maxY : minY)),
+					_mm_mul_ps(normalZ, plane.Normal.Z >= 0.0f ? maxZ : minZ)), d);
+
+				outside = _mm_or_ps(outside, _mm_cmpgt_ps(negative, zero));
+				crossing = _mm_or_ps(crossing, _mm_cmpnlt_ps(positive, zero));
+			}
+		}
+
+		CSHARP_TARGET("avx2")
+		static void TestBoxes(Plane const* planes, __m256 minX, __m256 minY, __m256 minZ, __m256 maxX, __m256 maxY, __m256 maxZ, __m256& outside, __m256& crossing) {
+			const auto zero = _mm256_setzero_ps();
+			outside = zero;
+			crossing = zero;
+
+			for (size_t p = 0; p < BoundingFrustum::PlaneCount; ++p) {
+				const auto& plane = planes[p];
+				const auto normalX = _mm256_set1_ps(plane.Normal.X);
+				const auto normalY = _mm256_set1_ps(plane.Normal.Y);
+				const auto normalZ = _mm256_set1_ps(plane.Normal.Z);
+				const auto d = _mm256_set1_ps(plane.D);
+
+				const auto negative = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+					_mm256_mul_ps(normalX, plane.Normal.X >= 0.0f ? minX : maxX),
+					_mm256_mul_ps(normalY, plane.Normal.Y >= 0.0f ? minY : maxY)),
+					_mm256_mul_ps(normalZ, plane.Normal.Z >= 0.0f ? minZ : maxZ)), d);
+				const auto positive = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+					_mm256_mul_ps(normalX, plane.Normal.X >= 0.0f ? maxX : minX),
+					_mm256_mul_ps(normalY, plane.Normal.Y >= 0.0f ? maxY : minY)),
+					_mm256_mul_ps(normalZ, plane.Normal.Z >= 0.0f ? maxZ : minZ)), d);
+
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(negative, zero, _CMP_GT_OQ));
+				crossing = _mm256_or_ps(crossing, _mm256_cmp_ps(positive, zero, _CMP_NLT_UQ));
+			}
+		}
+
+		//Same as TestBoxes for spheres, with the order of operations of Plane::Intersects.
+		CSHARP_TARGET("sse2")
+		static void TestSpheres(Plane const* planes, __m128 x, __m128 y, __m128 z, __m128 radius, __m128& outside, __m128& crossing) {
+			const auto negativeRadius = _mm_xor_ps(radius, _mm_set1_ps(-0.0f));
+			outside = _mm_setzero_ps();
+			crossing = _mm_setzero_ps();
+
+			for (size_t p = 0; p < BoundingFrustum::PlaneCount; ++p) {
+				const auto& plane = planes[p];
+				const auto distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(x, _mm_set1_ps(plane.Normal.X)),
+					_mm_mul_ps(y, _mm_set1_ps(plane.Normal.Y))),
+					_mm_mul_ps(z, _mm_set1_ps(plane.Normal.Z))), _mm_set1_ps(plane.D));
+
+				outside = _mm_or_ps(outside, _mm_cmpgt_ps(distance, radius));
+				crossing = _mm_or_ps(crossing, _mm_cmpnlt_ps(distance, negativeRadius));
+			}
+		}
+
+		CSHARP_TARGET("avx2")
+		static void TestSpheres(Plane const* planes, __m256 x, __m256 y, __m256 z, __m256 radius, __m256& outside, __m256& crossing) {
+			const auto negativeRadius = _mm256_xor_ps(radius, _mm256_set1_ps(-0.0f));
+			outside = _mm256_setzero_ps();
+			crossing = _mm256_setzero_ps();
+
+			for (size_t p = 0; p < BoundingFrustum::PlaneCount; ++p) {
+				const auto& plane = planes[p];
+				const auto distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+					_mm256_mul_ps(x, _mm256_set1_ps(plane.Normal.X)),
+					_mm256_mul_ps(y, _mm256_set1_ps(plane.Normal.Y))),
+					_mm256_mul_ps(z, _mm256_set1_ps(plane.Normal.Z))), _mm256_set1_ps(plane.D));
+
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, radius, _CMP_GT_OQ));
+				crossing = _mm256_or_ps(crossing, _mm256_cmp_ps(distance, negativeRadius, _CMP_NLT_UQ));
+			}
+		}
+
+		//Min.X, Min.Y, Min.Z and Max.X of a box, or the center and radius of a sphere.
+		CSHARP_TARGET("sse2")
+		static __m128 LoadFirst(float const* volume) {
+			return _mm_loadu_ps(volume);
+		}
+
+		//Max.Y and Max.Z of a box in the low lanes.
+		CSHARP_TARGET("sse2")
+		static __m128 LoadLast(BoundingBox const* box) {
+			return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const*>(&box->Max.Y)));
+		}
+
+		//LoadFirst of a volume in the low half and of the volume four places after it in the high half.
+		CSHARP_TARGET("avx2")
+		static __m256 LoadFirst8(float const* volume, size_t stride) {
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(LoadFirst(volume)), LoadFirst(volume + 4 * stride), 1);
+		}
+
+		CSHARP_TARGET("avx2")
+		static __m256 LoadLast8(BoundingBox const* box) {
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(LoadLast(box)), LoadLast(box + 4), 1);
+		}
+
+		CSHARP_TARGET("sse2")
+		static void Test(Plane const* planes, Boxes const& source, size_t index, __m128& outside, __m128& crossing) {
+			const auto boxes = source.Values + index;
+			auto minX = LoadFirst(&boxes[0].Min.X);
+			auto minY = LoadFirst(&boxes[1].Min.X);
+			auto minZ = LoadFirst(&boxes[2].Min.X);
+			auto maxX = LoadFirst(&boxes[3].Min.X);
+			Transpose4(minX, minY, minZ, maxX);
+
+			const auto last01 = _mm_unpacklo_ps(LoadLast(boxes), LoadLast(boxes + 1));
+			const auto last23 = _mm_unpacklo_ps(LoadLast(boxes + 2), LoadLast(boxes + 3));
+			TestBoxes(planes, minX, minY, minZ, maxX,
+				_mm_shuffle_ps(last01, last23, _MM_SHUFFLE(1, 0, 1, 0)), _mm_shuffle_ps(last01, last23, _MM_SHUFFLE(3, 2, 3, 2)), outside, crossing);
+		}
+
+		CSHARP_TARGET("avx2")
+		static void Test(Plane const* planes, Boxes const& source, size_t index, __m256& outside, __m256& crossing) {
+			const auto boxes = source.Values + index;
+			auto minX = LoadFirst8(&boxes[0].Min.X, 6);
+			auto minY = LoadFirst8(&boxes[1].Min.X, 6);
+			auto minZ = LoadFirst8(&boxes[2].Min.X, 6);
+			auto maxX = LoadFirst8(&boxes[3].Min.X, 6);
+			Transpose4(minX, minY, minZ, maxX);
+
+			const auto last01 = _mm256_unpacklo_ps(LoadLast8(boxes), LoadLast8(boxes + 1));
+			const auto last23 = _mm256_unpacklo_ps(LoadLast8(boxes + 2), LoadLast8(boxes + 3));
+			TestBoxes(planes, minX, minY, minZ, maxX,
+				_mm256_shuffle_ps(last01, last23, _MM_SHUFFLE(1, 0, 1, 0)), _mm256_shuffle_ps(last01, last23, _MM_SHUFFLE(3, 2, 3, 2)), outside, crossing);
+		}
+
+		CSHARP_TARGET("sse2")
+		static void Test(Plane const* planes, Spheres const& source, size_t index, __m128& outside, __m128& crossing) {
+			const auto spheres = source.Values + index;
+			auto x = LoadFirst(&spheres[0].Center.X);
+			auto y = LoadFirst(&spheres[1].Center.X);
+			auto z = LoadFirst(&spheres[2].Center.X);
+			auto radius = LoadFirst(&spheres[3].Center.X);
+			Transpose4(x, y, z, radius);
+			TestSpheres(planes, x, y, z, radius, outside, crossing);
+		}
+
+		CSHARP_TARGET("avx2")
+		static void Test(Plane const* planes, Spheres const& source, size_t index, __m256& outside, __m256& crossing) {
+			const auto spheres = source.Values + index;
+			auto x = LoadFirst8(&spheres[0].Center.X, 4);
+			auto y = LoadFirst8(&spheres[1].Center.X, 4);
+			auto z = LoadFirst8(&spheres[2].Center.X, 4);
+			auto radius = LoadFirst8(&spheres[3].Center.X, 4);
+			Transpose4(x, y, z, radius);
+			TestSpheres(planes, x, y, z, radius, outside, crossing);
+		}
+
+		CSHARP_TARGET("sse2")
+		static void Test(Plane const* planes, BoxStreams const& source, size_t index, __m128& outside, __m128& crossing) {
+			TestBoxes(planes, _mm_loadu_ps(source.MinX + index), _mm_loadu_ps(source.MinY + index), _mm_loadu_ps(source.MinZ + index),
+				_mm_loadu_ps(source.MaxX + index), _mm_loadu_ps(source.MaxY + index), _mm_loadu_ps(source.MaxZ + index), outside, crossing);
+		}
+
+		CSHARP_TARGET("avx2")
+		static void Test(Plane const* planes, BoxStreams const& source, size_t index, __m256& outside, __m256& crossing) {
+			TestBoxes(planes, _mm256_loadu_ps(source.MinX + index), _mm256_loadu_ps(source.MinY + index), _mm256_loadu_ps(source.MinZ + index),
+				_mm256_loadu_ps(source.MaxX + index), _mm256_loadu_ps(source.MaxY + index), _mm256_loadu_ps(source.MaxZ + index), outside, crossing);
+		}
+
+		CSHARP_TARGET("sse2")
+		static void Test(Plane const* planes, SphereStreams const& source, size_t index, __m128& outside, __m128& crossing) {
+			TestSpheres(planes, _mm_loadu_ps(source.X + index), _mm_loadu_ps(source.Y + index), _mm_loadu_ps(source.Z + index),
+				_mm_loadu_ps(source.Radius + index), outside, crossing);
+		}
+
+		CSHARP_TARGET("avx2")
+		static void Test(Plane const* planes, SphereStreams const& source, size_t index, __m256& outside, __m256& crossing) {
+			TestSpheres(planes, _mm256_loadu_ps(source.X + index), _mm256_loadu_ps(source.Y + index), _mm256_loadu_ps(source.Z + index),
+				_mm256_loadu_ps(source.Radius + index), outside, crossing);
+		}
+
+		CSHARP_TARGET("sse2")
+		static size_t CullSse2(Plane const* planes, BoundingBox const* boxes, ContainmentType* destination, size_t count) {
+			const auto one = _mm_set1_epi32(1);
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4) {
+				__m128 outside, crossing;
+				Test(planes, Boxes{ boxes }, i, outside, crossing);
+
+				//1 - (-1) is Intersects and 1 - 0 is Contains, cleared to Disjoint by outside.
+				const auto result = _mm_andnot_si128(_mm_castps_si128(outside), _mm_sub_epi32(one, _mm_castps_si128(crossing)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), result);
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t CullAvx2(Plane const* planes, BoundingBox const* boxes, ContainmentType* destination, size_t count) {
+			const auto one = _mm256_set1_epi32(1);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				__m256 outside, crossing;
+				Test(planes, Boxes{ boxes }, i, outside, crossing);
+
+				const auto result = _mm256_andnot_si256(_mm256_castps_si256(outside), _mm256_sub_epi32(one, _mm256_castps_si256(crossing)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), result);
+			}
+
+			return i;
+		}
+
+		//Writes whole 64-bit words of bits for the volumes from first on, and returns the number of volumes they cover.
+		//A bit is set for a volume that is not Disjoint, or with Contained only for a volume that is Contains.
+		template <bool Contained, typename Source>
+		CSHARP_TARGET("sse2")
+		static size_t BitsSse2(Plane const* planes, Source const& source, size_t first, uint64_t* bits, size_t count) {
+			size_t i = 0;
+
+			for (; i + 64 <= count; i += 64) {
+				uint64_t word = 0;
+
+				for (size_t j = 0; j < 64; j += 4) {
+					__m128 outside, crossing;
+					Test(planes, source, first + i + j, outside, crossing);
+
+					if constexpr (Contained)
+						outside = _mm_or_ps(outside, crossing);
+
+					word |= static_cast<uint64_t>(~_mm_movemask_ps(outside) & 0xF) << j;
+				}
+
+				bits[i / 64] = word;
+			}
+
+			return i;
+		}
+
+		template <bool Contained, typename Source>
+		CSHARP_TARGET("avx2")
+		static size_t BitsAvx2(Plane const* planes, Source const& source, size_t first, uint64_t* bits, size_t count) {
+			size_t i = 0;
+
+			for (; i + 64 <= count; i += 64) {
+				uint64_t word = 0;
+
+				for (size_t j = 0; j < 64; j += 8) {
+					__m256 outside, crossing;
+					Test(planes, source, first + i + j, outside, crossing);
+
+					if constexpr (Contained)
+						outside = _mm256_or_ps(outside, crossing);
+
+					word |= static_cast<uint64_t>(~_mm256_movemask_ps(outside) & 0xFF) << j;
+				}
+
+				bits[i / 64] = word;
+			}
+
+			return i;
+		}
+#endif
+
+		//Writes the bits of count volumes from first on into (count + 63) / 64 words.
+		template <bool Contained, typename Source>
+		static void Bits(BoundingFrustum const& frustum, Source const& source, size_t first, uint64_t* bits, size_t count) {
+			size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx2)
+				i = BitsAvx2<Contained>(frustum.planes, source, first, bits, count);
+
+			i += BitsSse2<Contained>(frustum.planes, source, first + i, bits + i / 64, count - i);
+#endif
+			for (; i < count; i += 64) {
+				const auto end = std::min(count, i + 64);
+				uint64_t word = 0;
+
+				for (auto j = i; j < end; ++j) {
+					const auto result = Cull(frustum, source, first + j);
+
+					if (Contained ? result == ContainmentType::Contains : result != ContainmentType::Disjoint)
+						word |= uint64_t{ 1 } << (j - i);
+				}
+
+				bits[i / 64] = word;
+			}
+		}
+
+		//Runs Bits over count volumes, split in ranges of whole words among threadCount threads.
+		template <bool Contained, typename Source>
+		static bool Batch(BoundingFrustum const& frustum, Source const& source, size_t count, std::span<uint64_t> bits, size_t threadCount) {
+			const auto wordCount = (count + 63) / 64;
+
+			if (bits.size() < wordCount)
+				return false;
+
+			if (threadCount <= 1 || count < BoundingFrustum::MinimumParallelCount) {
+				Bits<Contained>(frustum, source, 0, bits.data(), count);
+				return true;
+			}
+
+			csharp::Parallel::For(count, threadCount, 64, [&](size_t, size_t first, size_t rangeCount) {
+				Bits<Contained>(frustum, source, first, bits.data() + first / 64, rangeCount);
+				});
+
+			return true;
+		}
+
+		static BoxStreams Streams(Vector3SoA const& minimums, Vector3SoA const& maximums) {
+			return { minimums.X(), minimums.Y(), minimums.Z(), maximums.X(), maximums.Y(), maximums.Z() };
+		}
+
+		static SphereStreams Streams(Vector4SoA const& spheres) {
+			return { spheres.X(), spheres.Y(), spheres.Z(), spheres.W() };
+		}
+	};
+
+	bool BoundingFrustum::Cull(std::span<const BoundingBox> boxes, std::span<ContainmentType> destination) const {
+		const auto count = boxes.size();
+
+		if (destination.size() < count)
+			return false;
+
+		size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+		if (FrustumKernels::UseAvx2)
+			i = FrustumKernels::CullAvx2(planes, boxes.data(), destination.data(), count);
+
+		i += FrustumKernels::CullSse2(planes, boxes.data() + i, destination.data() + i, count - i);
+#endif
+		for (; i < count; ++i)
+			destination[i] = FrustumKernels::Cull(*this, boxes[i]);
+
+		return true;
+	}
+
+	bool BoundingFrustum::CullBatch(std::span<const BoundingBox> boxes, std::span<uint64_t> visible, size_t threadCount) const {
+		return IntersectsBatch(boxes, visible, threadCount);
+	}
+
+	bool BoundingFrustum::IntersectsBatch(std::span<const BoundingBox> boxes, std::span<uint64_t> result, size_t threadCount) const {
+		return FrustumKernels::Batch<false>(*this, FrustumKernels::Boxes{ boxes.data() }, boxes.size(), result, threadCount);
+	}
+
+	bool BoundingFrustum::IntersectsBatch(std::span<const BoundingSphere> spheres, std::span<uint64_t> result, size_t threadCount) const {
+		return FrustumKernels::Batch<false>(*this, FrustumKernels::Spheres{ spheres.data() }, spheres.size(), result, threadCount);
+	}
+
+	bool BoundingFrustum::IntersectsBatch(Vector3SoA const& minimums, Vector3SoA const& maximums, std::span<uint64_t> result, size_t threadCount) const {
+		if (minimums.Count() != maximums.Count())
+			return false;
+
+		return FrustumKernels::Batch<false>(*this, FrustumKernels::Streams(minimums, maximums), minimums.Count(), result, threadCount);
+	}
+
+	bool BoundingFrustum::IntersectsBatch(Vector4SoA const& spheres, std::span<uint64_t> result, size_t threadCount) const {
+		return FrustumKernels::Batch<false>(*this, FrustumKernels::Streams(spheres), spheres.Count(), result, threadCount);
+	}
+
+	bool BoundingFrustum::ContainsBatch(std::span<const BoundingBox> boxes, std::span<uint64_t> result, size_t threadCount) const {
+		return FrustumKernels::Batch<true>(*this, FrustumKernels::Boxes{ boxes.data() }, boxes.size(), result, threadCount);
+	}
+
+	bool BoundingFrustum::ContainsBatch(std::span<const BoundingSphere> spheres, std::span<uint64_t> result, size_t threadCount) const {
+		return FrustumKernels::Batch<true>(*this, FrustumKernels::Spheres{ spheres.data() }, spheres.size(), result, threadCount);
+	}
+
+	bool BoundingFrustum::ContainsBatch(Vector3SoA const& minimums, Vector3SoA const& maximums, std::span<uint64_t> result, size_t threadCount) const {
+		if (minimums.Count() != maximums.Count())
+			return false;
+
+		return FrustumKernels::Batch<true>(*this, FrustumKernels::Streams(minimums, maximums), minimums.Count(), result, threadCount);
+	}
+
+	bool BoundingFrustum::ContainsBatch(Vector4SoA const& spheres, std::span<uint64_t> result, size_t threadCount) const {
+		return FrustumKernels::Batch<true>(*this, FrustumKernels::Streams(spheres), spheres.Count(), result, threadCount);
+	}
+
+	size_t BoundingFrustum::GetIndices(std::span<const uint64_t> bits, size_t count, std::span<uint32_t> indices) {
+		const auto wordCount = std::min((count + 63) / 64, bits.size());
+		size_t written = 0;
+
+		for (size_t w = 0; w < wordCount; ++w) {
+			auto word = bits[w];
+
+			if (w * 64 + 64 > count)
+				word &= (uint64_t{ 1 } << (count - w * 64)) - 1;
+
+			while (word != 0) {
+				if (written == indices.size())
+					return written;
+
+				indices[written++] = static_cast<uint32_t>(w * 64 + std::countr_zero(word));
+				word &= word - 1;
+			}
+		}
+
+		return written;
+	}
+
 	std::optional<float> BoundingBox::Intersects(Ray const& ray) const {
 		float num1 = 0.0f;
 		float num2 = FLOAT_MAX_VALUE;
@@ -323,7 +797,7 @@ namespace xna {
 		return num1;
 	}
 
-	ContainmentType BoundingBox::Contains(BoundingFrustum& frustum) const {
+	ContainmentType BoundingBox::Contains(BoundingFrustum const& frustum) const {
 		if (!frustum.Intersects(*this))
 			return ContainmentType::Disjoint;
 
@@ -336,6 +810,616 @@ namespace xna {
 		return ContainmentType::Contains;
 	}
 
+	//Reductions over arrays of points for BoundingBox::CreateFromPoints and BoundingSphere::CreateFromPoints.
+	struct PointKernels {
+		static constexpr size_t MaxDirections = 49;
+
+		//Directions of the extremal point search, the first 3, 7 or 49 of them for each BoundingSphereQuality.
+		//They need not be unit vectors, only the order of the projections on each of them matters.
+		static constexpr float Directions[MaxDirections][3] = {
+			{ 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+			{ 1, 1, 1 }, { 1, 1, -1 }, { 1, -1, 1 }, { 1, -1, -1 },
+			{ 1, 1, 0 }, { 1, -1, 0 }, { 1, 0, 1 }, { 1, 0, -1 }, { 0, 1, 1 }, { 0, 1, -1 },
+			{ 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 2, 0, 1 }, { 1, 2, 0 }, { 2, 1, 0 },
+			{ 0, 1, -2 }, { 0, 2, -1 }, { 1, 0, -2 }, { 2, 0, -1 }, { 1, -2, 0 }, { 2, -1, 0 },
+			{ 1, 1, 2 }, { 2, 1, 1 }, { 1, 2, 1 }, { 1, -1, 2 }, { 1, 1, -2 }, { 1, -1, -2 },
+			{ 2, -1, 1 }, { 2, 1, -1 }, { 2, -1, -1 }, { 1, -2, 1 }, { 1, 2, -1 }, { 1, -2, -1 },
+			{ 2, 2, 1 }, { 1, 2, 2 }, { 2, 1, 2 }, { 2, -2, 1 }, { 2, 2, -1 }, { 2, -2, -1 },
+			{ 1, -2, 2 }, { 1, 2, -2 }, { 1, -2, -2 }, { 2, -1, 2 }, { 2, 1, -2 }, { 2, -1, -2 },
+		};
+
+		static constexpr size_t DirectionCount(BoundingSphereQuality quality) {
+			switch (quality) {
+			case BoundingSphereQuality::Fast:
+				return 3;
+			case BoundingSphereQuality::Balanced:
+				return 7;
+			default:
+				return MaxDirections;
+			}
+		}
+
+		//Points with the lowest and highest projection on every direction.
+		struct Extremes {
+			float Low[MaxDirections];
+			float High[MaxDirections];
+			size_t LowIndex[MaxDirections];
+			size_t HighIndex[MaxDirections];
+		};
+
+		static constexpr size_t BlockSize = 256;
+
+		//Points copied to one array per component, so the projections and distances of a block run four or eight points at a time.
+		struct Block {
+			alignas(32) float X[BlockSize];
+			alignas(32) float Y[BlockSize];
+			alignas(32) float Z[BlockSize];
+
+			void Load(Vector3 const* points, size_t count) {
+				for (size_t i = 0; i < count; ++i) {
+					X[i] = points[i].X;
+					Y[i] = points[i].Y;
+					Z[i] = points[i].Z;
+				}
+			}
+		};
+
+		//Point and sphere in double precision for the smallest sphere of the extremal points.
+		struct Point3d {
+			double X{ 0 };
+			double Y{ 0 };
+			double Z{ 0 };
+
+			friend Point3d operator+(Point3d const& a, Point3d const& b) { return { a.X + b.X, a.Y + b.Y, a.Z + b.Z }; }
+			friend Point3d operator-(Point3d const& a, Point3d const& b) { return { a.X - b.X, a.Y - b.Y, a.Z - b.Z }; }
+			friend Point3d operator*(Point3d const& a, double factor) { return { a.X * factor, a.Y * factor, a.Z * factor }; }
+		};
+
+		struct Sphere3d {
+			Point3d Center;
+			//Negative for the empty sphere.
+			double RadiusSq{ -1 };
+		};
+
+		//Lowers minimum and raises maximum to bound the points.
+		static void MinMax(Vector3 const* points, size_t count, Vector3& minimum, Vector3& maximum) {
+			size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx2)
+				i = MinMaxAvx2(points, count, minimum, maximum);
+
+			i += MinMaxSse2(points + i, count - i, minimum, maximum);
+#endif
+			for (; i < count; ++i) {
+				minimum = Vector3::Min(minimum, points[i]);
+				maximum = Vector3::Max(maximum, points[i]);
+			}
+		}
+
+#if defined(CSHARP_INTRINSICS_X86)
+		inline static const bool UseAvx2 = csharp::X86Intrinsics::IsAvx2Supported();
+
+		static_assert(sizeof(Vector3) == 3 * sizeof(float));
+
+		//Merges lanes of minimums and maximums where lane j holds component j % 3.
+		static void MergeLanes(float const* lows, float const* highs, size_t laneCount, Vector3& minimum, Vector3& maximum) {
+			float low[3] = { minimum.X, minimum.Y, minimum.Z };
+			float high[3] = { maximum.X, maximum.Y, maximum.Z };
+
+			for (size_t j = 0; j < laneCount; ++j) {
+				low[j % 3] = std::min(low[j % 3], lows[j]);
+				high[j % 3] = std::max(high[j % 3], highs[j]);
+			}
+
+			minimum = Vector3(low[0], low[1], low[2]);
+			maximum = Vector3(high[0], high[1], high[2]);
+		}
+
+		//Four points are three vectors, x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3, so lane j of vector k always holds component (4k + j) % 3
+		//and every vector keeps its own minimum and maximum, with no shuffles in the loop. Returns the number of points done.
+		CSHARP_TARGET("sse2")
+		static size_t MinMaxSse2(Vector3 const* points, size_t count, Vector3& minimum, Vector3& maximum) {
+			const auto end = count / 4 * 4;
+
+			if (end == 0)
+				return 0;
+
+			const auto values = &points[0].X;
+			auto min0 = _mm_loadu_ps(values);
+			auto min1 = _mm_loadu_ps(values + 4);
+			auto min2 = _mm_loadu_ps(values + 8);
+			auto max0 = min0;
+			auto max1 = min1;
+			auto max2 = min2;
+
+			for (size_t i = 4; i < end; i += 4) {
+				const auto v0 = _mm_loadu_ps(values + i * 3);
+				const auto v1 = _mm_loadu_ps(values + i * 3 + 4);
+				const auto v2 = _mm_loadu_ps(values + i * 3 + 8);
+				min0 = _mm_min_ps(min0, v0);
+				min1 = _mm_min_ps(min1, v1);
+				min2 = _mm_min_ps(min2, v2);
+				max0 = _mm_max_ps(max0, v0);
+				max1 = _mm_max_ps(max1, v1);
+				max2 = _mm_max_ps(max2, v2);
+			}
+
+			float lows[12];
+			float highs[12];
+			_mm_storeu_ps(lows, min0);
+			_mm_storeu_ps(lows + 4, min1);
+			_mm_storeu_ps(lows + 8, min2);
+			_mm_storeu_ps(highs, max0);
+			_mm_storeu_ps(highs + 4, max1);
+			_mm_storeu_ps(highs + 8, max2);
+			MergeLanes(lows, highs, 12, minimum, maximum);
+			return end;
+		}
+
+		//Same as MinMaxSse2 with eight points in three vectors, where lane j of vector k holds component (8k + j) % 3.
+		CSHARP_TARGET("avx2")
+		static size_t MinMaxAvx2(Vector3 const* points, size_t count, Vector3& minimum, Vector3& maximum) {
+			const auto end = count / 8 * 8;
+
+			if (end == 0)
+				return 0;
+
+			const auto values = &points[0].X;
+			auto min0 = _mm256_loadu_ps(values);
+			auto min1 = _mm256_loadu_ps(values + 8);
+			auto min2 = _mm256_loadu_ps(values + 16);
+			auto max0 = min0;
+			auto max1 = min1;
+			auto max2 = min2;
+
+			for (size_t i = 8; i < end; i += 8) {
+				const auto v0 = _mm256_loadu_ps(values + i * 3);
+				const auto v1 = _mm256_loadu_ps(values + i * 3 + 8);
+				const auto v2 = _mm256_loadu_ps(values + i * 3 + 16);
+				min0 = _mm256_min_ps(min0, v0);
+				min1 = _mm256_min_ps(min1, v1);
+				min2 = _mm256_min_ps(min2, v2);
+				max0 = _mm256_max_ps(max0, v0);
+				max1 = _mm256_max_ps(max1, v1);
+				max2 = _mm256_max_ps(max2, v2);
+			}
+
+			float lows[24];
+			float highs[24];
+			_mm256_storeu_ps(lows, min0);
+			_mm256_storeu_ps(lows + 8, min1);
+			_mm256_storeu_ps(lows + 16, min2);
+			_mm256_storeu_ps(highs, max0);
+			_mm256_storeu_ps(highs + 8, max1);
+			_mm256_storeu_ps(highs + 16, max2);
+			MergeLanes(lows, highs, 24, minimum, maximum);
+			return end;
+		}
+#endif
+
+		//Lowers low and raises high to bound the projections of the first count points of a block on direction.
+		static void ProjectionRange(Block const& block, size_t count, float const* direction, float& low, float& high) {
+			size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx2)
+				i = ProjectionRangeAvx2(block, count, direction, low, high);
+
+			i += ProjectionRangeSse2(block, i, count, direction, low, high);
+#endif
+			for (; i < count; ++i) {
+				const auto projection = block.X[i] * direction[0] + block.Y[i] * direction[1] + block.Z[i] * direction[2];
+				low = std::min(low, projection);
+				high = std::max(high, projection);
+			}
+		}
+
+		//Gets the largest squared distance from center of the first count points of a block.
+		static float MaxDistanceSquared(Block const& block, size_t count, Vector3 const& center) {
+			auto result = 0.0f;
+			size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx2)
+				i = MaxDistanceSquaredAvx2(block, count, center, result);
+
+			i += MaxDistanceSquaredSse2(block, i, count, center, result);
+#endif
+			for (; i < count; ++i) {
+				const auto x = block.X[i] - center.X;
+				const auto y = block.Y[i] - center.Y;
+				const auto z = block.Z[i] - center.Z;
+				result = std::max(result, x * x + y * y + z * z);
+			}
+
+			return result;
+		}
+
+#if defined(CSHARP_INTRINSICS_X86)
+		//Returns the index of the first point not done.
+		CSHARP_TARGET("sse2")
+		static size_t ProjectionRangeSse2(Block const& block, size_t first, size_t count, float const* direction, float& low, float& high) {
+			const auto end = first + (count - first) / 4 * 4;
+			const auto dx = _mm_set1_ps(direction[0]);
+			const auto dy = _mm_set1_ps(direction[1]);
+			const auto dz = _mm_set1_ps(direction[2]);
+			auto lows = _mm_set1_ps(low);
+			auto highs = _mm_set1_ps(high);
+
+			for (auto i = first; i < end; i += 4) {
+				const auto projection = _mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(_mm_load_ps(block.X + i), dx),
+					_mm_mul_ps(_mm_load_ps(block.Y + i), dy)),
+					_mm_mul_ps(_mm_load_ps(block.Z + i), dz));
+				lows = _mm_min_ps(lows, projection);
+				highs = _mm_max_ps(highs, projection);
+			}
+
+			float values[4];
+			_mm_storeu_ps(values, lows);
+			low = std::min(std::min(values[0], values[1]), std::min(values[2], values[3]));
+			_mm_storeu_ps(values, highs);
+			high = std::max(std::max(values[0], values[1]), std::max(values[2], values[3]));
+			return end - first;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t ProjectionRangeAvx2(Block const& block, size_t count, float const* direction, float& low, float& high) {
+			const auto end = count / 8 * 8;
+			const auto dx = _mm256_set1_ps(direction[0]);
+			const auto dy = _mm256_set1_ps(direction[1]);
+			const auto dz = _mm256_set1_ps(direction[2]);
+			auto lows = _mm256_set1_ps(low);
+			auto highs = _mm256_set1_ps(high);
+
+			for (size_t i = 0; i < end; i += 8) {
+				const auto projection = _mm256_add_ps(_mm256_add_ps(
+					_mm256_mul_ps(_mm256_load_ps(block.X + i), dx),
+					_mm256_mul_ps(_mm256_load_ps(block.Y + i), dy)),
+					_mm256_mul_ps(_mm256_load_ps(block.Z + i), dz));
+				lows = _mm256_min_ps(lows, projection);
+				highs = _mm256_max_ps(highs, projection);
+			}
+
+			float values[8];
+			_mm256_storeu_ps(values, lows);
+			low = *std::min_element(values, values + 8);
+			_mm256_storeu_ps(values, highs);
+			high = *std::max_element(values, values + 8);
+			return end;
+		}
+
+		CSHARP_TARGET("sse2")
+		static size_t MaxDistanceSquaredSse2(Block const& block, size_t first, size_t count, Vector3 const& center, float& result) {
+			const auto end = first + (count - first) / 4 * 4;
+			const auto cx = _mm_set1_ps(center.X);
+			const auto cy = _mm_set1_ps(center.Y);
+			const auto cz = _mm_set1_ps(center.Z);
+			auto maximum = _mm_set1_ps(result);
+
+			for (auto i = first; i < end; i += 4) {
+				const auto x = _mm_sub_ps(_mm_load_ps(block.X + i), cx);
+				const auto y = _mm_sub_ps(_mm_load_ps(block.Y + i), cy);
+				const auto z = _mm_sub_ps(_mm_load_ps(block.Z + i), cz);
+				maximum = _mm_max_ps(maximum, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+			}
+
+			float values[4];
+			_mm_storeu_ps(values, maximum);
+			result = std::max(std::max(values[0], values[1]), std::max(values[2], values[3]));
+			return end - first;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t MaxDistanceSquaredAvx2(Block const& block, size_t count, Vector3 const& center, float& result) {
+			const auto end = count / 8 * 8;
+			const auto cx = _mm256_set1_ps(center.X);
+			const auto cy = _mm256_set1_ps(center.Y);
+			const auto cz = _mm256_set1_ps(center.Z);
+			auto maximum = _mm256_set1_ps(result);
+
+			for (size_t i = 0; i < end; i += 8) {
+				const auto x = _mm256_sub_ps(_mm256_load_ps(block.X + i), cx);
+				const auto y = _mm256_sub_ps(_mm256_load_ps(block.Y + i), cy);
+				const auto z = _mm256_sub_ps(_mm256_load_ps(block.Z + i), cz);
+				maximum = _mm256_max_ps(maximum, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)));
+			}
+
+			float values[8];
+			_mm256_storeu_ps(values, maximum);
+			result = *std::max_element(values, values + 8);
+			return end;
+		}
+#endif
+
+		static void FindExtremes(Vector3 const* points, size_t first, size_t count, size_t directionCount, Extremes& extremes) {
+			for (size_t d = 0; d < directionCount; ++d) {
+				extremes.Low[d] = (std::numeric_limits<float>::max)();
+				extremes.High[d] = std::numeric_limits<float>::lowest();
+				extremes.LowIndex[d] = first;
+				extremes.HighIndex[d] = first;
+			}
+
+			Block block;
+
+			for (auto start = first; start < first + count; start += BlockSize) {
+				const auto size = std::min(BlockSize, first + count - start);
+				block.Load(points + start, size);
+
+				for (size_t d = 0; d < directionCount; ++d) {
+					const auto direction = Directions[d];
+					auto low = extremes.Low[d];
+					auto high = extremes.High[d];
+					ProjectionRange(block, size, direction, low, high);
+
+					if (low >= extremes.Low[d] && high <= extremes.High[d])
+						continue;
+
+					//Only a block with a new extreme is searched again for the point, which is rare after the first blocks.
+					for (size_t i = 0; i < size; ++i) {
+						const auto projection = block.X[i] * direction[0] + block.Y[i] * direction[1] + block.Z[i] * direction[2];
+
+						if (projection < extremes.Low[d]) {
+							extremes.Low[d] = projection;
+							extremes.LowIndex[d] = start + i;
+						}
+
+						if (projection > extremes.High[d]) {
+							extremes.High[d] = projection;
+							extremes.HighIndex[d] = start + i;
+						}
+					}
+				}
+			}
+		}
+
+		static double Dot(Point3d const& a, Point3d const& b) {
+			return a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+		}
+
+		static Point3d Cross(Point3d const& a, Point3d const& b) {
+			return { a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X };
+		}
+
+		static bool Contains(Sphere3d const& sphere, Point3d const& point) {
+			const auto offset = point - sphere.Center;
+			return Dot(offset, offset) <= sphere.RadiusSq * (1.0 + 1E-10);
+		}
+
+		static Sphere3d SphereOf(Point3d const& a, Point3d const& b) {
+			const auto offset = b - a;
+			return { (a + b) * 0.5, Dot(offset, offset) * 0.25 };
+		}
+
+		//Smallest sphere with every support point on its boundary: the circumcircle of a triangle, the circumsphere of a tetrahedron.
+		//Points on one line or plane fall back to the smallest sphere of fewer points that contains them all.
+		static Sphere3d SphereOf(Point3d const* support, size_t count) {
+			if (count == 0)
+				return {};
+
+			if (count == 1)
+				return { support[0], 0.0 };
+
+			if (count == 2)
+				return SphereOf(support[0], support[1]);
+
+			const auto& a = support[0];
+			const auto ab = support[1] - a;
+			const auto ac = support[2] - a;
+
+			if (count == 3) {
+				const auto normal = Cross(ab, ac);
+				const auto denominator = 2.0 * Dot(normal, normal);
+
+				if (denominator <= 1E-12 * Dot(ab, ab) * Dot(ac, ac)) {
+					auto sphere = SphereOf(support[0], support[1]);
+
+					for (const auto& candidate : { SphereOf(support[0], support[2]), SphereOf(support[1], support[2]) }) {
+						if (candidate.RadiusSq > sphere.RadiusSq)
+							sphere = candidate;
+					}
+
+					return sphere;
+				}
+
+				const auto offset = (Cross(normal, ab) * Dot(ac, ac) + Cross(ac, normal) * Dot(ab, ab)) * (1.0 / denominator);
+				return { a + offset, Dot(offset, offset) };
+			}
+
+			const auto ad = support[3] - a;
+			const auto denominator = 2.0 * Dot(ab, Cross(ac, ad));
+
+			if (std::abs(denominator) <= 1E-12 * std::sqrt(Dot(ab, ab) * Dot(ac, ac) * Dot(ad, ad))) {
+				Sphere3d best;
+
+				for (size_t skipped = 0; skipped < 4; ++skipped) {
+					Point3d triangle[3];
+					size_t size = 0;
+
+					for (size_t i = 0; i < 4; ++i) {
+						if (i != skipped)
+							triangle[size++] = support[i];
+					}
+
+					const auto candidate = SphereOf(triangle, 3);
+
+					if (Contains(candidate, support[skipped]) && (best.RadiusSq < 0 || candidate.RadiusSq < best.RadiusSq))
+						best = candidate;
+				}
+
+				return best;
+			}
+
+			const auto offset = (Cross(ab, ac) * Dot(ad, ad) + Cross(ad, ab) * Dot(ac, ac) + Cross(ac, ad) * Dot(ab, ab)) * (1.0 / denominator);
+			return { a + offset, Dot(offset, offset) };
+		}
+
+		//Welzl's algorithm with the move-to-front heuristic, for the few extremal points.
+		static Sphere3d MinimumSphere(Point3d* points, size_t end, Point3d* support, size_t supportCount) {
+			auto sphere = SphereOf(support, supportCount);
+
+			if (supportCount == 4)
+				return sphere;
+
+			for (size_t i = 0; i < end; ++i) {
+				if (Contains(sphere, points[i]))
+					continue;
+
+				support[supportCount] = points[i];
+				sphere = MinimumSphere(points, i, support, supportCount + 1);
+				std::rotate(points, points + i, points + i + 1);
+			}
+
+			return sphere;
+		}
+
+		//Grows the sphere to every point outside it, like the second pass of CreateFromPoints(points, size).
+		//Blocks with no point outside are skipped after one batch distance test.
+		static void Grow(Vector3 const* points, size_t count, BoundingSphere& sphere) {
+			auto center = sphere.Center;
+			auto radius = sphere.Radius;
+			auto radiusSq = radius * radius;
+			Block block;
+
+			for (size_t start = 0; start < count; start += BlockSize) {
+				const auto size = std::min(BlockSize, count - start);
+				block.Load(points + start, size);
+
+				if (MaxDistanceSquared(block, size, center) <= radiusSq)
+					continue;
+
+				for (auto i = start; i < start + size; ++i) {
+					const auto offset = points[i] - center;
+					const auto distanceSq = offset.LengthSquared();
+
+					if (distanceSq <= radiusSq)
+						continue;
+
+					const auto distance = std::sqrt(distanceSq);
+					const auto grown = (radius + distance) * 0.5f;
+					center += offset * ((distance - grown) / distance);
+					radius = grown;
+					radiusSq = radius * radius;
+				}
+			}
+
+			sphere.Center = center;
+			sphere.Radius = radius;
+		}
+	};
+
+	BoundingBox BoundingBox::CreateFromPoints(std::span<const Vector3> points, size_t threadCount) {
+		if (points.empty())
+			return BoundingBox(Vector3(FLOAT_MAX_VALUE), Vector3(std::numeric_limits<float>::lowest()));
+
+		if (threadCount <= 1 || points.size() < MinimumParallelCount) {
+			BoundingBox box(points[0], points[0]);
+			PointKernels::MinMax(points.data(), points.size(), box.Min, box.Max);
+			return box;
+		}
+
+		//Every range starts from the first point, which is in the set anyway.
+		std::vector<BoundingBox> boxes(threadCount, BoundingBox(points[0], points[0]));
+
+		csharp::Parallel::For(points.size(), threadCount, [&](size_t range, size_t first, size_t count) {
+			PointKernels::MinMax(points.data() + first, count, boxes[range].Min, boxes[range].Max);
+			});
+
+		auto box = boxes[0];
+
+		for (size_t range = 1; range < threadCount; ++range)
+			box = CreateMerged(box, boxes[range]);
+
+		return box;
+	}
+
+	BoundingSphere BoundingSphere::CreateFromPoints(std::span<const Vector3> points, BoundingSphereQuality quality, size_t threadCount) {
+		if (points.empty())
+			return BoundingSphere();
+
+		const auto directionCount = PointKernels::DirectionCount(quality);
+		const auto parallel = threadCount > 1 && points.size() >= MinimumParallelCount;
+		PointKernels::Extremes extremes;
+
+		if (!parallel) {
+			PointKernels::FindExtremes(points.data(), 0, points.size(), directionCount, extremes);
+		}
+		else {
+			std::vector<PointKernels::Extremes> ranges(threadCount);
+			std::vector<uint8_t> used(threadCount);
+
+			csharp::Parallel::For(points.size(), threadCount, [&](size_t range, size_t first, size_t count) {
+				PointKernels::FindExtremes(points.data(), first, count, directionCount, ranges[range]);
+				used[range] = 1;
+				});
+
+			extremes = ranges[0];
+
+			for (size_t range = 1; range < threadCount; ++range) {
+				if (!used[range])
+					continue;
+
+				const auto& other = ranges[range];
+
+				for (size_t d = 0; d < directionCount; ++d) {
+					if (other.Low[d] < extremes.Low[d]) {
+						extremes.Low[d] = other.Low[d];
+						extremes.LowIndex[d] = other.LowIndex[d];
+					}
+
+					if (other.High[d] > extremes.High[d]) {
+						extremes.High[d] = other.High[d];
+						extremes.HighIndex[d] = other.HighIndex[d];
+					}
+				}
+			}
+		}
+
+		//The same point is often extreme along several directions.
+		size_t indices[PointKernels::MaxDirections * 2];
+		size_t indexCount = 0;
+
+		for (size_t d = 0; d < directionCount; ++d) {
+			indices[indexCount++] = extremes.LowIndex[d];
+			indices[indexCount++] = extremes.HighIndex[d];
+		}
+
+		std::sort(indices, indices + indexCount);
+		indexCount = static_cast<size_t>(std::unique(indices, indices + indexCount) - indices);
+
+		PointKernels::Point3d extremal[PointKernels::MaxDirections * 2];
+		PointKernels::Point3d support[4];
+
+		for (size_t i = 0; i < indexCount; ++i) {
+			const auto& point = points[indices[i]];
+			extremal[i] = { point.X, point.Y, point.Z };
+		}
+
+		const auto minimum = PointKernels::MinimumSphere(extremal, indexCount, support, 0);
+
+		BoundingSphere sphere;
+		sphere.Center = Vector3(static_cast<float>(minimum.Center.X), static_cast<float>(minimum.Center.Y), static_cast<float>(minimum.Center.Z));
+		sphere.Radius = static_cast<float>(std::sqrt(minimum.RadiusSq));
+
+		if (!parallel) {
+			PointKernels::Grow(points.data(), points.size(), sphere);
+			return sphere;
+		}
+
+		//Every range grows a copy of the sphere of the extremal points, and the grown spheres are merged.
+		std::vector<BoundingSphere> spheres(threadCount, sphere);
+
+		csharp::Parallel::For(points.size(), threadCount, [&](size_t range, size_t first, size_t count) {
+			PointKernels::Grow(points.data() + first, count, spheres[range]);
+			});
+
+		for (const auto& grown : spheres)
+			sphere = CreateMerged(sphere, grown);
+
+		return sphere;
+	}
+
 	BoundingSphere BoundingSphere::CreateFromBoundingBox(BoundingBox const& box) {
 		BoundingSphere fromBoundingBox;
 		fromBoundingBox.Center = Vector3::Lerp(box.Min, box.Max, 0.5f);
@@ -425,7 +1509,7 @@ namespace xna {
 		return fromPoints;
 	}	
 
-	ContainmentType BoundingSphere::Contains(BoundingFrustum& frustum) const {
+	ContainmentType BoundingSphere::Contains(BoundingFrustum const& frustum) const {
 		if (!frustum.Intersects(*this))
 			return ContainmentType::Disjoint;
 
@@ -572,4 +1656,763 @@ namespace xna {
 		merged.Radius = num3;
 		return merged;
 	}
+
+	struct OrientedBoxKernels {
+		//Added to the absolute cosines between the axes of two boxes. The crossing of two nearly parallel axes is nearly zero
+		//and points anywhere, and the tolerance keeps it from separating the boxes.
+		static constexpr float ParallelTolerance = 1E-06F;
+		//Squared length, relative to the squared lengths of the vectors crossed, under which a crossing is taken as no axis.
+		static constexpr float CrossingTolerance = 1E-10F;
+
+		//A box as its center, unit axes and half sizes.
+		struct Frame {
+			Vector3 Center;
+			Vector3 Axes[3];
+			float Extents[3];
+		};
+
+		static Frame FrameOf(BoundingOrientedBox const& box) {
+			Frame frame;
+			frame.Center = box.Center;
+			box.GetAxes(frame.Axes[0], frame.Axes[1], frame.Axes[2]);
+			frame.Extents[0] = box.Extents.X;
+			frame.Extents[1] = box.Extents.Y;
+			frame.Extents[2] = box.Extents.Z;
+			return frame;
+		}
+
+		static Frame FrameOf(BoundingBox const& box) {
+			Frame frame;
+			frame.Center = (box.Min + box.Max) * 0.5f;
+			frame.Axes[0] = Vector3::UnitX();
+			frame.Axes[1] = Vector3::UnitY();
+			frame.Axes[2] = Vector3::UnitZ();
+			frame.Extents[0] = (box.Max.X - box.Min.X) * 0.5f;
+			frame.Extents[1] = (box.Max.Y - box.Min.Y) * 0.5f;
+			frame.Extents[2] = (box.Max.Z - box.Min.Z) * 0.5f;
+			return frame;
+		}
+
+		//Gets a point relative to the center of the box, along its axes.
+		static Vector3 ToLocal(Frame const& frame, Vector3 const& point) {
+			const auto offset = point - frame.Center;
+			return Vector3(Vector3::Dot(offset, frame.Axes[0]), Vector3::Dot(offset, frame.Axes[1]), Vector3::Dot(offset, frame.Axes[2]));
+		}
+
+		//Gets half the length of the projection of the box on axis.
+		static float Radius(Frame const& frame, Vector3 const& axis) {
+			return frame.Extents[0] * std::abs(Vector3::Dot(frame.Axes[0], axis))
+				+ frame.Extents[1] * std::abs(Vector3::Dot(frame.Axes[1], axis))
+				+ frame.Extents[2] * std::abs(Vector3::Dot(frame.Axes[2], axis));
+		}
+
+		static bool Contains(Frame const& frame, Vector3 const& point) {
+			const auto local = ToLocal(frame, point);
+			return std::abs(local.X) <= frame.Extents[0] && std::abs(local.Y) <= frame.Extents[1] && std::abs(local.Z) <= frame.Extents[2];
+		}
+
+		static void Corners(Frame const& frame, Vector3* corners) {
+			const auto x = frame.Axes[0] * frame.Extents[0];
+			const auto y = frame.Axes[1] * frame.Extents[1];
+			const auto z = frame.Axes[2] * frame.Extents[2];
+			corners[0] = frame.Center - x + y + z;
+			corners[1] = frame.Center + x + y + z;
+			corners[2] = frame.Center + x - y + z;
+			corners[3] = frame.Center - x - y + z;
+			corners[4] = frame.Center - x + y - z;
+			corners[5] = frame.Center + x + y - z;
+			corners[6] = frame.Center + x - y - z;
+			corners[7] = frame.Center - x - y - z;
+		}
+
+		static void ProjectionRange(Vector3 const* points, size_t count, Vector3 const& axis, float& low, float& high) {
+			low = high = Vector3::Dot(points[0], axis);
+
+			for (size_t i = 1; i < count; ++i) {
+				const auto projection = Vector3::Dot(points[i], axis);
+				low = std::min(low, projection);
+				high = std::max(high, projection);
+			}
+		}
+
+		//Gets whether the box is apart from a convex volume, given by its corners, along axis.
+		static bool Separated(Frame const& frame, Vector3 const* corners, size_t count, Vector3 const& axis) {
+			float low;
+			float high;
+			ProjectionRange(corners, count, axis, low, high);
+			const auto center = Vector3::Dot(frame.Center, axis);
+			const auto radius = Radius(frame, axis);
+			return center - radius > high || center + radius < low;
+		}
+
+		//Separating axis test of two boxes over the axes of both and the nine crossings of their axes.
+		static bool Separated(Frame const& a, Frame const& b) {
+#if defined(CSHARP_INTRINSICS_X86)
+			return SeparatedSse2(a, b);
+#else
+			return SeparatedScalar(a, b);
+#endif
+		}
+
+		//The order of the tests of Ericson, Real-Time Collision Detection 4.4.1, returning on the first separating axis.
+		static bool SeparatedScalar(Frame const& a, Frame const& b) {
+			float rotation[3][3];
+			float absolute[3][3];
+
+			for (size_t i = 0; i < 3; ++i) {
+				for (size_t j = 0; j < 3; ++j) {
+					rotation[i][j] = Vector3::Dot(a.Axes[i], b.Axes[j]);
+					absolute[i][j] = std::abs(rotation[i][j]) + ParallelTolerance;
+				}
+			}
+
+			const auto offset = b.Center - a.Center;
+			const float t[3] = { Vector3::Dot(offset, a.Axes[0]), Vector3::Dot(offset, a.Axes[1]), Vector3::Dot(offset, a.Axes[2]) };
+			const auto& ea = a.Extents;
+			const auto& eb = b.Extents;
+
+			for (size_t i = 0; i < 3; ++i) {
+				if (std::abs(t[i]) > ea[i] + eb[0] * absolute[i][0] + eb[1] * absolute[i][1] + eb[2] * absolute[i][2])
+					return true;
+			}
+
+			for (size_t j = 0; j < 3; ++j) {
+				const auto distance = t[0] * rotation[0][j] + t[1] * rotation[1][j] + t[2] * rotation[2][j];
+
+				if (std::abs(distance) > eb[j] + ea[0] * absolute[0][j] + ea[1] * absolute[1][j] + ea[2] * absolute[2][j])
+					return true;
+			}
+
+			for (size_t i = 0; i < 3; ++i) {
+				const auto i1 = (i + 1) % 3;
+				const auto i2 = (i + 2) % 3;
+
+				for (size_t j = 0; j < 3; ++j) {
+					const auto j1 = (j + 1) % 3;
+					const auto j2 = (j + 2) % 3;
+					const auto distance = t[i2] * rotation[i1][j] - t[i1] * rotation[i2][j];
+					const auto radius = ea[i1] * absolute[i2][j] + ea[i2] * absolute[i1][j] + eb[j1] * absolute[i][j2] + eb[j2] * absolute[i][j1];
+
+					if (std::abs(distance) > radius)
+						return true;
+				}
+			}
+
+			return false;
+		}
+
+#if defined(CSHARP_INTRINSICS_X86)
+		//The 15 tests of SeparatedScalar in five comparisons of three lanes: the axes of a, the axes of b,
+		//and the crossings of each axis of a with the three axes of b. Only the six face axes, which separate most boxes
+		//that are apart, are checked before the crossings.
+		CSHARP_TARGET("sse2")
+		static bool SeparatedSse2(Frame const& a, Frame const& b) {
+			const auto signMask = _mm_set1_ps(-0.0f);
+			const auto tolerance = _mm_set1_ps(ParallelTolerance);
+
+			//The x, y and z components of the three axes of each box, lane 3 zero.
+			const auto ax = _mm_setr_ps(a.Axes[0].X, a.Axes[1].X, a.Axes[2].X, 0.0f);
+			const auto ay = _mm_setr_ps(a.Axes[0].Y, a.Axes[1].Y, a.Axes[2].Y, 0.0f);
+			const auto az = _mm_setr_ps(a.Axes[0].Z, a.Axes[1].Z, a.Axes[2].Z, 0.0f);
+			const auto bx = _mm_setr_ps(b.Axes[0].X, b.Axes[1].X, b.Axes[2].X, 0.0f);
+			const auto by = _mm_setr_ps(b.Axes[0].Y, b.Axes[1].Y, b.Axes[2].Y, 0.0f);
+			const auto bz = _mm_setr_ps(b.Axes[0].Z, b.Axes[1].Z, b.Axes[2].Z, 0.0f);
+
+			//Row i holds the cosines between axis i of a and the axes of b, column j those between axis j of b and the axes of a.
+			__m128 rows[3];
+			__m128 absoluteRows[3];
+			__m128 absoluteColumns[3];
+
+			for (size_t i = 0; i < 3; ++i) {
+				rows[i] = _mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(_mm_set1_ps(a.Axes[i].X), bx),
+					_mm_mul_ps(_mm_set1_ps(a.Axes[i].Y), by)),
+					_mm_mul_ps(_mm_set1_ps(a.Axes[i].Z), bz));
+				absoluteRows[i] = _mm_add_ps(_mm_andnot_ps(signMask, rows[i]), tolerance);
+
+				const auto column = _mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(_mm_set1_ps(b.Axes[i].X), ax),
+					_mm_mul_ps(_mm_set1_ps(b.Axes[i].Y), ay)),
+					_mm_mul_ps(_mm_set1_ps(b.Axes[i].Z), az));
+				absoluteColumns[i] = _mm_add_ps(_mm_andnot_ps(signMask, column), tolerance);
+			}
+
+			//The offset between the centers along the axes of a, in the lanes and broadcast.
+			const auto offset = b.Center - a.Center;
+			const auto t = _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(offset.X), ax),
+				_mm_mul_ps(_mm_set1_ps(offset.Y), ay)),
+				_mm_mul_ps(_mm_set1_ps(offset.Z), az));
+			const __m128 ts[3] = {
+				_mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0)),
+				_mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)),
+				_mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2)) };
+
+			const auto extentsA = _mm_setr_ps(a.Extents[0], a.Extents[1], a.Extents[2], 0.0f);
+			const auto extentsB = _mm_setr_ps(b.Extents[0], b.Extents[1], b.Extents[2], 0.0f);
+			const __m128 eas[3] = { _mm_set1_ps(a.Extents[0]), _mm_set1_ps(a.Extents[1]), _mm_set1_ps(a.Extents[2]) };
+
+			//Axes of a.
+			auto separated = _mm_cmpgt_ps(_mm_andnot_ps(signMask, t), _mm_add_ps(extentsA, _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(b.Extents[0]), absoluteColumns[0]),
+				_mm_mul_ps(_mm_set1_ps(b.Extents[1]), absoluteColumns[1])),
+				_mm_mul_ps(_mm_set1_ps(b.Extents[2]), absoluteColumns[2]))));
+
+			//Axes of b.
+			const auto distanceB = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ts[0], rows[0]), _mm_mul_ps(ts[1], rows[1])), _mm_mul_ps(ts[2], rows[2]));
+			separated = _mm_or_ps(separated, _mm_cmpgt_ps(_mm_andnot_ps(signMask, distanceB), _mm_add_ps(extentsB, _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(eas[0], absoluteRows[0]),
+				_mm_mul_ps(eas[1], absoluteRows[1])),
+				_mm_mul_ps(eas[2], absoluteRows[2])))));
+
+			if (_mm_movemask_ps(separated) != 0)
+				return true;
+
+			//Crossings of axis i of a with axis j of b in lane j, where the extents of b and the row of i are rotated to j + 1 and j + 2.
+			const auto extentsB1 = _mm_shuffle_ps(extentsB, extentsB, _MM_SHUFFLE(3, 0, 2, 1));
+			const auto extentsB2 = _mm_shuffle_ps(extentsB, extentsB, _MM_SHUFFLE(3, 1, 0, 2));
+
+			for (size_t i = 0; i < 3; ++i) {
+				const auto i1 = (i + 1) % 3;
+				const auto i2 = (i + 2) % 3;
+				const auto distance = _mm_sub_ps(_mm_mul_ps(ts[i2], rows[i1]), _mm_mul_ps(ts[i1], rows[i2]));
+				const auto radius = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(eas[i1], absoluteRows[i2]), _mm_mul_ps(eas[i2], absoluteRows[i1])),
+					_mm_add_ps(
+						_mm_mul_ps(extentsB1, _mm_shuffle_ps(absoluteRows[i], absoluteRows[i], _MM_SHUFFLE(3, 1, 0, 2))),
+						_mm_mul_ps(extentsB2, _mm_shuffle_ps(absoluteRows[i], absoluteRows[i], _MM_SHUFFLE(3, 0, 2, 1)))));
+
+				separated = _mm_or_ps(separated, _mm_cmpgt_ps(_mm_andnot_ps(signMask, distance), radius));
+			}
+
+			//Lane 3 compares 0 with a radius of at least 0, never greater.
+			return _mm_movemask_ps(separated) != 0;
+		}
+#endif
+
+		//Gets a unit vector perpendicular to a unit vector.
+		static Vector3 Perpendicular(Vector3 const& axis) {
+			const auto x = std::abs(axis.X);
+			const auto y = std::abs(axis.Y);
+			const auto z = std::abs(axis.Z);
+			const auto other = x <= y && x <= z ? Vector3::UnitX() : (y <= z ? Vector3::UnitY() : Vector3::UnitZ());
+			return Vector3::Normalize(Vector3::Cross(axis, other));
+		}
+
+		//Gets the unit rotation whose axes are closest to the directions, taken in order: the first direction,
+		//the part of the second across it, and their cross product. Directions of no length are replaced by any that fits.
+		static Quaternion OrientationOf(Vector3 const* directions) {
+			Vector3 axes[3];
+			const auto firstSq = directions[0].LengthSquared();
+			axes[0] = firstSq > 0.0f ? directions[0] / std::sqrt(firstSq) : Vector3::UnitX();
+
+			const auto across = directions[1] - axes[0] * Vector3::Dot(directions[1], axes[0]);
+			const auto acrossSq = across.LengthSquared();
+			axes[1] = acrossSq > CrossingTolerance * directions[1].LengthSquared() && acrossSq > 0.0f
+				? across / std::sqrt(acrossSq)
+				: Perpendicular(axes[0]);
+
+			axes[2] = Vector3::Cross(axes[0], axes[1]);
+
+			auto matrix = Matrix::Identity();
+			matrix.M11 = axes[0].X;
+			matrix.M12 = axes[0].Y;
+			matrix.M13 = axes[0].Z;
+			matrix.M21 = axes[1].X;
+			matrix.M22 = axes[1].Y;
+			matrix.M23 = axes[1].Z;
+			matrix.M31 = axes[2].X;
+			matrix.M32 = axes[2].Y;
+			matrix.M33 = axes[2].Z;
+			return Quaternion::Normalize(Quaternion::CreateFromRotationMatrix(matrix));
+		}
+
+		//Sums of the offsets of points from an origin and of their products, for the covariance of CreateFromPoints.
+		struct Moments {
+			double Sum[3]{};
+			//xx, yy, zz, xy, xz and yz.
+			double Products[6]{};
+
+			void Add(Moments const& other) {
+				for (size_t i = 0; i < 3; ++i)
+					Sum[i] += other.Sum[i];
+
+				for (size_t i = 0; i < 6; ++i)
+					Products[i] += other.Products[i];
+			}
+		};
+
+		//Adds the moments of the first count points of a block. A block is summed in float, four points at a time, and added in double.
+		static void Accumulate(PointKernels::Block const& block, size_t count, Vector3 const& origin, Moments& moments) {
+			float sums[9] = {};
+			size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			i = AccumulateSse2(block, count, origin, sums);
+#endif
+			for (; i < count; ++i) {
+				const auto x = block.X[i] - origin.X;
+				const auto y = block.Y[i] - origin.Y;
+				const auto z = block.Z[i] - origin.Z;
+				sums[0] += x;
+				sums[1] += y;
+				sums[2] += z;
+				sums[3] += x * x;
+				sums[4] += y * y;
+				sums[5] += z * z;
+				sums[6] += x * y;
+				sums[7] += x * z;
+				sums[8] += y * z;
+			}
+
+			for (size_t k = 0; k < 3; ++k)
+				moments.Sum[k] += sums[k];
+
+			for (size_t k = 0; k < 6; ++k)
+				moments.Products[k] += sums[k + 3];
+		}
+
+#if defined(CSHARP_INTRINSICS_X86)
+		//Returns the number of points done.
+		CSHARP_TARGET("sse2")
+		static size_t AccumulateSse2(PointKernels::Block const& block, size_t count, Vector3 const& origin, float* sums) {
+			const auto end = count / 4 * 4;
+			const auto originX = _mm_set1_ps(origin.X);
+			const auto originY = _mm_set1_ps(origin.Y);
+			const auto originZ = _mm_set1_ps(origin.Z);
+			__m128 lanes[9];
+
+			for (auto& lane : lanes)
+				lane = _mm_setzero_ps();
+
+			for (size_t i = 0; i < end; i += 4) {
+				const auto x = _mm_sub_ps(_mm_load_ps(block.X + i), originX);
+				const auto y = _mm_sub_ps(_mm_load_ps(block.Y + i), originY);
+				const auto z = _mm_sub_ps(_mm_load_ps(block.Z + i), originZ);
+				lanes[0] = _mm_add_ps(lanes[0], x);
+				lanes[1] = _mm_add_ps(lanes[1], y);
+				lanes[2] = _mm_add_ps(lanes[2], z);
+				lanes[3] = _mm_add_ps(lanes[3], _mm_mul_ps(x, x));
+				lanes[4] = _mm_add_ps(lanes[4], _mm_mul_ps(y, y));
+				lanes[5] = _mm_add_ps(lanes[5], _mm_mul_ps(z, z));
+				lanes[6] = _mm_add_ps(lanes[6], _mm_mul_ps(x, y));
+				lanes[7] = _mm_add_ps(lanes[7], _mm_mul_ps(x, z));
+				lanes[8] = _mm_add_ps(lanes[8], _mm_mul_ps(y, z));
+			}
+
+			alignas(16) float values[4];
+
+			for (size_t k = 0; k < 9; ++k) {
+				_mm_store_ps(values, lanes[k]);
+				sums[k] = (values[0] + values[1]) + (values[2] + values[3]);
+			}
+
+			return end;
+		}
+#endif
+
+		static void Accumulate(Vector3 const* points, size_t count, Vector3 const& origin, Moments& moments) {
+			PointKernels::Block block;
+
+			for (size_t start = 0; start < count; start += PointKernels::BlockSize) {
+				const auto size = std::min(PointKernels::BlockSize, count - start);
+				block.Load(points + start, size);
+				Accumulate(block, size, origin, moments);
+			}
+		}
+
+		//The three axes of a box, then the X, Y and Z axes.
+		static constexpr size_t ProjectionCount = 6;
+
+		struct Projections {
+			float Low[ProjectionCount];
+			float High[ProjectionCount];
+		};
+
+		//Widening of the half sizes of CreateFromPoints, relative to the distance of the box from the origin plus its size.
+		//It covers the rounding of the projections of the points and of the offsets from the center that Contains measures.
+		static constexpr double ContainmentTolerance = 8 * static_cast<double>(std::numeric_limits<float>::epsilon());
+
+		static Vector3 Widen(Vector3 const& center, double const* extents) {
+			const auto size = std::sqrt(extents[0] * extents[0] + extents[1] * extents[1] + extents[2] * extents[2]);
+			const auto widening = (static_cast<double>(center.Length()) + size) * ContainmentTolerance;
+			return Vector3(static_cast<float>(extents[0] + widening), static_cast<float>(extents[1] + widening), static_cast<float>(extents[2] + widening));
+		}
+
+		static void Project(Vector3 const* points, size_t count, float const (&directions)[ProjectionCount][3], Projections& projections) {
+			for (size_t d = 0; d < ProjectionCount; ++d) {
+				projections.Low[d] = (std::numeric_limits<float>::max)();
+				projections.High[d] = std::numeric_limits<float>::lowest();
+			}
+
+			PointKernels::Block block;
+
+			for (size_t start = 0; start < count; start += PointKernels::BlockSize) {
+				const auto size = std::min(PointKernels::BlockSize, count - start);
+				block.Load(points + start, size);
+
+				for (size_t d = 0; d < ProjectionCount; ++d)
+					PointKernels::ProjectionRange(block, size, directions[d], projections.Low[d], projections.High[d]);
+			}
+		}
+
+		//Eigenvectors of a symmetric 3x3 matrix, as the columns of vectors, by cyclic Jacobi rotations.
+		static void Eigenvectors(double (&matrix)[3][3], double (&vectors)[3][3]) {
+			for (size_t i = 0; i < 3; ++i) {
+				for (size_t j = 0; j < 3; ++j)
+					vectors[i][j] = i == j ? 1.0 : 0.0;
+			}
+
+			for (size_t sweep = 0; sweep < 32; ++sweep) {
+				const auto offDiagonal = matrix[0][1] * matrix[0][1] + matrix[0][2] * matrix[0][2] + matrix[1][2] * matrix[1][2];
+				const auto diagonal = matrix[0][0] * matrix[0][0] + matrix[1][1] * matrix[1][1] + matrix[2][2] * matrix[2][2];
+
+				if (offDiagonal <= 1E-24 * diagonal || offDiagonal == 0.0)
+					return;
+
+				for (size_t p = 0; p < 2; ++p) {
+					for (size_t q = p + 1; q < 3; ++q) {
+						if (matrix[p][q] == 0.0)
+							continue;
+
+						//The rotation in the p, q plane that makes matrix[p][q] zero.
+						const auto theta = (matrix[q][q] - matrix[p][p]) / (2.0 * matrix[p][q]);
+						const auto tangent = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+						const auto cosine = 1.0 / std::sqrt(tangent * tangent + 1.0);
+						const auto sine = tangent * cosine;
+
+						for (size_t k = 0; k < 3; ++k) {
+							const auto kp = matrix[k][p];
+							const auto kq = matrix[k][q];
+							matrix[k][p] = cosine * kp - sine * kq;
+							matrix[k][q] = sine * kp + cosine * kq;
+						}
+
+						for (size_t k = 0; k < 3; ++k) {
+							const auto pk = matrix[p][k];
+							const auto qk = matrix[q][k];
+							matrix[p][k] = cosine * pk - sine * qk;
+							matrix[q][k] = sine * pk + cosine * qk;
+						}
+
+						for (size_t k = 0; k < 3; ++k) {
+							const auto kp = vectors[k][p];
+							const auto kq = vectors[k][q];
+							vectors[k][p] = cosine * kp - sine * kq;
+							vectors[k][q] = sine * kp + cosine * kq;
+						}
+					}
+				}
+			}
+		}
+	};
+
+	void BoundingOrientedBox::GetCorners(std::vector<Vector3>& corners) const {
+		if (corners.size() < CornerCount)
+			corners.resize(CornerCount);
+
+		OrientedBoxKernels::Corners(OrientedBoxKernels::FrameOf(*this), corners.data());
+	}
+
+	BoundingOrientedBox BoundingOrientedBox::CreateFromPoints(std::span<const Vector3> points, size_t threadCount) {
+		if (points.empty())
+			return BoundingOrientedBox();
+
+		const auto parallel = threadCount > 1 && points.size() >= MinimumParallelCount;
+		//Offsets from the first point keep the sums small for points far from the origin.
+		const auto origin = points[0];
+		OrientedBoxKernels::Moments moments;
+
+		if (!parallel) {
+			OrientedBoxKernels::Accumulate(points.data(), points.size(), origin, moments);
+		}
+		else {
+			std::vector<OrientedBoxKernels::Moments> ranges(threadCount);
+
+			csharp::Parallel::For(points.size(), threadCount, [&](size_t range, size_t first, size_t count) {
+				OrientedBoxKernels::Accumulate(points.data() + first, count, origin, ranges[range]);
+				});
+
+			for (const auto& range : ranges)
+				moments.Add(range);
+		}
+
+		const auto count = static_cast<double>(points.size());
+		const double mean[3] = { moments.Sum[0] / count, moments.Sum[1] / count, moments.Sum[2] / count };
+		double covariance[3][3];
+		covariance[0][0] = moments.Products[0] / count - mean[0] * mean[0];
+		covariance[1][1] = moments.Products[1] / count - mean[1] * mean[1];
+		covariance[2][2] = moments.Products[2] / count - mean[2] * mean[2];
+		covariance[0][1] = covariance[1][0] = moments.Products[3] / count - mean[0] * mean[1];
+		covariance[0][2] = covariance[2][0] = moments.Products[4] / count - mean[0] * mean[2];
+		covariance[1][2] = covariance[2][1] = moments.Products[5] / count - mean[1] * mean[2];
+
+		double vectors[3][3];
+		OrientedBoxKernels::Eigenvectors(covariance, vectors);
+
+		const Vector3 principal[2] = {
+			Vector3(static_cast<float>(vectors[0][0]), static_cast<float>(vectors[1][0]), static_cast<float>(vectors[2][0])),
+			Vector3(static_cast<float>(vectors[0][1]), static_cast<float>(vectors[1][1]), static_cast<float>(vectors[2][1])) };
+
+		//The points are measured along the axes of the stored orientation, so the box contains them as it is read back.
+		BoundingOrientedBox box;
+		box.Orientation = OrientedBoxKernels::OrientationOf(principal);
+
+		Vector3 axes[3];
+		box.GetAxes(axes[0], axes[1], axes[2]);
+
+		const float directions[OrientedBoxKernels::ProjectionCount][3] = {
+			{ axes[0].X, axes[0].Y, axes[0].Z }, { axes[1].X, axes[1].Y, axes[1].Z }, { axes[2].X, axes[2].Y, axes[2].Z },
+			{ 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+		OrientedBoxKernels::Projections projections;
+
+		if (!parallel) {
+			OrientedBoxKernels::Project(points.data(), points.size(), directions, projections);
+		}
+		else {
+			std::vector<OrientedBoxKernels::Projections> ranges(threadCount);
+			std::vector<uint8_t> used(threadCount);
+
+			csharp::Parallel::For(points.size(), threadCount, [&](size_t range, size_t first, size_t count) {
+				OrientedBoxKernels::Project(points.data() + first, count, directions, ranges[range]);
+				used[range] = 1;
+				});
+
+			projections = ranges[0];
+
+			for (size_t range = 1; range < threadCount; ++range) {
+				if (!used[range])
+					continue;
+
+				for (size_t d = 0; d < OrientedBoxKernels::ProjectionCount; ++d) {
+					projections.Low[d] = std::min(projections.Low[d], ranges[range].Low[d]);
+					projections.High[d] = std::max(projections.High[d], ranges[range].High[d]);
+				}
+			}
+		}
+
+		//In double, so that the middles and half sizes add no rounding of their own.
+		double extents[OrientedBoxKernels::ProjectionCount];
+		double middles[OrientedBoxKernels::ProjectionCount];
+
+		for (size_t d = 0; d < OrientedBoxKernels::ProjectionCount; ++d) {
+			extents[d] = (static_cast<double>(projections.High[d]) - projections.Low[d]) * 0.5;
+			middles[d] = (static_cast<double>(projections.High[d]) + projections.Low[d]) * 0.5;
+		}
+
+		//The principal axes follow the spread of the points, not their hull, and lose to the BoundingBox on some sets.
+		const auto volume = extents[0] * extents[1] * extents[2];
+		const auto area = extents[0] * extents[1] + extents[1] * extents[2] + extents[2] * extents[0];
+		const auto alignedVolume = extents[3] * extents[4] * extents[5];
+		const auto alignedArea = extents[3] * extents[4] + extents[4] * extents[5] + extents[5] * extents[3];
+
+		if (alignedVolume < volume || (alignedVolume == volume && alignedArea < area)) {
+			const auto center = Vector3(static_cast<float>(middles[3]), static_cast<float>(middles[4]), static_cast<float>(middles[5]));
+			return BoundingOrientedBox(center, OrientedBoxKernels::Widen(center, extents + 3), Quaternion::Identity());
+		}
+
+		double center[3];
+
+		for (size_t k = 0; k < 3; ++k) {
+			center[k] = static_cast<double>(directions[0][k]) * middles[0] + static_cast<double>(directions[1][k]) * middles[1]
+				+ static_cast<double>(directions[2][k]) * middles[2];
+		}
+
+		box.Center = Vector3(static_cast<float>(center[0]), static_cast<float>(center[1]), static_cast<float>(center[2]));
+		box.Extents = OrientedBoxKernels::Widen(box.Center, extents);
+		return box;
+	}
+
+	BoundingOrientedBox BoundingOrientedBox::Transform(Matrix const& matrix) const {
+		const auto frame = OrientedBoxKernels::FrameOf(*this);
+		Vector3 halves[3];
+
+		for (size_t i = 0; i < 3; ++i)
+			halves[i] = Vector3::TransformNormal(frame.Axes[i] * frame.Extents[i], matrix);
+
+		BoundingOrientedBox box;
+		box.Center = Vector3::Transform(Center, matrix);
+		box.Orientation = OrientedBoxKernels::OrientationOf(halves);
+
+		//Each extent is the projection of the transformed half sizes, which are the extents themselves when they stay at right angles.
+		Vector3 axes[3];
+		box.GetAxes(axes[0], axes[1], axes[2]);
+		float extents[3];
+
+		for (size_t k = 0; k < 3; ++k) {
+			extents[k] = std::abs(Vector3::Dot(halves[0], axes[k])) + std::abs(Vector3::Dot(halves[1], axes[k]))
+				+ std::abs(Vector3::Dot(halves[2], axes[k]));
+		}
+
+		box.Extents = Vector3(extents[0], extents[1], extents[2]);
+		return box;
+	}
+
+	BoundingOrientedBox BoundingOrientedBox::Transform(Quaternion const& rotation) const {
+		return BoundingOrientedBox(Vector3::Transform(Center, rotation), Extents,
+			Quaternion::Normalize(Quaternion::Concatenate(Orientation, rotation)));
+	}
+
+	bool BoundingOrientedBox::Intersects(BoundingOrientedBox const& box) const {
+		return !OrientedBoxKernels::Separated(OrientedBoxKernels::FrameOf(*this), OrientedBoxKernels::FrameOf(box));
+	}
+
+	bool BoundingOrientedBox::Intersects(BoundingBox const& box) const {
+		return !OrientedBoxKernels::Separated(OrientedBoxKernels::FrameOf(*this), OrientedBoxKernels::FrameOf(box));
+	}
+
+	bool BoundingOrientedBox::Intersects(BoundingSphere const& sphere) const {
+		const auto local = OrientedBoxKernels::ToLocal(OrientedBoxKernels::FrameOf(*this), sphere.Center);
+		const auto closest = Vector3::Clamp(local, -Extents, Extents);
+		return Vector3::DistanceSquared(local, closest) <= sphere.Radius * sphere.Radius;
+	}
+
+	bool BoundingOrientedBox::Intersects(BoundingFrustum const& frustum) const {
+		const auto frame = OrientedBoxKernels::FrameOf(*this);
+
+		//The faces of the frustum, whose planes point out.
+		for (size_t i = 0; i < BoundingFrustum::PlaneCount; ++i) {
+			const auto& plane = frustum.planes[i];
+
+			if (plane.DotCoordinate(Center) > OrientedBoxKernels::Radius(frame, plane.Normal))
+				return false;
+		}
+
+		//The faces of the box.
+		for (size_t i = 0; i < 3; ++i) {
+			if (OrientedBoxKernels::Separated(frame, frustum.corners, BoundingFrustum::CornerCount, frame.Axes[i]))
+				return false;
+		}
+
+		//The crossings of the box axes with the edge directions of the frustum: two of the near face, two of the far face,
+		//equal to those of the near face unless the projection is oblique, and the four sides.
+		const auto& corners = frustum.corners;
+		const Vector3 edges[8] = {
+			corners[1] - corners[0], corners[3] - corners[0], corners[5] - corners[4], corners[7] - corners[4],
+			corners[4] - corners[0], corners[5] - corners[1], corners[6] - corners[2], corners[7] - corners[3] };
+
+		for (const auto& edge : edges) {
+			const auto edgeSq = edge.LengthSquared();
+
+			for (size_t i = 0; i < 3; ++i) {
+				const auto axis = Vector3::Cross(frame.Axes[i], edge);
+
+				if (axis.LengthSquared() <= OrientedBoxKernels::CrossingTolerance * edgeSq)
+					continue;
+
+				if (OrientedBoxKernels::Separated(frame, corners, BoundingFrustum::CornerCount, axis))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	PlaneIntersectionType BoundingOrientedBox::Intersects(Plane const& plane) const {
+		const auto distance = plane.DotCoordinate(Center);
+		const auto radius = OrientedBoxKernels::Radius(OrientedBoxKernels::FrameOf(*this), plane.Normal);
+
+		if (distance > radius)
+			return PlaneIntersectionType::Front;
+
+		return distance < -radius ? PlaneIntersectionType::Back : PlaneIntersectionType::Intersecting;
+	}
+
+	std::optional<float> BoundingOrientedBox::Intersects(Ray const& ray) const {
+		//The slab test of BoundingBox in the frame of the box, where distances along the ray are the same.
+		const auto frame = OrientedBoxKernels::FrameOf(*this);
+		Ray local;
+		local.Position = OrientedBoxKernels::ToLocal(frame, ray.Position);
+		local.Direction = Vector3(Vector3::Dot(ray.Direction, frame.Axes[0]), Vector3::Dot(ray.Direction, frame.Axes[1]), Vector3::Dot(ray.Direction, frame.Axes[2]));
+		return BoundingBox(-Extents, Extents).Intersects(local);
+	}
+
+	ContainmentType BoundingOrientedBox::Contains(Vector3 const& point) const {
+		return OrientedBoxKernels::Contains(OrientedBoxKernels::FrameOf(*this), point) ? ContainmentType::Contains : ContainmentType::Disjoint;
+	}
+
+	ContainmentType BoundingOrientedBox::Contains(BoundingSphere const& sphere) const {
+		const auto local = OrientedBoxKernels::ToLocal(OrientedBoxKernels::FrameOf(*this), sphere.Center);
+		const auto closest = Vector3::Clamp(local, -Extents, Extents);
+		const auto radius = sphere.Radius;
+
+		if (Vector3::DistanceSquared(local, closest) > radius * radius)
+			return ContainmentType::Disjoint;
+
+		return std::abs(local.X) + radius <= Extents.X && std::abs(local.Y) + radius <= Extents.Y && std::abs(local.Z) + radius <= Extents.Z
+			? ContainmentType::Contains
+			: ContainmentType::Intersects;
+	}
+
+	ContainmentType BoundingOrientedBox::Contains(BoundingBox const& box) const {
+		if (!Intersects(box))
+			return ContainmentType::Disjoint;
+
+		const auto frame = OrientedBoxKernels::FrameOf(*this);
+		Vector3 corners[CornerCount];
+		OrientedBoxKernels::Corners(OrientedBoxKernels::FrameOf(box), corners);
+
+		for (const auto& corner : corners) {
+			if (!OrientedBoxKernels::Contains(frame, corner))
+				return ContainmentType::Intersects;
+		}
+
+		return ContainmentType::Contains;
+	}
+
+	ContainmentType BoundingOrientedBox::Contains(BoundingOrientedBox const& box) const {
+		if (!Intersects(box))
+			return ContainmentType::Disjoint;
+
+		const auto frame = OrientedBoxKernels::FrameOf(*this);
+		Vector3 corners[CornerCount];
+		OrientedBoxKernels::Corners(OrientedBoxKernels::FrameOf(box), corners);
+
+		for (const auto& corner : corners) {
+			if (!OrientedBoxKernels::Contains(frame, corner))
+				return ContainmentType::Intersects;
+		}
+
+		return ContainmentType::Contains;
+	}
+
+	ContainmentType BoundingOrientedBox::Contains(BoundingFrustum const& frustum) const {
+		if (!Intersects(frustum))
+			return ContainmentType::Disjoint;
+
+		const auto frame = OrientedBoxKernels::FrameOf(*this);
+
+		for (const auto& corner : frustum.corners) {
+			if (!OrientedBoxKernels::Contains(frame, corner))
+				return ContainmentType::Intersects;
+		}
+
+		return ContainmentType::Contains;
+	}
+
+	void BoundingOrientedBox::SupportMapping(Vector3 const& v, Vector3& result) const {
+		const auto frame = OrientedBoxKernels::FrameOf(*this);
+		result = Center;
+
+		for (size_t i = 0; i < 3; ++i)
+			result += frame.Axes[i] * (Vector3::Dot(v, frame.Axes[i]) >= 0.0f ? frame.Extents[i] : -frame.Extents[i]);
+	}
+
+	ContainmentType BoundingFrustum::Contains(BoundingOrientedBox const& box) const {
+		auto flag = false;
+
+		for (size_t i = 0; i < PlaneCount; ++i) {
+			switch (box.Intersects(planes[i])) {
+			case PlaneIntersectionType::Front:
+				return ContainmentType::Disjoint;
+			case PlaneIntersectionType::Intersecting:
+				flag = true;
+				break;
+			default:
+				break;
+			}
+		}
+
+		return !flag ? ContainmentType::Contains : ContainmentType::Intersects;
+	}
 }
\ No newline at end of file
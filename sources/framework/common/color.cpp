@@ -1,4 +1,6 @@
 #include "xna/common/color.hpp"
+#include "csharp/runtime/intrinsics.hpp"
+#include <cstring>
 
 namespace xna {
 	Color::Color(float r, float g, float b, float a) :
@@ -63,9 +65,511 @@ namespace xna {
 		const auto byteMax = static_cast<float>(ByteMaxValue);
 		const auto x = PackUtils::PackUNorm(byteMax, vectorX);
 		const auto y = PackUtils::PackUNorm(byteMax, vectorY) << 8;
-		const auto z = PackUtils::PackUNorm(byteMax, vectorZ);
+		const auto z = PackUtils::PackUNorm(byteMax, vectorZ) << 16;
 		const auto w = PackUtils::PackUNorm(byteMax, vectorW) << 24;
 
 		return x | y | z | w;
 	}
-}
\ No newline at end of file
+
+	//Kernels over packed colors. Channels are widened to 16 bits, where every product in Lerp, Multiply and
+	//FromNonPremultiplied fits, so the results are exact. Each vector kernel returns how many colors it processed
+	//and leaves the tail to the scalar functions.
+	struct ColorKernels {
+		static constexpr uint32_t SwapRedBlue(uint32_t value) {
+			return (value & 0xFF00FF00U) | ((value >> 16) & 0xFFU) | ((value & 0xFFU) << 16);
+		}
+
+		static uint32_t FromNonPremultiplied(uint32_t value) {
+			const auto a = static_cast<int32_t>(value >> 24);
+			return Color::FromNonPremultiplied(value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, a).PackedValue();
+		}
+
+		static uint32_t ToNonPremultiplied(uint32_t value) {
+			const auto a = value >> 24;
+			uint32_t result = a << 24;
+
+			if (a == 0)
+				return result;
+
+			for (uint32_t shift = 0; shift < 24; shift += 8) {
+				const auto channel = static_cast<float>((value >> shift) & 0xFF) * 255.0f / static_cast<float>(a) + 0.5f;
+				result |= (channel < 255.0f ? static_cast<uint32_t>(channel) : 255U) << shift;
+			}
+
+			return result;
+		}
+
+#if defined(CSHARP_INTRINSICS_X86)
+		inline static const bool UseAvx2 = csharp::X86Intrinsics::IsAvx2Supported();
+
+		//(d * bitmask) >> 16 with a signed d and an unsigned 16-bit bitmask.
+		CSHARP_TARGET("sse2")
+		static __m128i MultiplyHigh(__m128i d, __m128i bitmask) {
+			return _mm_sub_epi16(_mm_mulhi_epu16(d, bitmask), _mm_and_si128(_mm_srai_epi16(d, 15), bitmask));
+		}
+
+		CSHARP_TARGET("avx2")
+		static __m256i MultiplyHigh(__m256i d, __m256i bitmask) {
+			return _mm256_sub_epi16(_mm256_mulhi_epu16(d, bitmask), _mm256_and_si256(_mm256_srai_epi16(d, 15), bitmask));
+		}
+
+		CSHARP_TARGET("sse2")
+		static size_t LerpSse2(uint32_t const* values1, uint32_t const* values2, uint32_t bitmask, uint32_t* destination, size_t count) {
+			const auto zero = _mm_setzero_si128();
+			const auto factor = _mm_set1_epi16(static_cast<short>(bitmask));
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4) {
+				const auto a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(values1 + i));
+				const auto b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(values2 + i));
+				const auto aLow = _mm_unpacklo_epi8(a, zero);
+				const auto aHigh = _mm_unpackhi_epi8(a, zero);
+				const auto low = _mm_add_epi16(aLow, MultiplyHigh(_mm_sub_epi16(_mm_unpacklo_epi8(b, zero), aLow), factor));
+				const auto high = _mm_add_epi16(aHigh, MultiplyHigh(_mm_sub_epi16(_mm_unpackhi_epi8(b, zero), aHigh), factor));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(low, high));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t LerpAvx2(uint32_t const* values1, uint32_t const* values2, uint32_t bitmask, uint32_t* destination, size_t count) {
+			const auto zero = _mm256_setzero_si256();
+			const auto factor = _mm256_set1_epi16(static_cast<short>(bitmask));
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				const auto a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values1 + i));
+				const auto b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values2 + i));
+				const auto aLow = _mm256_unpacklo_epi8(a, zero);
+				const auto aHigh = _mm256_unpackhi_epi8(a, zero);
+				const auto low = _mm256_add_epi16(aLow, MultiplyHigh(_mm256_sub_epi16(_mm256_unpacklo_epi8(b, zero), aLow), factor));
+				const auto high = _mm256_add_epi16(aHigh, MultiplyHigh(_mm256_sub_epi16(_mm256_unpackhi_epi8(b, zero), aHigh), factor));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_packus_epi16(low, high));
+			}
+
+			return i;
+		}
+
+		//(c * scale) >> 16 for a 24-bit scale, split as c * (scale >> 16) + ((c * (scale & 0xFFFF)) >> 16),
+		//then saturated to 255.
+		CSHARP_TARGET("sse2")
+		static __m128i Scale(__m128i c, __m128i high, __m128i low) {
+			const auto saturate = _mm_set1_epi16(static_cast<short>(0xFF00));
+			const auto value = _mm_adds_epu16(_mm_mullo_epi16(c, high), _mm_mulhi_epu16(c, low));
+			return _mm_subs_epu16(_mm_adds_epu16(value, saturate), saturate);
+		}
+
+		CSHARP_TARGET("avx2")
+		static __m256i Scale(__m256i c, __m256i high, __m256i low) {
+			const auto saturate = _mm256_set1_epi16(static_cast<short>(0xFF00));
+			const auto value = _mm256_adds_epu16(_mm256_mullo_epi16(c, high), _mm256_mulhi_epu16(c, low));
+			return _mm256_subs_epu16(_mm256_adds_epu16(value, saturate), saturate);
+		}
+
+		CSHARP_TARGET("sse2")
+		static size_t MultiplySse2(uint32_t const* values, uint32_t scale, uint32_t* destination, size_t count) {
+			const auto zero = _mm_setzero_si128();
+			const auto high = _mm_set1_epi16(static_cast<short>(scale >> 16));
+			const auto low = _mm_set1_epi16(static_cast<short>(scale & 0xFFFF));
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4) {
+				const auto c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(values + i));
+				const auto cLow = Scale(_mm_unpacklo_epi8(c, zero), high, low);
+				const auto cHigh = Scale(_mm_unpackhi_epi8(c, zero), high, low);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(cLow, cHigh));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t MultiplyAvx2(uint32_t const* values, uint32_t scale, uint32_t* destination, size_t count) {
+			const auto zero = _mm256_setzero_si256();
+			const auto high = _mm256_set1_epi16(static_cast<short>(scale >> 16));
+			const auto low = _mm256_set1_epi16(static_cast<short>(scale & 0xFFFF));
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				const auto c = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values + i));
+				const auto cLow = Scale(_mm256_unpacklo_epi8(c, zero), high, low);
+				const auto cHigh = Scale(_mm256_unpackhi_epi8(c, zero), high, low);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_packus_epi16(cLow, cHigh));
+			}
+
+			return i;
+		}
+
+		//c * a / 255 with integer division, as (x + 1 + (x >> 8)) >> 8, which is exact for x up to 255 * 255.
+		//The alpha lanes keep their value.
+		CSHARP_TARGET("sse2")
+		static __m128i Premultiply(__m128i c) {
+			const auto alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			const auto x = _mm_mullo_epi16(c, alpha);
+			const auto quotient = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+			const auto alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+			return _mm_or_si128(_mm_andnot_si128(alphaMask, quotient), _mm_and_si128(alphaMask, c));
+		}
+
+		CSHARP_TARGET("avx2")
+		static __m256i Premultiply(__m256i c) {
+			const auto alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			const auto x = _mm256_mullo_epi16(c, alpha);
+			const auto quotient = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)), 8);
+			const auto alphaMask = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+			return _mm256_or_si256(_mm256_andnot_si256(alphaMask, quotient), _mm256_and_si256(alphaMask, c));
+		}
+
+		CSHARP_TARGET("sse2")
+		static size_t FromNonPremultipliedSse2(uint32_t const* values, uint32_t* destination, size_t count) {
+			const auto zero = _mm_setzero_si128();
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4) {
+				const auto c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(values + i));
+				const auto low = Premultiply(_mm_unpacklo_epi8(c, zero));
+				const auto high = Premultiply(_mm_unpackhi_epi8(c, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(low, high));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t FromNonPremultipliedAvx2(uint32_t const* values, uint32_t* destination, size_t count) {
+			const auto zero = _mm256_setzero_si256();
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				const auto c = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values + i));
+				const auto low = Premultiply(_mm256_unpacklo_epi8(c, zero));
+				const auto high = Premultiply(_mm256_unpackhi_epi8(c, zero));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_packus_epi16(low, high));
+			}
+
+			return i;
+		}
+
+		//c * 255 / a + 0.5, truncated. A zero alpha gives infinity or NaN, which convert to a negative
+		//integer and pack to 0; values above 255 pack to 255.
+		CSHARP_TARGET("sse2")
+		static __m128i Unpremultiply(__m128 c) {
+			const auto alpha = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+			return _mm_cvttps_epi32(_mm_add_ps(_mm_div_ps(_mm_mul_ps(c, _mm_set1_ps(255.0f)), alpha), _mm_set1_ps(0.5f)));
+		}
+
+		CSHARP_TARGET("avx2")
+		static __m256i Unpremultiply(__m256 c) {
+			const auto alpha = _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+			return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_div_ps(_mm256_mul_ps(c, _mm256_set1_ps(255.0f)), alpha), _mm256_set1_ps(0.5f)));
+		}
+
+		CSHARP_TARGET("sse2")
+		static size_t ToNonPremultipliedSse2(uint32_t const* values, uint32_t* destination, size_t count) {
+			const auto zero = _mm_setzero_si128();
+			const auto alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000U));
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4) {
+				const auto c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(values + i));
+				const auto low = _mm_unpacklo_epi8(c, zero);
+				const auto high = _mm_unpackhi_epi8(c, zero);
+				const auto c0 = Unpremultiply(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)));
+				const auto c1 = Unpremultiply(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)));
+				const auto c2 = Unpremultiply(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)));
+				const auto c3 = Unpremultiply(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)));
+				const auto packed = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_or_si128(_mm_andnot_si128(alphaMask, packed), _mm_and_si128(alphaMask, c)));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t ToNonPremultipliedAvx2(uint32_t const* values, uint32_t* destination, size_t count) {
+			const auto alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000U));
+			//The in-lane packs leave colors 0, 2, 4, 6 in the low lane and 1, 3, 5, 7 in the high lane.
+			const auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				const auto c = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values + i));
+				const auto c0 = Unpremultiply(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(values + i)))));
+				const auto c1 = Unpremultiply(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(values + i + 2)))));
+				const auto c2 = Unpremultiply(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(values + i + 4)))));
+				const auto c3 = Unpremultiply(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(values + i + 6)))));
+				const auto packed = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(_mm256_packs_epi32(c0, c1), _mm256_packs_epi32(c2, c3)), order);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_or_si256(_mm256_andnot_si256(alphaMask, packed), _mm256_and_si256(alphaMask, c)));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("sse2")
+		static size_t ToVector4Sse2(uint32_t const* values, Vector4* destination, size_t count) {
+			const auto zero = _mm_setzero_si128();
+			const auto byteMax = _mm_set1_ps(255.0f);
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4) {
+				const auto c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(values + i));
+				const auto low = _mm_unpacklo_epi8(c, zero);
+				const auto high = _mm_unpackhi_epi8(c, zero);
+				_mm_storeu_ps(&destination[i].X, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), byteMax));
+				_mm_storeu_ps(&destination[i + 1].X, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), byteMax));
+				_mm_storeu_ps(&destination[i + 2].X, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), byteMax));
+				_mm_storeu_ps(&destination[i + 3].X, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), byteMax));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t ToVector4Avx2(uint32_t const* values, Vector4* destination, size_t count) {
+			const auto byteMax = _mm256_set1_ps(255.0f);
+			size_t i = 0;
+
+			for (; i + 2 <= count; i += 2) {
+				const auto c = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(values + i)));
+				_mm256_storeu_ps(&destination[i].X, _mm256_div_ps(_mm256_cvtepi32_ps(c), byteMax));
+			}
+
+			return i;
+		}
+
+		//PackUNorm(255, value): NaN packs to 0, the rest is clamped to [0, 255] and rounded half away from zero.
+		//max(value, 0) returns 0 for NaN.
+		CSHARP_TARGET("sse2")
+		static __m128i Pack(__m128 vector) {
+			const auto value = _mm_min_ps(_mm_max_ps(_mm_mul_ps(vector, _mm_set1_ps(255.0f)), _mm_setzero_ps()), _mm_set1_ps(255.0f));
+			const auto truncated = _mm_cvttps_epi32(value);
+			const auto round = _mm_cmpge_ps(_mm_sub_ps(value, _mm_cvtepi32_ps(truncated)), _mm_set1_ps(0.5f));
+			return _mm_sub_epi32(truncated, _mm_castps_si128(round));
+		}
+
+		CSHARP_TARGET("avx2")
+		static __m256i Pack(__m256 vector) {
+			const auto value = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(vector, _mm256_set1_ps(255.0f)), _mm256_setzero_ps()), _mm256_set1_ps(255.0f));
+			const auto truncated = _mm256_cvttps_epi32(value);
+			const auto round = _mm256_cmp_ps(_mm256_sub_ps(value, _mm256_cvtepi32_ps(truncated)), _mm256_set1_ps(0.5f), _CMP_GE_OQ);
+			return _mm256_sub_epi32(truncated, _mm256_castps_si256(round));
+		}
+
+		CSHARP_TARGET("sse2")
+		static size_t FromVector4Sse2(Vector4 const* vectors, uint32_t* destination, size_t count) {
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4) {
+				const auto c0 = Pack(_mm_loadu_ps(&vectors[i].X));
+				const auto c1 = Pack(_mm_loadu_ps(&vectors[i + 1].X));
+				const auto c2 = Pack(_mm_loadu_ps(&vectors[i + 2].X));
+				const auto c3 = Pack(_mm_loadu_ps(&vectors[i + 3].X));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3)));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t FromVector4Avx2(Vector4 const* vectors, uint32_t* destination, size_t count) {
+			const auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				const auto c0 = Pack(_mm256_loadu_ps(&vectors[i].X));
+				const auto c1 = Pack(_mm256_loadu_ps(&vectors[i + 2].X));
+				const auto c2 = Pack(_mm256_loadu_ps(&vectors[i + 4].X));
+				const auto c3 = Pack(_mm256_loadu_ps(&vectors[i + 6].X));
+				const auto packed = _mm256_packus_epi16(_mm256_packs_epi32(c0, c1), _mm256_packs_epi32(c2, c3));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_permutevar8x32_epi32(packed, order));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("sse2")
+		static size_t SwapRedBlueSse2(uint32_t const* values, uint32_t* destination, size_t count) {
+			const auto keep = _mm_set1_epi32(static_cast<int>(0xFF00FF00U));
+			const auto red = _mm_set1_epi32(0xFF);
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4) {
+				const auto c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(values + i));
+				const auto swapped = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(c, 16), red), _mm_slli_epi32(_mm_and_si128(c, red), 16));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_or_si128(_mm_and_si128(c, keep), swapped));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx2")
+		static size_t SwapRedBlueAvx2(uint32_t const* values, uint32_t* destination, size_t count) {
+			const auto shuffle = _mm256_setr_epi8(
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				const auto c = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values + i));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_shuffle_epi8(c, shuffle));
+			}
+
+			return i;
+		}
+#endif
+	};
+
+	bool Color::Lerp(std::span<const uint32_t> values1, std::span<const uint32_t> values2, float amount, std::span<uint32_t> destination) {
+		const auto count = values1.size();
+
+		if (values2.size() != count || destination.size() < count)
+			return false;
+
+		const auto bitmask = PackUtils::PackUNorm(65536.0f, amount);
+
+		//An amount of 1 or more selects value2 and does not fit the 16-bit kernels.
+		if (bitmask > 0xFFFF) {
+			if (count != 0 && destination.data() != values2.data())
+				std::memmove(destination.data(), values2.data(), count * sizeof(uint32_t));
+
+			return true;
+		}
+
+		size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+		if (ColorKernels::UseAvx2)
+			i = ColorKernels::LerpAvx2(values1.data(), values2.data(), bitmask, destination.data(), count);
+
+		i += ColorKernels::LerpSse2(values1.data() + i, values2.data() + i, bitmask, destination.data() + i, count - i);
+#endif
+		for (; i < count; ++i)
+			destination[i] = Lerp(Color(values1[i]), Color(values2[i]), amount).PackedValue();
+
+		return true;
+	}
+
+	bool Color::Multiply(std::span<const uint32_t> values, float scale, std::span<uint32_t> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		//Same fixed point factor as the single color Multiply.
+		const auto factor = scale * 65536.0f;
+		const uint32_t fixedScale = factor >= 0.0F ? (factor <= 16777215.0F ? static_cast<uint32_t>(factor) : 16777215U) : 0U;
+		size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+		if (ColorKernels::UseAvx2)
+			i = ColorKernels::MultiplyAvx2(values.data(), fixedScale, destination.data(), count);
+
+		i += ColorKernels::MultiplySse2(values.data() + i, fixedScale, destination.data() + i, count - i);
+#endif
+		for (; i < count; ++i)
+			destination[i] = Multiply(Color(values[i]), scale).PackedValue();
+
+		return true;
+	}
+
+	bool Color::FromNonPremultiplied(std::span<const uint32_t> values, std::span<uint32_t> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+		if (ColorKernels::UseAvx2)
+			i = ColorKernels::FromNonPremultipliedAvx2(values.data(), destination.data(), count);
+
+		i += ColorKernels::FromNonPremultipliedSse2(values.data() + i, destination.data() + i, count - i);
+#endif
+		for (; i < count; ++i)
+			destination[i] = ColorKernels::FromNonPremultiplied(values[i]);
+
+		return true;
+	}
+
+	bool Color::ToNonPremultiplied(std::span<const uint32_t> values, std::span<uint32_t> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+		if (ColorKernels::UseAvx2)
+			i = ColorKernels::ToNonPremultipliedAvx2(values.data(), destination.data(), count);
+
+		i += ColorKernels::ToNonPremultipliedSse2(values.data() + i, destination.data() + i, count - i);
+#endif
+		for (; i < count; ++i)
+			destination[i] = ColorKernels::ToNonPremultiplied(values[i]);
+
+		return true;
+	}
+
+	bool Color::ToVector4(std::span<const uint32_t> values, std::span<Vector4> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+		if (ColorKernels::UseAvx2)
+			i = ColorKernels::ToVector4Avx2(values.data(), destination.data(), count);
+
+		i += ColorKernels::ToVector4Sse2(values.data() + i, destination.data() + i, count - i);
+#endif
+		for (; i < count; ++i)
+			destination[i] = Color(values[i]).ToVector4();
+
+		return true;
+	}
+
+	bool Color::FromVector4(std::span<const Vector4> vectors, std::span<uint32_t> destination) {
+		const auto count = vectors.size();
+
+		if (destination.size() < count)
+			return false;
+
+		size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+		if (ColorKernels::UseAvx2)
+			i = ColorKernels::FromVector4Avx2(vectors.data(), destination.data(), count);
+
+		i += ColorKernels::FromVector4Sse2(vectors.data() + i, destination.data() + i, count - i);
+#endif
+		for (; i < count; ++i)
+			destination[i] = PackHelper(vectors[i].X, vectors[i].Y, vectors[i].Z, vectors[i].W);
+
+		return true;
+	}
+
+	bool Color::SwapRedBlue(std::span<const uint32_t> values, std::span<uint32_t> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+		if (ColorKernels::UseAvx2)
+			i = ColorKernels::SwapRedBlueAvx2(values.data(), destination.data(), count);
+
+		i += ColorKernels::SwapRedBlueSse2(values.data() + i, destination.data() + i, count - i);
+#endif
+		for (; i < count; ++i)
+			destination[i] = ColorKernels::SwapRedBlue(values[i]);
+
+		return true;
+	}
+}
@@ -0,0 +1,262 @@
+#include "xna/common/dynamicaabbtree.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace xna {
+	void DynamicAabbTree::Clear() {
+		nodes.clear();
+		root = NullProxy;
+		freeList = NullProxy;
+		proxyCount = 0;
+	}
+
+	size_t DynamicAabbTree::Add(BoundingBox const& box, size_t userData) {
+		const auto leaf = AllocateNode();
+		auto& node = nodes[leaf];
+		node.Box = BoundingBox(box.Min - Vector3(margin), box.Max + Vector3(margin));
+		node.UserData = userData;
+		node.Height = 0;
+
+		InsertLeaf(leaf);
+		++proxyCount;
+		return leaf;
+	}
+
+	void DynamicAabbTree::Remove(size_t proxy) {
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		--proxyCount;
+	}
+
+	bool DynamicAabbTree::Move(size_t proxy, BoundingBox const& box, Vector3 const& displacement) {
+		auto fatBox = BoundingBox(box.Min - Vector3(margin), box.Max + Vector3(margin));
+		const auto stretch = displacement * DisplacementMultiplier;
+
+		if (stretch.X < 0.0f) fatBox.Min.X += stretch.X; else fatBox.Max.X += stretch.X;
+		if (stretch.Y < 0.0f) fatBox.Min.Y += stretch.Y; else fatBox.Max.Y += stretch.Y;
+		if (stretch.Z < 0.0f) fatBox.Min.Z += stretch.Z; else fatBox.Max.Z += stretch.Z;
+
+		const auto& treeBox = nodes[proxy].Box;
+
+		if (treeBox.Contains(box) == ContainmentType::Contains) {
+			//Kept unless it is much larger than needed, as after a fast object stops.
+			const auto limit = Vector3(4.0f * margin);
+			const auto largestBox = BoundingBox(fatBox.Min - limit, fatBox.Max + limit);
+
+			if (largestBox.Contains(treeBox) == ContainmentType::Contains)
+				return false;
+		}
+
+		RemoveLeaf(proxy);
+		nodes[proxy].Box = fatBox;
+		InsertLeaf(proxy);
+		return true;
+	}
+
+	size_t DynamicAabbTree::AllocateNode() {
+		if (freeList == NullProxy) {
+			nodes.emplace_back();
+			return nodes.size() - 1;
+		}
+
+		const auto index = freeList;
+		freeList = nodes[index].Parent;
+		nodes[index] = Node();
+		return index;
+	}
+
+	void DynamicAabbTree::FreeNode(size_t index) {
+		auto& node = nodes[index];
+		node.Parent = freeList;
+		node.Child1 = NullProxy;
+		node.Child2 = NullProxy;
+		node.Height = -1;
+		freeList = index;
+	}
+
+	void DynamicAabbTree::InsertLeaf(size_t leaf) {
+		if (root == NullProxy) {
+			root = leaf;
+			nodes[leaf].Parent = NullProxy;
+			return;
+		}
+
+		const auto sibling = FindBestSibling(nodes[leaf].Box);
+		const auto oldParent = nodes[sibling].Parent;
+		const auto newParent = AllocateNode();
+
+		auto& parent = nodes[newParent];
+		parent.Parent = oldParent;
+		parent.Box = BoundingBox::CreateMerged(nodes[sibling].Box, nodes[leaf].Box);
+		parent.Height = nodes[sibling].Height + 1;
+		parent.Child1 = sibling;
+		parent.Child2 = leaf;
+
+		if (oldParent == NullProxy)
+			root = newParent;
+		else if (nodes[oldParent].Child1 == sibling)
+			nodes[oldParent].Child1 = newParent;
+		else
+			nodes[oldParent].Child2 = newParent;
+
+		nodes[sibling].Parent = newParent;
+		nodes[leaf].Parent = newParent;
+
+		Refit(oldParent);
+	}
+
+	void DynamicAabbTree::RemoveLeaf(size_t leaf) {
+		if (leaf == root) {
+			root = NullProxy;
+			return;
+		}
+
+		const auto parent = nodes[leaf].Parent;
+		const auto grandParent = nodes[parent].Parent;
+		const auto sibling = nodes[parent].Child1 == leaf ? nodes[parent].Child2 : nodes[parent].Child1;
+
+		if (grandParent == NullProxy)
+			root = sibling;
+		else if (nodes[grandParent].Child1 == parent)
+			nodes[grandParent].Child1 = sibling;
+		else
+			nodes[grandParent].Child2 = sibling;
+
+		nodes[sibling].Parent = grandParent;
+		FreeNode(parent);
+		Refit(grandParent);
+	}
+
+	size_t DynamicAabbTree::FindBestSibling(BoundingBox const& box) const {
+		//The cost of making a node the sibling is the area of the new parent plus the growth of the ancestors, which the children inherit.
+		//Descends into the child with the lower bound on the cost of its subtree, until neither bound beats the best cost found.
+		const auto boxArea = Area(box);
+		auto index = root;
+		auto nodeArea = Area(nodes[index].Box);
+		auto directCost = Area(BoundingBox::CreateMerged(nodes[index].Box, box));
+		auto inheritedCost = 0.0f;
+		auto best = index;
+		auto bestCost = directCost;
+
+		while (!nodes[index].IsLeaf()) {
+			const auto& node = nodes[index];
+			const auto cost = directCost + inheritedCost;
+
+			if (cost < bestCost) {
+				bestCost = cost;
+				best = index;
+			}
+
+			inheritedCost += directCost - nodeArea;
+
+			auto bound = [&](size_t child, float& childArea, float& childCost) {
+				const auto& childNode = nodes[child];
+				childArea = Area(childNode.Box);
+				childCost = Area(BoundingBox::CreateMerged(childNode.Box, box));
+
+				if (!childNode.IsLeaf())
+					return inheritedCost + childCost + (std::min)(boxArea - childArea, 0.0f);
+
+				if (childCost + inheritedCost < bestCost) {
+					bestCost = childCost + inheritedCost;
+					best = child;
+				}
+
+				return (std::numeric_limits<float>::max)();
+				};
+
+			float area1, cost1, area2, cost2;
+			const auto bound1 = bound(node.Child1, area1, cost1);
+			const auto bound2 = bound(node.Child2, area2, cost2);
+
+			if (bestCost <= bound1 && bestCost <= bound2)
+				break;
+
+			if (bound1 <= bound2) {
+				index = node.Child1;
+				nodeArea = area1;
+				directCost = cost1;
+			}
+			else {
+				index = node.Child2;
+				nodeArea = area2;
+				directCost = cost2;
+			}
+		}
+
+		return best;
+	}
+
+	void DynamicAabbTree::Refit(size_t index) {
+		while (index != NullProxy) {
+			auto& node = nodes[index];
+			node.Box = BoundingBox::CreateMerged(nodes[node.Child1].Box, nodes[node.Child2].Box);
+			node.Height = 1 + (std::max)(nodes[node.Child1].Height, nodes[node.Child2].Height);
+
+			Rotate(index);
+			index = node.Parent;
+		}
+	}
+
+	void DynamicAabbTree::Rotate(size_t index) {
+		auto& node = nodes[index];
+
+		if (node.Height < 2)
+			return;
+
+		//Swapping a child of the node with a grandchild under the other child changes only that other child,
+		//so the best swap is the one that shrinks it the most.
+		auto bestChild = NullProxy;
+		auto bestGrandChild = NullProxy;
+		auto bestGain = 0.0f;
+
+		auto consider = [&](size_t child, size_t other) {
+			const auto& otherNode = nodes[other];
+
+			if (otherNode.IsLeaf())
+				return;
+
+			const auto otherArea = Area(otherNode.Box);
+			const auto gain1 = otherArea - Area(BoundingBox::CreateMerged(nodes[child].Box, nodes[otherNode.Child2].Box));
+			const auto gain2 = otherArea - Area(BoundingBox::CreateMerged(nodes[child].Box, nodes[otherNode.Child1].Box));
+
+			if (gain1 > bestGain) {
+				bestGain = gain1;
+				bestChild = child;
+				bestGrandChild = otherNode.Child1;
+			}
+
+			if (gain2 > bestGain) {
+				bestGain = gain2;
+				bestChild = child;
+				bestGrandChild = otherNode.Child2;
+			}
+			};
+
+		consider(node.Child1, node.Child2);
+		consider(node.Child2, node.Child1);
+
+		if (bestChild == NullProxy)
+			return;
+
+		const auto other = node.Child1 == bestChild ? node.Child2 : node.Child1;
+		auto& otherNode = nodes[other];
+
+		if (node.Child1 == bestChild)
+			node.Child1 = bestGrandChild;
+		else
+			node.Child2 = bestGrandChild;
+
+		if (otherNode.Child1 == bestGrandChild)
+			otherNode.Child1 = bestChild;
+		else
+			otherNode.Child2 = bestChild;
+
+		nodes[bestGrandChild].Parent = index;
+		nodes[bestChild].Parent = other;
+
+		otherNode.Box = BoundingBox::CreateMerged(nodes[otherNode.Child1].Box, nodes[otherNode.Child2].Box);
+		otherNode.Height = 1 + (std::max)(nodes[otherNode.Child1].Height, nodes[otherNode.Child2].Height);
+		node.Height = 1 + (std::max)(nodes[node.Child1].Height, nodes[node.Child2].Height);
+	}
+}
@@ -1,4 +1,5 @@
 #include "xna/common/collision.hpp"
+#include <utility>
 
 namespace xna {
 	Vector3 Gjk::ComputeClosestPoint() {
@@ -101,4 +102,269 @@ namespace xna {
         UpdateDeterminant(index1);
         return UpdateSimplex(index1);
     }
-}
\ No newline at end of file
+
+	bool Gjk::AddSupportPoint(SupportVertex const& vertex) {
+		//Same slot as the one AddSupportPoint(Vector3) picks.
+		vertices[(Gjk::BitsToIndices[simplexBits ^ 15] & 7) - 1] = vertex;
+		return AddSupportPoint(vertex.Point);
+	}
+
+	void Gjk::ClosestPoints(Vector3& pointA, Vector3& pointB) const {
+		auto sum = 0.0f;
+		pointA = Vector3::Zero();
+		pointB = Vector3::Zero();
+
+		for (auto bitsToIndex = Gjk::BitsToIndices[simplexBits]; bitsToIndex != 0; bitsToIndex >>= 3)
+		{
+			auto index = (bitsToIndex & 7) - 1;
+			auto weight = det[simplexBits][index];
+			sum += weight;
+			pointA += vertices[index].PointA * weight;
+			pointB += vertices[index].PointB * weight;
+		}
+
+		if (sum != 0.0f) {
+			pointA = pointA / sum;
+			pointB = pointB / sum;
+		}
+	}
+
+	int32_t Gjk::Vertices(SupportVertex* result) const {
+		int32_t count = 0;
+
+		for (auto bitsToIndex = Gjk::BitsToIndices[simplexBits]; bitsToIndex != 0; bitsToIndex >>= 3)
+			result[count++] = vertices[(bitsToIndex & 7) - 1];
+
+		return count;
+	}
+
+	void Gjk::Save(GjkCache& cache) const {
+		cache.Count = 0;
+
+		for (auto bitsToIndex = Gjk::BitsToIndices[simplexBits]; bitsToIndex != 0; bitsToIndex >>= 3)
+			cache.Directions[cache.Count++] = vertices[(bitsToIndex & 7) - 1].Direction;
+	}
+
+	bool Gjk::ContainsVertex(Vector3 const& point) const {
+		for (auto bitsToIndex = Gjk::BitsToIndices[simplexBits]; bitsToIndex != 0; bitsToIndex >>= 3)
+		{
+			auto index = (bitsToIndex & 7) - 1;
+
+			if (Vector3::DistanceSquared(y[index], point) <= DuplicateTolerance * yLengthSq[index])
+				return true;
+		}
+
+		return false;
+	}
+
+	bool Epa::Initialize(SupportVertex const* tetrahedron) {
+		center = Vector3::Zero();
+		size = 0.0f;
+
+		for (int32_t i = 0; i < 4; ++i) {
+			vertices[i] = tetrahedron[i];
+			center += tetrahedron[i].Point * 0.25f;
+			size = MathHelper::Max(size, tetrahedron[i].Point.Length());
+		}
+
+		vertexCount = 4;
+		faceCount = 4;
+
+		if (!MakeFace(0, 1, 2, faces[0]) || !MakeFace(0, 3, 1, faces[1]) || !MakeFace(0, 2, 3, faces[2]) || !MakeFace(1, 3, 2, faces[3]))
+			return false;
+
+		FindClosest();
+		return true;
+	}
+
+	bool Epa::MakeFace(int32_t a, int32_t b, int32_t c, Face& face) const {
+		const auto& pointA = vertices[a].Point;
+		auto normal = Vector3::Cross(vertices[b].Point - pointA, vertices[c].Point - pointA);
+		const auto length = normal.Length();
+
+		if (length <= 1E-08f * size * size)
+			return false;
+
+		//The center is inside the polytope, so the outward normal points away from it.
+		if (Vector3::Dot(normal, pointA - center) < 0.0f) {
+			normal = -normal;
+			std::swap(b, c);
+		}
+
+		face.Vertices[0] = a;
+		face.Vertices[1] = b;
+		face.Vertices[2] = c;
+		face.Normal = normal / length;
+		face.Distance = Vector3::Dot(face.Normal, pointA);
+		return true;
+	}
+
+	void Epa::FindClosest() {
+		closest = 0;
+
+		for (int32_t i = 1; i < faceCount; ++i) {
+			if (faces[i].Distance < faces[closest].Distance)
+				closest = i;
+		}
+	}
+
+	bool Epa::IsVisible(Face const& face, Vector3 const& point) const {
+		return Vector3::Dot(face.Normal, point - vertices[face.Vertices[0]].Point) > 0.0f;
+	}
+
+	int32_t Epa::FindHorizon(bool const* visible) {
+		int32_t horizonCount = 0;
+
+		//The edges of the visible faces that are not shared by two of them form the horizon.
+		for (int32_t i = 0; i < faceCount; ++i) {
+			if (!visible[i])
+				continue;
+
+			const auto& face = faces[i];
+
+			for (int32_t k = 0; k < 3; ++k) {
+				const auto from = face.Vertices[k];
+				const auto to = face.Vertices[(k + 1) % 3];
+				auto shared = false;
+
+				for (int32_t j = 0; j < horizonCount; ++j) {
+					if (horizon[j][0] == to && horizon[j][1] == from) {
+						horizon[j][0] = horizon[horizonCount - 1][0];
+						horizon[j][1] = horizon[horizonCount - 1][1];
+						--horizonCount;
+						shared = true;
+						break;
+					}
+				}
+
+				if (!shared) {
+					horizon[horizonCount][0] = from;
+					horizon[horizonCount][1] = to;
+					++horizonCount;
+				}
+			}
+		}
+
+		return horizonCount;
+	}
+
+	int32_t Epa::FindFace(int32_t from, int32_t to) const {
+		for (int32_t i = 0; i < faceCount; ++i) {
+			const auto& face = faces[i];
+
+			for (int32_t k = 0; k < 3; ++k) {
+				if (face.Vertices[k] == from && face.Vertices[(k + 1) % 3] == to)
+					return i;
+			}
+		}
+
+		return -1;
+	}
+
+	bool Epa::Expand(SupportVertex const& vertex) {
+		if (vertexCount == MaxVertices)
+			return false;
+
+		//The visible faces are found from the closest face across the edges, so they are connected and have one horizon around them
+		//even where faces on one plane disagree about the side of the vertex.
+		bool visible[MaxFaces]{};
+		int32_t stack[MaxFaces];
+		int32_t stackCount = 0;
+		int32_t visibleCount = 0;
+
+		if (!IsVisible(faces[closest], vertex.Point))
+			return false;
+
+		visible[closest] = true;
+		stack[stackCount++] = closest;
+		++visibleCount;
+
+		while (stackCount > 0) {
+			const auto& face = faces[stack[--stackCount]];
+
+			for (int32_t k = 0; k < 3; ++k) {
+				const auto next = FindFace(face.Vertices[(k + 1) % 3], face.Vertices[k]);
+
+				if (next >= 0 && !visible[next] && IsVisible(faces[next], vertex.Point)) {
+					visible[next] = true;
+					stack[stackCount++] = next;
+					++visibleCount;
+				}
+			}
+		}
+
+		//Every new face is checked before the polytope changes.
+		const auto index = vertexCount;
+		vertices[index] = vertex;
+		Face face;
+		int32_t horizonCount;
+
+		//A new face is flat when the vertex is on the line of its horizon edge. The face beyond that edge then has the vertex
+		//on its plane, so it is replaced along with the visible faces and the horizon is found again.
+		for (;;) {
+			horizonCount = FindHorizon(visible);
+			auto flat = -1;
+
+			for (int32_t j = 0; j < horizonCount && flat < 0; ++j) {
+				if (!MakeFace(horizon[j][0], horizon[j][1], index, face))
+					flat = j;
+			}
+
+			if (flat < 0)
+				break;
+
+			const auto beyond = FindFace(horizon[flat][1], horizon[flat][0]);
+
+			if (beyond < 0 || visible[beyond])
+				return false;
+
+			visible[beyond] = true;
+			++visibleCount;
+		}
+
+		if (horizonCount == 0 || faceCount - visibleCount + horizonCount > MaxFaces)
+			return false;
+
+		auto count = 0;
+
+		for (int32_t i = 0; i < faceCount; ++i) {
+			if (!visible[i])
+				faces[count++] = faces[i];
+		}
+
+		for (int32_t j = 0; j < horizonCount; ++j)
+			MakeFace(horizon[j][0], horizon[j][1], index, faces[count++]);
+
+		faceCount = count;
+		++vertexCount;
+		FindClosest();
+		return true;
+	}
+
+	void Epa::GetResult(GjkResult& result) const {
+		const auto& face = faces[closest];
+		const auto& a = vertices[face.Vertices[0]];
+		const auto& b = vertices[face.Vertices[1]];
+		const auto& c = vertices[face.Vertices[2]];
+
+		//Barycentric coordinates of the projection of the origin on the face give the points of both shapes.
+		const auto point = face.Normal * face.Distance;
+		const auto edge0 = b.Point - a.Point;
+		const auto edge1 = c.Point - a.Point;
+		const auto offset = point - a.Point;
+		const auto d00 = Vector3::Dot(edge0, edge0);
+		const auto d01 = Vector3::Dot(edge0, edge1);
+		const auto d11 = Vector3::Dot(edge1, edge1);
+		const auto d20 = Vector3::Dot(offset, edge0);
+		const auto d21 = Vector3::Dot(offset, edge1);
+		const auto denominator = d00 * d11 - d01 * d01;
+		const auto v = (d11 * d20 - d01 * d21) / denominator;
+		const auto w = (d00 * d21 - d01 * d20) / denominator;
+		const auto u = 1.0f - v - w;
+
+		result.Depth = MathHelper::Max(face.Distance, 0.0f);
+		result.Normal = face.Normal;
+		result.PointA = a.PointA * u + b.PointA * v + c.PointA * w;
+		result.PointB = a.PointB * u + b.PointB * v + c.PointB * w;
+	}
+}
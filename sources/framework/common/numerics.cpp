@@ -1,17 +1,459 @@
 #include "xna/common/numerics.hpp"
+#include "xna/common/fastmath.hpp"
+#include "csharp/runtime/intrinsics.hpp"
+#include <array>
+#include <cstdint>
 
 namespace xna {
+    static_assert(sizeof(Vector2) == 2 * sizeof(float) && sizeof(Vector3) == 3 * sizeof(float) && sizeof(Vector4) == 4 * sizeof(float),
+        "The batch transforms read vector arrays as packed floats.");
+
+    //Coefficients of a batch transform. Output component j of a vector is
+    //in[0] * Rows[0][j] + in[1] * Rows[1][j] + ... (+ Rows[3][j] when translating),
+    //evaluated left to right like the single vector overloads, so every kernel returns the same bits.
+    struct TransformRows {
+        float Rows[4][4]{};
+
+        static TransformRows FromMatrix(Matrix const& matrix) {
+            TransformRows m;
+            m.Rows[0][0] = matrix.M11; m.Rows[0][1] = matrix.M12; m.Rows[0][2] = matrix.M13; m.Rows[0][3] = matrix.M14;
+            m.Rows[1][0] = matrix.M21; m.Rows[1][1] = matrix.M22; m.Rows[1][2] = matrix.M23; m.Rows[1][3] = matrix.M24;
+            m.Rows[2][0] = matrix.M31; m.Rows[2][1] = matrix.M32; m.Rows[2][2] = matrix.M33; m.Rows[2][3] = matrix.M34;
+            m.Rows[3][0] = matrix.M41; m.Rows[3][1] = matrix.M42; m.Rows[3][2] = matrix.M43; m.Rows[3][3] = matrix.M44;
+            return m;
+        }
+
+        static TransformRows FromQuaternion(Quaternion const& rotation) {
+            const auto num1 = rotation.X + rotation.X;
+            const auto num2 = rotation.Y + rotation.Y;
+            const auto num3 = rotation.Z + rotation.Z;
+            const auto num4 = rotation.W * num1;
+            const auto num5 = rotation.W * num2;
+            const auto num6 = rotation.W * num3;
+            const auto num7 = rotation.X * num1;
+            const auto num8 = rotation.X * num2;
+            const auto num9 = rotation.X * num3;
+            const auto num10 = rotation.Y * num2;
+            const auto num11 = rotation.Y * num3;
+            const auto num12 = rotation.Z * num3;
+
+            TransformRows m;
+            m.Rows[0][0] = 1.0f - num10 - num12;
+            m.Rows[1][0] = num8 - num6;
+            m.Rows[2][0] = num9 + num5;
+            m.Rows[0][1] = num8 + num6;
+            m.Rows[1][1] = 1.0f - num7 - num12;
+            m.Rows[2][1] = num11 - num4;
+            m.Rows[0][2] = num9 - num5;
+            m.Rows[1][2] = num11 + num4;
+            m.Rows[2][2] = 1.0f - num7 - num10;
+            return m;
+        }
+    };
+
+    //Batch transform kernels over packed arrays of vectors with Components floats each.
+    //The first Terms components are transformed and the others are copied, like the W of a Vector4 rotated by a quaternion.
+    //The vector kernels transpose a block of vectors to one register per component, transform it and transpose it back.
+    //Mul and add are never fused, so the results match the scalar code bit for bit.
+    struct TransformKernels {
+        template <size_t Components, size_t Terms, bool Translate>
+        static void Run(float const* source, float* destination, size_t count, TransformRows const& m) {
+            size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+            if (UseAvx512)
+                i = Avx512<Components, Terms, Translate>(source, destination, count, m);
+            else if (UseAvx2)
+                i = Avx2<Components, Terms, Translate>(source, destination, count, m);
+
+            if constexpr (Components == 3)
+                i += Sse2Vector3<Translate>(source + i * Components, destination + i * Components, count - i, m);
+            else
+                i += Sse2<Components, Terms, Translate>(source + i * Components, destination + i * Components, count - i, m);
+#endif
+            Scalar<Components, Terms, Translate>(source + i * Components, destination + i * Components, count - i, m);
+        }
+
+        template <size_t Components, size_t Terms, bool Translate>
+        static void Scalar(float const* source, float* destination, size_t count, TransformRows const& m) {
+            for (size_t i = 0; i < count; ++i, source += Components, destination += Components) {
+                float in[Components];
+
+                for (size_t k = 0; k < Components; ++k)
+                    in[k] = source[k];
+
+                for (size_t j = 0; j < Terms; ++j) {
+                    auto value = in[0] * m.Rows[0][j];
+
+                    for (size_t k = 1; k < Terms; ++k)
+                        value = value + in[k] * m.Rows[k][j];
+
+                    if constexpr (Translate)
+                        value = value + m.Rows[3][j];
+
+                    destination[j] = value;
+                }
+
+                for (size_t j = Terms; j < Components; ++j)
+                    destination[j] = in[j];
+            }
+        }
+
+#if defined(CSHARP_INTRINSICS_X86)
+        inline static const bool UseAvx2 = csharp::X86Intrinsics::IsAvx2Supported();
+        inline static const bool UseAvx512 = csharp::X86Intrinsics::IsAvx512Supported();
+
+        //Splits x0y0z0x1 y1z1x2y2 z2x3y3z3 into xxxx yyyy zzzz, in every 128-bit lane.
+        CSHARP_TARGET("avx2")
+        static void Deinterleave3(__m256 a, __m256 b, __m256 c, __m256& x, __m256& y, __m256& z) {
+            const auto lane0 = _mm256_permute2f128_ps(a, b, 0x30);
+            const auto lane1 = _mm256_permute2f128_ps(a, c, 0x21);
+            const auto lane2 = _mm256_permute2f128_ps(b, c, 0x30);
+            x = _mm256_shuffle_ps(lane0, _mm256_shuffle_ps(lane1, lane2, _MM_SHUFFLE(0, 1, 0, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+            y = _mm256_shuffle_ps(_mm256_shuffle_ps(lane0, lane1, _MM_SHUFFLE(0, 0, 0, 1)), _mm256_shuffle_ps(lane1, lane2, _MM_SHUFFLE(0, 2, 0, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+            z = _mm256_shuffle_ps(_mm256_shuffle_ps(lane0, lane1, _MM_SHUFFLE(0, 1, 0, 2)), _mm256_shuffle_ps(lane2, lane2, _MM_SHUFFLE(0, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+        }
+
+        //Inverse of Deinterleave3.
+        CSHARP_TARGET("avx2")
+        static void Interleave3(__m256 x, __m256 y, __m256 z, __m256& a, __m256& b, __m256& c) {
+            const auto lane0 = _mm256_shuffle_ps(_mm256_unpacklo_ps(x, y), _mm256_shuffle_ps(z, x, _MM_SHUFFLE(0, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+            const auto lane1 = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, _MM_SHUFFLE(0, 1, 0, 1)), _mm256_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+            const auto lane2 = _mm256_shuffle_ps(_mm256_shuffle_ps(z, x, _MM_SHUFFLE(0, 3, 0, 2)), _mm256_shuffle_ps(y, z, _MM_SHUFFLE(0, 3, 0, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+            a = _mm256_permute2f128_ps(lane0, lane1, 0x20);
+            b = _mm256_permute2f128_ps(lane2, lane0, 0x30);
+            c = _mm256_permute2f128_ps(lane1, lane2, 0x31);
+        }
+
+        //Transposes the 4x4 blocks held in every 128-bit lane of r0..r3.
+        CSHARP_TARGET("avx2")
+        static void Transpose4(__m256& r0, __m256& r1, __m256& r2, __m256& r3) {
+            const auto t0 = _mm256_unpacklo_ps(r0, r1);
+            const auto t1 = _mm256_unpackhi_ps(r0, r1);
+            const auto t2 = _mm256_unpacklo_ps(r2, r3);
+            const auto t3 = _mm256_unpackhi_ps(r2, r3);
+            r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        }
+
+        CSHARP_TARGET("avx512f")
+        static void Transpose4(__m512& r0, __m512& r1, __m512& r2, __m512& r3) {
+            const auto t0 = _mm512_unpacklo_ps(r0, r1);
+            const auto t1 = _mm512_unpackhi_ps(r0, r1);
+            const auto t2 = _mm512_unpacklo_ps(r2, r3);
+            const auto t3 = _mm512_unpackhi_ps(r2, r3);
+            r0 = _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            r1 = _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            r2 = _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            r3 = _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        }
+
+        //Permutation indices that move 16 vectors of Components floats (Components registers) to one register per
+        //component and back. A value is taken from the concatenation of two registers, so moving data across three
+        //registers needs a second step that merges the third one.
+        template <size_t Components>
+        struct Avx512Indices {
+            std::array<std::array<int32_t, 16>, 4> Gather1{};
+            std::array<std::array<int32_t, 16>, 4> Gather2{};
+            std::array<std::array<int32_t, 16>, 4> Scatter1{};
+            std::array<std::array<int32_t, 16>, 4> Scatter2{};
+
+            constexpr Avx512Indices() {
+                for (int32_t k = 0; k < static_cast<int32_t>(Components); ++k) {
+                    for (int32_t i = 0; i < 16; ++i) {
+                        const auto index = static_cast<int32_t>(Components) * i + k;
+                        Gather1[k][i] = index < 32 ? index : 0;
+                        Gather2[k][i] = index < 32 ? i : 16 + index - 32;
+                    }
+                }
+
+                for (int32_t q = 0; q < static_cast<int32_t>(Components); ++q) {
+                    for (int32_t l = 0; l < 16; ++l) {
+                        const auto index = 16 * q + l;
+                        const auto vector = index / static_cast<int32_t>(Components);
+                        const auto component = index % static_cast<int32_t>(Components);
+                        Scatter1[q][l] = component < 2 ? component * 16 + vector : 0;
+                        Scatter2[q][l] = component < 2 ? l : 16 + vector;
+                    }
+                }
+            }
+        };
+
+        template <size_t Components, size_t Terms, bool Translate>
+        CSHARP_TARGET("sse2")
+        static size_t Sse2(float const* source, float* destination, size_t count, TransformRows const& m) {
+            __m128 rows[4][4];
+
+            for (size_t k = 0; k < 4; ++k)
+                for (size_t j = 0; j < 4; ++j)
+                    rows[k][j] = _mm_set1_ps(m.Rows[k][j]);
+
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4, source += 4 * Components, destination += 4 * Components) {
+                __m128 lanes[4];
+
+                if constexpr (Components == 2) {
+                    const auto a = _mm_loadu_ps(source);
+                    const auto b = _mm_loadu_ps(source + 4);
+                    lanes[0] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                    lanes[1] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                }
+                else {
+                    lanes[0] = _mm_loadu_ps(source);
+                    lanes[1] = _mm_loadu_ps(source + 4);
+                    lanes[2] = _mm_loadu_ps(source + 8);
+                    lanes[3] = _mm_loadu_ps(source + 12);
+                    _MM_TRANSPOSE4_PS(lanes[0], lanes[1], lanes[2], lanes[3]);
+                }
+
+                __m128 out[4];
+
+                for (size_t j = 0; j < Terms; ++j) {
+                    auto value = _mm_mul_ps(lanes[0], rows[0][j]);
+
+                    for (size_t k = 1; k < Terms; ++k)
+                        value = _mm_add_ps(value, _mm_mul_ps(lanes[k], rows[k][j]));
+
+                    if constexpr (Translate)
+                        value = _mm_add_ps(value, rows[3][j]);
+
+                    out[j] = value;
+                }
+
+                for (size_t j = Terms; j < Components; ++j)
+                    out[j] = lanes[j];
+
+                if constexpr (Components == 2) {
+                    _mm_storeu_ps(destination, _mm_unpacklo_ps(out[0], out[1]));
+                    _mm_storeu_ps(destination + 4, _mm_unpackhi_ps(out[0], out[1]));
+                }
+                else {
+                    _MM_TRANSPOSE4_PS(out[0], out[1], out[2], out[3]);
+                    _mm_storeu_ps(destination, out[0]);
+                    _mm_storeu_ps(destination + 4, out[1]);
+                    _mm_storeu_ps(destination + 8, out[2]);
+                    _mm_storeu_ps(destination + 12, out[3]);
+                }
+            }
+
+            return i;
+        }
+
+        //Vector3 is not transposed in SSE2, where splitting it into components costs more shuffles than the transform saves.
+        //Four vectors load to x0y0z0x1 y1z1x2y2 z2x3y3z3, already laid out like the results, so every register of results
+        //is the x, y and z of its lanes times the matrix columns rotated to match.
+        template <bool Translate>
+        CSHARP_TARGET("sse2")
+        static size_t Sse2Vector3(float const* source, float* destination, size_t count, TransformRows const& m) {
+            __m128 rows[4][3];
+
+            for (size_t k = 0; k < 4; ++k)
+                for (size_t r = 0; r < 3; ++r)
+                    rows[k][r] = _mm_setr_ps(m.Rows[k][r % 3], m.Rows[k][(r + 1) % 3], m.Rows[k][(r + 2) % 3], m.Rows[k][r % 3]);
+
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4, source += 12, destination += 12) {
+                const auto a = _mm_loadu_ps(source);
+                const auto b = _mm_loadu_ps(source + 4);
+                const auto c = _mm_loadu_ps(source + 8);
+
+                //y0y0y1y1, z0z0z1z1, x2x2x3x3 and y2y2y3y3.
+                const auto y01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+                const auto z01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+                const auto x23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+                const auto y23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+
+                _mm_storeu_ps(destination, Sse2Vector3Lanes<Translate>(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 0, 0)),
+                    _mm_shuffle_ps(y01, y01, _MM_SHUFFLE(2, 0, 0, 0)), _mm_shuffle_ps(z01, z01, _MM_SHUFFLE(2, 0, 0, 0)), rows, 0));
+                _mm_storeu_ps(destination + 4, Sse2Vector3Lanes<Translate>(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 2, 3, 3)),
+                    _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 0, 0)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 0, 1, 1)), rows, 1));
+                _mm_storeu_ps(destination + 8, Sse2Vector3Lanes<Translate>(_mm_shuffle_ps(x23, x23, _MM_SHUFFLE(2, 2, 2, 0)),
+                    _mm_shuffle_ps(y23, y23, _MM_SHUFFLE(2, 2, 2, 0)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 0)), rows, 2));
+            }
+
+            return i;
+        }
+
+        //Register r of the results of Sse2Vector3, from the x, y and z of its lanes.
+        template <bool Translate>
+        CSHARP_TARGET("sse2")
+        static __m128 Sse2Vector3Lanes(__m128 x, __m128 y, __m128 z, __m128 const (&rows)[4][3], size_t r) {
+            auto value = _mm_add_ps(_mm_mul_ps(x, rows[0][r]), _mm_mul_ps(y, rows[1][r]));
+            value = _mm_add_ps(value, _mm_mul_ps(z, rows[2][r]));
+
+            if constexpr (Translate)
+                value = _mm_add_ps(value, rows[3][r]);
+
+            return value;
+        }
+
+        template <size_t Components, size_t Terms, bool Translate>
+        CSHARP_TARGET("avx2")
+        static size_t Avx2(float const* source, float* destination, size_t count, TransformRows const& m) {
+            __m256 rows[4][4];
+
+            for (size_t k = 0; k < 4; ++k)
+                for (size_t j = 0; j < 4; ++j)
+                    rows[k][j] = _mm256_set1_ps(m.Rows[k][j]);
+
+            size_t i = 0;
+
+            for (; i + 8 <= count; i += 8, source += 8 * Components, destination += 8 * Components) {
+                __m256 lanes[4];
+
+                if constexpr (Components == 2) {
+                    const auto a = _mm256_loadu_ps(source);
+                    const auto b = _mm256_loadu_ps(source + 8);
+                    lanes[0] = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                    lanes[1] = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                }
+                else if constexpr (Components == 3) {
+                    Deinterleave3(_mm256_loadu_ps(source), _mm256_loadu_ps(source + 8), _mm256_loadu_ps(source + 16), lanes[0], lanes[1], lanes[2]);
+                }
+                else {
+                    lanes[0] = _mm256_loadu_ps(source);
+                    lanes[1] = _mm256_loadu_ps(source + 8);
+                    lanes[2] = _mm256_loadu_ps(source + 16);
+                    lanes[3] = _mm256_loadu_ps(source + 24);
+                    Transpose4(lanes[0], lanes[1], lanes[2], lanes[3]);
+                }
+
+                __m256 out[4];
+
+                for (size_t j = 0; j < Terms; ++j) {
+                    auto value = _mm256_mul_ps(lanes[0], rows[0][j]);
+
+                    for (size_t k = 1; k < Terms; ++k)
+                        value = _mm256_add_ps(value, _mm256_mul_ps(lanes[k], rows[k][j]));
+
+                    if constexpr (Translate)
+                        value = _mm256_add_ps(value, rows[3][j]);
+
+                    out[j] = value;
+                }
+
+                for (size_t j = Terms; j < Components; ++j)
+                    out[j] = lanes[j];
+
+                if constexpr (Components == 2) {
+                    _mm256_storeu_ps(destination, _mm256_unpacklo_ps(out[0], out[1]));
+                    _mm256_storeu_ps(destination + 8, _mm256_unpackhi_ps(out[0], out[1]));
+                }
+                else if constexpr (Components == 3) {
+                    __m256 a, b, c;
+                    Interleave3(out[0], out[1], out[2], a, b, c);
+                    _mm256_storeu_ps(destination, a);
+                    _mm256_storeu_ps(destination + 8, b);
+                    _mm256_storeu_ps(destination + 16, c);
+                }
+                else {
+                    Transpose4(out[0], out[1], out[2], out[3]);
+                    _mm256_storeu_ps(destination, out[0]);
+                    _mm256_storeu_ps(destination + 8, out[1]);
+                    _mm256_storeu_ps(destination + 16, out[2]);
+                    _mm256_storeu_ps(destination + 24, out[3]);
+                }
+            }
+
+            return i;
+        }
+
+        template <size_t Components, size_t Terms, bool Translate>
+        CSHARP_TARGET("avx512f")
+        static size_t Avx512(float const* source, float* destination, size_t count, TransformRows const& m) {
+            static constexpr Avx512Indices<Components> indices{};
+            __m512 rows[4][4];
+
+            for (size_t k = 0; k < 4; ++k)
+                for (size_t j = 0; j < 4; ++j)
+                    rows[k][j] = _mm512_set1_ps(m.Rows[k][j]);
+
+            __m512i gather1[3], gather2[3], scatter1[3], scatter2[3];
+
+            for (size_t k = 0; k < 3; ++k) {
+                gather1[k] = _mm512_loadu_si512(indices.Gather1[k].data());
+                gather2[k] = _mm512_loadu_si512(indices.Gather2[k].data());
+                scatter1[k] = _mm512_loadu_si512(indices.Scatter1[k].data());
+                scatter2[k] = _mm512_loadu_si512(indices.Scatter2[k].data());
+            }
+
+            size_t i = 0;
+
+            for (; i + 16 <= count; i += 16, source += 16 * Components, destination += 16 * Components) {
+                __m512 lanes[4];
+
+                if constexpr (Components == 2) {
+                    const auto a = _mm512_loadu_ps(source);
+                    const auto b = _mm512_loadu_ps(source + 16);
+                    lanes[0] = _mm512_permutex2var_ps(a, gather1[0], b);
+                    lanes[1] = _mm512_permutex2var_ps(a, gather1[1], b);
+                }
+                else if constexpr (Components == 3) {
+                    const auto a = _mm512_loadu_ps(source);
+                    const auto b = _mm512_loadu_ps(source + 16);
+                    const auto c = _mm512_loadu_ps(source + 32);
+
+                    for (size_t k = 0; k < 3; ++k)
+                        lanes[k] = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, gather1[k], b), gather2[k], c);
+                }
+                else {
+                    lanes[0] = _mm512_loadu_ps(source);
+                    lanes[1] = _mm512_loadu_ps(source + 16);
+                    lanes[2] = _mm512_loadu_ps(source + 32);
+                    lanes[3] = _mm512_loadu_ps(source + 48);
+                    Transpose4(lanes[0], lanes[1], lanes[2], lanes[3]);
+                }
+
+                __m512 out[4];
+
+                //The rounding form of add is opaque to the compiler, which would otherwise fuse it with the multiply
+                //because AVX-512 implies FMA.
+                for (size_t j = 0; j < Terms; ++j) {
+                    auto value = _mm512_mul_ps(lanes[0], rows[0][j]);
+
+                    for (size_t k = 1; k < Terms; ++k)
+                        value = _mm512_add_round_ps(value, _mm512_mul_ps(lanes[k], rows[k][j]), _MM_FROUND_CUR_DIRECTION);
+
+                    if constexpr (Translate)
+                        value = _mm512_add_round_ps(value, rows[3][j], _MM_FROUND_CUR_DIRECTION);
+
+                    out[j] = value;
+                }
+
+                for (size_t j = Terms; j < Components; ++j)
+                    out[j] = lanes[j];
+
+                if constexpr (Components == 2) {
+                    _mm512_storeu_ps(destination, _mm512_permutex2var_ps(out[0], scatter1[0], out[1]));
+                    _mm512_storeu_ps(destination + 16, _mm512_permutex2var_ps(out[0], scatter1[1], out[1]));
+                }
+                else if constexpr (Components == 3) {
+                    for (size_t q = 0; q < 3; ++q)
+                        _mm512_storeu_ps(destination + 16 * q, _mm512_permutex2var_ps(_mm512_permutex2var_ps(out[0], scatter1[q], out[1]), scatter2[q], out[2]));
+                }
+                else {
+                    Transpose4(out[0], out[1], out[2], out[3]);
+                    _mm512_storeu_ps(destination, out[0]);
+                    _mm512_storeu_ps(destination + 16, out[1]);
+                    _mm512_storeu_ps(destination + 32, out[2]);
+                    _mm512_storeu_ps(destination + 48, out[3]);
+                }
+            }
+
+            return i;
+        }
+#endif
+    };
+
     bool Vector2::Transform(Vector2 const* sourceArray, size_t sourceArrayLength, Matrix const& matrix, Vector2* destinationArray, size_t destinationArrayLength) {
         if (!sourceArray || !destinationArray || destinationArrayLength < sourceArrayLength)
             return false;
 
-        for (size_t index = 0; index < sourceArrayLength; ++index)
-        {
-            const auto& source = sourceArray[index];
-            destinationArray[index].X = (source.X * matrix.M11 + source.Y * matrix.M21) + matrix.M41;
-            destinationArray[index].Y = (source.X * matrix.M12 + source.Y * matrix.M22) + matrix.M42;
-        }
-
+        TransformKernels::Run<2, 2, true>(reinterpret_cast<float const*>(sourceArray), reinterpret_cast<float*>(destinationArray), sourceArrayLength, TransformRows::FromMatrix(matrix));
         return true;
     }
 
@@ -29,12 +471,7 @@ namespace xna {
             || sourceArrayLength < sourceIndex + length || destinationArrayLength < destinationIndex + length)
             return false;
 
-        for (size_t i = 0; i < length; ++i) {
-            const auto& source = sourceArray[sourceIndex + i];
-            destinationArray[destinationIndex + i].X = (source.X * matrix.M11 + source.Y * matrix.M21) + matrix.M41;
-            destinationArray[destinationIndex + i].Y = (source.X * matrix.M12 + source.Y * matrix.M22) + matrix.M42;
-        }
-
+        TransformKernels::Run<2, 2, true>(reinterpret_cast<float const*>(sourceArray + sourceIndex), reinterpret_cast<float*>(destinationArray + destinationIndex), length, TransformRows::FromMatrix(matrix));
         return true;
     }
 
@@ -50,12 +487,7 @@ namespace xna {
         if (!sourceArray || !destinationArray || destinationArrayLength < sourceArrayLength)
             return false;
 
-        for (size_t index = 0; index < sourceArrayLength; ++index) {
-            const auto& source = sourceArray[index];
-            destinationArray[index].X = source.X * matrix.M11 + source.Y * matrix.M21;
-            destinationArray[index].Y = source.X * matrix.M12 + source.Y * matrix.M22;
-        }
-
+        TransformKernels::Run<2, 2, false>(reinterpret_cast<float const*>(sourceArray), reinterpret_cast<float*>(destinationArray), sourceArrayLength, TransformRows::FromMatrix(matrix));
         return true;
     }
 
@@ -72,13 +504,7 @@ namespace xna {
             || sourceArrayLength < sourceIndex + length || destinationArrayLength < destinationIndex + length)
             return false;
 
-        for (size_t i = 0; i < length; ++i)
-        {
-            const auto& source = sourceArray[sourceIndex + i];
-            destinationArray[destinationIndex].X = (source.X * matrix.M11 + source.Y * matrix.M21);
-            destinationArray[destinationIndex].Y = (source.X * matrix.M12 + source.Y * matrix.M22);
-        }
-
+        TransformKernels::Run<2, 2, false>(reinterpret_cast<float const*>(sourceArray + sourceIndex), reinterpret_cast<float*>(destinationArray + destinationIndex), length, TransformRows::FromMatrix(matrix));
         return true;
     }
 
@@ -94,25 +520,7 @@ namespace xna {
         if (!sourceArray || !destinationArray || destinationArrayLength < sourceArrayLength)
             return false;
 
-        const auto rx = rotation.X + rotation.X;
-        const auto ry = rotation.Y + rotation.Y;
-        const auto rz = rotation.Z + rotation.Z;
-        const auto rwz = rotation.W * rz;
-        const auto rxx = rotation.X * rx;
-        const auto rxy = rotation.X * ry;
-        const auto ryy = rotation.Y * ry;
-        const auto rzz = rotation.Z * rz;
-        const auto a = 1.0f - ryy - rzz;
-        const auto b = rxy - rwz;
-        const auto c = rxy + rwz;
-        const auto d = 1.0f - rxx - rzz;
-
-        for (size_t index = 0; index < sourceArrayLength; ++index) {
-            const auto& source = sourceArray[index];
-            destinationArray[index].X = source.X * a + source.Y * b;
-            destinationArray[index].Y = source.X * c + source.Y * d;
-        }
-
+        TransformKernels::Run<2, 2, false>(reinterpret_cast<float const*>(sourceArray), reinterpret_cast<float*>(destinationArray), sourceArrayLength, TransformRows::FromQuaternion(rotation));
         return true;
     }
 
@@ -130,28 +538,7 @@ namespace xna {
             || sourceArrayLength < sourceIndex + length || destinationArrayLength < destinationIndex + length)
             return false;
 
-        const auto rx = rotation.X + rotation.X;
-        const auto ry = rotation.Y + rotation.Y;
-        const auto rz = rotation.Z + rotation.Z;
-        const auto rwz = rotation.W * rz;
-        const auto rxx = rotation.X * rx;
-        const auto rxy = rotation.X * ry;
-        const auto ryy = rotation.Y * ry;
-        const auto rzz = rotation.Z * rz;
-        const auto a = 1.0f - ryy - rzz;
-        const auto b = rxy - rwz;
-        const auto c = rxy + rwz;
-        const auto d = 1.0f - rxx - rzz;
-
-        for (size_t i = 0; i < length; ++i) {
-            const auto& source = sourceArray[sourceIndex = i];
-
-            destinationArray[destinationIndex].X = source.X * a + source.Y * b;
-            destinationArray[destinationIndex].Y = source.X * c + source.Y * d;
-            ++sourceIndex;
-            ++destinationIndex;
-        }
-
+        TransformKernels::Run<2, 2, false>(reinterpret_cast<float const*>(sourceArray + sourceIndex), reinterpret_cast<float*>(destinationArray + destinationIndex), length, TransformRows::FromQuaternion(rotation));
         return true;
     }
 
@@ -168,14 +555,7 @@ namespace xna {
         if (!sourceArray || !destinationArray || destinationLength < sourceArrayLength)
             return false;
 
-        for (size_t index = 0; index < sourceArrayLength; ++index)
-        {
-            const auto& source = sourceArray[index];
-            destinationArray[index].X = (source.X * matrix.M11 + source.Y * matrix.M21 + source.Z * matrix.M31) + matrix.M41;
-            destinationArray[index].Y = (source.X * matrix.M12 + source.Y * matrix.M22 + source.Z * matrix.M32) + matrix.M42;
-            destinationArray[index].Z = (source.X * matrix.M13 + source.Y * matrix.M23 + source.Z * matrix.M33) + matrix.M43;
-        }
-
+        TransformKernels::Run<3, 3, true>(reinterpret_cast<float const*>(sourceArray), reinterpret_cast<float*>(destinationArray), sourceArrayLength, TransformRows::FromMatrix(matrix));
         return true;
     }
 
@@ -192,14 +572,7 @@ namespace xna {
         if (!sourceArray || !destinationArray || sourceArrayLength < sourceIndex + length || destinationLength < destinationIndex + length)
             return false;
 
-        for (size_t index = 0; index < length; ++index)
-        {
-            const auto& source = sourceArray[sourceIndex + index];
-            destinationArray[destinationIndex + index].X = (source.X * matrix.M11 + source.Y * matrix.M21 + source.Z * matrix.M31) + matrix.M41;
-            destinationArray[destinationIndex + index].Y = (source.X * matrix.M12 + source.Y * matrix.M22 + source.Z * matrix.M32) + matrix.M42;
-            destinationArray[destinationIndex + index].Z = (source.X * matrix.M13 + source.Y * matrix.M23 + source.Z * matrix.M33) + matrix.M43;
-        }
-
+        TransformKernels::Run<3, 3, true>(reinterpret_cast<float const*>(sourceArray + sourceIndex), reinterpret_cast<float*>(destinationArray + destinationIndex), length, TransformRows::FromMatrix(matrix));
         return true;
     }
 
@@ -213,17 +586,10 @@ namespace xna {
 
     bool Vector3::TransformNormal(Vector3 const* sourceArray, size_t sourceArrayLength, Matrix const& matrix, Vector3* destinationArray, size_t destionationArrayLength)
     {
-        if (!sourceArray || !destinationArray || sourceArrayLength < destionationArrayLength)
+        if (!sourceArray || !destinationArray || destionationArrayLength < sourceArrayLength)
             return false;
 
-        for (size_t index = 0; index < sourceArrayLength; ++index)
-        {
-            const auto& source = sourceArray[index];
-            destinationArray[index].X = source.X * matrix.M11 + source.Y * matrix.M21 + source.Z * matrix.M31;
-            destinationArray[index].Y = source.X * matrix.M12 + source.Y * matrix.M22 + source.Z * matrix.M32;
-            destinationArray[index].Z = source.X * matrix.M13 + source.Y * matrix.M23 + source.Z * matrix.M33;
-        }
-
+        TransformKernels::Run<3, 3, false>(reinterpret_cast<float const*>(sourceArray), reinterpret_cast<float*>(destinationArray), sourceArrayLength, TransformRows::FromMatrix(matrix));
         return true;
     }
 
@@ -240,13 +606,7 @@ namespace xna {
         if (!sourceArray || !destinationArray || sourceArrayLength < sourceIndex + length || destinationLength < destinationIndex + length)
             return false;
 
-        for (size_t index = 0; index < length; ++index) {
-            const auto& source = sourceArray[sourceIndex + index];
-            destinationArray[destinationIndex + index].X = source.X * matrix.M11 + source.Y * matrix.M21 + source.Z * matrix.M31;
-            destinationArray[destinationIndex + index].Y = source.X * matrix.M12 + source.Y * matrix.M22 + source.Z * matrix.M32;
-            destinationArray[destinationIndex + index].Z = source.X * matrix.M13 + source.Y * matrix.M23 + source.Z * matrix.M33;
-        }
-
+        TransformKernels::Run<3, 3, false>(reinterpret_cast<float const*>(sourceArray + sourceIndex), reinterpret_cast<float*>(destinationArray + destinationIndex), length, TransformRows::FromMatrix(matrix));
         return true;
     }
 
@@ -263,36 +623,7 @@ namespace xna {
         if (!sourceArray || !destinationArray || destinationLength < sourceArrayLength)
             return false;
 
-        const auto num1 = rotation.X + rotation.X;
-        const auto num2 = rotation.Y + rotation.Y;
-        const auto num3 = rotation.Z + rotation.Z;
-        const auto num4 = rotation.W * num1;
-        const auto num5 = rotation.W * num2;
-        const auto num6 = rotation.W * num3;
-        const auto num7 = rotation.X * num1;
-        const auto num8 = rotation.X * num2;
-        const auto num9 = rotation.X * num3;
-        const auto num10 = rotation.Y * num2;
-        const auto num11 = rotation.Y * num3;
-        const auto num12 = rotation.Z * num3;
-        const auto num13 = 1.0f - num10 - num12;
-        const auto num14 = num8 - num6;
-        const auto num15 = num9 + num5;
-        const auto num16 = num8 + num6;
-        const auto num17 = 1.0f - num7 - num12;
-        const auto num18 = num11 - num4;
-        const auto num19 = num9 - num5;
-        const auto num20 = num11 + num4;
-        const auto num21 = 1.0f - num7 - num10;
-
-        for (size_t index = 0; index < sourceArrayLength; ++index)
-        {
-            const auto& source = sourceArray[index];
-            destinationArray[index].X = source.X * num13 + source.Y * num14 + source.Z * num15;
-            destinationArray[index].Y = source.X * num16 + source.Y * num17 + source.Z * num18;
-            destinationArray[index].Z = source.X * num19 + source.Y * num20 + source.Z * num21;
-        }
-
+        TransformKernels::Run<3, 3, false>(reinterpret_cast<float const*>(sourceArray), reinterpret_cast<float*>(destinationArray), sourceArrayLength, TransformRows::FromQuaternion(rotation));
         return true;
     }
 
@@ -309,36 +640,7 @@ namespace xna {
         if (!sourceArray || !destinationArray || sourceArrayLength < sourceIndex + length || destinationLength < destinationIndex + length)
             return false;
 
-        const auto num1 = rotation.X + rotation.X;
-        const auto num2 = rotation.Y + rotation.Y;
-        const auto num3 = rotation.Z + rotation.Z;
-        const auto num4 = rotation.W * num1;
-        const auto num5 = rotation.W * num2;
-        const auto num6 = rotation.W * num3;
-        const auto num7 = rotation.X * num1;
-        const auto num8 = rotation.X * num2;
-        const auto num9 = rotation.X * num3;
-        const auto num10 = rotation.Y * num2;
-        const auto num11 = rotation.Y * num3;
-        const auto num12 = rotation.Z * num3;
-        const auto num13 = 1.0f - num10 - num12;
-        const auto num14 = num8 - num6;
-        const auto num15 = num9 + num5;
-        const auto num16 = num8 + num6;
-        const auto num17 = 1.0f - num7 - num12;
-        const auto num18 = num11 - num4;
-        const auto num19 = num9 - num5;
-        const auto num20 = num11 + num4;
-        const auto num21 = 1.0f - num7 - num10;
-
-        for (size_t index = 0; index < length; ++index)
-        {
-            const auto& source = sourceArray[sourceIndex + index];
-            destinationArray[destinationIndex + index].X = source.X * num13 + source.Y * num14 + source.Z * num15;
-            destinationArray[destinationIndex + index].Y = source.X * num16 + source.Y * num17 + source.Z * num18;
-            destinationArray[destinationIndex + index].Z = source.X * num19 + source.Y * num20 + source.Z * num21;
-        }
-
+        TransformKernels::Run<3, 3, false>(reinterpret_cast<float const*>(sourceArray + sourceIndex), reinterpret_cast<float*>(destinationArray + destinationIndex), length, TransformRows::FromQuaternion(rotation));
         return true;
     }
 
@@ -355,15 +657,7 @@ namespace xna {
         if (!sourceArray || !destinationArray || destinationLength < sourceLength)
             return false;
 
-        for (size_t index = 0; index < sourceLength; ++index)
-        {
-            const auto& source = sourceArray[index];
-            destinationArray[index].X = source.X * matrix.M11 + source.Y * matrix.M21 + source.Z * matrix.M31 + source.W * matrix.M41;
-            destinationArray[index].Y = source.X * matrix.M12 + source.Y * matrix.M22 + source.Z * matrix.M32 + source.W * matrix.M42;
-            destinationArray[index].Z = source.X * matrix.M13 + source.Y * matrix.M23 + source.Z * matrix.M33 + source.W * matrix.M43;
-            destinationArray[index].W = source.X * matrix.M14 + source.Y * matrix.M24 + source.Z * matrix.M34 + source.W * matrix.M44;
-        }
-
+        TransformKernels::Run<4, 4, false>(reinterpret_cast<float const*>(sourceArray), reinterpret_cast<float*>(destinationArray), sourceLength, TransformRows::FromMatrix(matrix));
         return true;
     }
 
@@ -380,15 +674,7 @@ namespace xna {
         if (!sourceArray || !destinationArray || sourceLength < sourceIndex + length || destinationLength < destinationIndex + length)
             return false;
 
-        for (size_t i = 0; i < length; ++i)
-        {
-            const auto& source = sourceArray[sourceIndex + i];
-            destinationArray[destinationIndex].X = source.X * matrix.M11 + source.Y * matrix.M21 + source.Z * matrix.M31 + source.W * matrix.M41;
-            destinationArray[destinationIndex].Y = source.X * matrix.M12 + source.Y * matrix.M22 + source.Z * matrix.M32 + source.W * matrix.M42;
-            destinationArray[destinationIndex].Z = source.X * matrix.M13 + source.Y * matrix.M23 + source.Z * matrix.M33 + source.W * matrix.M43;
-            destinationArray[destinationIndex].W = source.X * matrix.M14 + source.Y * matrix.M24 + source.Z * matrix.M34 + source.W * matrix.M44;
-        }
-
+        TransformKernels::Run<4, 4, false>(reinterpret_cast<float const*>(sourceArray + sourceIndex), reinterpret_cast<float*>(destinationArray + destinationIndex), length, TransformRows::FromMatrix(matrix));
         return true;
     }
 
@@ -405,37 +691,7 @@ namespace xna {
         if (!sourceArray || !destinationArray || destinationLength < sourceLength)
             return false;
 
-        const auto num1 = rotation.X + rotation.X;
-        const auto num2 = rotation.Y + rotation.Y;
-        const auto num3 = rotation.Z + rotation.Z;
-        const auto num4 = rotation.W * num1;
-        const auto num5 = rotation.W * num2;
-        const auto num6 = rotation.W * num3;
-        const auto num7 = rotation.X * num1;
-        const auto num8 = rotation.X * num2;
-        const auto num9 = rotation.X * num3;
-        const auto num10 = rotation.Y * num2;
-        const auto num11 = rotation.Y * num3;
-        const auto num12 = rotation.Z * num3;
-        const auto num13 = 1.0f - num10 - num12;
-        const auto num14 = num8 - num6;
-        const auto num15 = num9 + num5;
-        const auto num16 = num8 + num6;
-        const auto num17 = 1.0f - num7 - num12;
-        const auto num18 = num11 - num4;
-        const auto num19 = num9 - num5;
-        const auto num20 = num11 + num4;
-        const auto num21 = 1.0f - num7 - num10;
-
-        for (size_t index = 0; index < sourceLength; ++index)
-        {
-            const auto& source = sourceArray[index];
-            destinationArray[index].X = source.Z * num13 + source.Y * num14 + source.Z * num15;
-            destinationArray[index].Y = source.Z * num16 + source.Y * num17 + source.Z * num18;
-            destinationArray[index].Z = source.Z * num19 + source.Y * num20 + source.Z * num21;
-            destinationArray[index].W = sourceArray[index].W;
-        }
-
+        TransformKernels::Run<4, 3, false>(reinterpret_cast<float const*>(sourceArray), reinterpret_cast<float*>(destinationArray), sourceLength, TransformRows::FromQuaternion(rotation));
         return true;
     }
 
@@ -452,37 +708,7 @@ namespace xna {
         if (!sourceArray || !destinationArray || sourceLength < sourceIndex + length || destinationLength < destinationIndex + length)
             return false;
 
-        const auto num1 = rotation.X + rotation.X;
-        const auto num2 = rotation.Y + rotation.Y;
-        const auto num3 = rotation.Z + rotation.Z;
-        const auto num4 = rotation.W * num1;
-        const auto num5 = rotation.W * num2;
-        const auto num6 = rotation.W * num3;
-        const auto num7 = rotation.X * num1;
-        const auto num8 = rotation.X * num2;
-        const auto num9 = rotation.X * num3;
-        const auto num10 = rotation.Y * num2;
-        const auto num11 = rotation.Y * num3;
-        const auto num12 = rotation.Z * num3;
-        const auto num13 = 1.0f - num10 - num12;
-        const auto num14 = num8 - num6;
-        const auto num15 = num9 + num5;
-        const auto num16 = num8 + num6;
-        const auto num17 = 1.0f - num7 - num12;
-        const auto num18 = num11 - num4;
-        const auto num19 = num9 - num5;
-        const auto num20 = num11 + num4;
-        const auto num21 = 1.0f - num7 - num10;
-
-        for (size_t i = 0; i < length; ++i)
-        {
-            const auto& source = sourceArray[sourceIndex + i];
-            destinationArray[destinationIndex].X = source.X * num13 + source.Y * num14 + source.Z * num15;
-            destinationArray[destinationIndex].Y = source.X * num16 + source.Y * num17 + source.Z * num18;
-            destinationArray[destinationIndex].Z = source.X * num19 + source.Y * num20 + source.Z * num21;
-            destinationArray[destinationIndex].W = source.W;
-        }
-
+        TransformKernels::Run<4, 3, false>(reinterpret_cast<float const*>(sourceArray + sourceIndex), reinterpret_cast<float*>(destinationArray + destinationIndex), length, TransformRows::FromQuaternion(rotation));
         return true;
     }
     bool Vector4::Transform(std::vector<Vector4> const& sourceArray, size_t sourceIndex, Quaternion const& rotation, std::vector<Vector4>& destinationArray, size_t destinationIndex, size_t length)
@@ -493,132 +719,885 @@ namespace xna {
         return Transform(sourceArray.data(), sourceArray.size(), sourceIndex, rotation, destinationArray.data(), destinationArray.size(), destinationIndex, length);
     }    
 
-    Quaternion Quaternion::CreateFromAxisAngle(Vector3 const& axis, float angle) {
-        const auto num1 = angle * 0.5f;
-        const auto num2 = std::sin(num1);
-        const auto num3 = std::cos(num1);
-        Quaternion fromAxisAngle;
-        fromAxisAngle.X = axis.X * num2;
-        fromAxisAngle.Y = axis.Y * num2;
-        fromAxisAngle.Z = axis.Z * num2;
-        fromAxisAngle.W = num3;
-        return fromAxisAngle;
-    }
-
-    Quaternion Quaternion::CreateFromYawPitchRoll(float yaw, float pitch, float roll) {
-        const auto num1 = roll * 0.5f;
-        const auto num2 = std::sin(num1);
-        const auto num3 = std::cos(num1);
-        const auto num4 = pitch * 0.5f;
-        const auto num5 = std::sin(num4);
-        const auto num6 = std::cos(num4);
-        const auto num7 = yaw * 0.5f;
-        const auto num8 = std::sin(num7);
-        const auto num9 = std::cos(num7);
-        Quaternion fromYawPitchRoll;
-        fromYawPitchRoll.X = (num9 * num5 * num3 + num8 * num6 * num2);
-        fromYawPitchRoll.Y = (num8 * num6 * num3 - num9 * num5 * num2);
-        fromYawPitchRoll.Z = (num9 * num6 * num2 - num8 * num5 * num3);
-        fromYawPitchRoll.W = (num9 * num6 * num3 + num8 * num5 * num2);
-        return fromYawPitchRoll;
-    }
-
-    Quaternion Quaternion::CreateFromRotationMatrix(Matrix const& matrix) {
-        const auto num1 = matrix.M11 + matrix.M22 + matrix.M33;
-
-        Quaternion fromRotationMatrix;
-        if (num1 > 0.0)
-        {
-            const auto num2 = std::sqrt(num1 + 1.0F);
-            fromRotationMatrix.W = num2 * 0.5f;
-            const auto num3 = 0.5f / num2;
-            fromRotationMatrix.X = (matrix.M23 - matrix.M32) * num3;
-            fromRotationMatrix.Y = (matrix.M31 - matrix.M13) * num3;
-            fromRotationMatrix.Z = (matrix.M12 - matrix.M21) * num3;
-        }
-        else if (matrix.M11 >= matrix.M22 && matrix.M11 >= matrix.M33)
-        {
-            const auto num4 = std::sqrt(1.0F + matrix.M11 - matrix.M22 - matrix.M33);
-            const auto num5 = 0.5f / num4;
-            fromRotationMatrix.X = 0.5f * num4;
-            fromRotationMatrix.Y = (matrix.M12 + matrix.M21) * num5;
-            fromRotationMatrix.Z = (matrix.M13 + matrix.M31) * num5;
-            fromRotationMatrix.W = (matrix.M23 - matrix.M32) * num5;
-        }
-        else if (matrix.M22 > matrix.M33)
-        {
-            const auto num6 = std::sqrt(1.0F + matrix.M22 - matrix.M11 - matrix.M33);
-            const auto num7 = 0.5f / num6;
-            fromRotationMatrix.X = (matrix.M21 + matrix.M12) * num7;
-            fromRotationMatrix.Y = 0.5f * num6;
-            fromRotationMatrix.Z = (matrix.M32 + matrix.M23) * num7;
-            fromRotationMatrix.W = (matrix.M31 - matrix.M13) * num7;
+    //4x4 matrix kernels. A row of the product is a linear combination of the rows of the right matrix,
+    //so the batch multiply broadcasts one element of the left row at a time and needs no transposes.
+    //Invert evaluates the same cofactors as Matrix::Invert, one result column per register.
+    //Mul and add are never fused, so every kernel returns the same bits as the scalar code.
+    struct MatrixKernels {
+#if defined(CSHARP_INTRINSICS_X86)
+        inline static const bool UseAvx2 = csharp::X86Intrinsics::IsAvx2Supported();
+        inline static const bool UseAvx512 = csharp::X86Intrinsics::IsAvx512Supported();
+
+        CSHARP_TARGET("sse2")
+        static void Load(Matrix const& matrix, __m128 (&rows)[4]) {
+            for (size_t k = 0; k < 4; ++k)
+                rows[k] = _mm_load_ps(&matrix.M11 + k * 4);
+        }
+
+        CSHARP_TARGET("sse2")
+        static void Store(__m128 const (&rows)[4], Matrix& matrix) {
+            for (size_t k = 0; k < 4; ++k)
+                _mm_store_ps(&matrix.M11 + k * 4, rows[k]);
         }
+
+        //Two rows per register, with the right matrix broadcast to both 128-bit lanes.
+        CSHARP_TARGET("avx2")
+        static void MultiplyBatchAvx2(Matrix const* matrices, Matrix const& matrix, Matrix* destination, size_t count) {
+            __m256 right[4];
+
+            for (size_t k = 0; k < 4; ++k)
+                right[k] = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(&matrix.M11 + k * 4));
+
+            for (size_t i = 0; i < count; ++i) {
+                auto source = &matrices[i].M11;
+                auto target = &destination[i].M11;
+                const auto rows01 = _mm256_loadu_ps(source);
+                const auto rows23 = _mm256_loadu_ps(source + 8);
+
+                auto value01 = _mm256_mul_ps(_mm256_permute_ps(rows01, _MM_SHUFFLE(0, 0, 0, 0)), right[0]);
+                auto value23 = _mm256_mul_ps(_mm256_permute_ps(rows23, _MM_SHUFFLE(0, 0, 0, 0)), right[0]);
+                value01 = _mm256_add_ps(value01, _mm256_mul_ps(_mm256_permute_ps(rows01, _MM_SHUFFLE(1, 1, 1, 1)), right[1]));
+                value23 = _mm256_add_ps(value23, _mm256_mul_ps(_mm256_permute_ps(rows23, _MM_SHUFFLE(1, 1, 1, 1)), right[1]));
+                value01 = _mm256_add_ps(value01, _mm256_mul_ps(_mm256_permute_ps(rows01, _MM_SHUFFLE(2, 2, 2, 2)), right[2]));
+                value23 = _mm256_add_ps(value23, _mm256_mul_ps(_mm256_permute_ps(rows23, _MM_SHUFFLE(2, 2, 2, 2)), right[2]));
+                value01 = _mm256_add_ps(value01, _mm256_mul_ps(_mm256_permute_ps(rows01, _MM_SHUFFLE(3, 3, 3, 3)), right[3]));
+                value23 = _mm256_add_ps(value23, _mm256_mul_ps(_mm256_permute_ps(rows23, _MM_SHUFFLE(3, 3, 3, 3)), right[3]));
+
+                _mm256_storeu_ps(target, value01);
+                _mm256_storeu_ps(target + 8, value23);
+            }
+        }
+
+        //The whole matrix in one register. The rounding form of add keeps the compiler from fusing it with the multiply.
+        CSHARP_TARGET("avx512f")
+        static void MultiplyBatchAvx512(Matrix const* matrices, Matrix const& matrix, Matrix* destination, size_t count) {
+            __m512 right[4];
+
+            for (size_t k = 0; k < 4; ++k)
+                right[k] = _mm512_broadcast_f32x4(_mm_load_ps(&matrix.M11 + k * 4));
+
+            for (size_t i = 0; i < count; ++i) {
+                const auto rows = _mm512_loadu_ps(&matrices[i].M11);
+
+                auto value = _mm512_mul_ps(_mm512_permute_ps(rows, _MM_SHUFFLE(0, 0, 0, 0)), right[0]);
+                value = _mm512_add_round_ps(value, _mm512_mul_ps(_mm512_permute_ps(rows, _MM_SHUFFLE(1, 1, 1, 1)), right[1]), _MM_FROUND_CUR_DIRECTION);
+                value = _mm512_add_round_ps(value, _mm512_mul_ps(_mm512_permute_ps(rows, _MM_SHUFFLE(2, 2, 2, 2)), right[2]), _MM_FROUND_CUR_DIRECTION);
+                value = _mm512_add_round_ps(value, _mm512_mul_ps(_mm512_permute_ps(rows, _MM_SHUFFLE(3, 3, 3, 3)), right[3]), _MM_FROUND_CUR_DIRECTION);
+
+                _mm512_storeu_ps(&destination[i].M11, value);
+            }
+        }
+
+        //Lane l holds the 2x2 determinant a[i] * b[j] - a[j] * b[i] of columns i and j of rows a and b,
+        //for the column pairs (3, 4) (3, 4) (2, 4) (2, 3), (2, 4) (1, 4) (1, 4) (1, 3) and (2, 3) (1, 3) (1, 2) (1, 2).
+        //These are num1..num6 of Matrix::Invert, in the order each result column uses them.
+        CSHARP_TARGET("sse2")
+        static void Determinants2x2(__m128 a, __m128 b, __m128& p, __m128& q, __m128& r) {
+            const auto a1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 2, 2));
+            const auto a2 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 3, 3));
+            const auto b1 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 2, 2));
+            const auto b2 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 3, 3));
+            p = _mm_sub_ps(_mm_mul_ps(a1, b2), _mm_mul_ps(a2, b1));
+
+            const auto a3 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 1));
+            const auto b3 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 1));
+            q = _mm_sub_ps(_mm_mul_ps(a3, b2), _mm_mul_ps(a2, b3));
+
+            r = _mm_sub_ps(_mm_mul_ps(a3, b1), _mm_mul_ps(a1, b3));
+        }
+
+        //Unsigned cofactors of one result column: x[a] * p - x[b] * q + x[c] * r in every lane.
+        CSHARP_TARGET("sse2")
+        static __m128 Cofactors(__m128 x, __m128 p, __m128 q, __m128 r) {
+            const auto a = _mm_shuffle_ps(x, x, _MM_SHUFFLE(0, 0, 0, 1));
+            const auto b = _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 2, 2));
+            const auto c = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 3, 3));
+            return _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a, p), _mm_mul_ps(b, q)), _mm_mul_ps(c, r));
+        }
+
+        CSHARP_TARGET("sse2")
+        static void Invert(Matrix const& matrix, Matrix& result) {
+            __m128 rows[4];
+            Load(matrix, rows);
+
+            const auto evenSigns = _mm_castsi128_ps(_mm_set_epi32(INT32_MIN, 0, INT32_MIN, 0));
+            const auto oddSigns = _mm_castsi128_ps(_mm_set_epi32(0, INT32_MIN, 0, INT32_MIN));
+
+            __m128 p, q, r;
+            __m128 columns[4];
+
+            Determinants2x2(rows[2], rows[3], p, q, r);
+            columns[0] = _mm_xor_ps(Cofactors(rows[1], p, q, r), evenSigns);
+            columns[1] = _mm_xor_ps(Cofactors(rows[0], p, q, r), oddSigns);
+
+            Determinants2x2(rows[1], rows[3], p, q, r);
+            columns[2] = _mm_xor_ps(Cofactors(rows[0], p, q, r), evenSigns);
+
+            Determinants2x2(rows[1], rows[2], p, q, r);
+            columns[3] = _mm_xor_ps(Cofactors(rows[0], p, q, r), oddSigns);
+
+            //The determinant is summed left to right like the scalar code.
+            const auto products = _mm_mul_ps(rows[0], columns[0]);
+            alignas(16) float terms[4];
+            _mm_store_ps(terms, products);
+            const auto scale = _mm_set1_ps(1.0f / (terms[0] + terms[1] + terms[2] + terms[3]));
+
+            for (size_t k = 0; k < 4; ++k)
+                columns[k] = _mm_mul_ps(columns[k], scale);
+
+            _MM_TRANSPOSE4_PS(columns[0], columns[1], columns[2], columns[3]);
+            Store(columns, result);
+        }
+
+        CSHARP_TARGET("sse2")
+        static void Transpose(Matrix const& matrix, Matrix& result) {
+            __m128 rows[4];
+            Load(matrix, rows);
+            _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+            Store(rows, result);
+        }
+#endif
+    };
+
+    bool Matrix::InvertVectorized(Matrix const& matrix, Matrix& result) {
+#if defined(CSHARP_INTRINSICS_X86)
+        MatrixKernels::Invert(matrix, result);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool Matrix::TransposeVectorized(Matrix const& matrix, Matrix& result) {
+#if defined(CSHARP_INTRINSICS_X86)
+        MatrixKernels::Transpose(matrix, result);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool Matrix::Multiply(std::span<const Matrix> matrices, Matrix const& matrix, std::span<Matrix> destination) {
+        if (destination.size() < matrices.size())
+            return false;
+
+#if defined(CSHARP_INTRINSICS_X86)
+        if (MatrixKernels::UseAvx512)
+            MatrixKernels::MultiplyBatchAvx512(matrices.data(), matrix, destination.data(), matrices.size());
+        else if (MatrixKernels::UseAvx2)
+            MatrixKernels::MultiplyBatchAvx2(matrices.data(), matrix, destination.data(), matrices.size());
         else
+#endif
         {
-            const auto num8 = std::sqrt(1.0F + matrix.M33 - matrix.M11 - matrix.M22);
-            const auto num9 = 0.5f / num8;
-            fromRotationMatrix.X = (matrix.M31 + matrix.M13) * num9;
-            fromRotationMatrix.Y = (matrix.M32 + matrix.M23) * num9;
-            fromRotationMatrix.Z = 0.5f * num8;
-            fromRotationMatrix.W = (matrix.M12 - matrix.M21) * num9;
-        }
-        return fromRotationMatrix;
-    }
-
-    Quaternion Quaternion::Slerp(Quaternion const& quaternion1, Quaternion const& quaternion2, float amount) {
-        const auto num1 = amount;
-        auto d = quaternion1.X * quaternion2.X + quaternion1.Y * quaternion2.Y + quaternion1.Z * quaternion2.Z + quaternion1.W * quaternion2.W;
-        bool flag = false;
-
-        if (d < 0.0) {
-            flag = true;
-            d = -d;
-        }
-
-        float num2 = 0;
-        float num3 = 0;
-
-        if (d > 0.99999898672103882) {
-            num2 = 1.0f - num1;
-            num3 = flag ? -num1 : num1;
-        }
-        else {
-            const auto a = std::acos(d);
-            const auto num4 = 1.0F / std::sin(a);
-            num2 = std::sin((1.0F - num1) * a) * num4;
-            num3 = flag ? -std::sin(num1 * a) * num4 : std::sin(num1 * a) * num4;
-        }
-        Quaternion quaternion;
-        quaternion.X = num2 * quaternion1.X + num3 * quaternion2.X;
-        quaternion.Y = num2 * quaternion1.Y + num3 * quaternion2.Y;
-        quaternion.Z = num2 * quaternion1.Z + num3 * quaternion2.Z;
-        quaternion.W = num2 * quaternion1.W + num3 * quaternion2.W;
-        return quaternion;
-    }
-
-    Quaternion Quaternion::Lerp(Quaternion const& quaternion1, Quaternion const& quaternion2, float amount) {
-        const auto num1 = amount;
-        const auto num2 = 1.0f - num1;
-        Quaternion quaternion;
-
-        if (quaternion1.X * quaternion2.X + quaternion1.Y * quaternion2.Y + quaternion1.Z * quaternion2.Z + quaternion1.W * quaternion2.W >= 0.0) {
-            quaternion.X = num2 * quaternion1.X + num1 * quaternion2.X;
-            quaternion.Y = num2 * quaternion1.Y + num1 * quaternion2.Y;
-            quaternion.Z = num2 * quaternion1.Z + num1 * quaternion2.Z;
-            quaternion.W = num2 * quaternion1.W + num1 * quaternion2.W;
-        }
-        else {
-            quaternion.X = num2 * quaternion1.X - num1 * quaternion2.X;
-            quaternion.Y = num2 * quaternion1.Y - num1 * quaternion2.Y;
-            quaternion.Z = num2 * quaternion1.Z - num1 * quaternion2.Z;
-            quaternion.W = num2 * quaternion1.W - num1 * quaternion2.W;
-        }
-        const auto num3 = 1.0f / std::sqrt(quaternion.X * quaternion.X + quaternion.Y * quaternion.Y + quaternion.Z * quaternion.Z + quaternion.W * quaternion.W);
-        quaternion.X *= num3;
-        quaternion.Y *= num3;
-        quaternion.Z *= num3;
-        quaternion.W *= num3;
-        return quaternion;
+            //matrix can be one of the destination elements.
+            const auto right = matrix;
+
+            for (size_t i = 0; i < matrices.size(); ++i)
+                destination[i] = Matrix::Multiply(matrices[i], right);
+        }
+
+        return true;
+    }
+
+    //Quaternion kernels. Four quaternions (eight with AVX2) are transposed to one register per component, so every
+    //lane evaluates the scalar formula with the same operations in the same order and the results are identical.
+    //With AVX2 a register holds two 4x4 blocks that are transposed in place, which permutes the quaternions
+    //between lanes in the same way on the way in and on the way out.
+    struct QuaternionKernels {
+        //Lerp is Quaternion::Lerp, FastLerp normalizes with the estimate of FastMath::ReciprocalSqrt
+        //and FastSlerp also adjusts the amount like FastMath::Slerp.
+        enum class Blending {
+            Lerp,
+            FastLerp,
+            FastSlerp
+        };
+
+        template <Blending Mode>
+        static Quaternion BlendScalar(Quaternion const& quaternion1, Quaternion const& quaternion2, float amount) {
+            if constexpr (Mode == Blending::Lerp)
+                return Quaternion::Lerp(quaternion1, quaternion2, amount);
+            else if constexpr (Mode == Blending::FastLerp)
+                return FastMath::Lerp(quaternion1, quaternion2, amount);
+            else
+                return FastMath::Slerp(quaternion1, quaternion2, amount);
+        }
+
+        template <Blending Mode>
+        static void Blend(Quaternion const* quaternions1, Quaternion const* quaternions2, float amount, Quaternion* destination, size_t count) {
+            size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+            if (TransformKernels::UseAvx2)
+                i = BlendAvx2<Mode>(quaternions1, quaternions2, amount, destination, count);
+
+            i += BlendSse2<Mode>(quaternions1 + i, quaternions2 + i, amount, destination + i, count - i);
+#endif
+            for (; i < count; ++i)
+                destination[i] = BlendScalar<Mode>(quaternions1[i], quaternions2[i], amount);
+        }
+
+        static void Normalize(Quaternion const* source, Quaternion* destination, size_t count) {
+            size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+            if (TransformKernels::UseAvx2)
+                i = NormalizeAvx2(source, destination, count);
+
+            i += NormalizeSse2(source + i, destination + i, count - i);
+#endif
+            for (; i < count; ++i)
+                destination[i] = Quaternion::Normalize(source[i]);
+        }
+
+        //Matrix::CreateFromQuaternion, or Matrix::Compose when Composed is true.
+        template <bool Composed>
+        static void CreateMatrices(Vector3 const* scales, Quaternion const* quaternions, Vector3 const* translations, Matrix* destination, size_t count) {
+            size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+            if (TransformKernels::UseAvx2)
+                i = CreateMatricesAvx2<Composed>(scales, quaternions, translations, destination, count);
+
+            i += CreateMatricesSse2<Composed>(scales + (Composed ? i : 0), quaternions + i, translations + (Composed ? i : 0), destination + i, count - i);
+#endif
+            for (; i < count; ++i) {
+                if constexpr (Composed)
+                    destination[i] = Matrix::Compose(scales[i], quaternions[i], translations[i]);
+                else
+                    destination[i] = Matrix::CreateFromQuaternion(quaternions[i]);
+            }
+        }
+
+#if defined(CSHARP_INTRINSICS_X86)
+        CSHARP_TARGET("sse2")
+        static __m128 ReciprocalSqrt(__m128 value, bool fast) {
+            if (!fast)
+                return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(value));
+
+            const auto estimate = _mm_rsqrt_ps(value);
+            const auto xyy = _mm_mul_ps(_mm_mul_ps(value, estimate), estimate);
+            return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), estimate), _mm_sub_ps(_mm_set1_ps(3.0f), xyy));
+        }
+
+        CSHARP_TARGET("avx2")
+        static __m256 ReciprocalSqrt(__m256 value, bool fast) {
+            if (!fast)
+                return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(value));
+
+            const auto estimate = _mm256_rsqrt_ps(value);
+            const auto xyy = _mm256_mul_ps(_mm256_mul_ps(value, estimate), estimate);
+            return _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), estimate), _mm256_sub_ps(_mm256_set1_ps(3.0f), xyy));
+        }
+
+        //Blocks of four and eight quaternions with one register per component. The members are loaded and stored one by one;
+        //loops over an array of registers make the compiler copy the array through memory.
+        struct Block4 {
+            __m128 X, Y, Z, W;
+        };
+
+        struct Block8 {
+            __m256 X, Y, Z, W;
+        };
+
+        CSHARP_TARGET("sse2")
+        static __m128 Dot(Block4 const& a, Block4 const& b) {
+            auto dot = _mm_mul_ps(a.X, b.X);
+            dot = _mm_add_ps(dot, _mm_mul_ps(a.Y, b.Y));
+            dot = _mm_add_ps(dot, _mm_mul_ps(a.Z, b.Z));
+            return _mm_add_ps(dot, _mm_mul_ps(a.W, b.W));
+        }
+
+        CSHARP_TARGET("avx2")
+        static __m256 Dot(Block8 const& a, Block8 const& b) {
+            auto dot = _mm256_mul_ps(a.X, b.X);
+            dot = _mm256_add_ps(dot, _mm256_mul_ps(a.Y, b.Y));
+            dot = _mm256_add_ps(dot, _mm256_mul_ps(a.Z, b.Z));
+            return _mm256_add_ps(dot, _mm256_mul_ps(a.W, b.W));
+        }
+
+        CSHARP_TARGET("sse2")
+        static Block4 Scale(Block4 const& q, __m128 factor) {
+            return { _mm_mul_ps(q.X, factor), _mm_mul_ps(q.Y, factor), _mm_mul_ps(q.Z, factor), _mm_mul_ps(q.W, factor) };
+        }
+
+        CSHARP_TARGET("avx2")
+        static Block8 Scale(Block8 const& q, __m256 factor) {
+            return { _mm256_mul_ps(q.X, factor), _mm256_mul_ps(q.Y, factor), _mm256_mul_ps(q.Z, factor), _mm256_mul_ps(q.W, factor) };
+        }
+
+        CSHARP_TARGET("sse2")
+        static Block4 Load4(Quaternion const* quaternions) {
+            Block4 q{ _mm_loadu_ps(&quaternions[0].X), _mm_loadu_ps(&quaternions[1].X), _mm_loadu_ps(&quaternions[2].X), _mm_loadu_ps(&quaternions[3].X) };
+            _MM_TRANSPOSE4_PS(q.X, q.Y, q.Z, q.W);
+            return q;
+        }
+
+        CSHARP_TARGET("sse2")
+        static void Store(Block4 q, Quaternion* quaternions) {
+            _MM_TRANSPOSE4_PS(q.X, q.Y, q.Z, q.W);
+            _mm_storeu_ps(&quaternions[0].X, q.X);
+            _mm_storeu_ps(&quaternions[1].X, q.Y);
+            _mm_storeu_ps(&quaternions[2].X, q.Z);
+            _mm_storeu_ps(&quaternions[3].X, q.W);
+        }
+
+        CSHARP_TARGET("avx2")
+        static Block8 Load8(Quaternion const* quaternions) {
+            Block8 q{ _mm256_loadu_ps(&quaternions[0].X), _mm256_loadu_ps(&quaternions[2].X), _mm256_loadu_ps(&quaternions[4].X), _mm256_loadu_ps(&quaternions[6].X) };
+            TransformKernels::Transpose4(q.X, q.Y, q.Z, q.W);
+            return q;
+        }
+
+        CSHARP_TARGET("avx2")
+        static void Store(Block8 q, Quaternion* quaternions) {
+            TransformKernels::Transpose4(q.X, q.Y, q.Z, q.W);
+            _mm256_storeu_ps(&quaternions[0].X, q.X);
+            _mm256_storeu_ps(&quaternions[2].X, q.Y);
+            _mm256_storeu_ps(&quaternions[4].X, q.Z);
+            _mm256_storeu_ps(&quaternions[6].X, q.W);
+        }
+
+        template <Blending Mode>
+        CSHARP_TARGET("sse2")
+        static size_t BlendSse2(Quaternion const* quaternions1, Quaternion const* quaternions2, float amount, Quaternion* destination, size_t count) {
+            const auto one = _mm_set1_ps(1.0f);
+            const auto signMask = _mm_set1_ps(-0.0f);
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4) {
+                const auto q1 = Load4(quaternions1 + i);
+                const auto q2 = Load4(quaternions2 + i);
+
+                const auto dot = Dot(q1, q2);
+                auto t = _mm_set1_ps(amount);
+
+                if constexpr (Mode == Blending::FastSlerp) {
+                    const auto cosine = _mm_andnot_ps(signMask, dot);
+                    const auto h = _mm_sub_ps(t, _mm_set1_ps(0.5f));
+                    auto a = _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(cosine, _mm_set1_ps(1.43519f)));
+                    a = _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(cosine, a));
+                    a = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(cosine, a));
+                    auto b = _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(cosine, _mm_set1_ps(0.215638f)));
+                    b = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(cosine, b));
+                    const auto k = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(a, h), h), b);
+                    t = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, h), _mm_sub_ps(t, one)), k));
+                }
+
+                //num2 * q1 + num1 * q2, with num1 negated when the dot product is negative or NaN.
+                const auto num1 = _mm_xor_ps(t, _mm_andnot_ps(_mm_cmpge_ps(dot, _mm_setzero_ps()), signMask));
+                const auto num2 = _mm_sub_ps(one, t);
+                const Block4 q{
+                    _mm_add_ps(_mm_mul_ps(num2, q1.X), _mm_mul_ps(num1, q2.X)),
+                    _mm_add_ps(_mm_mul_ps(num2, q1.Y), _mm_mul_ps(num1, q2.Y)),
+                    _mm_add_ps(_mm_mul_ps(num2, q1.Z), _mm_mul_ps(num1, q2.Z)),
+                    _mm_add_ps(_mm_mul_ps(num2, q1.W), _mm_mul_ps(num1, q2.W))
+                };
+
+                Store(Scale(q, ReciprocalSqrt(Dot(q, q), Mode != Blending::Lerp)), destination + i);
+            }
+
+            return i;
+        }
+
+        template <Blending Mode>
+        CSHARP_TARGET("avx2")
+        static size_t BlendAvx2(Quaternion const* quaternions1, Quaternion const* quaternions2, float amount, Quaternion* destination, size_t count) {
+            const auto one = _mm256_set1_ps(1.0f);
+            const auto signMask = _mm256_set1_ps(-0.0f);
+            size_t i = 0;
+
+            for (; i + 8 <= count; i += 8) {
+                const auto q1 = Load8(quaternions1 + i);
+                const auto q2 = Load8(quaternions2 + i);
+
+                const auto dot = Dot(q1, q2);
+                auto t = _mm256_set1_ps(amount);
+
+                if constexpr (Mode == Blending::FastSlerp) {
+                    const auto cosine = _mm256_andnot_ps(signMask, dot);
+                    const auto h = _mm256_sub_ps(t, _mm256_set1_ps(0.5f));
+                    auto a = _mm256_sub_ps(_mm256_set1_ps(3.55645f), _mm256_mul_ps(cosine, _mm256_set1_ps(1.43519f)));
+                    a = _mm256_add_ps(_mm256_set1_ps(-3.2452f), _mm256_mul_ps(cosine, a));
+                    a = _mm256_add_ps(_mm256_set1_ps(1.0904f), _mm256_mul_ps(cosine, a));
+                    auto b = _mm256_add_ps(_mm256_set1_ps(-1.06021f), _mm256_mul_ps(cosine, _mm256_set1_ps(0.215638f)));
+                    b = _mm256_add_ps(_mm256_set1_ps(0.848013f), _mm256_mul_ps(cosine, b));
+                    const auto k = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(a, h), h), b);
+                    t = _mm256_add_ps(t, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, h), _mm256_sub_ps(t, one)), k));
+                }
+
+                const auto num1 = _mm256_xor_ps(t, _mm256_andnot_ps(_mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_GE_OQ), signMask));
+                const auto num2 = _mm256_sub_ps(one, t);
+                const Block8 q{
+                    _mm256_add_ps(_mm256_mul_ps(num2, q1.X), _mm256_mul_ps(num1, q2.X)),
+                    _mm256_add_ps(_mm256_mul_ps(num2, q1.Y), _mm256_mul_ps(num1, q2.Y)),
+                    _mm256_add_ps(_mm256_mul_ps(num2, q1.Z), _mm256_mul_ps(num1, q2.Z)),
+                    _mm256_add_ps(_mm256_mul_ps(num2, q1.W), _mm256_mul_ps(num1, q2.W))
+                };
+
+                Store(Scale(q, ReciprocalSqrt(Dot(q, q), Mode != Blending::Lerp)), destination + i);
+            }
+
+            return i;
+        }
+
+        CSHARP_TARGET("sse2")
+        static size_t NormalizeSse2(Quaternion const* source, Quaternion* destination, size_t count) {
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4) {
+                const auto q = Load4(source + i);
+                Store(Scale(q, ReciprocalSqrt(Dot(q, q), false)), destination + i);
+            }
+
+            return i;
+        }
+
+        CSHARP_TARGET("avx2")
+        static size_t NormalizeAvx2(Quaternion const* source, Quaternion* destination, size_t count) {
+            size_t i = 0;
+
+            for (; i + 8 <= count; i += 8) {
+                const auto q = Load8(source + i);
+                Store(Scale(q, ReciprocalSqrt(Dot(q, q), false)), destination + i);
+            }
+
+            return i;
+        }
+
+        CSHARP_TARGET("sse2")
+        static void StoreMatrix(__m128 row1, __m128 row2, __m128 row3, Matrix& matrix) {
+            _mm_store_ps(&matrix.M11, row1);
+            _mm_store_ps(&matrix.M21, row2);
+            _mm_store_ps(&matrix.M31, row3);
+            _mm_store_ps(&matrix.M41, _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+        }
+
+        //Stores the rows of Matrix::Compose: the rotation rows times the scale, which leaves the fourth elements
+        //at +0, and the translation.
+        template <bool Composed>
+        CSHARP_TARGET("sse2")
+        static void StoreMatrix(__m128 row1, __m128 row2, __m128 row3, Vector3 const* scales, Vector3 const* translations, size_t index, Matrix& matrix) {
+            if constexpr (Composed) {
+                const auto& scale = scales[index];
+                const auto& translation = translations[index];
+                _mm_store_ps(&matrix.M11, _mm_mul_ps(row1, _mm_set_ps(1.0f, scale.X, scale.X, scale.X)));
+                _mm_store_ps(&matrix.M21, _mm_mul_ps(row2, _mm_set_ps(1.0f, scale.Y, scale.Y, scale.Y)));
+                _mm_store_ps(&matrix.M31, _mm_mul_ps(row3, _mm_set_ps(1.0f, scale.Z, scale.Z, scale.Z)));
+                _mm_store_ps(&matrix.M41, _mm_set_ps(1.0f, translation.Z, translation.Y, translation.X));
+            }
+            else {
+                StoreMatrix(row1, row2, row3, matrix);
+            }
+        }
+
+        //Rows 1 to 3 of Matrix::CreateFromQuaternion are built one element per register and transposed back to rows;
+        //row 4 is always (0, 0, 0, 1). Compose then scales the rows and sets the translation.
+        template <bool Composed>
+        CSHARP_TARGET("sse2")
+        static size_t CreateMatricesSse2(Vector3 const* scales, Quaternion const* quaternions, Vector3 const* translations, Matrix* destination, size_t count) {
+            const auto one = _mm_set1_ps(1.0f);
+            const auto two = _mm_set1_ps(2.0f);
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4) {
+                const auto q = Load4(quaternions + i);
+
+                const auto num1 = _mm_mul_ps(q.X, q.X);
+                const auto num2 = _mm_mul_ps(q.Y, q.Y);
+                const auto num3 = _mm_mul_ps(q.Z, q.Z);
+                const auto num4 = _mm_mul_ps(q.X, q.Y);
+                const auto num5 = _mm_mul_ps(q.Z, q.W);
+                const auto num6 = _mm_mul_ps(q.Z, q.X);
+                const auto num7 = _mm_mul_ps(q.Y, q.W);
+                const auto num8 = _mm_mul_ps(q.Y, q.Z);
+                const auto num9 = _mm_mul_ps(q.X, q.W);
+
+                auto a0 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(num2, num3)));
+                auto a1 = _mm_mul_ps(two, _mm_add_ps(num4, num5));
+                auto a2 = _mm_mul_ps(two, _mm_sub_ps(num6, num7));
+                auto a3 = _mm_setzero_ps();
+                auto b0 = _mm_mul_ps(two, _mm_sub_ps(num4, num5));
+                auto b1 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(num3, num1)));
+                auto b2 = _mm_mul_ps(two, _mm_add_ps(num8, num9));
+                auto b3 = _mm_setzero_ps();
+                auto c0 = _mm_mul_ps(two, _mm_add_ps(num6, num7));
+                auto c1 = _mm_mul_ps(two, _mm_sub_ps(num8, num9));
+                auto c2 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(num2, num1)));
+                auto c3 = _mm_setzero_ps();
+
+                _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+                _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+                _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+                StoreMatrix<Composed>(a0, b0, c0, scales, translations, i, destination[i]);
+                StoreMatrix<Composed>(a1, b1, c1, scales, translations, i + 1, destination[i + 1]);
+                StoreMatrix<Composed>(a2, b2, c2, scales, translations, i + 2, destination[i + 2]);
+                StoreMatrix<Composed>(a3, b3, c3, scales, translations, i + 3, destination[i + 3]);
+            }
+
+            return i;
+        }
+
+        //Load puts quaternions 2m and 2m + 1 in the low and high lane of register m, so after the transposes
+        //register m holds the rows of those two matrices.
+        template <bool Composed>
+        CSHARP_TARGET("avx2")
+        static void StoreMatrices(__m256 row1, __m256 row2, __m256 row3, Vector3 const* scales, Vector3 const* translations, size_t index, Matrix* destination) {
+            StoreMatrix<Composed>(_mm256_castps256_ps128(row1), _mm256_castps256_ps128(row2), _mm256_castps256_ps128(row3), scales, translations, index, destination[index]);
+            StoreMatrix<Composed>(_mm256_extractf128_ps(row1, 1), _mm256_extractf128_ps(row2, 1), _mm256_extractf128_ps(row3, 1), scales, translations, index + 1, destination[index + 1]);
+        }
+
+        template <bool Composed>
+        CSHARP_TARGET("avx2")
+        static size_t CreateMatricesAvx2(Vector3 const* scales, Quaternion const* quaternions, Vector3 const* translations, Matrix* destination, size_t count) {
+            const auto one = _mm256_set1_ps(1.0f);
+            const auto two = _mm256_set1_ps(2.0f);
+            size_t i = 0;
+
+            for (; i + 8 <= count; i += 8) {
+                const auto q = Load8(quaternions + i);
+
+                const auto num1 = _mm256_mul_ps(q.X, q.X);
+                const auto num2 = _mm256_mul_ps(q.Y, q.Y);
+                const auto num3 = _mm256_mul_ps(q.Z, q.Z);
+                const auto num4 = _mm256_mul_ps(q.X, q.Y);
+                const auto num5 = _mm256_mul_ps(q.Z, q.W);
+                const auto num6 = _mm256_mul_ps(q.Z, q.X);
+                const auto num7 = _mm256_mul_ps(q.Y, q.W);
+                const auto num8 = _mm256_mul_ps(q.Y, q.Z);
+                const auto num9 = _mm256_mul_ps(q.X, q.W);
+
+                auto a0 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(num2, num3)));
+                auto a1 = _mm256_mul_ps(two, _mm256_add_ps(num4, num5));
+                auto a2 = _mm256_mul_ps(two, _mm256_sub_ps(num6, num7));
+                auto a3 = _mm256_setzero_ps();
+                auto b0 = _mm256_mul_ps(two, _mm256_sub_ps(num4, num5));
+                auto b1 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(num3, num1)));
+                auto b2 = _mm256_mul_ps(two, _mm256_add_ps(num8, num9));
+                auto b3 = _mm256_setzero_ps();
+                auto c0 = _mm256_mul_ps(two, _mm256_add_ps(num6, num7));
+                auto c1 = _mm256_mul_ps(two, _mm256_sub_ps(num8, num9));
+                auto c2 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(num2, num1)));
+                auto c3 = _mm256_setzero_ps();
+
+                TransformKernels::Transpose4(a0, a1, a2, a3);
+                TransformKernels::Transpose4(b0, b1, b2, b3);
+                TransformKernels::Transpose4(c0, c1, c2, c3);
+
+                StoreMatrices<Composed>(a0, b0, c0, scales, translations, i, destination);
+                StoreMatrices<Composed>(a1, b1, c1, scales, translations, i + 2, destination);
+                StoreMatrices<Composed>(a2, b2, c2, scales, translations, i + 4, destination);
+                StoreMatrices<Composed>(a3, b3, c3, scales, translations, i + 6, destination);
+            }
+
+            return i;
+        }
+#endif
+    };
+
+    //Decompose kernels. Four matrices (eight with AVX2) are transposed to one register per element and every lane
+    //evaluates the orthonormal case of Matrix::Decompose with the same operations in the same order, the four
+    //branches of Quaternion::CreateFromRotationMatrix being selected with masks. Lanes that are singular or whose rows
+    //are not orthogonal are decomposed again with the scalar code.
+    struct DecomposeKernels {
+        static void Decompose(Matrix const* matrices, Vector3* scales, Quaternion* rotations, Vector3* translations, size_t count) {
+            size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+            if (TransformKernels::UseAvx2)
+                i = DecomposeAvx2(matrices, scales, rotations, translations, count);
+
+            i += DecomposeSse2(matrices + i, scales + i, rotations + i, translations + i, count - i);
+#endif
+            for (; i < count; ++i)
+                matrices[i].Decompose(scales[i], rotations[i], translations[i]);
+        }
+
+#if defined(CSHARP_INTRINSICS_X86)
+        //Results of one block, written per matrix by StoreLanes.
+        template <size_t Count>
+        struct Lanes {
+            alignas(32) float ScaleX[Count];
+            alignas(32) float ScaleY[Count];
+            alignas(32) float ScaleZ[Count];
+            alignas(32) float X[Count];
+            alignas(32) float Y[Count];
+            alignas(32) float Z[Count];
+            alignas(32) float W[Count];
+        };
+
+        template <size_t Count>
+        static void StoreLanes(Lanes<Count> const& lanes, int valid, Matrix const* matrices, Vector3* scales, Quaternion* rotations, Vector3* translations) {
+            for (size_t k = 0; k < Count; ++k) {
+                if (valid & (1 << k)) {
+                    translations[k] = matrices[k].Translation();
+                    scales[k] = Vector3(lanes.ScaleX[k], lanes.ScaleY[k], lanes.ScaleZ[k]);
+                    rotations[k] = Quaternion(lanes.X[k], lanes.Y[k], lanes.Z[k], lanes.W[k]);
+                }
+                else {
+                    matrices[k].Decompose(scales[k], rotations[k], translations[k]);
+                }
+            }
+        }
+
+        CSHARP_TARGET("sse2")
+        static __m128 Select(__m128 mask, __m128 a, __m128 b) {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        CSHARP_TARGET("sse2")
+        static size_t DecomposeSse2(Matrix const* matrices, Vector3* scales, Quaternion* rotations, Vector3* translations, size_t count) {
+            const auto zero = _mm_setzero_ps();
+            const auto one = _mm_set1_ps(1.0f);
+            const auto half = _mm_set1_ps(0.5f);
+            const auto signMask = _mm_set1_ps(-0.0f);
+            const auto epsilon = _mm_set1_ps(Matrix::DecomposeEpsilon);
+            const auto tolerance = _mm_set1_ps(Matrix::OrthogonalTolerance);
+            Lanes<4> lanes;
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4) {
+                auto m11 = _mm_load_ps(&matrices[i].M11);
+                auto m12 = _mm_load_ps(&matrices[i + 1].M11);
+                auto m13 = _mm_load_ps(&matrices[i + 2].M11);
+                auto m14 = _mm_load_ps(&matrices[i + 3].M11);
+                auto m21 = _mm_load_ps(&matrices[i].M21);
+                auto m22 = _mm_load_ps(&matrices[i + 1].M21);
+                auto m23 = _mm_load_ps(&matrices[i + 2].M21);
+                auto m24 = _mm_load_ps(&matrices[i + 3].M21);
+                auto m31 = _mm_load_ps(&matrices[i].M31);
+                auto m32 = _mm_load_ps(&matrices[i + 1].M31);
+                auto m33 = _mm_load_ps(&matrices[i + 2].M31);
+                auto m34 = _mm_load_ps(&matrices[i + 3].M31);
+                _MM_TRANSPOSE4_PS(m11, m12, m13, m14);
+                _MM_TRANSPOSE4_PS(m21, m22, m23, m24);
+                _MM_TRANSPOSE4_PS(m31, m32, m33, m34);
+
+                const auto determinant = _mm_add_ps(_mm_sub_ps(
+                    _mm_mul_ps(m11, _mm_sub_ps(_mm_mul_ps(m22, m33), _mm_mul_ps(m23, m32))),
+                    _mm_mul_ps(m12, _mm_sub_ps(_mm_mul_ps(m21, m33), _mm_mul_ps(m23, m31)))),
+                    _mm_mul_ps(m13, _mm_sub_ps(_mm_mul_ps(m21, m32), _mm_mul_ps(m22, m31))));
+                const auto reflected = _mm_and_ps(_mm_cmplt_ps(determinant, zero), signMask);
+                const auto scaleX = _mm_xor_ps(_mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m11, m11), _mm_mul_ps(m12, m12)), _mm_mul_ps(m13, m13))), reflected);
+                const auto scaleY = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m21, m21), _mm_mul_ps(m22, m22)), _mm_mul_ps(m23, m23)));
+                const auto scaleZ = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m31, m31), _mm_mul_ps(m32, m32)), _mm_mul_ps(m33, m33)));
+                const auto dot12 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m11, m21), _mm_mul_ps(m12, m22)), _mm_mul_ps(m13, m23));
+                const auto dot13 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m11, m31), _mm_mul_ps(m12, m32)), _mm_mul_ps(m13, m33));
+                const auto dot23 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m21, m31), _mm_mul_ps(m22, m32)), _mm_mul_ps(m23, m33));
+
+                auto valid = _mm_cmpgt_ps(_mm_andnot_ps(signMask, determinant), _mm_mul_ps(epsilon, _mm_andnot_ps(signMask, _mm_mul_ps(_mm_mul_ps(scaleX, scaleY), scaleZ))));
+                valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_andnot_ps(signMask, dot12), _mm_mul_ps(tolerance, _mm_andnot_ps(signMask, _mm_mul_ps(scaleX, scaleY)))));
+                valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_andnot_ps(signMask, dot13), _mm_mul_ps(tolerance, _mm_andnot_ps(signMask, _mm_mul_ps(scaleX, scaleZ)))));
+                valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_andnot_ps(signMask, dot23), _mm_mul_ps(tolerance, _mm_andnot_ps(signMask, _mm_mul_ps(scaleY, scaleZ)))));
+
+                const auto inverseX = _mm_div_ps(one, scaleX);
+                const auto inverseY = _mm_div_ps(one, scaleY);
+                const auto inverseZ = _mm_div_ps(one, scaleZ);
+                const auto r11 = _mm_mul_ps(m11, inverseX);
+                const auto r12 = _mm_mul_ps(m12, inverseX);
+                const auto r13 = _mm_mul_ps(m13, inverseX);
+                const auto r21 = _mm_mul_ps(m21, inverseY);
+                const auto r22 = _mm_mul_ps(m22, inverseY);
+                const auto r23 = _mm_mul_ps(m23, inverseY);
+                const auto r31 = _mm_mul_ps(m31, inverseZ);
+                const auto r32 = _mm_mul_ps(m32, inverseZ);
+                const auto r33 = _mm_mul_ps(m33, inverseZ);
+
+                const auto trace = _mm_add_ps(_mm_add_ps(r11, r22), r33);
+                const auto case0 = _mm_cmpgt_ps(trace, zero);
+                const auto case1 = _mm_andnot_ps(case0, _mm_and_ps(_mm_cmpge_ps(r11, r22), _mm_cmpge_ps(r11, r33)));
+                const auto case2 = _mm_andnot_ps(_mm_or_ps(case0, case1), _mm_cmpgt_ps(r22, r33));
+                const auto a = Select(case0, _mm_add_ps(trace, one),
+                    Select(case1, _mm_sub_ps(_mm_sub_ps(_mm_add_ps(one, r11), r22), r33),
+                    Select(case2, _mm_sub_ps(_mm_sub_ps(_mm_add_ps(one, r22), r11), r33), _mm_sub_ps(_mm_sub_ps(_mm_add_ps(one, r33), r11), r22))));
+                const auto root = _mm_sqrt_ps(a);
+                const auto h = _mm_div_ps(half, root);
+                const auto m = _mm_mul_ps(root, half);
+                const auto d1 = _mm_mul_ps(_mm_sub_ps(r23, r32), h);
+                const auto d2 = _mm_mul_ps(_mm_sub_ps(r31, r13), h);
+                const auto d3 = _mm_mul_ps(_mm_sub_ps(r12, r21), h);
+                const auto s1 = _mm_mul_ps(_mm_add_ps(r12, r21), h);
+                const auto s2 = _mm_mul_ps(_mm_add_ps(r13, r31), h);
+                const auto s3 = _mm_mul_ps(_mm_add_ps(r32, r23), h);
+
+                _mm_store_ps(lanes.X, Select(case0, d1, Select(case1, m, Select(case2, s1, s2))));
+                _mm_store_ps(lanes.Y, Select(case0, d2, Select(case1, s1, Select(case2, m, s3))));
+                _mm_store_ps(lanes.Z, Select(case0, d3, Select(case1, s2, Select(case2, s3, m))));
+                _mm_store_ps(lanes.W, Select(case0, m, Select(case1, d1, Select(case2, d2, d3))));
+                _mm_store_ps(lanes.ScaleX, scaleX);
+                _mm_store_ps(lanes.ScaleY, scaleY);
+                _mm_store_ps(lanes.ScaleZ, scaleZ);
+                StoreLanes(lanes, _mm_movemask_ps(valid), matrices + i, scales + i, rotations + i, translations + i);
+            }
+
+            return i;
+        }
+
+        CSHARP_TARGET("avx2")
+        static __m256 Select(__m256 mask, __m256 a, __m256 b) {
+            return _mm256_blendv_ps(b, a, mask);
+        }
+
+        //Matrices k and k + 4 share register k, so after the transposes lane j holds matrix j.
+        CSHARP_TARGET("avx2")
+        static __m256 LoadRows(Matrix const* matrices, size_t row) {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(&matrices[0].M11 + row * 4)), _mm_load_ps(&matrices[4].M11 + row * 4), 1);
+        }
+
+        CSHARP_TARGET("avx2")
+        static size_t DecomposeAvx2(Matrix const* matrices, Vector3* scales, Quaternion* rotations, Vector3* translations, size_t count) {
+            const auto zero = _mm256_setzero_ps();
+            const auto one = _mm256_set1_ps(1.0f);
+            const auto half = _mm256_set1_ps(0.5f);
+            const auto signMask = _mm256_set1_ps(-0.0f);
+            const auto epsilon = _mm256_set1_ps(Matrix::DecomposeEpsilon);
+            const auto tolerance = _mm256_set1_ps(Matrix::OrthogonalTolerance);
+            Lanes<8> lanes;
+            size_t i = 0;
+
+            for (; i + 8 <= count; i += 8) {
+                auto m11 = LoadRows(matrices + i, 0);
+                auto m12 = LoadRows(matrices + i + 1, 0);
+                auto m13 = LoadRows(matrices + i + 2, 0);
+                auto m14 = LoadRows(matrices + i + 3, 0);
+                auto m21 = LoadRows(matrices + i, 1);
+                auto m22 = LoadRows(matrices + i + 1, 1);
+                auto m23 = LoadRows(matrices + i + 2, 1);
+                auto m24 = LoadRows(matrices + i + 3, 1);
+                auto m31 = LoadRows(matrices + i, 2);
+                auto m32 = LoadRows(matrices + i + 1, 2);
+                auto m33 = LoadRows(matrices + i + 2, 2);
+                auto m34 = LoadRows(matrices + i + 3, 2);
+                TransformKernels::Transpose4(m11, m12, m13, m14);
+                TransformKernels::Transpose4(m21, m22, m23, m24);
+                TransformKernels::Transpose4(m31, m32, m33, m34);
+
+                const auto determinant = _mm256_add_ps(_mm256_sub_ps(
+                    _mm256_mul_ps(m11, _mm256_sub_ps(_mm256_mul_ps(m22, m33), _mm256_mul_ps(m23, m32))),
+                    _mm256_mul_ps(m12, _mm256_sub_ps(_mm256_mul_ps(m21, m33), _mm256_mul_ps(m23, m31)))),
+                    _mm256_mul_ps(m13, _mm256_sub_ps(_mm256_mul_ps(m21, m32), _mm256_mul_ps(m22, m31))));
+                const auto reflected = _mm256_and_ps(_mm256_cmp_ps(determinant, zero, _CMP_LT_OQ), signMask);
+                const auto scaleX = _mm256_xor_ps(_mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m11, m11), _mm256_mul_ps(m12, m12)), _mm256_mul_ps(m13, m13))), reflected);
+                const auto scaleY = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m21, m21), _mm256_mul_ps(m22, m22)), _mm256_mul_ps(m23, m23)));
+                const auto scaleZ = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m31, m31), _mm256_mul_ps(m32, m32)), _mm256_mul_ps(m33, m33)));
+                const auto dot12 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m11, m21), _mm256_mul_ps(m12, m22)), _mm256_mul_ps(m13, m23));
+                const auto dot13 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m11, m31), _mm256_mul_ps(m12, m32)), _mm256_mul_ps(m13, m33));
+                const auto dot23 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m21, m31), _mm256_mul_ps(m22, m32)), _mm256_mul_ps(m23, m33));
+
+                auto valid = _mm256_cmp_ps(_mm256_andnot_ps(signMask, determinant), _mm256_mul_ps(epsilon, _mm256_andnot_ps(signMask, _mm256_mul_ps(_mm256_mul_ps(scaleX, scaleY), scaleZ))), _CMP_GT_OQ);
+                valid = _mm256_and_ps(valid, _mm256_cmp_ps(_mm256_andnot_ps(signMask, dot12), _mm256_mul_ps(tolerance, _mm256_andnot_ps(signMask, _mm256_mul_ps(scaleX, scaleY))), _CMP_LE_OQ));
+                valid = _mm256_and_ps(valid, _mm256_cmp_ps(_mm256_andnot_ps(signMask, dot13), _mm256_mul_ps(tolerance, _mm256_andnot_ps(signMask, _mm256_mul_ps(scaleX, scaleZ))), _CMP_LE_OQ));
+                valid = _mm256_and_ps(valid, _mm256_cmp_ps(_mm256_andnot_ps(signMask, dot23), _mm256_mul_ps(tolerance, _mm256_andnot_ps(signMask, _mm256_mul_ps(scaleY, scaleZ))), _CMP_LE_OQ));
+
+                const auto inverseX = _mm256_div_ps(one, scaleX);
+                const auto inverseY = _mm256_div_ps(one, scaleY);
+                const auto inverseZ = _mm256_div_ps(one, scaleZ);
+                const auto r11 = _mm256_mul_ps(m11, inverseX);
+                const auto r12 = _mm256_mul_ps(m12, inverseX);
+                const auto r13 = _mm256_mul_ps(m13, inverseX);
+                const auto r21 = _mm256_mul_ps(m21, inverseY);
+                const auto r22 = _mm256_mul_ps(m22, inverseY);
+                const auto r23 = _mm256_mul_ps(m23, inverseY);
+                const auto r31 = _mm256_mul_ps(m31, inverseZ);
+                const auto r32 = _mm256_mul_ps(m32, inverseZ);
+                const auto r33 = _mm256_mul_ps(m33, inverseZ);
+
+                const auto trace = _mm256_add_ps(_mm256_add_ps(r11, r22), r33);
+                const auto case0 = _mm256_cmp_ps(trace, zero, _CMP_GT_OQ);
+                const auto case1 = _mm256_andnot_ps(case0, _mm256_and_ps(_mm256_cmp_ps(r11, r22, _CMP_GE_OQ), _mm256_cmp_ps(r11, r33, _CMP_GE_OQ)));
+                const auto case2 = _mm256_andnot_ps(_mm256_or_ps(case0, case1), _mm256_cmp_ps(r22, r33, _CMP_GT_OQ));
+                const auto a = Select(case0, _mm256_add_ps(trace, one),
+                    Select(case1, _mm256_sub_ps(_mm256_sub_ps(_mm256_add_ps(one, r11), r22), r33),
+                    Select(case2, _mm256_sub_ps(_mm256_sub_ps(_mm256_add_ps(one, r22), r11), r33), _mm256_sub_ps(_mm256_sub_ps(_mm256_add_ps(one, r33), r11), r22))));
+                const auto root = _mm256_sqrt_ps(a);
+                const auto h = _mm256_div_ps(half, root);
+                const auto m = _mm256_mul_ps(root, half);
+                const auto d1 = _mm256_mul_ps(_mm256_sub_ps(r23, r32), h);
+                const auto d2 = _mm256_mul_ps(_mm256_sub_ps(r31, r13), h);
+                const auto d3 = _mm256_mul_ps(_mm256_sub_ps(r12, r21), h);
+                const auto s1 = _mm256_mul_ps(_mm256_add_ps(r12, r21), h);
+                const auto s2 = _mm256_mul_ps(_mm256_add_ps(r13, r31), h);
+                const auto s3 = _mm256_mul_ps(_mm256_add_ps(r32, r23), h);
+
+                _mm256_store_ps(lanes.X, Select(case0, d1, Select(case1, m, Select(case2, s1, s2))));
+                _mm256_store_ps(lanes.Y, Select(case0, d2, Select(case1, s1, Select(case2, m, s3))));
+                _mm256_store_ps(lanes.Z, Select(case0, d3, Select(case1, s2, Select(case2, s3, m))));
+                _mm256_store_ps(lanes.W, Select(case0, m, Select(case1, d1, Select(case2, d2, d3))));
+                _mm256_store_ps(lanes.ScaleX, scaleX);
+                _mm256_store_ps(lanes.ScaleY, scaleY);
+                _mm256_store_ps(lanes.ScaleZ, scaleZ);
+                StoreLanes(lanes, _mm256_movemask_ps(valid), matrices + i, scales + i, rotations + i, translations + i);
+            }
+
+            return i;
+        }
+#endif
+    };
+
+    bool Matrix::Compose(std::span<const Vector3> scales, std::span<const Quaternion> rotations, std::span<const Vector3> translations, std::span<Matrix> destination) {
+        if (scales.size() != rotations.size() || translations.size() != rotations.size() || destination.size() < rotations.size())
+            return false;
+
+        QuaternionKernels::CreateMatrices<true>(scales.data(), rotations.data(), translations.data(), destination.data(), rotations.size());
+        return true;
+    }
+
+    bool Matrix::Decompose(std::span<const Matrix> matrices, std::span<Vector3> scales, std::span<Quaternion> rotations, std::span<Vector3> translations) {
+        if (scales.size() < matrices.size() || rotations.size() < matrices.size() || translations.size() < matrices.size())
+            return false;
+
+        DecomposeKernels::Decompose(matrices.data(), scales.data(), rotations.data(), translations.data(), matrices.size());
+        return true;
+    }
+
+    bool Matrix::CreateFromQuaternion(std::span<const Quaternion> quaternions, std::span<Matrix> destination) {
+        if (destination.size() < quaternions.size())
+            return false;
+
+        QuaternionKernels::CreateMatrices<false>(nullptr, quaternions.data(), nullptr, destination.data(), quaternions.size());
+        return true;
+    }
+
+    bool Quaternion::Normalize(std::span<const Quaternion> source, std::span<Quaternion> destination) {
+        if (destination.size() < source.size())
+            return false;
+
+        QuaternionKernels::Normalize(source.data(), destination.data(), source.size());
+        return true;
+    }
+
+    bool Quaternion::Slerp(std::span<const Quaternion> quaternions1, std::span<const Quaternion> quaternions2, float amount, std::span<Quaternion> destination) {
+        if (quaternions1.size() != quaternions2.size() || destination.size() < quaternions1.size())
+            return false;
+
+        //acos and sin have no vector form here, so the exact slerp stays scalar; FastMath::Slerp is the vectorized approximation.
+        for (size_t i = 0; i < quaternions1.size(); ++i)
+            destination[i] = Quaternion::Slerp(quaternions1[i], quaternions2[i], amount);
+
+        return true;
+    }
+
+    bool Quaternion::Lerp(std::span<const Quaternion> quaternions1, std::span<const Quaternion> quaternions2, float amount, std::span<Quaternion> destination) {
+        if (quaternions1.size() != quaternions2.size() || destination.size() < quaternions1.size())
+            return false;
+
+        QuaternionKernels::Blend<QuaternionKernels::Blending::Lerp>(quaternions1.data(), quaternions2.data(), amount, destination.data(), quaternions1.size());
+        return true;
+    }
+
+    bool FastMath::Lerp(std::span<const Quaternion> quaternions1, std::span<const Quaternion> quaternions2, float amount, std::span<Quaternion> destination) {
+        if (quaternions1.size() != quaternions2.size() || destination.size() < quaternions1.size())
+            return false;
+
+        QuaternionKernels::Blend<QuaternionKernels::Blending::FastLerp>(quaternions1.data(), quaternions2.data(), amount, destination.data(), quaternions1.size());
+        return true;
+    }
+
+    bool FastMath::Slerp(std::span<const Quaternion> quaternions1, std::span<const Quaternion> quaternions2, float amount, std::span<Quaternion> destination) {
+        if (quaternions1.size() != quaternions2.size() || destination.size() < quaternions1.size())
+            return false;
+
+        QuaternionKernels::Blend<QuaternionKernels::Blending::FastSlerp>(quaternions1.data(), quaternions2.data(), amount, destination.data(), quaternions1.size());
+        return true;
     }
 }
@@ -1,4 +1,5 @@
 #include "xna/common/packedvalue.hpp"
+#include "csharp/runtime/intrinsics.hpp"
 
 namespace xna {
 	uint32_t PackUtils::PackUnsigned(float bitmask, float value) {
@@ -9,7 +10,7 @@ namespace xna {
 		const auto max = static_cast<float>(bitmask >> 1);
 		const auto min = -max - 1.0F;
 
-		return static_cast<uint32_t>(ClampAndRound(value, min, max)) & bitmask;
+		return static_cast<uint32_t>(static_cast<int32_t>(ClampAndRound(value, min, max))) & bitmask;
 	}
 
 	uint32_t PackUtils::PackUNorm(float bitmask, float value) {
@@ -20,14 +21,14 @@ namespace xna {
 	uint32_t PackUtils::PackSNorm(uint32_t bitmask, float value) {
 		const auto max = static_cast<float>(bitmask >> 1);
 		value *= max;
-		return static_cast<uint32_t>(ClampAndRound(value, -max, max)) & bitmask;
+		return static_cast<uint32_t>(static_cast<int32_t>(ClampAndRound(value, -max, max))) & bitmask;
 	}
 
 	double PackUtils::ClampAndRound(float value, float min, float max) {
-		if (isnan(value))
+		if (std::isnan(value))
 			return 0.0;
 
-		if (isinf(value))
+		if (std::isinf(value))
 			return value < 0 ? static_cast<double>(min) : static_cast<double>(max);
 
 		if (value < min)
@@ -35,4 +36,729 @@ namespace xna {
 
 		return value > max ? static_cast<double>(max) : std::round(static_cast<double>(value));
 	}
-}
\ No newline at end of file
+
+	uint16_t HalfUtils::Pack(float value) {
+		const auto bits = std::bit_cast<uint32_t>(value);
+		const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+		const auto magnitude = bits & 0x7FFFFFFF;
+
+		//Above 65504, including infinity and NaN.
+		if (magnitude > 0x477FE000)
+			return static_cast<uint16_t>(sign | (magnitude > 0x7F800000 ? 0x7FFF : 0x7BFF));
+
+		//Below the smallest normal half, 2^-14. Adding 0.5 leaves 2^-24 steps in the mantissa, so the processor
+		//rounds to the nearest half subnormal, ties to even, and the difference is its encoding.
+		if (magnitude < 0x38800000) {
+			const auto rounded = std::bit_cast<uint32_t>(std::bit_cast<float>(magnitude) + 0.5f) - 0x3F000000;
+			return static_cast<uint16_t>(sign | rounded);
+		}
+
+		//Rebiases the exponent from 127 to 15 and rounds the 13 dropped bits to nearest, ties to even.
+		return static_cast<uint16_t>(sign | ((magnitude - 0x38000000 + 0xFFF + ((magnitude >> 13) & 1)) >> 13));
+	}
+
+	HalfVector2::HalfVector2(float x, float y) {
+		_packedValue = static_cast<uint32_t>(HalfUtils::Pack(x)) | static_cast<uint32_t>(HalfUtils::Pack(y)) << 16;
+	}
+
+	HalfVector2::HalfVector2(Vector2 const& vector) : HalfVector2(vector.X, vector.Y) {}
+
+	void HalfVector2::PackFromVector4(Vector4 const& vector) {
+		*this = HalfVector2(vector.X, vector.Y);
+	}
+
+	HalfVector4::HalfVector4(float x, float y, float z, float w) {
+		_packedValue = static_cast<uint64_t>(HalfUtils::Pack(x))
+			| static_cast<uint64_t>(HalfUtils::Pack(y)) << 16
+			| static_cast<uint64_t>(HalfUtils::Pack(z)) << 32
+			| static_cast<uint64_t>(HalfUtils::Pack(w)) << 48;
+	}
+
+	HalfVector4::HalfVector4(Vector4 const& vector) : HalfVector4(vector.X, vector.Y, vector.Z, vector.W) {}
+
+	void HalfVector4::PackFromVector4(Vector4 const& vector) {
+		*this = HalfVector4(vector);
+	}
+
+	NormalizedByte4::NormalizedByte4(float x, float y, float z, float w) {
+		_packedValue = PackUtils::PackSNorm(0xFF, x)
+			| PackUtils::PackSNorm(0xFF, y) << 8
+			| PackUtils::PackSNorm(0xFF, z) << 16
+			| PackUtils::PackSNorm(0xFF, w) << 24;
+	}
+
+	NormalizedByte4::NormalizedByte4(Vector4 const& vector) : NormalizedByte4(vector.X, vector.Y, vector.Z, vector.W) {}
+
+	void NormalizedByte4::PackFromVector4(Vector4 const& vector) {
+		*this = NormalizedByte4(vector);
+	}
+
+	NormalizedShort2::NormalizedShort2(float x, float y) {
+		_packedValue = PackUtils::PackSNorm(0xFFFF, x) | PackUtils::PackSNorm(0xFFFF, y) << 16;
+	}
+
+	NormalizedShort2::NormalizedShort2(Vector2 const& vector) : NormalizedShort2(vector.X, vector.Y) {}
+
+	void NormalizedShort2::PackFromVector4(Vector4 const& vector) {
+		*this = NormalizedShort2(vector.X, vector.Y);
+	}
+
+	NormalizedShort4::NormalizedShort4(float x, float y, float z, float w) {
+		_packedValue = static_cast<uint64_t>(PackUtils::PackSNorm(0xFFFF, x))
+			| static_cast<uint64_t>(PackUtils::PackSNorm(0xFFFF, y)) << 16
+			| static_cast<uint64_t>(PackUtils::PackSNorm(0xFFFF, z)) << 32
+			| static_cast<uint64_t>(PackUtils::PackSNorm(0xFFFF, w)) << 48;
+	}
+
+	NormalizedShort4::NormalizedShort4(Vector4 const& vector) : NormalizedShort4(vector.X, vector.Y, vector.Z, vector.W) {}
+
+	void NormalizedShort4::PackFromVector4(Vector4 const& vector) {
+		*this = NormalizedShort4(vector);
+	}
+
+	Short4::Short4(float x, float y, float z, float w) {
+		_packedValue = static_cast<uint64_t>(PackUtils::PackSigned(0xFFFF, x))
+			| static_cast<uint64_t>(PackUtils::PackSigned(0xFFFF, y)) << 16
+			| static_cast<uint64_t>(PackUtils::PackSigned(0xFFFF, z)) << 32
+			| static_cast<uint64_t>(PackUtils::PackSigned(0xFFFF, w)) << 48;
+	}
+
+	Short4::Short4(Vector4 const& vector) : Short4(vector.X, vector.Y, vector.Z, vector.W) {}
+
+	void Short4::PackFromVector4(Vector4 const& vector) {
+		*this = Short4(vector);
+	}
+
+	Bgra5551::Bgra5551(float x, float y, float z, float w) {
+		_packedValue = static_cast<uint16_t>(PackUtils::PackUNorm(31.0f, x) << 10
+			| PackUtils::PackUNorm(31.0f, y) << 5
+			| PackUtils::PackUNorm(31.0f, z)
+			| PackUtils::PackUNorm(1.0f, w) << 15);
+	}
+
+	Bgra5551::Bgra5551(Vector4 const& vector) : Bgra5551(vector.X, vector.Y, vector.Z, vector.W) {}
+
+	void Bgra5551::PackFromVector4(Vector4 const& vector) {
+		*this = Bgra5551(vector);
+	}
+
+	Bgr565::Bgr565(float x, float y, float z) {
+		_packedValue = static_cast<uint16_t>(PackUtils::PackUNorm(31.0f, x) << 11
+			| PackUtils::PackUNorm(63.0f, y) << 5
+			| PackUtils::PackUNorm(31.0f, z));
+	}
+
+	Bgr565::Bgr565(Vector3 const& vector) : Bgr565(vector.X, vector.Y, vector.Z) {}
+
+	void Bgr565::PackFromVector4(Vector4 const& vector) {
+		*this = Bgr565(vector.X, vector.Y, vector.Z);
+	}
+
+	Rgba1010102::Rgba1010102(float x, float y, float z, float w) {
+		_packedValue = PackUtils::PackUNorm(1023.0f, x)
+			| PackUtils::PackUNorm(1023.0f, y) << 10
+			| PackUtils::PackUNorm(1023.0f, z) << 20
+			| PackUtils::PackUNorm(3.0f, w) << 30;
+	}
+
+	Rgba1010102::Rgba1010102(Vector4 const& vector) : Rgba1010102(vector.X, vector.Y, vector.Z, vector.W) {}
+
+	void Rgba1010102::PackFromVector4(Vector4 const& vector) {
+		*this = Rgba1010102(vector);
+	}
+
+	//Bulk conversion kernels. Half floats use F16C. The signed formats pack every component the same way, so they
+	//convert a stream of floats to a stream of 8 or 16-bit integers with SSE2. The bit field formats shift every
+	//component into place with AVX2. Each kernel returns how many floats or vectors it processed and leaves the tail
+	//to the single vector functions.
+	struct PackedKernels {
+		//Unsigned normalized bit fields of a packed format: the mask of every component before shifting, and its shift.
+		struct Fields {
+			int32_t Mask[4];
+			int32_t Shift[4];
+		};
+
+		static constexpr Fields Bgra5551Fields{ { 0x1F, 0x1F, 0x1F, 0x01 }, { 10, 5, 0, 15 } };
+		static constexpr Fields Bgr565Fields{ { 0x1F, 0x3F, 0x1F, 0 }, { 11, 5, 0, 0 } };
+		static constexpr Fields Rgba1010102Fields{ { 0x3FF, 0x3FF, 0x3FF, 0x03 }, { 0, 10, 20, 30 } };
+
+#if defined(CSHARP_INTRINSICS_X86)
+		inline static const bool UseF16c = csharp::X86Intrinsics::IsF16cSupported();
+		inline static const bool UseAvx2 = csharp::X86Intrinsics::IsAvx2Supported();
+
+		//vcvtps2ph rounds like HalfUtils::Pack but turns overflow into infinity, so those lanes are clamped to 65504,
+		//and NaN lanes are replaced by 0x7FFF.
+		CSHARP_TARGET("avx,f16c")
+		static size_t ToHalfF16c(float const* source, uint16_t* destination, size_t count) {
+			const auto sign = _mm_set1_epi16(static_cast<short>(0x8000));
+			const auto maximum = _mm_set1_epi16(0x7BFF);
+			const auto infinity = _mm_set1_epi16(0x7C00);
+			const auto quiet = _mm_set1_epi16(0x0400);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				const auto half = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+				const auto magnitude = _mm_andnot_si128(sign, half);
+				const auto overflow = _mm_cmpgt_epi16(magnitude, maximum);
+				const auto nan = _mm_cmpgt_epi16(magnitude, infinity);
+				const auto clamped = _mm_or_si128(_mm_and_si128(half, sign), _mm_or_si128(maximum, _mm_and_si128(nan, quiet)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_or_si128(_mm_andnot_si128(overflow, half), _mm_and_si128(overflow, clamped)));
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx,f16c")
+		static size_t FromHalfF16c(uint16_t const* source, float* destination, size_t count) {
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8)
+				_mm256_storeu_ps(destination + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i))));
+
+			return i;
+		}
+
+		//Same steps as PackUtils::ClampAndRound: NaN becomes 0, then the value is clamped and rounded half away from zero.
+		CSHARP_TARGET("sse2")
+		static __m128i ClampAndRound(__m128 value, __m128 minimum, __m128 maximum) {
+			value = _mm_and_ps(value, _mm_cmpord_ps(value, value));
+			value = _mm_min_ps(_mm_max_ps(value, minimum), maximum);
+			const auto truncated = _mm_cvttps_epi32(value);
+			const auto fraction = _mm_sub_ps(value, _mm_cvtepi32_ps(truncated));
+			const auto up = _mm_castps_si128(_mm_cmpge_ps(fraction, _mm_set1_ps(0.5f)));
+			const auto down = _mm_castps_si128(_mm_cmple_ps(fraction, _mm_set1_ps(-0.5f)));
+			return _mm_add_epi32(_mm_sub_epi32(truncated, up), down);
+		}
+
+		CSHARP_TARGET("avx2")
+		static __m256i ClampAndRound(__m256 value, __m256 minimum, __m256 maximum) {
+			value = _mm256_and_ps(value, _mm256_cmp_ps(value, value, _CMP_ORD_Q));
+			value = _mm256_min_ps(_mm256_max_ps(value, minimum), maximum);
+			const auto truncated = _mm256_cvttps_epi32(value);
+			const auto fraction = _mm256_sub_ps(value, _mm256_cvtepi32_ps(truncated));
+			const auto up = _mm256_castps_si256(_mm256_cmp_ps(fraction, _mm256_set1_ps(0.5f), _CMP_GE_OQ));
+			const auto down = _mm256_castps_si256(_mm256_cmp_ps(fraction, _mm256_set1_ps(-0.5f), _CMP_LE_OQ));
+			return _mm256_add_epi32(_mm256_sub_epi32(truncated, up), down);
+		}
+
+		//PackSNorm(0xFFFF) with maximum 32767, and PackSigned(0xFFFF) with scale 1, minimum -32768 and maximum 32767.
+		CSHARP_TARGET("sse2")
+		static size_t PackShortsSse2(float const* source, int16_t* destination, size_t count, float scale, float minimum, float maximum) {
+			const auto s = _mm_set1_ps(scale);
+			const auto low = _mm_set1_ps(minimum);
+			const auto high = _mm_set1_ps(maximum);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				const auto a = ClampAndRound(_mm_mul_ps(_mm_loadu_ps(source + i), s), low, high);
+				const auto b = ClampAndRound(_mm_mul_ps(_mm_loadu_ps(source + i + 4), s), low, high);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packs_epi32(a, b));
+			}
+
+			return i;
+		}
+
+		//PackSNorm(0xFF).
+		CSHARP_TARGET("sse2")
+		static size_t PackSBytesSse2(float const* source, int8_t* destination, size_t count) {
+			const auto s = _mm_set1_ps(127.0f);
+			const auto low = _mm_set1_ps(-127.0f);
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				const auto a = ClampAndRound(_mm_mul_ps(_mm_loadu_ps(source + i), s), low, s);
+				const auto b = ClampAndRound(_mm_mul_ps(_mm_loadu_ps(source + i + 4), s), low, s);
+				const auto c = ClampAndRound(_mm_mul_ps(_mm_loadu_ps(source + i + 8), s), low, s);
+				const auto d = ClampAndRound(_mm_mul_ps(_mm_loadu_ps(source + i + 12), s), low, s);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+			}
+
+			return i;
+		}
+
+		//UnpackSNorm(0xFFFF) when Normalized, where -32768 maps to -1 like -32767, and a plain conversion otherwise.
+		template <bool Normalized>
+		CSHARP_TARGET("sse2")
+		static size_t UnpackShortsSse2(int16_t const* source, float* destination, size_t count) {
+			const auto divisor = _mm_set1_ps(32767.0f);
+			const auto minusOne = _mm_set1_ps(-1.0f);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				const auto x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i));
+				auto a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+				auto b = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+
+				if constexpr (Normalized) {
+					a = _mm_max_ps(_mm_div_ps(a, divisor), minusOne);
+					b = _mm_max_ps(_mm_div_ps(b, divisor), minusOne);
+				}
+
+				_mm_storeu_ps(destination + i, a);
+				_mm_storeu_ps(destination + i + 4, b);
+			}
+
+			return i;
+		}
+
+		//UnpackSNorm(0xFF), where -128 maps to -1 like -127.
+		CSHARP_TARGET("sse2")
+		static size_t UnpackSBytesSse2(int8_t const* source, float* destination, size_t count) {
+			const auto divisor = _mm_set1_ps(127.0f);
+			const auto minusOne = _mm_set1_ps(-1.0f);
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				const auto x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i));
+				const auto low = _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8);
+				const auto high = _mm_srai_epi16(_mm_unpackhi_epi8(x, x), 8);
+				const __m128i words[4] = {
+					_mm_srai_epi32(_mm_unpacklo_epi16(low, low), 16),
+					_mm_srai_epi32(_mm_unpackhi_epi16(low, low), 16),
+					_mm_srai_epi32(_mm_unpacklo_epi16(high, high), 16),
+					_mm_srai_epi32(_mm_unpackhi_epi16(high, high), 16) };
+
+				for (size_t k = 0; k < 4; ++k)
+					_mm_storeu_ps(destination + i + k * 4, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(words[k]), divisor), minusOne));
+			}
+
+			return i;
+		}
+
+		//Loads two vectors of Stride floats into one register. With Stride 3 the fourth lane belongs to the next vector
+		//and is ignored through a zero mask.
+		template <size_t Stride>
+		CSHARP_TARGET("avx2")
+		static __m256 LoadPair(float const* source) {
+			if constexpr (Stride == 4)
+				return _mm256_loadu_ps(source);
+			else
+				return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(source)), _mm_loadu_ps(source + Stride), 1);
+		}
+
+		//Packs 8 vectors at a time. The shifted fields have no bits in common, so the horizontal adds act as ors,
+		//and leave vectors 0, 2, 4, 6 in the low lane and 1, 3, 5, 7 in the high lane.
+		template <size_t Stride, typename T>
+		CSHARP_TARGET("avx2")
+		static size_t PackFieldsAvx2(float const* source, T* destination, size_t count, Fields const& fields) {
+			const auto mask = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(fields.Mask)));
+			const auto shift = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(fields.Shift)));
+			const auto scale = _mm256_cvtepi32_ps(mask);
+			const auto zero = _mm256_setzero_ps();
+			const auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+			//A Vector3 load reads one float past the vector, so the last vector is left to the scalar loop.
+			const auto end = Stride == 4 ? count : (count > 0 ? count - 1 : 0);
+			size_t i = 0;
+
+			for (; i + 8 <= end; i += 8) {
+				const auto p = source + i * Stride;
+				const auto a = _mm256_sllv_epi32(ClampAndRound(_mm256_mul_ps(LoadPair<Stride>(p), scale), zero, scale), shift);
+				const auto b = _mm256_sllv_epi32(ClampAndRound(_mm256_mul_ps(LoadPair<Stride>(p + Stride * 2), scale), zero, scale), shift);
+				const auto c = _mm256_sllv_epi32(ClampAndRound(_mm256_mul_ps(LoadPair<Stride>(p + Stride * 4), scale), zero, scale), shift);
+				const auto d = _mm256_sllv_epi32(ClampAndRound(_mm256_mul_ps(LoadPair<Stride>(p + Stride * 6), scale), zero, scale), shift);
+				const auto packed = _mm256_permutevar8x32_epi32(_mm256_hadd_epi32(_mm256_hadd_epi32(a, b), _mm256_hadd_epi32(c, d)), order);
+
+				if constexpr (sizeof(T) == 4) {
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), packed);
+				}
+				else {
+					const auto words = _mm_packus_epi32(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), words);
+				}
+			}
+
+			return i;
+		}
+
+		//Unpacks 4 values at a time, two per register, each broadcast to the four lanes of its vector.
+		template <size_t Stride, typename T>
+		CSHARP_TARGET("avx2")
+		static size_t UnpackFieldsAvx2(T const* source, float* destination, size_t count, Fields const& fields) {
+			const auto mask = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(fields.Mask)));
+			const auto shift = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(fields.Shift)));
+			//Unused lanes have a zero mask; dividing them by 1 keeps NaN out of the stores.
+			const auto divisor = _mm256_max_ps(_mm256_cvtepi32_ps(mask), _mm256_set1_ps(1.0f));
+			const auto first = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+			const auto second = _mm256_setr_epi32(2, 2, 2, 2, 3, 3, 3, 3);
+			//A Vector3 store writes one float past the vector, so the last vector is left to the scalar loop.
+			const auto end = Stride == 4 ? count : (count > 0 ? count - 1 : 0);
+			size_t i = 0;
+
+			for (; i + 4 <= end; i += 4) {
+				__m128i values;
+
+				if constexpr (sizeof(T) == 4)
+					values = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i));
+				else
+					values = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(source + i)));
+
+				const auto wide = _mm256_castsi128_si256(values);
+				const auto a = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srlv_epi32(_mm256_permutevar8x32_epi32(wide, first), shift), mask)), divisor);
+				const auto b = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srlv_epi32(_mm256_permutevar8x32_epi32(wide, second), shift), mask)), divisor);
+				const auto p = destination + i * Stride;
+
+				if constexpr (Stride == 4) {
+					_mm256_storeu_ps(p, a);
+					_mm256_storeu_ps(p + 8, b);
+				}
+				else {
+					_mm_storeu_ps(p, _mm256_castps256_ps128(a));
+					_mm_storeu_ps(p + 3, _mm256_extractf128_ps(a, 1));
+					_mm_storeu_ps(p + 6, _mm256_castps256_ps128(b));
+					_mm_storeu_ps(p + 9, _mm256_extractf128_ps(b, 1));
+				}
+			}
+
+			return i;
+		}
+#endif
+
+		//Converts floats to halves, as HalfUtils::Pack.
+		static size_t ToHalf(float const* source, uint16_t* destination, size_t count) {
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseF16c)
+				return ToHalfF16c(source, destination, count);
+#endif
+			return 0;
+		}
+
+		//Converts halves to floats, as HalfUtils::Unpack.
+		static size_t FromHalf(uint16_t const* source, float* destination, size_t count) {
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseF16c)
+				return FromHalfF16c(source, destination, count);
+#endif
+			return 0;
+		}
+
+		static size_t PackShorts(float const* source, int16_t* destination, size_t count, float scale, float minimum, float maximum) {
+#if defined(CSHARP_INTRINSICS_X86)
+			return PackShortsSse2(source, destination, count, scale, minimum, maximum);
+#else
+			return 0;
+#endif
+		}
+
+		template <bool Normalized>
+		static size_t UnpackShorts(int16_t const* source, float* destination, size_t count) {
+#if defined(CSHARP_INTRINSICS_X86)
+			return UnpackShortsSse2<Normalized>(source, destination, count);
+#else
+			return 0;
+#endif
+		}
+
+		static size_t PackSBytes(float const* source, int8_t* destination, size_t count) {
+#if defined(CSHARP_INTRINSICS_X86)
+			return PackSBytesSse2(source, destination, count);
+#else
+			return 0;
+#endif
+		}
+
+		static size_t UnpackSBytes(int8_t const* source, float* destination, size_t count) {
+#if defined(CSHARP_INTRINSICS_X86)
+			return UnpackSBytesSse2(source, destination, count);
+#else
+			return 0;
+#endif
+		}
+
+		template <size_t Stride, typename T>
+		static size_t PackFields(float const* source, T* destination, size_t count, Fields const& fields) {
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx2)
+				return PackFieldsAvx2<Stride>(source, destination, count, fields);
+#endif
+			return 0;
+		}
+
+		template <size_t Stride, typename T>
+		static size_t UnpackFields(T const* source, float* destination, size_t count, Fields const& fields) {
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx2)
+				return UnpackFieldsAvx2<Stride>(source, destination, count, fields);
+#endif
+			return 0;
+		}
+	};
+
+	bool HalfVector2::Pack(std::span<const Vector2> vectors, std::span<uint32_t> destination) {
+		const auto count = vectors.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::ToHalf(reinterpret_cast<float const*>(vectors.data()), reinterpret_cast<uint16_t*>(destination.data()), count * 2) / 2;
+
+		for (; i < count; ++i)
+			destination[i] = HalfVector2(vectors[i]).PackedValue();
+
+		return true;
+	}
+
+	bool HalfVector2::Unpack(std::span<const uint32_t> values, std::span<Vector2> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::FromHalf(reinterpret_cast<uint16_t const*>(values.data()), reinterpret_cast<float*>(destination.data()), count * 2) / 2;
+		HalfVector2 value;
+
+		for (; i < count; ++i) {
+			value.PackedValue(values[i]);
+			destination[i] = value.ToVector2();
+		}
+
+		return true;
+	}
+
+	bool HalfVector4::Pack(std::span<const Vector4> vectors, std::span<uint64_t> destination) {
+		const auto count = vectors.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::ToHalf(reinterpret_cast<float const*>(vectors.data()), reinterpret_cast<uint16_t*>(destination.data()), count * 4) / 4;
+
+		for (; i < count; ++i)
+			destination[i] = HalfVector4(vectors[i]).PackedValue();
+
+		return true;
+	}
+
+	bool HalfVector4::Unpack(std::span<const uint64_t> values, std::span<Vector4> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::FromHalf(reinterpret_cast<uint16_t const*>(values.data()), reinterpret_cast<float*>(destination.data()), count * 4) / 4;
+		HalfVector4 value;
+
+		for (; i < count; ++i) {
+			value.PackedValue(values[i]);
+			destination[i] = value.ToVector4();
+		}
+
+		return true;
+	}
+
+	bool NormalizedByte4::Pack(std::span<const Vector4> vectors, std::span<uint32_t> destination) {
+		const auto count = vectors.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::PackSBytes(reinterpret_cast<float const*>(vectors.data()), reinterpret_cast<int8_t*>(destination.data()), count * 4) / 4;
+
+		for (; i < count; ++i)
+			destination[i] = NormalizedByte4(vectors[i]).PackedValue();
+
+		return true;
+	}
+
+	bool NormalizedByte4::Unpack(std::span<const uint32_t> values, std::span<Vector4> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::UnpackSBytes(reinterpret_cast<int8_t const*>(values.data()), reinterpret_cast<float*>(destination.data()), count * 4) / 4;
+		NormalizedByte4 value;
+
+		for (; i < count; ++i) {
+			value.PackedValue(values[i]);
+			destination[i] = value.ToVector4();
+		}
+
+		return true;
+	}
+
+	bool NormalizedShort2::Pack(std::span<const Vector2> vectors, std::span<uint32_t> destination) {
+		const auto count = vectors.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::PackShorts(reinterpret_cast<float const*>(vectors.data()), reinterpret_cast<int16_t*>(destination.data()), count * 2, 32767.0f, -32767.0f, 32767.0f) / 2;
+
+		for (; i < count; ++i)
+			destination[i] = NormalizedShort2(vectors[i]).PackedValue();
+
+		return true;
+	}
+
+	bool NormalizedShort2::Unpack(std::span<const uint32_t> values, std::span<Vector2> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::UnpackShorts<true>(reinterpret_cast<int16_t const*>(values.data()), reinterpret_cast<float*>(destination.data()), count * 2) / 2;
+		NormalizedShort2 value;
+
+		for (; i < count; ++i) {
+			value.PackedValue(values[i]);
+			destination[i] = value.ToVector2();
+		}
+
+		return true;
+	}
+
+	bool NormalizedShort4::Pack(std::span<const Vector4> vectors, std::span<uint64_t> destination) {
+		const auto count = vectors.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::PackShorts(reinterpret_cast<float const*>(vectors.data()), reinterpret_cast<int16_t*>(destination.data()), count * 4, 32767.0f, -32767.0f, 32767.0f) / 4;
+
+		for (; i < count; ++i)
+			destination[i] = NormalizedShort4(vectors[i]).PackedValue();
+
+		return true;
+	}
+
+	bool NormalizedShort4::Unpack(std::span<const uint64_t> values, std::span<Vector4> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::UnpackShorts<true>(reinterpret_cast<int16_t const*>(values.data()), reinterpret_cast<float*>(destination.data()), count * 4) / 4;
+		NormalizedShort4 value;
+
+		for (; i < count; ++i) {
+			value.PackedValue(values[i]);
+			destination[i] = value.ToVector4();
+		}
+
+		return true;
+	}
+
+	bool Short4::Pack(std::span<const Vector4> vectors, std::span<uint64_t> destination) {
+		const auto count = vectors.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::PackShorts(reinterpret_cast<float const*>(vectors.data()), reinterpret_cast<int16_t*>(destination.data()), count * 4, 1.0f, -32768.0f, 32767.0f) / 4;
+
+		for (; i < count; ++i)
+			destination[i] = Short4(vectors[i]).PackedValue();
+
+		return true;
+	}
+
+	bool Short4::Unpack(std::span<const uint64_t> values, std::span<Vector4> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::UnpackShorts<false>(reinterpret_cast<int16_t const*>(values.data()), reinterpret_cast<float*>(destination.data()), count * 4) / 4;
+		Short4 value;
+
+		for (; i < count; ++i) {
+			value.PackedValue(values[i]);
+			destination[i] = value.ToVector4();
+		}
+
+		return true;
+	}
+
+	bool Bgra5551::Pack(std::span<const Vector4> vectors, std::span<uint16_t> destination) {
+		const auto count = vectors.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::PackFields<4>(reinterpret_cast<float const*>(vectors.data()), destination.data(), count, PackedKernels::Bgra5551Fields);
+
+		for (; i < count; ++i)
+			destination[i] = Bgra5551(vectors[i]).PackedValue();
+
+		return true;
+	}
+
+	bool Bgra5551::Unpack(std::span<const uint16_t> values, std::span<Vector4> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::UnpackFields<4>(values.data(), reinterpret_cast<float*>(destination.data()), count, PackedKernels::Bgra5551Fields);
+		Bgra5551 value;
+
+		for (; i < count; ++i) {
+			value.PackedValue(values[i]);
+			destination[i] = value.ToVector4();
+		}
+
+		return true;
+	}
+
+	bool Bgr565::Pack(std::span<const Vector3> vectors, std::span<uint16_t> destination) {
+		const auto count = vectors.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::PackFields<3>(reinterpret_cast<float const*>(vectors.data()), destination.data(), count, PackedKernels::Bgr565Fields);
+
+		for (; i < count; ++i)
+			destination[i] = Bgr565(vectors[i]).PackedValue();
+
+		return true;
+	}
+
+	bool Bgr565::Unpack(std::span<const uint16_t> values, std::span<Vector3> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::UnpackFields<3>(values.data(), reinterpret_cast<float*>(destination.data()), count, PackedKernels::Bgr565Fields);
+		Bgr565 value;
+
+		for (; i < count; ++i) {
+			value.PackedValue(values[i]);
+			destination[i] = value.ToVector3();
+		}
+
+		return true;
+	}
+
+	bool Rgba1010102::Pack(std::span<const Vector4> vectors, std::span<uint32_t> destination) {
+		const auto count = vectors.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::PackFields<4>(reinterpret_cast<float const*>(vectors.data()), destination.data(), count, PackedKernels::Rgba1010102Fields);
+
+		for (; i < count; ++i)
+			destination[i] = Rgba1010102(vectors[i]).PackedValue();
+
+		return true;
+	}
+
+	bool Rgba1010102::Unpack(std::span<const uint32_t> values, std::span<Vector4> destination) {
+		const auto count = values.size();
+
+		if (destination.size() < count)
+			return false;
+
+		auto i = PackedKernels::UnpackFields<4>(values.data(), reinterpret_cast<float*>(destination.data()), count, PackedKernels::Rgba1010102Fields);
+		Rgba1010102 value;
+
+		for (; i < count; ++i) {
+			value.PackedValue(values[i]);
+			destination[i] = value.ToVector4();
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,670 @@
+#include "xna/common/soa.hpp"
+#include "csharp/runtime/intrinsics.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace xna {
+	//Streams of one VectorSoA, or of a single vector repeated, as seen by the kernels.
+	struct SoAStreams {
+		float const* Source[4]{};
+		float* Destination[4]{};
+	};
+
+	//Kernels over component streams. Each vector kernel returns how many vectors it processed and leaves the tail,
+	//shorter than one register, to the scalar loop. The operations run in the same order as the Vector3 and Vector4
+	//members without fusing multiply and add, so all paths return the same results.
+	struct SoAKernels {
+		template <size_t Components, size_t Terms, bool Translate>
+		static void TransformScalar(SoAStreams const& s, float const (&m)[4][4], size_t first, size_t count) {
+			for (size_t i = first; i < count; ++i) {
+				float in[Components];
+
+				for (size_t k = 0; k < Components; ++k)
+					in[k] = s.Source[k][i];
+
+				for (size_t j = 0; j < Components; ++j) {
+					auto value = in[0] * m[0][j];
+
+					for (size_t k = 1; k < Terms; ++k)
+						value = value + in[k] * m[k][j];
+
+					if constexpr (Translate)
+						value = value + m[3][j];
+
+					s.Destination[j][i] = value;
+				}
+			}
+		}
+
+		template <size_t Components, bool Squared, bool Subtract>
+		static void DotScalar(float const* const* a, float const* const* b, size_t strideB, float* result, size_t first, size_t count) {
+			for (size_t i = first; i < count; ++i) {
+				float value = 0;
+
+				for (size_t k = 0; k < Components; ++k) {
+					const auto x = a[k][i];
+					const auto y = b[k][i * strideB];
+
+					if constexpr (Subtract) {
+						const auto d = x - y;
+						value = k == 0 ? d * d : value + d * d;
+					}
+					else {
+						value = k == 0 ? x * y : value + x * y;
+					}
+				}
+
+				result[i] = Squared ? value : std::sqrt(value);
+			}
+		}
+
+		template <size_t Components>
+		static void NormalizeScalar(SoAStreams const& s, size_t first, size_t count) {
+			for (size_t i = first; i < count; ++i) {
+				float lengthSquared = 0;
+
+				for (size_t k = 0; k < Components; ++k)
+					lengthSquared = k == 0 ? s.Source[k][i] * s.Source[k][i] : lengthSquared + s.Source[k][i] * s.Source[k][i];
+
+				const auto num = 1.0f / std::sqrt(lengthSquared);
+
+				for (size_t k = 0; k < Components; ++k)
+					s.Destination[k][i] = s.Source[k][i] * num;
+			}
+		}
+
+		template <size_t Components>
+		static void LerpScalar(float const* const* a, float const* const* b, float* const* destination, float amount, size_t first, size_t count) {
+			for (size_t k = 0; k < Components; ++k)
+				for (size_t i = first; i < count; ++i)
+					destination[k][i] = a[k][i] + (b[k][i] - a[k][i]) * amount;
+		}
+
+#if defined(CSHARP_INTRINSICS_X86)
+		inline static const bool UseAvx2 = csharp::X86Intrinsics::IsAvx2Supported();
+		inline static const bool UseAvx512 = csharp::X86Intrinsics::IsAvx512Supported();
+
+		template <size_t Components, size_t Terms, bool Translate>
+		CSHARP_TARGET("avx2")
+		static size_t TransformAvx2(SoAStreams const& s, float const (&m)[4][4], size_t count) {
+			__m256 rows[4][4];
+
+			for (size_t k = 0; k < 4; ++k)
+				for (size_t j = 0; j < 4; ++j)
+					rows[k][j] = _mm256_set1_ps(m[k][j]);
+
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				__m256 in[Components];
+
+				for (size_t k = 0; k < Components; ++k)
+					in[k] = _mm256_load_ps(s.Source[k] + i);
+
+				for (size_t j = 0; j < Components; ++j) {
+					auto value = _mm256_mul_ps(in[0], rows[0][j]);
+
+					for (size_t k = 1; k < Terms; ++k)
+						value = _mm256_add_ps(value, _mm256_mul_ps(in[k], rows[k][j]));
+
+					if constexpr (Translate)
+						value = _mm256_add_ps(value, rows[3][j]);
+
+					_mm256_store_ps(s.Destination[j] + i, value);
+				}
+			}
+
+			return i;
+		}
+
+		//The rounding form of add is opaque to the compiler, which would otherwise fuse it with the multiply
+		//because AVX-512 implies FMA.
+		template <size_t Components, size_t Terms, bool Translate>
+		CSHARP_TARGET("avx512f")
+		static size_t TransformAvx512(SoAStreams const& s, float const (&m)[4][4], size_t count) {
+			__m512 rows[4][4];
+
+			for (size_t k = 0; k < 4; ++k)
+				for (size_t j = 0; j < 4; ++j)
+					rows[k][j] = _mm512_set1_ps(m[k][j]);
+
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				__m512 in[Components];
+
+				for (size_t k = 0; k < Components; ++k)
+					in[k] = _mm512_load_ps(s.Source[k] + i);
+
+				for (size_t j = 0; j < Components; ++j) {
+					auto value = _mm512_mul_ps(in[0], rows[0][j]);
+
+					for (size_t k = 1; k < Terms; ++k)
+						value = _mm512_add_round_ps(value, _mm512_mul_ps(in[k], rows[k][j]), _MM_FROUND_CUR_DIRECTION);
+
+					if constexpr (Translate)
+						value = _mm512_add_round_ps(value, rows[3][j], _MM_FROUND_CUR_DIRECTION);
+
+					_mm512_store_ps(s.Destination[j] + i, value);
+				}
+			}
+
+			return i;
+		}
+
+		//b is either streams of the same length (strideB = 1) or a single vector whose components are broadcast (strideB = 0).
+		template <size_t Components, bool Squared, bool Subtract>
+		CSHARP_TARGET("avx2")
+		static size_t DotAvx2(float const* const* a, float const* const* b, size_t strideB, float* result, size_t count) {
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				__m256 value = _mm256_setzero_ps();
+
+				for (size_t k = 0; k < Components; ++k) {
+					const auto x = _mm256_load_ps(a[k] + i);
+					const auto y = strideB ? _mm256_load_ps(b[k] + i) : _mm256_set1_ps(b[k][0]);
+					const auto product = Subtract ? _mm256_mul_ps(_mm256_sub_ps(x, y), _mm256_sub_ps(x, y)) : _mm256_mul_ps(x, y);
+					value = k == 0 ? product : _mm256_add_ps(value, product);
+				}
+
+				_mm256_storeu_ps(result + i, Squared ? value : _mm256_sqrt_ps(value));
+			}
+
+			return i;
+		}
+
+		template <size_t Components, bool Squared, bool Subtract>
+		CSHARP_TARGET("avx512f")
+		static size_t DotAvx512(float const* const* a, float const* const* b, size_t strideB, float* result, size_t count) {
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				__m512 value = _mm512_setzero_ps();
+
+				for (size_t k = 0; k < Components; ++k) {
+					const auto x = _mm512_load_ps(a[k] + i);
+					const auto y = strideB ? _mm512_load_ps(b[k] + i) : _mm512_set1_ps(b[k][0]);
+					const auto product = Subtract ? _mm512_mul_ps(_mm512_sub_ps(x, y), _mm512_sub_ps(x, y)) : _mm512_mul_ps(x, y);
+					value = k == 0 ? product : _mm512_add_round_ps(value, product, _MM_FROUND_CUR_DIRECTION);
+				}
+
+				_mm512_storeu_ps(result + i, Squared ? value : _mm512_sqrt_ps(value));
+			}
+
+			return i;
+		}
+
+		template <size_t Components>
+		CSHARP_TARGET("avx2")
+		static size_t NormalizeAvx2(SoAStreams const& s, size_t count) {
+			const auto one = _mm256_set1_ps(1.0f);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				__m256 in[Components];
+				__m256 lengthSquared = _mm256_setzero_ps();
+
+				for (size_t k = 0; k < Components; ++k) {
+					in[k] = _mm256_load_ps(s.Source[k] + i);
+					lengthSquared = k == 0 ? _mm256_mul_ps(in[k], in[k]) : _mm256_add_ps(lengthSquared, _mm256_mul_ps(in[k], in[k]));
+				}
+
+				const auto num = _mm256_div_ps(one, _mm256_sqrt_ps(lengthSquared));
+
+				for (size_t k = 0; k < Components; ++k)
+					_mm256_store_ps(s.Destination[k] + i, _mm256_mul_ps(in[k], num));
+			}
+
+			return i;
+		}
+
+		template <size_t Components>
+		CSHARP_TARGET("avx512f")
+		static size_t NormalizeAvx512(SoAStreams const& s, size_t count) {
+			const auto one = _mm512_set1_ps(1.0f);
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				__m512 in[Components];
+				__m512 lengthSquared = _mm512_setzero_ps();
+
+				for (size_t k = 0; k < Components; ++k) {
+					in[k] = _mm512_load_ps(s.Source[k] + i);
+					lengthSquared = k == 0 ? _mm512_mul_ps(in[k], in[k]) : _mm512_add_round_ps(lengthSquared, _mm512_mul_ps(in[k], in[k]), _MM_FROUND_CUR_DIRECTION);
+				}
+
+				const auto num = _mm512_div_ps(one, _mm512_sqrt_ps(lengthSquared));
+
+				for (size_t k = 0; k < Components; ++k)
+					_mm512_store_ps(s.Destination[k] + i, _mm512_mul_ps(in[k], num));
+			}
+
+			return i;
+		}
+
+		template <size_t Components>
+		CSHARP_TARGET("avx2")
+		static size_t LerpAvx2(float const* const* a, float const* const* b, float* const* destination, float amount, size_t count) {
+			const auto t = _mm256_set1_ps(amount);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				for (size_t k = 0; k < Components; ++k) {
+					const auto x = _mm256_load_ps(a[k] + i);
+					const auto y = _mm256_load_ps(b[k] + i);
+					_mm256_store_ps(destination[k] + i, _mm256_add_ps(x, _mm256_mul_ps(_mm256_sub_ps(y, x), t)));
+				}
+			}
+
+			return i;
+		}
+
+		template <size_t Components>
+		CSHARP_TARGET("avx512f")
+		static size_t LerpAvx512(float const* const* a, float const* const* b, float* const* destination, float amount, size_t count) {
+			const auto t = _mm512_set1_ps(amount);
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				for (size_t k = 0; k < Components; ++k) {
+					const auto x = _mm512_load_ps(a[k] + i);
+					const auto y = _mm512_load_ps(b[k] + i);
+					_mm512_store_ps(destination[k] + i, _mm512_add_round_ps(x, _mm512_mul_ps(_mm512_sub_ps(y, x), t), _MM_FROUND_CUR_DIRECTION));
+				}
+			}
+
+			return i;
+		}
+
+		//Reduces one stream to its lowest and highest values. min_ps(a, b) returns a < b ? a : b, like Vector3::Min.
+		CSHARP_TARGET("avx2")
+		static size_t MinMaxAvx2(float const* stream, size_t count, float& minimum, float& maximum) {
+			if (count < 8)
+				return 0;
+
+			auto low = _mm256_load_ps(stream);
+			auto high = low;
+			size_t i = 8;
+
+			for (; i + 8 <= count; i += 8) {
+				const auto value = _mm256_load_ps(stream + i);
+				low = _mm256_min_ps(low, value);
+				high = _mm256_max_ps(high, value);
+			}
+
+			alignas(32) float lows[8];
+			alignas(32) float highs[8];
+			_mm256_store_ps(lows, low);
+			_mm256_store_ps(highs, high);
+
+			minimum = lows[0];
+			maximum = highs[0];
+
+			for (size_t l = 1; l < 8; ++l) {
+				minimum = minimum < lows[l] ? minimum : lows[l];
+				maximum = maximum > highs[l] ? maximum : highs[l];
+			}
+
+			return i;
+		}
+
+		CSHARP_TARGET("avx512f")
+		static size_t MinMaxAvx512(float const* stream, size_t count, float& minimum, float& maximum) {
+			if (count < 16)
+				return 0;
+
+			auto low = _mm512_load_ps(stream);
+			auto high = low;
+			size_t i = 16;
+
+			for (; i + 16 <= count; i += 16) {
+				const auto value = _mm512_load_ps(stream + i);
+				low = _mm512_min_ps(low, value);
+				high = _mm512_max_ps(high, value);
+			}
+
+			alignas(64) float lows[16];
+			alignas(64) float highs[16];
+			_mm512_store_ps(lows, low);
+			_mm512_store_ps(highs, high);
+
+			minimum = lows[0];
+			maximum = highs[0];
+
+			for (size_t l = 1; l < 16; ++l) {
+				minimum = minimum < lows[l] ? minimum : lows[l];
+				maximum = maximum > highs[l] ? maximum : highs[l];
+			}
+
+			return i;
+		}
+#endif
+
+		template <size_t Components, size_t Terms, bool Translate>
+		static void Transform(SoAStreams const& s, Matrix const& matrix, size_t count) {
+			const float m[4][4] = {
+				{ matrix.M11, matrix.M12, matrix.M13, matrix.M14 },
+				{ matrix.M21, matrix.M22, matrix.M23, matrix.M24 },
+				{ matrix.M31, matrix.M32, matrix.M33, matrix.M34 },
+				{ matrix.M41, matrix.M42, matrix.M43, matrix.M44 },
+			};
+
+			size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx512)
+				i = TransformAvx512<Components, Terms, Translate>(s, m, count);
+			else if (UseAvx2)
+				i = TransformAvx2<Components, Terms, Translate>(s, m, count);
+#endif
+			TransformScalar<Components, Terms, Translate>(s, m, i, count);
+		}
+
+		template <size_t Components, bool Squared, bool Subtract>
+		static void Dot(float const* const* a, float const* const* b, size_t strideB, float* result, size_t count) {
+			size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx512)
+				i = DotAvx512<Components, Squared, Subtract>(a, b, strideB, result, count);
+			else if (UseAvx2)
+				i = DotAvx2<Components, Squared, Subtract>(a, b, strideB, result, count);
+#endif
+			DotScalar<Components, Squared, Subtract>(a, b, strideB, result, i, count);
+		}
+
+		template <size_t Components>
+		static void Normalize(SoAStreams const& s, size_t count) {
+			size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx512)
+				i = NormalizeAvx512<Components>(s, count);
+			else if (UseAvx2)
+				i = NormalizeAvx2<Components>(s, count);
+#endif
+			NormalizeScalar<Components>(s, i, count);
+		}
+
+		template <size_t Components>
+		static void Lerp(float const* const* a, float const* const* b, float* const* destination, float amount, size_t count) {
+			size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx512)
+				i = LerpAvx512<Components>(a, b, destination, amount, count);
+			else if (UseAvx2)
+				i = LerpAvx2<Components>(a, b, destination, amount, count);
+#endif
+			LerpScalar<Components>(a, b, destination, amount, i, count);
+		}
+
+		static void MinMax(float const* stream, size_t count, float& minimum, float& maximum) {
+			size_t i = 0;
+
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx512)
+				i = MinMaxAvx512(stream, count, minimum, maximum);
+			else if (UseAvx2)
+				i = MinMaxAvx2(stream, count, minimum, maximum);
+#endif
+			if (i == 0) {
+				minimum = stream[0];
+				maximum = stream[0];
+				i = 1;
+			}
+
+			for (; i < count; ++i) {
+				minimum = minimum < stream[i] ? minimum : stream[i];
+				maximum = maximum > stream[i] ? maximum : stream[i];
+			}
+		}
+	};
+
+
+	template <typename T>
+	static void SourcesOf(VectorSoA<T> const& value, float const* (&streams)[4]) {
+		for (size_t k = 0; k < VectorSoA<T>::Components; ++k)
+			streams[k] = value.Stream(k);
+	}
+
+	template <typename T>
+	static SoAStreams StreamsOf(VectorSoA<T> const& source, VectorSoA<T>& destination) {
+		SoAStreams s;
+		SourcesOf(source, s.Source);
+
+		for (size_t k = 0; k < VectorSoA<T>::Components; ++k)
+			s.Destination[k] = destination.Stream(k);
+
+		return s;
+	}
+
+	template <typename T>
+	static std::array<float, 4> ComponentsOf(T const& value) {
+		if constexpr (VectorSoA<T>::Components == 4)
+			return { value.X, value.Y, value.Z, value.W };
+		else
+			return { value.X, value.Y, value.Z, 0.0f };
+	}
+
+	template <typename T>
+	void VectorSoA<T>::Reserve(size_t minimumCount) {
+		const auto newCapacity = (minimumCount + LaneCount - 1) / LaneCount * LaneCount;
+
+		if (newCapacity <= capacity)
+			return;
+
+		std::vector<float, csharp::AlignedAllocator<float, Alignment>> newData(newCapacity * Components);
+
+		for (size_t k = 0; k < Components; ++k)
+			std::copy_n(Stream(k), count, newData.data() + k * newCapacity);
+
+		data.swap(newData);
+		capacity = newCapacity;
+	}
+
+	template <typename T>
+	void VectorSoA<T>::Resize(size_t newCount) {
+		Reserve(newCount);
+
+		if (newCount > count) {
+			for (size_t k = 0; k < Components; ++k)
+				std::fill_n(Stream(k) + count, newCount - count, 0.0f);
+		}
+
+		count = newCount;
+	}
+
+	template <typename T>
+	void VectorSoA<T>::Add(T const& value) {
+		if (count == capacity)
+			Reserve(capacity == 0 ? LaneCount : capacity * 2);
+
+		Set(count++, value);
+	}
+
+	template <typename T>
+	T VectorSoA<T>::Get(size_t index) const {
+		if constexpr (Components == 4)
+			return T(X()[index], Y()[index], Z()[index], W()[index]);
+		else
+			return T(X()[index], Y()[index], Z()[index]);
+	}
+
+	template <typename T>
+	void VectorSoA<T>::Set(size_t index, T const& value) {
+		const auto components = ComponentsOf(value);
+
+		for (size_t k = 0; k < Components; ++k)
+			Stream(k)[index] = components[k];
+	}
+
+	template <typename T>
+	void VectorSoA<T>::CopyFrom(T const* values, size_t valueCount) {
+		count = 0;
+		Reserve(valueCount);
+		count = valueCount;
+
+		for (size_t i = 0; i < valueCount; ++i) {
+			const auto components = ComponentsOf(values[i]);
+
+			for (size_t k = 0; k < Components; ++k)
+				Stream(k)[i] = components[k];
+		}
+	}
+
+	template <typename T>
+	bool VectorSoA<T>::CopyTo(T* destinationArray, size_t destinationLength) const {
+		if (!destinationArray || destinationLength < count)
+			return false;
+
+		for (size_t i = 0; i < count; ++i)
+			destinationArray[i] = Get(i);
+
+		return true;
+	}
+
+	template <typename T>
+	std::vector<T> VectorSoA<T>::ToArray() const {
+		std::vector<T> array(count);
+		CopyTo(array.data(), array.size());
+		return array;
+	}
+
+	template <typename T>
+	T VectorSoA<T>::Min() const {
+		if (count == 0)
+			return T();
+
+		float minimum[4]{};
+		float maximum[4]{};
+
+		for (size_t k = 0; k < Components; ++k)
+			SoAKernels::MinMax(Stream(k), count, minimum[k], maximum[k]);
+
+		if constexpr (Components == 4)
+			return T(minimum[0], minimum[1], minimum[2], minimum[3]);
+		else
+			return T(minimum[0], minimum[1], minimum[2]);
+	}
+
+	template <typename T>
+	T VectorSoA<T>::Max() const {
+		if (count == 0)
+			return T();
+
+		float minimum[4]{};
+		float maximum[4]{};
+
+		for (size_t k = 0; k < Components; ++k)
+			SoAKernels::MinMax(Stream(k), count, minimum[k], maximum[k]);
+
+		if constexpr (Components == 4)
+			return T(maximum[0], maximum[1], maximum[2], maximum[3]);
+		else
+			return T(maximum[0], maximum[1], maximum[2]);
+	}
+
+	template <typename T>
+	void VectorSoA<T>::Transform(VectorSoA const& source, Matrix const& matrix, VectorSoA& destination) {
+		destination.Resize(source.count);
+
+		if constexpr (Components == 4)
+			SoAKernels::Transform<4, 4, false>(StreamsOf(source, destination), matrix, source.count);
+		else
+			SoAKernels::Transform<3, 3, true>(StreamsOf(source, destination), matrix, source.count);
+	}
+
+	template <typename T>
+	void VectorSoA<T>::TransformNormal(VectorSoA const& source, Matrix const& matrix, VectorSoA& destination) requires (Components == 3) {
+		destination.Resize(source.count);
+		SoAKernels::Transform<3, 3, false>(StreamsOf(source, destination), matrix, source.count);
+	}
+
+	//Runs a dot-product style kernel over two containers of the same length.
+	template <typename T, bool Squared, bool Subtract>
+	static bool PairwiseDot(VectorSoA<T> const& value1, VectorSoA<T> const& value2, float* result) {
+		if (!result || value1.Count() != value2.Count())
+			return false;
+
+		float const* a[4]{};
+		float const* b[4]{};
+		SourcesOf(value1, a);
+		SourcesOf(value2, b);
+
+		SoAKernels::Dot<VectorSoA<T>::Components, Squared, Subtract>(a, b, 1, result, value1.Count());
+		return true;
+	}
+
+	//Runs a dot-product style kernel over a container and a single vector.
+	template <typename T, bool Squared, bool Subtract>
+	static void BroadcastDot(VectorSoA<T> const& value1, T const& value2, float* result) {
+		const auto components = ComponentsOf(value2);
+		float const* a[4]{};
+		float const* b[4] = { &components[0], &components[1], &components[2], &components[3] };
+		SourcesOf(value1, a);
+
+		SoAKernels::Dot<VectorSoA<T>::Components, Squared, Subtract>(a, b, 0, result, value1.Count());
+	}
+
+	template <typename T>
+	bool VectorSoA<T>::Dot(VectorSoA const& value1, VectorSoA const& value2, float* result) {
+		return PairwiseDot<T, true, false>(value1, value2, result);
+	}
+
+	template <typename T>
+	void VectorSoA<T>::Dot(VectorSoA const& value1, T const& value2, float* result) {
+		BroadcastDot<T, true, false>(value1, value2, result);
+	}
+
+	template <typename T>
+	void VectorSoA<T>::Normalize(VectorSoA const& source, VectorSoA& destination) {
+		destination.Resize(source.count);
+		SoAKernels::Normalize<Components>(StreamsOf(source, destination), source.count);
+	}
+
+	template <typename T>
+	bool VectorSoA<T>::Lerp(VectorSoA const& value1, VectorSoA const& value2, float amount, VectorSoA& destination) {
+		if (value1.count != value2.count)
+			return false;
+
+		destination.Resize(value1.count);
+
+		float const* a[4]{};
+		float const* b[4]{};
+		float* d[4]{};
+		SourcesOf(value1, a);
+		SourcesOf(value2, b);
+
+		for (size_t k = 0; k < Components; ++k)
+			d[k] = destination.Stream(k);
+
+		SoAKernels::Lerp<Components>(a, b, d, amount, value1.count);
+		return true;
+	}
+
+	template <typename T>
+	bool VectorSoA<T>::Distance(VectorSoA const& value1, VectorSoA const& value2, float* result) {
+		return PairwiseDot<T, false, true>(value1, value2, result);
+	}
+
+	template <typename T>
+	void VectorSoA<T>::Distance(VectorSoA const& value1, T const& value2, float* result) {
+		BroadcastDot<T, false, true>(value1, value2, result);
+	}
+
+	template <typename T>
+	bool VectorSoA<T>::DistanceSquared(VectorSoA const& value1, VectorSoA const& value2, float* result) {
+		return PairwiseDot<T, true, true>(value1, value2, result);
+	}
+
+	template <typename T>
+	void VectorSoA<T>::DistanceSquared(VectorSoA const& value1, T const& value2, float* result) {
+		BroadcastDot<T, true, true>(value1, value2, result);
+	}
+
+	template class VectorSoA<Vector3>;
+	template class VectorSoA<Vector4>;
+}
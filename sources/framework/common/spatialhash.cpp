@@ -0,0 +1,292 @@
+#include "xna/common/spatialhash.hpp"
+#include <stdexcept>
+
+namespace xna {
+	SpatialHash::SpatialHash(int32_t cellSize) : cellSize(cellSize) {
+		if (cellSize <= 0)
+			throw std::invalid_argument("SpatialHash: cellSize must be greater than 0.");
+	}
+
+	void SpatialHash::Clear() {
+		proxies.clear();
+		chunks.clear();
+		cells.clear();
+		proxyCount = 0;
+		cellCount = 0;
+		freeProxy = NullProxy;
+		freeChunk = NullIndex;
+	}
+
+	size_t SpatialHash::Add(Rectangle const& bounds, size_t userData) {
+		size_t proxy;
+
+		if (freeProxy == NullProxy) {
+			proxies.emplace_back();
+			proxy = proxies.size() - 1;
+		}
+		else {
+			proxy = freeProxy;
+			freeProxy = proxies[proxy].UserData;
+		}
+
+		auto& value = proxies[proxy];
+		value.Bounds = bounds;
+		value.Cells = CellsOf(bounds);
+		value.UserData = userData;
+
+		Insert(static_cast<uint32_t>(proxy), value.Cells);
+		++proxyCount;
+		return proxy;
+	}
+
+	void SpatialHash::Remove(size_t proxy) {
+		Erase(static_cast<uint32_t>(proxy), proxies[proxy].Cells);
+		proxies[proxy].UserData = freeProxy;
+		freeProxy = proxy;
+		--proxyCount;
+	}
+
+	bool SpatialHash::Move(size_t proxy, Rectangle const& bounds) {
+		auto& value = proxies[proxy];
+		const auto range = CellsOf(bounds);
+		value.Bounds = bounds;
+
+		if (range == value.Cells)
+			return false;
+
+		//Only the cells that are in one range and not in the other change.
+		const auto old = value.Cells;
+		const auto index = static_cast<uint32_t>(proxy);
+
+		for (auto y = old.MinY; ; ++y) {
+			for (auto x = old.MinX; ; ++x) {
+				if (!range.Contains(x, y))
+					EraseFromCell(index, x, y);
+
+				if (x == old.MaxX)
+					break;
+			}
+
+			if (y == old.MaxY)
+				break;
+		}
+
+		for (auto y = range.MinY; ; ++y) {
+			for (auto x = range.MinX; ; ++x) {
+				if (!old.Contains(x, y))
+					InsertInCell(index, x, y);
+
+				if (x == range.MaxX)
+					break;
+			}
+
+			if (y == range.MaxY)
+				break;
+		}
+
+		value.Cells = range;
+		return true;
+	}
+
+	SpatialHash::CellRange SpatialHash::CellsOf(Rectangle const& bounds) const {
+		//Right and Bottom are outside the rectangle, so the last cell is the one of the coordinate before them.
+		const auto right = static_cast<int64_t>(bounds.X) + bounds.Width - 1;
+		const auto bottom = static_cast<int64_t>(bounds.Y) + bounds.Height - 1;
+
+		CellRange range;
+		range.MinX = CellOf(bounds.X);
+		range.MinY = CellOf(bounds.Y);
+		range.MaxX = bounds.Width > 0 ? CellOf(static_cast<int32_t>(right > INT32_MAX ? INT32_MAX : right)) : range.MinX;
+		range.MaxY = bounds.Height > 0 ? CellOf(static_cast<int32_t>(bottom > INT32_MAX ? INT32_MAX : bottom)) : range.MinY;
+		return range;
+	}
+
+	size_t SpatialHash::SlotOf(int32_t x, int32_t y) const {
+		auto key = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+		key ^= key >> 33;
+		key *= 0xFF51AFD7ED558CCDull;
+		key ^= key >> 33;
+		return static_cast<size_t>(key) & (cells.size() - 1);
+	}
+
+	uint32_t SpatialHash::FindCell(int32_t x, int32_t y) const {
+		if (cells.empty())
+			return NullIndex;
+
+		const auto mask = cells.size() - 1;
+
+		for (auto slot = SlotOf(x, y); ; slot = (slot + 1) & mask) {
+			const auto& cell = cells[slot];
+
+			if (cell.Count == UnusedSlot)
+				return NullIndex;
+
+			if (cell.X == x && cell.Y == y)
+				return static_cast<uint32_t>(slot);
+		}
+	}
+
+	uint32_t SpatialHash::FindOrAddCell(int32_t x, int32_t y) {
+		//At most half of the slots are used, so the probes stay short.
+		if ((cellCount + 1) * 2 > cells.size())
+			Grow();
+
+		const auto mask = cells.size() - 1;
+
+		for (auto slot = SlotOf(x, y); ; slot = (slot + 1) & mask) {
+			auto& cell = cells[slot];
+
+			if (cell.Count == UnusedSlot) {
+				cell.X = x;
+				cell.Y = y;
+				cell.Head = NullIndex;
+				cell.Count = 0;
+				++cellCount;
+				return static_cast<uint32_t>(slot);
+			}
+
+			if (cell.X == x && cell.Y == y)
+				return static_cast<uint32_t>(slot);
+		}
+	}
+
+	void SpatialHash::RemoveCell(uint32_t slot) {
+		//Backward shift deletion: the cells after the slot move back when the slot is on their probe path, so no tombstones are left.
+		const auto mask = cells.size() - 1;
+		auto hole = static_cast<size_t>(slot);
+
+		for (auto next = (hole + 1) & mask; cells[next].Count != UnusedSlot; next = (next + 1) & mask) {
+			const auto home = SlotOf(cells[next].X, cells[next].Y);
+			const auto distanceToHole = (hole - home) & mask;
+			const auto distanceToNext = (next - home) & mask;
+
+			if (distanceToHole < distanceToNext) {
+				cells[hole] = cells[next];
+				hole = next;
+			}
+		}
+
+		cells[hole] = Cell();
+		--cellCount;
+	}
+
+	void SpatialHash::Grow() {
+		auto old = std::move(cells);
+		cells.assign(old.empty() ? 64 : old.size() * 2, Cell());
+
+		const auto mask = cells.size() - 1;
+
+		for (const auto& cell : old) {
+			if (cell.Count == UnusedSlot)
+				continue;
+
+			auto slot = SlotOf(cell.X, cell.Y);
+
+			while (cells[slot].Count != UnusedSlot)
+				slot = (slot + 1) & mask;
+
+			cells[slot] = cell;
+		}
+	}
+
+	void SpatialHash::Insert(uint32_t proxy, CellRange const& range) {
+		for (auto y = range.MinY; ; ++y) {
+			for (auto x = range.MinX; ; ++x) {
+				InsertInCell(proxy, x, y);
+
+				if (x == range.MaxX)
+					break;
+			}
+
+			if (y == range.MaxY)
+				break;
+		}
+	}
+
+	void SpatialHash::Erase(uint32_t proxy, CellRange const& range) {
+		for (auto y = range.MinY; ; ++y) {
+			for (auto x = range.MinX; ; ++x) {
+				EraseFromCell(proxy, x, y);
+
+				if (x == range.MaxX)
+					break;
+			}
+
+			if (y == range.MaxY)
+				break;
+		}
+	}
+
+	void SpatialHash::InsertInCell(uint32_t proxy, int32_t x, int32_t y) {
+		auto& cell = cells[FindOrAddCell(x, y)];
+
+		if (cell.Count < LocalCapacity) {
+			cell.Local[cell.Count++] = proxy;
+			return;
+		}
+
+		const auto filled = (cell.Count - LocalCapacity) % ChunkCapacity;
+
+		if (filled == 0) {
+			uint32_t chunk;
+
+			if (freeChunk == NullIndex) {
+				chunks.emplace_back();
+				chunk = static_cast<uint32_t>(chunks.size() - 1);
+			}
+			else {
+				chunk = freeChunk;
+				freeChunk = chunks[chunk].Next;
+			}
+
+			chunks[chunk].Next = cell.Head;
+			cell.Head = chunk;
+		}
+
+		chunks[cell.Head].Proxies[filled] = proxy;
+		++cell.Count;
+	}
+
+	void SpatialHash::EraseFromCell(uint32_t proxy, int32_t x, int32_t y) {
+		const auto slot = FindCell(x, y);
+		auto& cell = cells[slot];
+		const auto headCount = HeadCount(cell);
+
+		//The proxy is replaced by the last one of the cell, which is in the head chunk if there is one.
+		auto& last = headCount == 0 ? cell.Local[cell.Count - 1] : chunks[cell.Head].Proxies[headCount - 1];
+		auto found = false;
+
+		for (uint32_t i = 0; i < LocalCapacity && i < cell.Count; ++i) {
+			if (cell.Local[i] == proxy) {
+				cell.Local[i] = last;
+				found = true;
+				break;
+			}
+		}
+
+		for (auto chunk = cell.Head; !found && chunk != NullIndex; chunk = chunks[chunk].Next) {
+			auto& current = chunks[chunk];
+			const auto filled = chunk == cell.Head ? headCount : ChunkCapacity;
+
+			for (uint32_t i = 0; i < filled; ++i) {
+				if (current.Proxies[i] == proxy) {
+					current.Proxies[i] = last;
+					found = true;
+					break;
+				}
+			}
+		}
+
+		--cell.Count;
+
+		if (headCount == 1) {
+			const auto emptied = cell.Head;
+			cell.Head = chunks[emptied].Next;
+			chunks[emptied].Next = freeChunk;
+			freeChunk = emptied;
+		}
+
+		if (cell.Count == 0)
+			RemoveCell(slot);
+	}
+}
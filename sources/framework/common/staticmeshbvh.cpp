@@ -0,0 +1,1051 @@
+#include "xna/common/staticmeshbvh.hpp"
+#include "csharp/runtime/intrinsics.hpp"
+#include "csharp/threading/parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <memory>
+
+namespace xna {
+	//Build and traversal of StaticMeshBvh.
+	struct MeshBvhKernels {
+		using Node = StaticMeshBvh::Node;
+		using Triangle = StaticMeshBvh::Triangle;
+
+		static constexpr size_t BinCount = StaticMeshBvh::BinCount;
+		static constexpr float Infinity = std::numeric_limits<float>::infinity();
+		//Cost of visiting a node, in triangle tests, for the surface area heuristic.
+		static constexpr float TraversalCost = 1.0F;
+		//Direction components closer to 0 are moved to this, so the inverse stays finite and the slab tests never multiply 0 by infinity.
+		static constexpr float MinimumDirection = 1E-20F;
+		//Triangle of a packet lane that hit nothing yet, in the order of the leaves.
+		static constexpr uint32_t NoIndex = static_cast<uint32_t>(-1);
+
+		static_assert(sizeof(Node) == 32);
+
+		//Box that merges points and boxes, empty until the first one.
+		struct Box {
+			Vector3 Min{ Infinity, Infinity, Infinity };
+			Vector3 Max{ -Infinity, -Infinity, -Infinity };
+
+			void Merge(Vector3 const& point) {
+				Min = Vector3::Min(Min, point);
+				Max = Vector3::Max(Max, point);
+			}
+
+			void Merge(Box const& box) {
+				Min = Vector3::Min(Min, box.Min);
+				Max = Vector3::Max(Max, box.Max);
+			}
+
+			//Half the surface area, 0 for an empty box.
+			float Area() const {
+				if (Min.X > Max.X)
+					return 0;
+
+				const auto x = Max.X - Min.X;
+				const auto y = Max.Y - Min.Y;
+				const auto z = Max.Z - Min.Z;
+				return x * y + y * z + z * x;
+			}
+		};
+
+		struct Bin {
+			Box Bounds;
+			uint32_t Count{ 0 };
+		};
+
+		//Bins along every axis, of which a node uses the first binCount.
+		struct Bins {
+			Bin Values[3][BinCount];
+
+			void Reset(size_t binCount) {
+				for (auto& values : Values)
+					std::fill(values, values + binCount, Bin());
+			}
+
+			void Merge(Bins const& other, size_t binCount) {
+				for (size_t axis = 0; axis < 3; ++axis) {
+					for (size_t i = 0; i < binCount; ++i) {
+						auto& bin = Values[axis][i];
+						bin.Bounds.Merge(other.Values[axis][i].Bounds);
+						bin.Count += other.Values[axis][i].Count;
+					}
+				}
+			}
+		};
+
+		static float Component(Vector3 const& value, size_t axis) {
+			return axis == 0 ? value.X : (axis == 1 ? value.Y : value.Z);
+		}
+
+		//Maps the centroids of a node to Count bins of the same width along every axis.
+		//Nodes with fewer triangles than BinCount use one bin per triangle, since the sweep costs more than the binning for them.
+		struct Binning {
+			size_t Count{ BinCount };
+			float Origin[3]{};
+			float Scale[3]{};
+
+			Binning(Box const& centroids, size_t triangleCount) : Count(std::min(BinCount, triangleCount)) {
+				for (size_t axis = 0; axis < 3; ++axis) {
+					const auto extent = Component(centroids.Max, axis) - Component(centroids.Min, axis);
+					Origin[axis] = Component(centroids.Min, axis);
+					Scale[axis] = extent > 0 ? static_cast<float>(Count) / extent : 0;
+				}
+			}
+
+			size_t BinOf(float value, size_t axis) const {
+				const auto bin = static_cast<size_t>((value - Origin[axis]) * Scale[axis]);
+				return std::min(bin, Count - 1);
+			}
+		};
+
+		//Bounds of a triangle, kept with its index so the partitions move them together and the binning reads them in order.
+		struct Reference {
+			Box Bounds;
+			uint32_t Triangle{ 0 };
+
+			Vector3 Centroid() const { return (Bounds.Min + Bounds.Max) * 0.5F; }
+		};
+
+		//Triangles of the mesh while the tree is built, every node owning a range of them.
+		struct State {
+			std::vector<Reference> References;
+		};
+
+		//Node waiting to be split, with the range of references it owns.
+		struct Task {
+			uint32_t Node{ 0 };
+			uint32_t First{ 0 };
+			uint32_t Count{ 0 };
+			Box Centroids;
+		};
+
+		//Best split plane among the bins, with the bounds of the children. LeftCount is 0 when no plane separates the centroids.
+		//The bounds of the centroids are found by the partition.
+		struct Split {
+			size_t Axis{ 0 };
+			//First bin of the right child.
+			size_t Bin{ 0 };
+			//Areas of the children times their triangle counts.
+			float Cost{ Infinity };
+			uint32_t LeftCount{ 0 };
+			Box LeftBounds;
+			Box LeftCentroids;
+			Box RightBounds;
+			Box RightCentroids;
+		};
+
+		static Vector3 const& PositionOf(VertexPositionNormalTexture const& vertex) { return vertex.Position; }
+		static Vector3 const& PositionOf(Vector3 const& position) { return position; }
+
+		template <typename Vertex, typename Index>
+		static bool Build(StaticMeshBvh& bvh, std::span<const Vertex> vertices, std::span<const Index> indices, size_t threadCount) {
+			bvh.Clear();
+
+			if (indices.size() % 3 != 0 || indices.size() / 3 > (std::numeric_limits<uint32_t>::max)() / 2)
+				return false;
+
+			const auto count = indices.size() / 3;
+
+			if (count == 0)
+				return true;
+
+			threadCount = std::max(threadCount, size_t{ 1 });
+			const auto passThreads = count >= StaticMeshBvh::MinimumParallelCount ? threadCount : 1;
+
+			State state;
+			state.References.resize(count);
+
+			struct RangeBounds {
+				Box Bounds;
+				Box Centroids;
+				bool Valid{ true };
+			};
+
+			std::vector<RangeBounds> ranges(passThreads);
+
+			csharp::Parallel::For(count, passThreads, [&](size_t range, size_t first, size_t rangeCount) {
+				auto& result = ranges[range];
+
+				for (auto i = first; i < first + rangeCount; ++i) {
+					const auto index0 = static_cast<size_t>(indices[i * 3]);
+					const auto index1 = static_cast<size_t>(indices[i * 3 + 1]);
+					const auto index2 = static_cast<size_t>(indices[i * 3 + 2]);
+
+					if (index0 >= vertices.size() || index1 >= vertices.size() || index2 >= vertices.size()) {
+						result.Valid = false;
+						return;
+					}
+
+					auto& reference = state.References[i];
+					reference.Bounds = Box();
+					reference.Bounds.Merge(PositionOf(vertices[index0]));
+					reference.Bounds.Merge(PositionOf(vertices[index1]));
+					reference.Bounds.Merge(PositionOf(vertices[index2]));
+					reference.Triangle = static_cast<uint32_t>(i);
+					result.Bounds.Merge(reference.Bounds);
+					result.Centroids.Merge(reference.Centroid());
+				}
+				});
+
+			Box bounds;
+			Box centroids;
+
+			for (const auto& range : ranges) {
+				if (!range.Valid)
+					return false;
+
+				bounds.Merge(range.Bounds);
+				centroids.Merge(range.Centroids);
+			}
+
+			BuildTree(state, bounds, centroids, threadCount, bvh.nodes);
+
+			bvh.triangles.resize(count);
+			bvh.triangleIndices.resize(count);
+
+			csharp::Parallel::For(count, passThreads, [&](size_t, size_t first, size_t rangeCount) {
+				for (auto i = first; i < first + rangeCount; ++i) {
+					const auto triangle = static_cast<size_t>(state.References[i].Triangle);
+					const auto& vertex0 = PositionOf(vertices[static_cast<size_t>(indices[triangle * 3])]);
+					const auto& vertex1 = PositionOf(vertices[static_cast<size_t>(indices[triangle * 3 + 1])]);
+					const auto& vertex2 = PositionOf(vertices[static_cast<size_t>(indices[triangle * 3 + 2])]);
+					bvh.triangles[i] = { vertex0, vertex1 - vertex0, vertex2 - vertex0 };
+					bvh.triangleIndices[i] = static_cast<uint32_t>(triangle);
+				}
+				});
+
+			return true;
+		}
+
+		//The nodes with at least MinimumParallelCount triangles are split on the calling thread with threaded binning.
+		//The smaller subtrees below them are built one per thread into their own arrays, then appended in order,
+		//so the nodes are laid out the same for any threadCount.
+		static void BuildTree(State& state, Box const& bounds, Box const& centroids, size_t threadCount, std::vector<Node>& nodes) {
+			nodes.push_back({ bounds.Min, bounds.Max });
+
+			std::vector<Task> stack{ { 0, 0, static_cast<uint32_t>(state.References.size()), centroids } };
+			std::vector<Task> subtrees;
+			auto bins = std::make_unique<Bins>();
+
+			while (!stack.empty()) {
+				const auto task = stack.back();
+				stack.pop_back();
+
+				if (task.Count < StaticMeshBvh::MinimumParallelCount) {
+					subtrees.push_back(task);
+					continue;
+				}
+
+				Task left;
+				Task right;
+
+				if (SplitNode(state, nodes, task, threadCount, *bins, left, right)) {
+					stack.push_back(right);
+					stack.push_back(left);
+				}
+			}
+
+			std::vector<std::vector<Node>> built(subtrees.size());
+			std::atomic<size_t> next{ 0 };
+			auto work = [&] {
+				for (auto i = next++; i < subtrees.size(); i = next++)
+					BuildSubtree(state, nodes[subtrees[i].Node], subtrees[i], built[i]);
+				};
+
+			csharp::Parallel::Run(std::min(threadCount, subtrees.size()), [&](size_t) { work(); });
+
+			//The root of a subtree replaces its node, and the other nodes move from index i of the subtree to base + i - 1.
+			auto total = nodes.size();
+
+			for (const auto& subtree : built)
+				total += subtree.size() - 1;
+
+			nodes.reserve(total);
+
+			for (size_t i = 0; i < subtrees.size(); ++i) {
+				const auto base = static_cast<uint32_t>(nodes.size()) - 1;
+
+				for (size_t j = 0; j < built[i].size(); ++j) {
+					auto node = built[i][j];
+
+					if (!node.IsLeaf())
+						node.First += base;
+
+					if (j == 0)
+						nodes[subtrees[i].Node] = node;
+					else
+						nodes.push_back(node);
+				}
+			}
+		}
+
+		static void BuildSubtree(State& state, Node const& root, Task task, std::vector<Node>& nodes) {
+			nodes.push_back(root);
+			task.Node = 0;
+
+			std::vector<Task> stack{ task };
+			auto bins = std::make_unique<Bins>();
+
+			while (!stack.empty()) {
+				const auto current = stack.back();
+				stack.pop_back();
+
+				Task left;
+				Task right;
+
+				if (SplitNode(state, nodes, current, 1, *bins, left, right)) {
+					stack.push_back(right);
+					stack.push_back(left);
+				}
+			}
+		}
+
+		static void Accumulate(State const& state, Binning const& binning, size_t first, size_t count, Bins& bins) {
+			for (auto i = first; i < first + count; ++i) {
+				const auto& box = state.References[i].Bounds;
+				const auto centroid = state.References[i].Centroid();
+				auto& binX = bins.Values[0][binning.BinOf(centroid.X, 0)];
+				auto& binY = bins.Values[1][binning.BinOf(centroid.Y, 1)];
+				auto& binZ = bins.Values[2][binning.BinOf(centroid.Z, 2)];
+				binX.Bounds.Merge(box);
+				binY.Bounds.Merge(box);
+				binZ.Bounds.Merge(box);
+				++binX.Count;
+				++binY.Count;
+				++binZ.Count;
+			}
+		}
+
+		//Sweeps the bins of every axis from both ends and keeps the plane with the lowest cost.
+		static Split BestSplit(Bins const& bins, size_t binCount) {
+			Split best;
+
+			for (size_t axis = 0; axis < 3; ++axis) {
+				const auto& values = bins.Values[axis];
+				float rightArea[BinCount]{};
+				uint32_t rightCount[BinCount]{};
+				Box right;
+				uint32_t count = 0;
+
+				for (auto i = binCount - 1; i > 0; --i) {
+					right.Merge(values[i].Bounds);
+					count += values[i].Count;
+					rightArea[i] = right.Area();
+					rightCount[i] = count;
+				}
+
+				Box left;
+				count = 0;
+
+				for (size_t i = 1; i < binCount; ++i) {
+					left.Merge(values[i - 1].Bounds);
+					count += values[i - 1].Count;
+
+					if (count == 0 || rightCount[i] == 0)
+						continue;
+
+					const auto cost = left.Area() * static_cast<float>(count) + rightArea[i] * static_cast<float>(rightCount[i]);
+
+					if (cost < best.Cost) {
+						best.Cost = cost;
+						best.Axis = axis;
+						best.Bin = i;
+					}
+				}
+			}
+
+			if (best.Cost == Infinity)
+				return best;
+
+			for (size_t i = 0; i < binCount; ++i) {
+				const auto& bin = bins.Values[best.Axis][i];
+
+				if (i < best.Bin) {
+					best.LeftBounds.Merge(bin.Bounds);
+					best.LeftCount += bin.Count;
+				}
+				else {
+					best.RightBounds.Merge(bin.Bounds);
+				}
+			}
+
+			return best;
+		}
+
+		static void BoundsOf(State const& state, size_t first, size_t count, Box& bounds, Box& centroids) {
+			for (auto i = first; i < first + count; ++i) {
+				bounds.Merge(state.References[i].Bounds);
+				centroids.Merge(state.References[i].Centroid());
+			}
+		}
+
+		//Adds the two children of the node of task at the end of nodes and sets left and right to their tasks.
+		//Returns false if the node is cheaper as a leaf, which it becomes. bins is scratch space kept by the caller.
+		static bool SplitNode(State& state, std::vector<Node>& nodes, Task const& task, size_t threadCount, Bins& bins, Task& left, Task& right) {
+			const auto count = static_cast<size_t>(task.Count);
+			Box bounds;
+			bounds.Min = nodes[task.Node].Min;
+			bounds.Max = nodes[task.Node].Max;
+
+			const Binning binning(task.Centroids, count);
+			bins.Reset(binning.Count);
+
+			if (threadCount > 1 && count >= StaticMeshBvh::MinimumParallelCount) {
+				//Ranges are merged in order, and the merges are exact, so the bins do not depend on threadCount.
+				auto partial = std::make_unique<Bins[]>(threadCount);
+				csharp::Parallel::For(count, threadCount, [&](size_t range, size_t first, size_t rangeCount) {
+					Accumulate(state, binning, task.First + first, rangeCount, partial[range]);
+					});
+
+				for (size_t range = 0; range < threadCount; ++range)
+					bins.Merge(partial[range], binning.Count);
+			}
+			else {
+				Accumulate(state, binning, task.First, count, bins);
+			}
+
+			auto split = BestSplit(bins, binning.Count);
+
+			//Costs are compared times the area of the node, which can be 0.
+			const auto area = bounds.Area();
+
+			if (count <= StaticMeshBvh::MaxLeafTriangles
+				&& (split.LeftCount == 0 || static_cast<float>(count) * area <= TraversalCost * area + split.Cost)) {
+				nodes[task.Node].First = task.First;
+				nodes[task.Node].Count = task.Count;
+				return false;
+			}
+
+			if (split.LeftCount == 0) {
+				//All centroids are at one point, so the triangles are halved in their order.
+				split.LeftCount = task.Count / 2;
+				BoundsOf(state, task.First, split.LeftCount, split.LeftBounds, split.LeftCentroids);
+				BoundsOf(state, task.First + split.LeftCount, count - split.LeftCount, split.RightBounds, split.RightCentroids);
+			}
+			else {
+				//Partition from both ends that bounds the centroids of both sides on the way.
+				auto& references = state.References;
+				auto low = static_cast<size_t>(task.First);
+				auto high = low + count;
+				auto isLeft = [&](Vector3 const& centroid) {
+					return binning.BinOf(Component(centroid, split.Axis), split.Axis) < split.Bin;
+					};
+
+				while (true) {
+					for (; low < high; ++low) {
+						const auto centroid = references[low].Centroid();
+
+						if (!isLeft(centroid))
+							break;
+
+						split.LeftCentroids.Merge(centroid);
+					}
+
+					for (; low < high; --high) {
+						const auto centroid = references[high - 1].Centroid();
+
+						if (isLeft(centroid))
+							break;
+
+						split.RightCentroids.Merge(centroid);
+					}
+
+					if (low == high)
+						break;
+
+					std::swap(references[low], references[high - 1]);
+				}
+			}
+
+			const auto child = static_cast<uint32_t>(nodes.size());
+			nodes[task.Node].First = child;
+			nodes[task.Node].Count = 0;
+			nodes.push_back({ split.LeftBounds.Min, split.LeftBounds.Max });
+			nodes.push_back({ split.RightBounds.Min, split.RightBounds.Max });
+
+			left = { child, task.First, split.LeftCount, split.LeftCentroids };
+			right = { child + 1, task.First + split.LeftCount, task.Count - split.LeftCount, split.RightCentroids };
+			return true;
+		}
+
+		//Traversal stack that spills to the heap only for very deep trees.
+		template <typename T>
+		class NodeStack {
+		public:
+			bool Empty() const { return count == 0; }
+
+			void Push(T const& value) {
+				if (count < Capacity)
+					local[count] = value;
+				else
+					spill.push_back(value);
+
+				++count;
+			}
+
+			T Pop() {
+				--count;
+
+				if (count < Capacity)
+					return local[count];
+
+				const auto value = spill.back();
+				spill.pop_back();
+				return value;
+			}
+
+		private:
+			static constexpr size_t Capacity = 64;
+			T local[Capacity];
+			std::vector<T> spill;
+			size_t count{ 0 };
+		};
+
+		struct NodeEntry {
+			uint32_t Node{ 0 };
+			float Entry{ 0 };
+		};
+
+		static float SafeInverse(float value) {
+			return 1.0F / (std::abs(value) < MinimumDirection ? std::copysign(MinimumDirection, value) : value);
+		}
+
+		//Distance where the ray enters the node, clamped to 0, or Infinity if it does not enter it before distance.
+		static float Entry(Node const& node, Vector3 const& origin, Vector3 const& inverse, float distance) {
+			const auto x1 = (node.Min.X - origin.X) * inverse.X;
+			const auto x2 = (node.Max.X - origin.X) * inverse.X;
+			const auto y1 = (node.Min.Y - origin.Y) * inverse.Y;
+			const auto y2 = (node.Max.Y - origin.Y) * inverse.Y;
+			const auto z1 = (node.Min.Z - origin.Z) * inverse.Z;
+			const auto z2 = (node.Max.Z - origin.Z) * inverse.Z;
+			const auto entry = std::max(std::max(std::min(x1, x2), std::min(y1, y2)), std::max(std::min(z1, z2), 0.0F));
+			const auto exit = std::min(std::min(std::max(x1, x2), std::max(y1, y2)), std::min(std::max(z1, z2), distance));
+			return entry <= exit ? entry : Infinity;
+		}
+
+		//Möller-Trumbore test, hitting both sides. If the ray hits the triangle closer than distance, lowers distance to the hit,
+		//sets u and v and returns true.
+		static bool Intersect(Triangle const& triangle, Vector3 const& origin, Vector3 const& direction, float& distance, float& u, float& v) {
+			const auto p = Vector3::Cross(direction, triangle.Edge2);
+			const auto determinant = Vector3::Dot(triangle.Edge1, p);
+
+			if (determinant == 0)
+				return false;
+
+			const auto inverse = 1.0F / determinant;
+			const auto s = origin - triangle.Vertex0;
+			const auto hitU = Vector3::Dot(s, p) * inverse;
+
+			if (!(hitU >= 0 && hitU <= 1))
+				return false;
+
+			const auto q = Vector3::Cross(s, triangle.Edge1);
+			const auto hitV = Vector3::Dot(direction, q) * inverse;
+
+			if (!(hitV >= 0 && hitU + hitV <= 1))
+				return false;
+
+			const auto hitDistance = Vector3::Dot(triangle.Edge2, q) * inverse;
+
+			if (!(hitDistance >= 0 && hitDistance < distance))
+				return false;
+
+			distance = hitDistance;
+			u = hitU;
+			v = hitV;
+			return true;
+		}
+
+		//Nearest hit of one ray, or the first hit found with Any. Sets hit.Triangle to the index in the order of the leaves.
+		template <bool Any>
+		static bool Trace(StaticMeshBvh const& bvh, Ray const& ray, float distance, MeshRayHit& hit) {
+			const auto& nodes = bvh.nodes;
+
+			if (nodes.empty())
+				return false;
+
+			const Vector3 inverse(SafeInverse(ray.Direction.X), SafeInverse(ray.Direction.Y), SafeInverse(ray.Direction.Z));
+			const auto rootEntry = Entry(nodes[0], ray.Position, inverse, distance);
+			auto found = false;
+			NodeStack<NodeEntry> stack;
+
+			if (rootEntry != Infinity)
+				stack.Push({ 0, rootEntry });
+
+			while (!stack.Empty()) {
+				const auto [index, entry] = stack.Pop();
+
+				//Nodes pushed before a closer hit can be behind it now.
+				if (entry > distance)
+					continue;
+
+				const auto& node = nodes[index];
+
+				if (node.IsLeaf()) {
+					for (auto i = node.First; i < node.First + node.Count; ++i) {
+						if (Intersect(bvh.triangles[i], ray.Position, ray.Direction, distance, hit.U, hit.V)) {
+							hit.Distance = distance;
+							hit.Triangle = i;
+							found = true;
+
+							if constexpr (Any)
+								return true;
+						}
+					}
+
+					continue;
+				}
+
+				const auto entry1 = Entry(nodes[node.First], ray.Position, inverse, distance);
+				const auto entry2 = Entry(nodes[node.First + 1], ray.Position, inverse, distance);
+
+				//The nearer child goes on top of the stack.
+				if (entry1 <= entry2) {
+					if (entry2 != Infinity)
+						stack.Push({ node.First + 1, entry2 });
+
+					if (entry1 != Infinity)
+						stack.Push({ node.First, entry1 });
+				}
+				else {
+					if (entry1 != Infinity)
+						stack.Push({ node.First, entry1 });
+
+					stack.Push({ node.First + 1, entry2 });
+				}
+			}
+
+			return found;
+		}
+
+		//Rays traced together, one per lane. Empty lanes and, with Any, lanes that hit have a negative Distance, so no node or triangle takes them.
+		template <size_t Width>
+		struct Packet {
+			alignas(32) float OriginX[Width];
+			alignas(32) float OriginY[Width];
+			alignas(32) float OriginZ[Width];
+			alignas(32) float DirectionX[Width];
+			alignas(32) float DirectionY[Width];
+			alignas(32) float DirectionZ[Width];
+			alignas(32) float InverseX[Width];
+			alignas(32) float InverseY[Width];
+			alignas(32) float InverseZ[Width];
+			alignas(32) float Distance[Width];
+			alignas(32) float U[Width];
+			alignas(32) float V[Width];
+			uint32_t Triangle[Width];
+			uint32_t Active{ 0 };
+
+			void Load(Ray const* rays, size_t count, float maxDistance) {
+				Active = 0;
+
+				for (size_t lane = 0; lane < Width; ++lane) {
+					const auto ray = lane < count ? rays[lane] : Ray(Vector3(0, 0, 0), Vector3(1, 0, 0));
+					OriginX[lane] = ray.Position.X;
+					OriginY[lane] = ray.Position.Y;
+					OriginZ[lane] = ray.Position.Z;
+					DirectionX[lane] = ray.Direction.X;
+					DirectionY[lane] = ray.Direction.Y;
+					DirectionZ[lane] = ray.Direction.Z;
+					InverseX[lane] = SafeInverse(ray.Direction.X);
+					InverseY[lane] = SafeInverse(ray.Direction.Y);
+					InverseZ[lane] = SafeInverse(ray.Direction.Z);
+					Distance[lane] = lane < count ? maxDistance : -1.0F;
+					U[lane] = 0;
+					V[lane] = 0;
+					Triangle[lane] = NoIndex;
+
+					if (lane < count)
+						Active |= 1U << lane;
+				}
+			}
+
+			//Gets whether the directions of all rays have the same signs. Other packets split at most nodes
+			//and are traced one ray at a time.
+			bool IsCoherent() const {
+				uint32_t octants = 0;
+
+				for (size_t lane = 0; lane < Width; ++lane) {
+					if ((Active >> lane) & 1)
+						octants |= 1U << ((DirectionX[lane] < 0 ? 1 : 0) | (DirectionY[lane] < 0 ? 2 : 0) | (DirectionZ[lane] < 0 ? 4 : 0));
+				}
+
+				return std::has_single_bit(octants);
+			}
+		};
+
+#if defined(CSHARP_INTRINSICS_X86)
+		inline static const bool UseAvx2 = csharp::X86Intrinsics::IsAvx2Supported();
+
+		//Lanes of the rays that enter the node before their Distance. Same operations as Entry.
+		CSHARP_TARGET("sse2")
+		static uint32_t Enter(Node const& node, Packet<4> const& packet) {
+			const auto originX = _mm_load_ps(packet.OriginX);
+			const auto originY = _mm_load_ps(packet.OriginY);
+			const auto originZ = _mm_load_ps(packet.OriginZ);
+			const auto inverseX = _mm_load_ps(packet.InverseX);
+			const auto inverseY = _mm_load_ps(packet.InverseY);
+			const auto inverseZ = _mm_load_ps(packet.InverseZ);
+			const auto x1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.Min.X), originX), inverseX);
+			const auto x2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.Max.X), originX), inverseX);
+			const auto y1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.Min.Y), originY), inverseY);
+			const auto y2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.Max.Y), originY), inverseY);
+			const auto z1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.Min.Z), originZ), inverseZ);
+			const auto z2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.Max.Z), originZ), inverseZ);
+			const auto entry = _mm_max_ps(_mm_max_ps(_mm_min_ps(x1, x2), _mm_min_ps(y1, y2)), _mm_max_ps(_mm_min_ps(z1, z2), _mm_setzero_ps()));
+			const auto exit = _mm_min_ps(_mm_min_ps(_mm_max_ps(x1, x2), _mm_max_ps(y1, y2)), _mm_min_ps(_mm_max_ps(z1, z2), _mm_load_ps(packet.Distance)));
+			return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(entry, exit)));
+		}
+
+		CSHARP_TARGET("avx2")
+		static uint32_t Enter(Node const& node, Packet<8> const& packet) {
+			const auto originX = _mm256_load_ps(packet.OriginX);
+			const auto originY = _mm256_load_ps(packet.OriginY);
+			const auto originZ = _mm256_load_ps(packet.OriginZ);
+			const auto inverseX = _mm256_load_ps(packet.InverseX);
+			const auto inverseY = _mm256_load_ps(packet.InverseY);
+			const auto inverseZ = _mm256_load_ps(packet.InverseZ);
+			const auto x1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.Min.X), originX), inverseX);
+			const auto x2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.Max.X), originX), inverseX);
+			const auto y1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.Min.Y), originY), inverseY);
+			const auto y2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.Max.Y), originY), inverseY);
+			const auto z1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.Min.Z), originZ), inverseZ);
+			const auto z2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.Max.Z), originZ), inverseZ);
+			const auto entry = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(x1, x2), _mm256_min_ps(y1, y2)), _mm256_max_ps(_mm256_min_ps(z1, z2), _mm256_setzero_ps()));
+			const auto exit = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(x1, x2), _mm256_max_ps(y1, y2)), _mm256_min_ps(_mm256_max_ps(z1, z2), _mm256_load_ps(packet.Distance)));
+			return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(entry, exit, _CMP_LE_OQ)));
+		}
+
+		//Intersect for every lane, with the same operations. A zero determinant gives an infinite or NaN u, which fails the tests.
+		//Returns the lanes that hit.
+		CSHARP_TARGET("sse2")
+		static uint32_t Intersect(Triangle const& triangle, uint32_t index, Packet<4>& packet) {
+			const auto directionX = _mm_load_ps(packet.DirectionX);
+			const auto directionY = _mm_load_ps(packet.DirectionY);
+			const auto directionZ = _mm_load_ps(packet.DirectionZ);
+			const auto edge1X = _mm_set1_ps(triangle.Edge1.X);
+			const auto edge1Y = _mm_set1_ps(triangle.Edge1.Y);
+			const auto edge1Z = _mm_set1_ps(triangle.Edge1.Z);
+			const auto edge2X = _mm_set1_ps(triangle.Edge2.X);
+			const auto edge2Y = _mm_set1_ps(triangle.Edge2.Y);
+			const auto edge2Z = _mm_set1_ps(triangle.Edge2.Z);
+
+			const auto pX = _mm_sub_ps(_mm_mul_ps(directionY, edge2Z), _mm_mul_ps(directionZ, edge2Y));
+			const auto pY = _mm_sub_ps(_mm_mul_ps(directionZ, edge2X), _mm_mul_ps(directionX, edge2Z));
+			const auto pZ = _mm_sub_ps(_mm_mul_ps(directionX, edge2Y), _mm_mul_ps(directionY, edge2X));
+			const auto determinant = _mm_add_ps(_mm_add_ps(_mm_mul_ps(edge1X, pX), _mm_mul_ps(edge1Y, pY)), _mm_mul_ps(edge1Z, pZ));
+			const auto inverse = _mm_div_ps(_mm_set1_ps(1.0F), determinant);
+
+			const auto sX = _mm_sub_ps(_mm_load_ps(packet.OriginX), _mm_set1_ps(triangle.Vertex0.X));
+			const auto sY = _mm_sub_ps(_mm_load_ps(packet.OriginY), _mm_set1_ps(triangle.Vertex0.Y));
+			const auto sZ = _mm_sub_ps(_mm_load_ps(packet.OriginZ), _mm_set1_ps(triangle.Vertex0.Z));
+			const auto u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sX, pX), _mm_mul_ps(sY, pY)), _mm_mul_ps(sZ, pZ)), inverse);
+
+			const auto qX = _mm_sub_ps(_mm_mul_ps(sY, edge1Z), _mm_mul_ps(sZ, edge1Y));
+			const auto qY = _mm_sub_ps(_mm_mul_ps(sZ, edge1X), _mm_mul_ps(sX, edge1Z));
+			const auto qZ = _mm_sub_ps(_mm_mul_ps(sX, edge1Y), _mm_mul_ps(sY, edge1X));
+			const auto v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(directionX, qX), _mm_mul_ps(directionY, qY)), _mm_mul_ps(directionZ, qZ)), inverse);
+			const auto t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(edge2X, qX), _mm_mul_ps(edge2Y, qY)), _mm_mul_ps(edge2Z, qZ)), inverse);
+
+			const auto zero = _mm_setzero_ps();
+			const auto one = _mm_set1_ps(1.0F);
+			const auto distance = _mm_load_ps(packet.Distance);
+			auto hit = _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one));
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmplt_ps(t, distance)));
+
+			const auto lanes = static_cast<uint32_t>(_mm_movemask_ps(hit));
+
+			if (lanes == 0)
+				return 0;
+
+			_mm_store_ps(packet.Distance, _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, distance)));
+			_mm_store_ps(packet.U, _mm_or_ps(_mm_and_ps(hit, u), _mm_andnot_ps(hit, _mm_load_ps(packet.U))));
+			_mm_store_ps(packet.V, _mm_or_ps(_mm_and_ps(hit, v), _mm_andnot_ps(hit, _mm_load_ps(packet.V))));
+
+			for (uint32_t lane = 0; lane < 4; ++lane) {
+				if ((lanes >> lane) & 1)
+					packet.Triangle[lane] = index;
+			}
+
+			return lanes;
+		}
+
+		CSHARP_TARGET("avx2")
+		static uint32_t Intersect(Triangle const& triangle, uint32_t index, Packet<8>& packet) {
+			const auto directionX = _mm256_load_ps(packet.DirectionX);
+			const auto directionY = _mm256_load_ps(packet.DirectionY);
+			const auto directionZ = _mm256_load_ps(packet.DirectionZ);
+			const auto edge1X = _mm256_set1_ps(triangle.Edge1.X);
+			const auto edge1Y = _mm256_set1_ps(triangle.Edge1.Y);
+			const auto edge1Z = _mm256_set1_ps(triangle.Edge1.Z);
+			const auto edge2X = _mm256_set1_ps(triangle.Edge2.X);
+			const auto edge2Y = _mm256_set1_ps(triangle.Edge2.Y);
+			const auto edge2Z = _mm256_set1_ps(triangle.Edge2.Z);
+
+			const auto pX = _mm256_sub_ps(_mm256_mul_ps(directionY, edge2Z), _mm256_mul_ps(directionZ, edge2Y));
+			const auto pY = _mm256_sub_ps(_mm256_mul_ps(directionZ, edge2X), _mm256_mul_ps(directionX, edge2Z));
+			const auto pZ = _mm256_sub_ps(_mm256_mul_ps(directionX, edge2Y), _mm256_mul_ps(directionY, edge2X));
+			const auto determinant = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(edge1X, pX), _mm256_mul_ps(edge1Y, pY)), _mm256_mul_ps(edge1Z, pZ));
+			const auto inverse = _mm256_div_ps(_mm256_set1_ps(1.0F), determinant);
+
+			const auto sX = _mm256_sub_ps(_mm256_load_ps(packet.OriginX), _mm256_set1_ps(triangle.Vertex0.X));
+			const auto sY = _mm256_sub_ps(_mm256_load_ps(packet.OriginY), _mm256_set1_ps(triangle.Vertex0.Y));
+			const auto sZ = _mm256_sub_ps(_mm256_load_ps(packet.OriginZ), _mm256_set1_ps(triangle.Vertex0.Z));
+			const auto u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sX, pX), _mm256_mul_ps(sY, pY)), _mm256_mul_ps(sZ, pZ)), inverse);
+
+			const auto qX = _mm256_sub_ps(_mm256_mul_ps(sY, edge1Z), _mm256_mul_ps(sZ, edge1Y));
+			const auto qY = _mm256_sub_ps(_mm256_mul_ps(sZ, edge1X), _mm256_mul_ps(sX, edge1Z));
+			const auto qZ = _mm256_sub_ps(_mm256_mul_ps(sX, edge1Y), _mm256_mul_ps(sY, edge1X));
+			const auto v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(directionX, qX), _mm256_mul_ps(directionY, qY)), _mm256_mul_ps(directionZ, qZ)), inverse);
+			const auto t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(edge2X, qX), _mm256_mul_ps(edge2Y, qY)), _mm256_mul_ps(edge2Z, qZ)), inverse);
+
+			const auto zero = _mm256_setzero_ps();
+			const auto one = _mm256_set1_ps(1.0F);
+			const auto distance = _mm256_load_ps(packet.Distance);
+			auto hit = _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, one, _CMP_LE_OQ));
+			hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ)));
+			hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GE_OQ), _mm256_cmp_ps(t, distance, _CMP_LT_OQ)));
+
+			const auto lanes = static_cast<uint32_t>(_mm256_movemask_ps(hit));
+
+			if (lanes == 0)
+				return 0;
+
+			_mm256_store_ps(packet.Distance, _mm256_blendv_ps(distance, t, hit));
+			_mm256_store_ps(packet.U, _mm256_blendv_ps(_mm256_load_ps(packet.U), u, hit));
+			_mm256_store_ps(packet.V, _mm256_blendv_ps(_mm256_load_ps(packet.V), v, hit));
+
+			for (uint32_t lane = 0; lane < 8; ++lane) {
+				if ((lanes >> lane) & 1)
+					packet.Triangle[lane] = index;
+			}
+
+			return lanes;
+		}
+#else
+		template <size_t Width>
+		static uint32_t Enter(Node const& node, Packet<Width> const& packet) {
+			uint32_t lanes = 0;
+
+			for (size_t lane = 0; lane < Width; ++lane) {
+				const Vector3 origin(packet.OriginX[lane], packet.OriginY[lane], packet.OriginZ[lane]);
+				const Vector3 inverse(packet.InverseX[lane], packet.InverseY[lane], packet.InverseZ[lane]);
+
+				if (Entry(node, origin, inverse, packet.Distance[lane]) != Infinity)
+					lanes |= 1U << lane;
+			}
+
+			return lanes;
+		}
+
+		template <size_t Width>
+		static uint32_t Intersect(Triangle const& triangle, uint32_t index, Packet<Width>& packet) {
+			uint32_t lanes = 0;
+
+			for (size_t lane = 0; lane < Width; ++lane) {
+				const Vector3 origin(packet.OriginX[lane], packet.OriginY[lane], packet.OriginZ[lane]);
+				const Vector3 direction(packet.DirectionX[lane], packet.DirectionY[lane], packet.DirectionZ[lane]);
+
+				if (Intersect(triangle, origin, direction, packet.Distance[lane], packet.U[lane], packet.V[lane])) {
+					packet.Triangle[lane] = index;
+					lanes |= 1U << lane;
+				}
+			}
+
+			return lanes;
+		}
+#endif
+
+		//Traces the rays of a packet down the tree together, visiting a node while any lane enters it.
+		//The children are ordered for the first ray, which suits rays going the same way.
+		template <bool Any, size_t Width>
+		static void Trace(StaticMeshBvh const& bvh, Packet<Width>& packet) {
+			const auto& nodes = bvh.nodes;
+			const auto lead = static_cast<size_t>(std::countr_zero(packet.Active));
+			const float direction[3] = { packet.DirectionX[lead], packet.DirectionY[lead], packet.DirectionZ[lead] };
+			uint32_t hits = 0;
+			NodeStack<uint32_t> stack;
+			stack.Push(0);
+
+			while (!stack.Empty()) {
+				const auto& node = nodes[stack.Pop()];
+
+				if (Enter(node, packet) == 0)
+					continue;
+
+				if (node.IsLeaf()) {
+					for (auto i = node.First; i < node.First + node.Count; ++i) {
+						const auto lanes = Intersect(bvh.triangles[i], i, packet);
+
+						if constexpr (Any) {
+							if (lanes == 0)
+								continue;
+
+							for (size_t lane = 0; lane < Width; ++lane) {
+								if ((lanes >> lane) & 1)
+									packet.Distance[lane] = -1.0F;
+							}
+
+							hits |= lanes;
+
+							if (hits == packet.Active)
+								return;
+						}
+					}
+
+					continue;
+				}
+
+				//The children are ordered along the axis where their centers are farthest apart.
+				const auto& child1 = nodes[node.First];
+				const auto& child2 = nodes[node.First + 1];
+				const auto offset = (child2.Min + child2.Max) - (child1.Min + child1.Max);
+				const float offsets[3] = { offset.X, offset.Y, offset.Z };
+				size_t axis = 0;
+
+				for (size_t i = 1; i < 3; ++i) {
+					if (std::abs(offsets[i]) > std::abs(offsets[axis]))
+						axis = i;
+				}
+
+				const auto firstIsNearer = (offsets[axis] >= 0) == (direction[axis] >= 0);
+				stack.Push(firstIsNearer ? node.First + 1 : node.First);
+				stack.Push(firstIsNearer ? node.First : node.First + 1);
+			}
+		}
+
+		//Traces count rays from first in packets of Width, writing the hits or the bits from first / 64 on.
+		template <bool Any, size_t Width>
+		static void TracePackets(StaticMeshBvh const& bvh, Ray const* rays, size_t first, size_t count, float maxDistance, MeshRayHit* hits, uint64_t* bits) {
+			Packet<Width> packet;
+
+			for (auto start = first; start < first + count; start += Width) {
+				const auto packetCount = std::min(Width, first + count - start);
+				packet.Load(rays + start, packetCount, maxDistance);
+
+				if (bvh.nodes.empty())
+					continue;
+
+				if (packet.IsCoherent()) {
+					Trace<Any>(bvh, packet);
+				}
+				else {
+					for (size_t lane = 0; lane < packetCount; ++lane) {
+						MeshRayHit hit;
+
+						if (Trace<Any>(bvh, rays[start + lane], maxDistance, hit)) {
+							packet.Distance[lane] = hit.Distance;
+							packet.U[lane] = hit.U;
+							packet.V[lane] = hit.V;
+							packet.Triangle[lane] = static_cast<uint32_t>(hit.Triangle);
+						}
+					}
+				}
+
+				for (size_t lane = 0; lane < packetCount; ++lane) {
+					const auto triangle = packet.Triangle[lane];
+					const auto index = start + lane;
+
+					if constexpr (Any) {
+						if (triangle != NoIndex)
+							bits[index / 64] |= uint64_t{ 1 } << (index % 64);
+					}
+					else if (triangle == NoIndex) {
+						hits[index] = MeshRayHit();
+					}
+					else {
+						hits[index] = { packet.Distance[lane], static_cast<size_t>(bvh.triangleIndices[triangle]), packet.U[lane], packet.V[lane] };
+					}
+				}
+			}
+		}
+
+		template <bool Any>
+		static void TraceRange(StaticMeshBvh const& bvh, Ray const* rays, size_t first, size_t count, float maxDistance, MeshRayHit* hits, uint64_t* bits) {
+			if constexpr (Any)
+				std::fill(bits + first / 64, bits + (first + count + 63) / 64, uint64_t{ 0 });
+
+#if defined(CSHARP_INTRINSICS_X86)
+			if (UseAvx2) {
+				TracePackets<Any, 8>(bvh, rays, first, count, maxDistance, hits, bits);
+				return;
+			}
+#endif
+			TracePackets<Any, 4>(bvh, rays, first, count, maxDistance, hits, bits);
+		}
+
+		template <bool Any>
+		static void Batch(StaticMeshBvh const& bvh, std::span<const Ray> rays, float maxDistance, MeshRayHit* hits, uint64_t* bits, size_t threadCount) {
+			const auto count = rays.size();
+
+			if (threadCount <= 1 || count < StaticMeshBvh::MinimumParallelRayCount) {
+				TraceRange<Any>(bvh, rays.data(), 0, count, maxDistance, hits, bits);
+				return;
+			}
+
+			csharp::Parallel::For(count, threadCount, 64, [&](size_t, size_t first, size_t rangeCount) {
+				TraceRange<Any>(bvh, rays.data(), first, rangeCount, maxDistance, hits, bits);
+				});
+		}
+	};
+
+	bool StaticMeshBvh::Build(std::span<const VertexPositionNormalTexture> vertices, std::span<const uint16_t> indices, size_t threadCount) {
+		return MeshBvhKernels::Build(*this, vertices, indices, threadCount);
+	}
+
+	bool StaticMeshBvh::Build(std::span<const VertexPositionNormalTexture> vertices, std::span<const uint32_t> indices, size_t threadCount) {
+		return MeshBvhKernels::Build(*this, vertices, indices, threadCount);
+	}
+
+	bool StaticMeshBvh::Build(std::span<const Vector3> positions, std::span<const uint32_t> indices, size_t threadCount) {
+		return MeshBvhKernels::Build(*this, positions, indices, threadCount);
+	}
+
+	void StaticMeshBvh::Clear() {
+		nodes.clear();
+		triangles.clear();
+		triangleIndices.clear();
+	}
+
+	BoundingBox StaticMeshBvh::Bounds() const {
+		if (nodes.empty())
+			return BoundingBox();
+
+		return BoundingBox(nodes[0].Min, nodes[0].Max);
+	}
+
+	std::optional<MeshRayHit> StaticMeshBvh::RayCast(Ray const& ray, float maxDistance) const {
+		MeshRayHit hit;
+
+		if (!MeshBvhKernels::Trace<false>(*this, ray, maxDistance, hit))
+			return std::nullopt;
+
+		hit.Triangle = triangleIndices[hit.Triangle];
+		return hit;
+	}
+
+	bool StaticMeshBvh::RayCastAny(Ray const& ray, float maxDistance) const {
+		MeshRayHit hit;
+		return MeshBvhKernels::Trace<true>(*this, ray, maxDistance, hit);
+	}
+
+	bool StaticMeshBvh::RayCast(std::span<const Ray> rays, std::span<MeshRayHit> hits, float maxDistance, size_t threadCount) const {
+		if (hits.size() < rays.size())
+			return false;
+
+		MeshBvhKernels::Batch<false>(*this, rays, maxDistance, hits.data(), nullptr, threadCount);
+		return true;
+	}
+
+	bool StaticMeshBvh::RayCastAny(std::span<const Ray> rays, std::span<uint64_t> result, float maxDistance, size_t threadCount) const {
+		if (result.size() < (rays.size() + 63) / 64)
+			return false;
+
+		MeshBvhKernels::Batch<true>(*this, rays, maxDistance, nullptr, result.data(), threadCount);
+		return true;
+	}
+}
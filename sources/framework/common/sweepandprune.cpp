@@ -0,0 +1,328 @@
+#include "xna/common/sweepandprune.hpp"
+#include <algorithm>
+
+namespace xna {
+	template <typename T>
+	void SweepAndPrune<T>::Clear() {
+		for (auto& list : endpoints)
+			list.clear();
+
+		proxies.clear();
+		indices.clear();
+		proxyCount = 0;
+		freeProxy = NullIndex;
+		pairs.clear();
+		removedIndices.clear();
+		added.clear();
+		removed.clear();
+		sorted = true;
+	}
+
+	template <typename T>
+	typename SweepAndPrune<T>::Coordinate SweepAndPrune<T>::MinOf(T const& box, size_t axis) {
+		if constexpr (std::is_same_v<T, BoundingBox>)
+			return axis == 0 ? box.Min.X : (axis == 1 ? box.Min.Y : box.Min.Z);
+		else
+			return axis == 0 ? box.X : box.Y;
+	}
+
+	template <typename T>
+	typename SweepAndPrune<T>::Coordinate SweepAndPrune<T>::MaxOf(T const& box, size_t axis) {
+		if constexpr (std::is_same_v<T, BoundingBox>) {
+			return axis == 0 ? box.Max.X : (axis == 1 ? box.Max.Y : box.Max.Z);
+		}
+		else {
+			//Right and Bottom are outside the rectangle, so the last coordinate inside is kept and the test becomes inclusive like for boxes.
+			const auto position = static_cast<int64_t>(axis == 0 ? box.X : box.Y);
+			const auto size = static_cast<int64_t>(axis == 0 ? box.Width : box.Height);
+			return static_cast<int32_t>(position + (std::max)(size, int64_t{ 1 }) - 1);
+		}
+	}
+
+	template <typename T>
+	uint32_t SweepAndPrune<T>::AllocateProxy(T const& box, size_t userData) {
+		uint32_t proxy;
+
+		if (freeProxy == NullIndex) {
+			proxies.emplace_back();
+			indices.emplace_back();
+			proxy = static_cast<uint32_t>(proxies.size() - 1);
+		}
+		else {
+			proxy = freeProxy;
+			freeProxy = indices[proxy].Min[0];
+		}
+
+		proxies[proxy].Box = box;
+		proxies[proxy].UserData = userData;
+
+		++proxyCount;
+		return proxy;
+	}
+
+	template <typename T>
+	size_t SweepAndPrune<T>::Add(T const& box, size_t userData) {
+		Update();
+		const auto proxy = AllocateProxy(box, userData);
+
+		//The endpoints go straight to their sorted places, and the indices after them move up by one or two.
+		for (size_t axis = 0; axis < Axes; ++axis) {
+			auto& list = endpoints[axis];
+			const Endpoint minimum{ MinOf(box, axis), proxy << 1 };
+			const Endpoint maximum{ MaxOf(box, axis), (proxy << 1) | 1 };
+
+			const auto minIndex = std::upper_bound(list.begin(), list.end(), minimum) - list.begin();
+			list.insert(list.begin() + minIndex, minimum);
+			const auto maxIndex = std::upper_bound(list.begin() + minIndex + 1, list.end(), maximum) - list.begin();
+			list.insert(list.begin() + maxIndex, maximum);
+
+			for (auto i = static_cast<size_t>(minIndex); i < list.size(); ++i)
+				SetIndex(list[i], axis, static_cast<uint32_t>(i));
+		}
+
+		//Only the proxies whose minimum comes before the new maximum can overlap it.
+		const auto& value = indices[proxy];
+		const auto& list = endpoints[0];
+
+		for (uint32_t i = 0; i < value.Max[0]; ++i) {
+			const auto other = list[i].Proxy();
+
+			if (!list[i].IsMax() && other != proxy && Overlaps(value, indices[other]))
+				AddPair(proxy, other);
+		}
+
+		return proxy;
+	}
+
+	template <typename T>
+	bool SweepAndPrune<T>::Add(std::span<const T> boxes, std::span<const size_t> userData, std::span<size_t> proxiesOut) {
+		if (boxes.size() != userData.size() || boxes.size() != proxiesOut.size())
+			return false;
+
+		if (boxes.empty())
+			return true;
+
+		Update();
+
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			const auto proxy = AllocateProxy(boxes[i], userData[i]);
+			proxiesOut[i] = proxy;
+
+			for (size_t axis = 0; axis < Axes; ++axis) {
+				endpoints[axis].push_back({ MinOf(boxes[i], axis), proxy << 1 });
+				endpoints[axis].push_back({ MaxOf(boxes[i], axis), (proxy << 1) | 1 });
+			}
+		}
+
+		for (size_t axis = 0; axis < Axes; ++axis) {
+			auto& list = endpoints[axis];
+			std::sort(list.begin(), list.end());
+
+			for (size_t i = 0; i < list.size(); ++i)
+				SetIndex(list[i], axis, static_cast<uint32_t>(i));
+		}
+
+		std::vector<uint8_t> isNew(proxies.size());
+
+		for (const auto proxy : proxiesOut)
+			isNew[proxy] = 1;
+
+		//Sweep along the first axis with the proxies whose interval is open, testing the pairs with a new proxy.
+		std::vector<uint32_t> active;
+		std::vector<uint32_t> activeIndex(proxies.size());
+
+		for (const auto& endpoint : endpoints[0]) {
+			const auto proxy = endpoint.Proxy();
+
+			if (endpoint.IsMax()) {
+				const auto last = active.back();
+				active[activeIndex[proxy]] = last;
+				activeIndex[last] = activeIndex[proxy];
+				active.pop_back();
+				continue;
+			}
+
+			const auto& value = indices[proxy];
+
+			for (const auto other : active) {
+				if ((isNew[proxy] || isNew[other]) && Overlaps(value, indices[other]))
+					AddPair(proxy, other);
+			}
+
+			activeIndex[proxy] = static_cast<uint32_t>(active.size());
+			active.push_back(proxy);
+		}
+
+		return true;
+	}
+
+	template <typename T>
+	void SweepAndPrune<T>::Remove(size_t proxy) {
+		Update();
+
+		const auto index = static_cast<uint32_t>(proxy);
+		auto& value = indices[proxy];
+
+		//Both endpoints are moved to the end. Every pair ends when the minimum passes the maximum of the other proxy.
+		for (size_t axis = 0; axis < Axes; ++axis) {
+			auto& list = endpoints[axis];
+
+			for (auto i = value.Max[axis]; i + 1 < list.size(); ++i) {
+				list[i] = list[i + 1];
+				SetIndex(list[i], axis, i);
+			}
+
+			for (auto i = value.Min[axis]; i + 2 < list.size(); ++i) {
+				list[i] = list[i + 1];
+				SetIndex(list[i], axis, i);
+
+				if (axis == 0 && list[i].IsMax())
+					RemovePair(index, list[i].Proxy());
+			}
+
+			list.resize(list.size() - 2);
+		}
+
+		value.Min[0] = freeProxy;
+		value.Max[0] = NullIndex;
+		freeProxy = index;
+		--proxyCount;
+	}
+
+	template <typename T>
+	void SweepAndPrune<T>::Move(size_t proxy, T const& box) {
+		const auto& value = indices[proxy];
+		proxies[proxy].Box = box;
+
+		for (size_t axis = 0; axis < Axes; ++axis) {
+			endpoints[axis][value.Min[axis]].Value = MinOf(box, axis);
+			endpoints[axis][value.Max[axis]].Value = MaxOf(box, axis);
+		}
+
+		sorted = false;
+	}
+
+	template <typename T>
+	void SweepAndPrune<T>::Update() {
+		if (sorted)
+			return;
+
+		for (size_t axis = 0; axis < Axes; ++axis)
+			SortAxis(axis);
+
+		sorted = true;
+	}
+
+	template <typename T>
+	void SweepAndPrune<T>::ClearPairChanges() {
+		for (const auto& pair : added)
+			pairs[KeyOf(static_cast<uint32_t>(pair.Proxy1), static_cast<uint32_t>(pair.Proxy2))] = NullIndex;
+
+		added.clear();
+		removed.clear();
+		removedIndices.clear();
+	}
+
+	template <typename T>
+	void SweepAndPrune<T>::SetIndex(Endpoint const& endpoint, size_t axis, uint32_t index) {
+		auto& proxy = indices[endpoint.Proxy()];
+
+		if (endpoint.IsMax())
+			proxy.Max[axis] = index;
+		else
+			proxy.Min[axis] = index;
+	}
+
+	template <typename T>
+	void SweepAndPrune<T>::SortAxis(size_t axis) {
+		//Insertion sort over the whole axis, which walks the array in order and swaps only the endpoints that moved past others.
+		//The indices of this axis are stale until the end, so the overlap tests during the sort skip it.
+		auto& list = endpoints[axis];
+		auto first = list.size();
+		size_t last = 0;
+
+		for (size_t i = 1; i < list.size(); ++i) {
+			const auto endpoint = list[i];
+
+			if (!(endpoint < list[i - 1]))
+				continue;
+
+			const auto& owner = indices[endpoint.Proxy()];
+			auto index = i;
+
+			do {
+				const auto previous = list[index - 1];
+				list[index] = previous;
+				--index;
+
+				//A minimum passing a maximum down starts an overlap on this axis, a maximum passing a minimum ends one.
+				//The pair changes only if the proxies overlap on the other axes.
+				if (endpoint.IsMax() != previous.IsMax() && Overlaps(owner, indices[previous.Proxy()], axis)) {
+					if (endpoint.IsMax())
+						RemovePair(endpoint.Proxy(), previous.Proxy());
+					else
+						AddPair(endpoint.Proxy(), previous.Proxy());
+				}
+			} while (index > 0 && endpoint < list[index - 1]);
+
+			list[index] = endpoint;
+			first = (std::min)(first, index);
+			last = i;
+		}
+
+		for (auto i = first; i <= last && i < list.size(); ++i)
+			SetIndex(list[i], axis, static_cast<uint32_t>(i));
+	}
+
+	template <typename T>
+	void SweepAndPrune<T>::AddPair(uint32_t proxy1, uint32_t proxy2) {
+		const auto key = KeyOf(proxy1, proxy2);
+
+		if (pairs.contains(key))
+			return;
+
+		//A pair removed since the last ClearPairChanges is taken out of the removed list instead of being reported twice.
+		const auto removedIndex = removedIndices.find(key);
+
+		if (removedIndex != removedIndices.end()) {
+			const auto index = removedIndex->second;
+			const auto last = removed.back();
+			removed[index] = last;
+			removedIndices[KeyOf(static_cast<uint32_t>(last.Proxy1), static_cast<uint32_t>(last.Proxy2))] = index;
+			removed.pop_back();
+			removedIndices.erase(key);
+			pairs.emplace(key, NullIndex);
+			return;
+		}
+
+		pairs.emplace(key, static_cast<uint32_t>(added.size()));
+		added.push_back({ static_cast<size_t>(key >> 32), static_cast<size_t>(key & 0xFFFFFFFF) });
+	}
+
+	template <typename T>
+	void SweepAndPrune<T>::RemovePair(uint32_t proxy1, uint32_t proxy2) {
+		const auto key = KeyOf(proxy1, proxy2);
+		const auto pair = pairs.find(key);
+
+		if (pair == pairs.end())
+			return;
+
+		//A pair added since the last ClearPairChanges is taken out of the added list instead of being reported twice.
+		if (pair->second != NullIndex) {
+			const auto index = pair->second;
+			const auto last = added.back();
+			added[index] = last;
+			pairs[KeyOf(static_cast<uint32_t>(last.Proxy1), static_cast<uint32_t>(last.Proxy2))] = index;
+			added.pop_back();
+		}
+		else {
+			removedIndices.emplace(key, static_cast<uint32_t>(removed.size()));
+			removed.push_back({ static_cast<size_t>(key >> 32), static_cast<size_t>(key & 0xFFFFFFFF) });
+		}
+
+		pairs.erase(key);
+	}
+
+	template class SweepAndPrune<BoundingBox>;
+	template class SweepAndPrune<Rectangle>;
+}
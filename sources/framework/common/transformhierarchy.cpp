@@ -0,0 +1,191 @@
+#include "xna/common/transformhierarchy.hpp"
+#include "csharp/threading/parallel.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace xna {
+	void TransformHierarchy::Reserve(size_t capacity) {
+		parents.reserve(capacity);
+		translations.Reserve(capacity);
+		rotations.Reserve(capacity);
+		scales.Reserve(capacity);
+		dirty.reserve(capacity);
+		worlds.reserve(capacity);
+	}
+
+	void TransformHierarchy::Clear() {
+		parents.clear();
+		translations.Clear();
+		rotations.Clear();
+		scales.Clear();
+		dirty.clear();
+		worlds.clear();
+		anyDirty = false;
+		partitionThreads = 0;
+	}
+
+	size_t TransformHierarchy::Add(size_t parent) {
+		return Add(parent, Vector3::Zero(), Quaternion::Identity(), Vector3::One());
+	}
+
+	size_t TransformHierarchy::Add(size_t parent, Vector3 const& translation, Quaternion const& rotation, Vector3 const& scale) {
+		if (parent != NoParent && parent >= parents.size())
+			throw std::invalid_argument("TransformHierarchy::Add: parent is not an existing node.");
+
+		const auto node = parents.size();
+		parents.push_back(parent);
+		translations.Add(translation);
+		rotations.Add(Vector4(rotation.X, rotation.Y, rotation.Z, rotation.W));
+		scales.Add(scale);
+		dirty.push_back(1);
+		worlds.push_back(Matrix::Identity());
+		anyDirty = true;
+		partitionThreads = 0;
+		return node;
+	}
+
+	void TransformHierarchy::Translation(size_t node, Vector3 const& value) {
+		translations.Set(node, value);
+		MarkDirty(node);
+	}
+
+	Quaternion TransformHierarchy::Rotation(size_t node) const {
+		const auto value = rotations.Get(node);
+		return Quaternion(value.X, value.Y, value.Z, value.W);
+	}
+
+	void TransformHierarchy::Rotation(size_t node, Quaternion const& value) {
+		rotations.Set(node, Vector4(value.X, value.Y, value.Z, value.W));
+		MarkDirty(node);
+	}
+
+	void TransformHierarchy::Scale(size_t node, Vector3 const& value) {
+		scales.Set(node, value);
+		MarkDirty(node);
+	}
+
+	void TransformHierarchy::Local(size_t node, Vector3 const& translation, Quaternion const& rotation, Vector3 const& scale) {
+		translations.Set(node, translation);
+		rotations.Set(node, Vector4(rotation.X, rotation.Y, rotation.Z, rotation.W));
+		scales.Set(node, scale);
+		MarkDirty(node);
+	}
+
+	void TransformHierarchy::MarkDirty(size_t node) {
+		dirty[node] = 1;
+		anyDirty = true;
+	}
+
+	Matrix TransformHierarchy::LocalMatrix(size_t node) const {
+		//Read straight from the streams rather than through Get.
+		const Vector3 scale(scales.X()[node], scales.Y()[node], scales.Z()[node]);
+		const Quaternion rotation(rotations.X()[node], rotations.Y()[node], rotations.Z()[node], rotations.W()[node]);
+		const Vector3 translation(translations.X()[node], translations.Y()[node], translations.Z()[node]);
+		return Matrix::Compose(scale, rotation, translation);
+	}
+
+	void TransformHierarchy::Update(size_t threadCount) {
+		if (!anyDirty)
+			return;
+
+		//Parents come first, so one forward pass carries the flags down to every descendant.
+		const auto count = parents.size();
+		size_t dirtyCount = 0;
+
+		for (size_t i = 0; i < count; ++i) {
+			const auto parent = parents[i];
+
+			if (parent != NoParent && dirty[parent])
+				dirty[i] = 1;
+
+			dirtyCount += dirty[i];
+		}
+
+		if (threadCount > 1 && dirtyCount >= MinimumParallelCount) {
+			UpdateParallel(threadCount);
+		}
+		else {
+			for (size_t i = 0; i < count; ++i) {
+				if (dirty[i])
+					UpdateNode(i);
+			}
+		}
+
+		anyDirty = false;
+	}
+
+	void TransformHierarchy::UpdateNode(size_t node) {
+		const auto parent = parents[node];
+		const auto local = LocalMatrix(node);
+
+		worlds[node] = parent == NoParent ? local : Matrix::Multiply(local, worlds[parent]);
+		dirty[node] = 0;
+	}
+
+	void TransformHierarchy::UpdateParallel(size_t threadCount) {
+		if (partitionThreads != threadCount)
+			BuildPartitions(threadCount);
+
+		auto work = [this](size_t partition) {
+			for (auto i = partitionOffsets[partition]; i < partitionOffsets[partition + 1]; ++i) {
+				const auto node = partitionNodes[i];
+
+				if (dirty[node])
+					UpdateNode(node);
+			}
+			};
+
+		//The nodes above the subtrees go first, then every thread walks its own subtrees without waiting on the others.
+		work(0);
+		csharp::Parallel::Run(threadCount, [&](size_t thread) { work(thread + 1); });
+	}
+
+	void TransformHierarchy::BuildPartitions(size_t threadCount) {
+		const auto count = parents.size();
+		std::vector<size_t> sizes(count, 1);
+
+		for (size_t i = count; i-- > 0;) {
+			if (parents[i] != NoParent)
+				sizes[parents[i]] += sizes[i];
+		}
+
+		//Subtrees no larger than target are handed whole to the least loaded thread.
+		//Nodes whose subtree is larger stay in partition 0 and are updated first.
+		const auto target = std::max<size_t>(count / (threadCount * 4), 1);
+		std::vector<size_t> owners(count);
+		std::vector<size_t> loads(threadCount);
+
+		for (size_t i = 0; i < count; ++i) {
+			const auto parent = parents[i];
+
+			if (parent != NoParent && owners[parent] != 0) {
+				owners[i] = owners[parent];
+			}
+			else if (sizes[i] > target) {
+				owners[i] = 0;
+			}
+			else {
+				const auto thread = static_cast<size_t>(std::min_element(loads.begin(), loads.end()) - loads.begin());
+				loads[thread] += sizes[i];
+				owners[i] = thread + 1;
+			}
+		}
+
+		//Counting sort by owner, which keeps parents before children inside every partition.
+		partitionOffsets.assign(threadCount + 2, 0);
+
+		for (size_t i = 0; i < count; ++i)
+			++partitionOffsets[owners[i] + 1];
+
+		for (size_t partition = 0; partition <= threadCount; ++partition)
+			partitionOffsets[partition + 1] += partitionOffsets[partition];
+
+		partitionNodes.resize(count);
+		std::vector<size_t> next(partitionOffsets.begin(), partitionOffsets.end() - 1);
+
+		for (size_t i = 0; i < count; ++i)
+			partitionNodes[next[owners[i]]++] = i;
+
+		partitionThreads = threadCount;
+	}
+}
@@ -1,10 +1,16 @@
 #include "xna/content/manager.hpp"
+#include "csharp/io/prefetch.hpp"
 
 namespace xna {
 	std::shared_ptr<csharp::Stream> ContentManager::OpenStream(std::string const& assetName) const {
 		const auto filePath = rootDirectory + "\\" + assetName + contentExtension;
 		const auto stream = snew<csharp::FileStream>(filePath, csharp::FileMode::Open);		
 
+		if (prefetchThreshold > 0 && stream->Length() >= prefetchThreshold) {
+			const auto prefetch = snew<csharp::PrefetchStream>(reinterpret_pointer_cast<csharp::Stream>(stream));
+			return reinterpret_pointer_cast<csharp::Stream>(prefetch);
+		}
+
 		return reinterpret_pointer_cast<csharp::Stream>(stream);
 	}
 }
\ No newline at end of file
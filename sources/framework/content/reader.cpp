@@ -91,23 +91,23 @@ namespace xna {
 		return *(double*)&int64;
 	}
 
-	std::vector<Byte> ContentReader::ReadByteBuffer(size_t size)
+	std::span<const Byte> ContentReader::ReadByteBuffer(size_t size)
 	{
-		if (byteBuffer.empty() || byteBuffer.size() < size)
-		{
-			byteBuffer.resize(size);
-		}
+		byteBuffer.EnsureLength(size);
+
+		auto& buffer = byteBuffer.Buffer();
+		const auto bufferLength = static_cast<Int>(buffer.size());
 		
 		Int num = 0;
 		for (size_t index = 0; index < size; index += num)
 		{			
-			num = Read(byteBuffer.data(), byteBuffer.size(), index, size - index);
-			if (num == 0) {
+			num = Read(buffer.data(), bufferLength, static_cast<Int>(index), static_cast<Int>(size - index));
+			if (num <= 0) {
 				throw std::runtime_error("ContentReader::ReadByteBuffer: Bad xbn.");
 			}
 		}
 
-		return byteBuffer;
+		return std::span<const Byte>(buffer.data(), size);
 	}
 
 	std::shared_ptr<csharp::Stream> ContentReader::PrepareStream(std::shared_ptr<csharp::Stream>& input, String const& assetName, Int& graphicsProfile)
@@ -2,6 +2,7 @@
 #include "xna/content/reader.hpp"
 #include "xna/content/readers/default.hpp"
 #include "csharp/activator.hpp"
+#include "csharp/text/interner.hpp"
 
 namespace xna {
 
@@ -43,9 +44,9 @@ namespace xna {
 
 		for (size_t index = 0; index < typeCount; ++index)
 		{			
-			const auto readerTypeName = contentReader->ReadString();
-			const auto xnaType = readerTypeName.substr(0, readerTypeName.find(","));
-
+			//The view points into the reader's string buffer and is only used before the next string is read.
+			const auto readerTypeName = contentReader->ReadStringView();
+			const auto xnaType = readerTypeName.substr(0, readerTypeName.find(','));
 
 			auto typeReader = ContentTypeReaderManager::GetTypeReader(xnaType.empty() ? readerTypeName : xnaType, contentReader, newTypeReaders);
 
@@ -90,12 +91,13 @@ namespace xna {
 		initMaps();
 	}
 
-	sptr<ContentTypeReader> ContentTypeReaderManager::GetTypeReader(String const& readerTypeName, sptr<ContentReader>& contentReader, std::vector<PContentTypeReader>& newTypeReaders)
+	sptr<ContentTypeReader> ContentTypeReaderManager::GetTypeReader(std::string_view readerTypeName, sptr<ContentReader>& contentReader, std::vector<PContentTypeReader>& newTypeReaders)
 	{
 		sptr<ContentTypeReader> reader = nullptr;
+		const auto it = ContentTypeReaderManager::nameToReader.find(readerTypeName);
 
-		if (ContentTypeReaderManager::nameToReader.contains(readerTypeName)) {
-			return ContentTypeReaderManager::nameToReader[readerTypeName];
+		if (it != ContentTypeReaderManager::nameToReader.end()) {
+			return it->second;
 		}
 		else if (!ContentTypeReaderManager::InstantiateTypeReader(readerTypeName, contentReader, reader)) {
 			return reader;
@@ -108,20 +110,20 @@ namespace xna {
 		return reader;
 	}
 
-	bool ContentTypeReaderManager::InstantiateTypeReader(String const& readerTypeName, sptr<ContentReader>& contentReader, sptr<ContentTypeReader>& reader)
+	bool ContentTypeReaderManager::InstantiateTypeReader(std::string_view readerTypeName, sptr<ContentReader>& contentReader, sptr<ContentTypeReader>& reader)
 	{
 		sptr<csharp::Type> type = csharp::RuntimeType::GetType(readerTypeName);		
 
 		if (!type) {
 
 			std::string error("ContentTypeReaderManager::InstantiateTypeReader:  registered type is null. ");
-			error.append("TypeName: " + readerTypeName);
+			error.append("TypeName: ").append(readerTypeName);
 			throw std::runtime_error(error);
 		}
 
 		if (ContentTypeReaderManager::readerTypeToReader.contains(type)) {
 			reader = ContentTypeReaderManager::readerTypeToReader[type];
-			ContentTypeReaderManager::nameToReader.insert({ readerTypeName, reader });
+			ContentTypeReaderManager::nameToReader.insert({ csharp::StringInterner::Intern(readerTypeName), reader });
 			return false;
 		}
 
@@ -129,7 +131,7 @@ namespace xna {
 		return true;
 	}
 
-	void ContentTypeReaderManager::AddTypeReader(String const& readerTypeName, sptr<ContentReader>& contentReader, sptr<ContentTypeReader>& reader)
+	void ContentTypeReaderManager::AddTypeReader(std::string_view readerTypeName, sptr<ContentReader>& contentReader, sptr<ContentTypeReader>& reader)
 	{
 		auto targetType = reader->TargetType();
 
@@ -139,7 +141,7 @@ namespace xna {
 
 		ContentTypeReaderManager::targetTypeToReader.insert({ targetType, reader });
 		ContentTypeReaderManager::readerTypeToReader.insert({ std::make_shared<csharp::Type>(csharp::GetType(*reader)), reader});
-		ContentTypeReaderManager::nameToReader.insert({ readerTypeName, reader });
+		ContentTypeReaderManager::nameToReader.insert({ csharp::StringInterner::Intern(readerTypeName), reader });
 	}
 
 	void ContentTypeReaderManager::RollbackAddReaders(std::vector<sptr<ContentTypeReader>>& newTypeReaders)
@@ -166,8 +168,8 @@ namespace xna {
 		}
 	}	
 
-	void ContentTypeReaderManager::RollbackAddReader(std::map<String, PContentTypeReader>& dictionary, sptr<ContentTypeReader>& reader) {
-		std::map<String, sptr<ContentTypeReader>>::iterator it;
+	void ContentTypeReaderManager::RollbackAddReader(std::map<std::string_view, PContentTypeReader>& dictionary, sptr<ContentTypeReader>& reader) {
+		std::map<std::string_view, sptr<ContentTypeReader>>::iterator it;
 
 		for (it = dictionary.begin(); it != dictionary.end(); it++) {
 			if (it->second == reader) {
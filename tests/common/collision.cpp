@@ -0,0 +1,111 @@
+#include "xna/common/collision.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace xna;
+
+//Random clouds of points in rotated boxes, moved up to 1E+05 from the origin, where the rounding of the projections is largest.
+static std::vector<Vector3> RandomCloud(std::mt19937& random, size_t set, size_t count) {
+	std::uniform_real_distribution<float> unit(-1.0F, 1.0F);
+	const auto distance = std::pow(10.0F, static_cast<float>(set % 7) - 1.0F);
+	const auto size = std::pow(10.0F, static_cast<float>(set / 7 % 5) - 2.0F);
+
+	const Vector3 offset(unit(random) * distance, unit(random) * distance, unit(random) * distance);
+	const auto rotation = Quaternion::Normalize(Quaternion(unit(random), unit(random), unit(random), unit(random)));
+	const Vector3 half(size * (0.2F + std::abs(unit(random))), size * (0.2F + std::abs(unit(random))), size * (0.2F + std::abs(unit(random))));
+
+	std::vector<Vector3> points(count);
+
+	for (auto& point : points)
+		point = Vector3::Transform(Vector3(unit(random) * half.X, unit(random) * half.Y, unit(random) * half.Z), rotation) + offset;
+
+	return points;
+}
+
+static size_t CountOutside(BoundingOrientedBox const& box, std::vector<Vector3> const& points) {
+	size_t outside = 0;
+
+	for (const auto& point : points) {
+		if (box.Contains(point) == ContainmentType::Disjoint)
+			++outside;
+	}
+
+	return outside;
+}
+
+//BoundingOrientedBox::CreateFromPoints must contain every point it was created from.
+static bool OrientedBoxFromPointsContainsThem() {
+	std::mt19937 random(49);
+	auto passed = true;
+
+	for (size_t set = 0; set < 2000; ++set) {
+		const auto points = RandomCloud(random, set, 3 + set % 200);
+		const auto outside = CountOutside(BoundingOrientedBox::CreateFromPoints(points), points);
+
+		if (outside != 0) {
+			std::printf("CreateFromPoints: set %zu leaves %zu of %zu points outside\n", set, outside, points.size());
+			passed = false;
+		}
+	}
+
+	const auto points = RandomCloud(random, 6, BoundingOrientedBox::MinimumParallelCount);
+	const auto outside = CountOutside(BoundingOrientedBox::CreateFromPoints(points, 4), points);
+
+	if (outside != 0) {
+		std::printf("CreateFromPoints: the parallel set leaves %zu of %zu points outside\n", outside, points.size());
+		passed = false;
+	}
+
+	return passed;
+}
+
+//Depth of two intersecting boxes along their shallowest axis, or 0 when they do not intersect.
+static float BoxDepth(BoundingBox const& a, BoundingBox const& b) {
+	const auto depthX = std::min(a.Max.X - b.Min.X, b.Max.X - a.Min.X);
+	const auto depthY = std::min(a.Max.Y - b.Min.Y, b.Max.Y - a.Min.Y);
+	const auto depthZ = std::min(a.Max.Z - b.Min.Z, b.Max.Z - a.Min.Z);
+	return std::max(std::min(depthX, std::min(depthY, depthZ)), 0.0F);
+}
+
+//Gjk::Penetration of two boxes must find the depth along their shallowest axis, and moving B by Normal * Depth must separate them.
+static bool BoxPenetrationDepth() {
+	std::mt19937 random(47);
+	std::uniform_real_distribution<float> unit(-1.0F, 1.0F);
+	std::uniform_real_distribution<float> half(0.05F, 1.0F);
+	auto passed = true;
+
+	for (size_t pair = 0; pair < 100000; ++pair) {
+		const Vector3 centerA(unit(random), unit(random), unit(random));
+		const Vector3 centerB(unit(random), unit(random), unit(random));
+		const Vector3 halfA(half(random), half(random), half(random));
+		const Vector3 halfB(half(random), half(random), half(random));
+		const BoundingBox a(centerA - halfA, centerA + halfA);
+		const BoundingBox b(centerB - halfB, centerB + halfB);
+		const auto expected = BoxDepth(a, b);
+
+		if (expected <= 0.0F)
+			continue;
+
+		const auto result = Gjk::Penetration(a, b);
+		const auto offset = result.Normal * result.Depth;
+		const auto remaining = BoxDepth(a, BoundingBox(b.Min + offset, b.Max + offset));
+		const auto tolerance = 1E-04F * (1.0F + expected);
+
+		if (!result.Intersects || std::abs(result.Depth - expected) > tolerance || remaining > tolerance) {
+			std::printf("Penetration: pair %zu has depth %g, expected %g, and leaves %g after moving along (%g, %g, %g)\n",
+				pair, result.Depth, expected, remaining, result.Normal.X, result.Normal.Y, result.Normal.Z);
+			passed = false;
+		}
+	}
+
+	return passed;
+}
+
+int main() {
+	auto passed = OrientedBoxFromPointsContainsThem();
+	passed = BoxPenetrationDepth() && passed;
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include "xna/common/numerics.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+using namespace xna;
+
+//Matrices in constant expressions use the scalar code, the same calls at run time use the SSE, AVX2 or AVX-512 paths.
+//The vector paths add and multiply in the scalar order, so every result must have the same bits. GCC and Clang fuse
+//multiplies and adds at run time when FMA is enabled, for example with -march=native, and then no result has the same bits.
+static constexpr size_t MatrixCount = 64;
+
+using Matrices = std::array<Matrix, MatrixCount>;
+
+//Elements in [-2, 2) from a linear congruential generator, so the inputs can be built in constant expressions.
+static constexpr Matrices RandomMatrices(uint32_t seed, bool affine) {
+	Matrices matrices{};
+
+	for (auto& matrix : matrices) {
+		float* elements[16] = {
+			&matrix.M11, &matrix.M12, &matrix.M13, &matrix.M14,
+			&matrix.M21, &matrix.M22, &matrix.M23, &matrix.M24,
+			&matrix.M31, &matrix.M32, &matrix.M33, &matrix.M34,
+			&matrix.M41, &matrix.M42, &matrix.M43, &matrix.M44 };
+
+		for (auto element : elements) {
+			seed = seed * 1664525u + 1013904223u;
+			*element = static_cast<float>(seed >> 8) / 4194304.0F - 2.0F;
+		}
+
+		if (affine) {
+			matrix.M14 = 0.0F;
+			matrix.M24 = 0.0F;
+			matrix.M34 = 0.0F;
+			matrix.M44 = 1.0F;
+		}
+	}
+
+	return matrices;
+}
+
+template <typename Operation>
+static constexpr Matrices Apply(Matrices const& matrices, Operation operation) {
+	Matrices results{};
+
+	for (size_t i = 0; i < MatrixCount; ++i)
+		results[i] = operation(matrices[i], i);
+
+	return results;
+}
+
+static constexpr auto Left = RandomMatrices(33, false);
+static constexpr auto Right = RandomMatrices(34, false);
+static constexpr auto Affine = RandomMatrices(35, true);
+
+static constexpr auto Products = Apply(Left, [](Matrix const& matrix, size_t i) { return Matrix::Multiply(matrix, Right[i]); });
+static constexpr auto BatchProducts = Apply(Left, [](Matrix const& matrix, size_t) { return Matrix::Multiply(matrix, Right[0]); });
+static constexpr auto Inverses = Apply(Left, [](Matrix const& matrix, size_t) { return Matrix::Invert(matrix); });
+static constexpr auto Transposes = Apply(Left, [](Matrix const& matrix, size_t) { return Matrix::Transpose(matrix); });
+static constexpr auto AffineInverses = Apply(Affine, [](Matrix const& matrix, size_t) { return Matrix::InvertAffine(matrix); });
+static constexpr auto OrthonormalInverses = Apply(Affine, [](Matrix const& matrix, size_t) { return Matrix::InvertOrthonormal(matrix); });
+
+static bool SameBits(Matrix const& matrix1, Matrix const& matrix2) {
+	return std::memcmp(&matrix1, &matrix2, sizeof(Matrix)) == 0;
+}
+
+//Compares operation(source[i], i) at run time with the results of the constant evaluation.
+template <typename Operation>
+static bool Compare(char const* name, Matrices const& source, Matrices const& expected, Operation operation) {
+	auto passed = true;
+
+	for (size_t i = 0; i < MatrixCount; ++i) {
+		//Read through volatile, so the compiler cannot fold the call back into a constant.
+		const volatile size_t index = i;
+
+		if (!SameBits(operation(source[index], index), expected[i])) {
+			std::printf("%s: matrix %zu differs from the scalar result\n", name, i);
+			passed = false;
+		}
+	}
+
+	return passed;
+}
+
+//The batch Multiply must match the single Multiply for every count, which covers the tails of every vector path, and in place.
+static bool BatchMultiply() {
+	auto passed = true;
+	Matrices destination;
+
+	for (size_t count = 0; count <= MatrixCount; ++count) {
+		destination.fill(Matrix());
+
+		if (!Matrix::Multiply(std::span<const Matrix>(Left.data(), count), Right[0], std::span<Matrix>(destination.data(), count))) {
+			std::printf("Multiply batch: count %zu was rejected\n", count);
+			passed = false;
+			continue;
+		}
+
+		for (size_t i = 0; i < count; ++i) {
+			if (!SameBits(destination[i], BatchProducts[i])) {
+				std::printf("Multiply batch: matrix %zu of %zu differs from the scalar result\n", i, count);
+				passed = false;
+			}
+		}
+	}
+
+	destination = Left;
+	Matrix::Multiply(destination, destination[5], destination);
+	const auto right = Left[5];
+
+	for (size_t i = 0; i < MatrixCount; ++i) {
+		if (!SameBits(destination[i], Matrix::Multiply(Left[i], right))) {
+			std::printf("Multiply batch in place: matrix %zu differs from the single Multiply\n", i);
+			passed = false;
+		}
+	}
+
+	if (Matrix::Multiply(Left, Right[0], std::span<Matrix>(destination.data(), MatrixCount - 1))) {
+		std::printf("Multiply batch: a short destination was accepted\n");
+		passed = false;
+	}
+
+	return passed;
+}
+
+#if defined(__FMA__) && !defined(_MSC_VER)
+static constexpr bool Contracted = true;
+#else
+static constexpr bool Contracted = false;
+#endif
+
+//Exit code that CTest reports as a skipped test.
+static constexpr int Skipped = 77;
+
+int main() {
+	if (Contracted) {
+		std::printf("Skipped: FMA contraction changes the rounding of the run time results\n");
+		return Skipped;
+	}
+
+	auto passed = Compare("Multiply", Left, Products, [](Matrix const& matrix, size_t i) { return Matrix::Multiply(matrix, Right[i]); });
+	passed = Compare("Invert", Left, Inverses, [](Matrix const& matrix, size_t) { return Matrix::Invert(matrix); }) && passed;
+	passed = Compare("Transpose", Left, Transposes, [](Matrix const& matrix, size_t) { return Matrix::Transpose(matrix); }) && passed;
+	passed = Compare("InvertAffine", Affine, AffineInverses, [](Matrix const& matrix, size_t) { return Matrix::InvertAffine(matrix); }) && passed;
+	passed = Compare("InvertOrthonormal", Affine, OrthonormalInverses, [](Matrix const& matrix, size_t) { return Matrix::InvertOrthonormal(matrix); }) && passed;
+	passed = BatchMultiply() && passed;
+	return passed ? 0 : 1;
+}